@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <map>
+#include "tree_planner.hpp"
+#include "beam_search_strategy.hpp"
+#include "fixed_priority_cost_function.hpp"
+#include "neighbor_generator.hpp"
+#include "arbitrator_utils.hpp"
+
+namespace arbitrator
+{
+    /**
+     * \brief NeighborGenerator standing in for a set of strategic plugins
+     * 
+     * Each simulated plugin appends one maneuver of a plugin specific length to the plan
+     * after a fixed service call latency, so plan quality only depends on how much of the
+     * tree the search explores within its budget.
+     */
+    class SimulatedPluginNeighborGenerator : public NeighborGenerator
+    {
+        public:
+            SimulatedPluginNeighborGenerator(int num_plugins, std::chrono::microseconds latency) :
+                num_plugins_(num_plugins),
+                latency_(latency) {};
+
+            std::vector<cav_msgs::ManeuverPlan> generate_neighbors(cav_msgs::ManeuverPlan plan) const
+            {
+                std::this_thread::sleep_for(latency_);
+
+                double start_dist = plan.maneuvers.empty() ? 0.0 : arbitrator_utils::get_plan_end_distance(plan);
+                ros::Time start_time = plan.maneuvers.empty() ? ros::Time(0) : arbitrator_utils::get_plan_end_time(plan);
+
+                std::vector<cav_msgs::ManeuverPlan> out;
+                for (int i = 0; i < num_plugins_; i++)
+                {
+                    cav_msgs::ManeuverPlan child = plan;
+                    cav_msgs::Maneuver mvr;
+                    mvr.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+                    mvr.lane_following_maneuver.parameters.planning_strategic_plugin = plugin_name(i);
+                    mvr.lane_following_maneuver.start_dist = start_dist;
+                    mvr.lane_following_maneuver.end_dist = start_dist + 20.0 * (i + 1);
+                    mvr.lane_following_maneuver.start_time = start_time;
+                    mvr.lane_following_maneuver.end_time = start_time + ros::Duration(1.0 + 0.5 * i);
+                    child.maneuvers.push_back(mvr);
+                    out.push_back(child);
+                }
+                return out;
+            }
+
+            static std::string plugin_name(int i)
+            {
+                return "plugin_" + std::to_string(i);
+            }
+
+        private:
+            int num_plugins_;
+            std::chrono::microseconds latency_;
+    };
+
+    /**
+     * Plan a 15s horizon against 4 simulated plugins answering in 5ms each with a budget of
+     * range(0) milliseconds. The resulting plan duration and cost are reported as counters.
+     */
+    static void BM_TreePlannerBudget(benchmark::State& state)
+    {
+        const int num_plugins = 4;
+        std::map<std::string, double> priorities;
+        for (int i = 0; i < num_plugins; i++)
+        {
+            priorities[SimulatedPluginNeighborGenerator::plugin_name(i)] = 10.0 - i;
+        }
+        FixedPriorityCostFunction cf{priorities};
+        SimulatedPluginNeighborGenerator ng{num_plugins, std::chrono::microseconds(5000)};
+        BeamSearchStrategy ss{3};
+        TreePlanner tp{cf, ng, ss, ros::Duration(15.0), ros::WallDuration(state.range(0) / 1000.0)};
+
+        double plan_duration = 0.0;
+        double plan_cost = 0.0;
+        for (auto _ : state)
+        {
+            cav_msgs::ManeuverPlan plan = tp.generate_plan();
+            benchmark::DoNotOptimize(plan);
+            if (!plan.maneuvers.empty())
+            {
+                plan_duration = (arbitrator_utils::get_plan_end_time(plan) - arbitrator_utils::get_plan_start_time(plan)).toSec();
+                plan_cost = cf.compute_cost_per_unit_distance(plan);
+            }
+        }
+        state.counters["plan_duration_s"] = plan_duration;
+        state.counters["plan_cost_per_m"] = plan_cost;
+    }
+    // A budget of 0 is unbounded and serves as the quality reference
+    BENCHMARK(BM_TreePlannerBudget)->Arg(10)->Arg(25)->Arg(50)->Arg(100)->Arg(0)->Unit(benchmark::kMillisecond);
+
+    /**
+     * Cost of prioritizing an open list of range(0) plans into a beam of 3
+     */
+    static void BM_BeamSearchPrioritize(benchmark::State& state)
+    {
+        BeamSearchStrategy ss{3};
+        std::vector<std::pair<cav_msgs::ManeuverPlan, double>> plans;
+        for (int64_t i = 0; i < state.range(0); i++)
+        {
+            plans.push_back(std::make_pair(cav_msgs::ManeuverPlan(), static_cast<double>((i * 7919) % state.range(0))));
+        }
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(ss.prioritize_plans(plans));
+        }
+    }
+    BENCHMARK(BM_BeamSearchPrioritize)->Range(8, 4096);
+}
+
+BENCHMARK_MAIN();
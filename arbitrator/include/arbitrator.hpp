@@ -17,12 +17,19 @@
 #ifndef __ARBITRATOR_INCLUDE_ARBITRATOR_HPP__
 #define __ARBITRATOR_INCLUDE_ARBITRATOR_HPP__
 
+#include <memory>
+#include <mutex>
 #include <ros/ros.h>
 #include <carma_utils/CARMAUtils.h>
 #include "arbitrator_state_machine.hpp"
 #include "planning_strategy.hpp"
+#include "planning_scheduler.hpp"
 #include "capabilities_interface.hpp"
 #include <cav_msgs/GuidanceState.h>
+#include <cav_msgs/ManeuverPlan.h>
+#include <cav_msgs/RouteEvent.h>
+#include <geometry_msgs/TwistStamped.h>
+#include <autoware_lanelet2_msgs/MapBin.h>
 
 namespace arbitrator 
 {
@@ -60,12 +67,14 @@ namespace arbitrator
                 planning_strategy_(planning_strategy),
                 initialized_(false),
                 min_plan_duration_(min_plan_duration),
-                time_between_plans_(planning_frequency.expectedCycleTime()) {};
+                time_between_plans_(planning_frequency.expectedCycleTime()),
+                scheduler_(planning_frequency.expectedCycleTime()) {};
             
             /**
              * \brief Begin the operation of the arbitrator.
              * 
-             * Loops internally via ros::Duration sleeps and spins
+             * ROS callbacks are serviced by a background spinner while this thread
+             * runs the state machine, blocking on the PlanningScheduler between plans
              */
             void run();
         protected:
@@ -102,15 +111,56 @@ namespace arbitrator
              */
             void guidance_state_cb(const cav_msgs::GuidanceState::ConstPtr& msg);
 
+            /**
+             * \brief Callback for route events, requests an immediate replan if enabled
+             * \param msg The new RouteEvent message
+             */
+            void route_event_cb(const cav_msgs::RouteEvent::ConstPtr& msg);
+
+            /**
+             * \brief Callback for map updates, requests an immediate replan on geofence activation if enabled.
+             *      Updates published before the subscription was made and updates which add no regulations are ignored
+             * \param msg The new map update message
+             */
+            void map_update_cb(const autoware_lanelet2_msgs::MapBin::ConstPtr& msg);
+
+            /**
+             * \brief Callback for vehicle speed, requests an immediate replan if the vehicle deviates
+             *      from the speed expected by the last published plan by more than the configured threshold
+             * \param msg The new TwistStamped message
+             */
+            void twist_cb(const geometry_msgs::TwistStamped::ConstPtr& msg);
+
+            /**
+             * \brief Callback for the one-shot timer marking the start of the next planning period
+             */
+            void planning_timer_cb(const ros::TimerEvent& event);
+
         private:
             ArbitratorStateMachine *sm_;
             ros::Publisher final_plan_pub_;
             ros::Subscriber guidance_state_sub_;
+            ros::Subscriber route_event_sub_;
+            ros::Subscriber map_update_sub_;
+            // Time at which map_update was subscribed, older latched updates do not trigger a replan
+            ros::Time map_update_subscribe_time_;
+            ros::Subscriber twist_sub_;
+            ros::Publisher planning_latency_pub_;
+            ros::Publisher planning_jitter_pub_;
+            ros::Timer planning_timer_;
+            std::unique_ptr<ros::AsyncSpinner> spinner_;
             ros::CARMANodeHandle *nh_;
             ros::CARMANodeHandle *pnh_;
             ros::Duration min_plan_duration_;
             ros::Duration time_between_plans_;
-            ros::Time next_planning_process_start_;
+            PlanningScheduler scheduler_;
+            // Last published plan, used for deviation detection from the spinner thread
+            std::mutex plan_mutex_;
+            cav_msgs::ManeuverPlan latest_plan_;
+            bool deviation_reported_ = false;
+            bool replan_on_route_change_ = true;
+            bool replan_on_geofence_ = true;
+            double replan_speed_deviation_ = 0.0;
             CapabilitiesInterface *capabilities_interface_;
             PlanningStrategy &planning_strategy_;
             bool initialized_;
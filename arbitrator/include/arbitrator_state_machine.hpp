@@ -18,6 +18,7 @@
 #define __ARBITRATOR_INCLUDE_ARBITRATOR_STATE_MACHINE_HPP__
 
 #include <vector>
+#include <mutex>
 
 namespace arbitrator
 {
@@ -70,6 +71,7 @@ namespace arbitrator
      * state the Arbitrator will take. The transition list is defined internally
      * and each transition must be unique/deterministic (each state/event pair
      * must transition to one-and-only-one other state) or behavior is undefined.
+     * Events may be submitted from any thread.
      */
     class ArbitratorStateMachine
     {
@@ -113,6 +115,7 @@ namespace arbitrator
             };
 
             ArbitratorState current_state;
+            std::mutex state_mutex_;
     };
 }
 
@@ -19,6 +19,7 @@
 
 #include <ros/ros.h>
 #include <cav_msgs/ManeuverPlan.h>
+#include <autoware_lanelet2_msgs/MapBin.h>
 
 /**
  * \brief Macro definition to enable easier access to fields shared across the maneuver typees
@@ -103,6 +104,41 @@ namespace arbitrator_utils
      * \throws An invalid argument exception if the maneuver is poorly constructed
      */
     double get_maneuver_end_distance(const cav_msgs::Maneuver&);
+
+    /**
+     * \brief Get the speed the plan expects the vehicle to have at the specified time
+     * \param plan The plan to examine
+     * \param time The time to evaluate the plan at
+     * \return The speed in m/s linearly interpolated within the maneuver active at that time,
+     *      clamped to the start and end speeds of the plan outside of its time span
+     * \throws An invalid argument exception if the plan is empty
+     */
+    double get_planned_speed(const cav_msgs::ManeuverPlan&, ros::Time);
+
+    /**
+     * \brief Compute a hash of the maneuvers in a plan for duplicate detection
+     * \param plan The plan to examine
+     * \return A hash over the type, planning plugin, and start/end time, distance and speed of each maneuver.
+     *      Plans differing only in their ID or planning timestamps hash equally. Other fields such as lane ids
+     *      are not hashed, use plans_equal to tell plans with the same hash apart.
+     */
+    std::size_t hash_plan(const cav_msgs::ManeuverPlan&);
+
+    /**
+     * \brief Check whether two plans consist of the same maneuvers
+     * \param a The first plan
+     * \param b The second plan
+     * \return True if every field of every maneuver is equal. The plan ID and planning timestamps are ignored.
+     */
+    bool plans_equal(const cav_msgs::ManeuverPlan&, const cav_msgs::ManeuverPlan&);
+
+    /**
+     * \brief Check whether a map update adds or changes regulatory elements
+     * \param msg The map update published by the WMBroadcaster, in either the full or the compact format
+     * \return True if the decoded update has a regulatory element to add or update. Updates which only remove
+     *      regulatory elements, such as geofence deactivations, and updates which cannot be decoded return false
+     */
+    bool map_update_adds_regulations(const autoware_lanelet2_msgs::MapBin&);
 } // namespace arbitrator
 
 #endif //__ARBITRATOR_INCLUDE_ARBITRATOR_UTILS_HPP__
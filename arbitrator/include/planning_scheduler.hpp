@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#ifndef __ARBITRATOR_INCLUDE_PLANNING_SCHEDULER_HPP__
+#define __ARBITRATOR_INCLUDE_PLANNING_SCHEDULER_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <ros/ros.h>
+
+namespace arbitrator
+{
+    /**
+     * Reasons for the Arbitrator to start a new planning cycle:
+     * NONE - No replan has been requested
+     * PERIODIC - The planning period has elapsed since the start of the last cycle
+     * ROUTE_CHANGE - A new route has been selected, started or abandoned
+     * GEOFENCE_ACTIVATION - The map has been updated with a new geofence
+     * PLAN_DEVIATION - The vehicle state deviates too far from the current plan
+     */
+    enum PlanningTrigger {
+        NONE = 0,
+        PERIODIC,
+        ROUTE_CHANGE,
+        GEOFENCE_ACTIVATION,
+        PLAN_DEVIATION
+    };
+
+    /**
+     * \brief Statistics on the timing of the Arbitrator planning cycles
+     */
+    struct PlanningTimingStats
+    {
+        // Number of completed planning cycles
+        uint64_t cycles = 0;
+        // Number of cycles which took longer than the planning period
+        uint64_t deadline_misses = 0;
+        // Number of searches abandoned in favor of a newer trigger
+        uint64_t cancellations = 0;
+        // Duration of the last planning cycle in seconds
+        double last_latency = 0.0;
+        // Delay between the trigger and the start of the last planning cycle in seconds
+        double last_jitter = 0.0;
+        double max_latency = 0.0;
+        double max_jitter = 0.0;
+    };
+
+    /**
+     * \brief Thread safe scheduler deciding when the Arbitrator starts its next planning cycle
+     * 
+     * Planning triggers are submitted from ROS callbacks running on a spinner thread,
+     * while the Arbitrator main loop blocks in wait_for_trigger() until a trigger arrives.
+     * A trigger other than PERIODIC which arrives while a search is in progress sets the 
+     * cancellation flag so the search can give up early and the Arbitrator can replan with 
+     * the new information. To avoid starving the system of plans only one search in a row 
+     * may be cancelled.
+     */
+    class PlanningScheduler
+    {
+        public:
+            /**
+             * \brief Constructor for PlanningScheduler
+             * \param planning_period The nominal time between the start of two planning cycles
+             * \param allow_cancellation If false, triggers never cancel a search in progress
+             */
+            PlanningScheduler(ros::Duration planning_period, bool allow_cancellation = true) :
+                planning_period_(planning_period),
+                allow_cancellation_(allow_cancellation) {};
+
+            /**
+             * \brief Request a new planning cycle
+             * \param trigger The reason for replanning
+             * \param stamp The time at which the replan should have started, used for jitter tracking
+             */
+            void request_replan(PlanningTrigger trigger, ros::Time stamp);
+
+            /**
+             * \brief Wake up the thread blocked in wait_for_trigger without requesting a replan.
+             * Used to notify the Arbitrator of state machine changes and shutdown.
+             */
+            void notify();
+
+            /**
+             * \brief Block until a replan is requested or notify() is called
+             * \param max_wait Upper bound on the time spent waiting
+             * \return The pending trigger, or NONE if woken up without a trigger
+             */
+            PlanningTrigger wait_for_trigger(std::chrono::milliseconds max_wait);
+
+            /**
+             * \brief Discard any pending trigger without starting a planning cycle
+             */
+            void clear_trigger();
+
+            /**
+             * \brief Mark the start of a planning cycle, consuming any pending trigger
+             * \param now The current time
+             * \return The trigger which started this cycle
+             */
+            PlanningTrigger begin_planning(ros::Time now);
+
+            /**
+             * \brief Mark the end of a planning cycle and update the timing statistics
+             * \param now The current time
+             * \return True if the search of this cycle was cancelled
+             */
+            bool end_planning(ros::Time now);
+
+            /**
+             * \brief Flag which is set while a newer trigger supersedes the search in progress
+             */
+            const std::atomic<bool>& cancellation_flag() const;
+
+            /**
+             * \brief Get a copy of the current timing statistics
+             */
+            PlanningTimingStats get_stats() const;
+
+            /**
+             * \brief Get the nominal time between the start of two planning cycles
+             */
+            ros::Duration get_planning_period() const;
+
+        private:
+            mutable std::mutex mutex_;
+            std::condition_variable cv_;
+            ros::Duration planning_period_;
+            bool allow_cancellation_;
+            bool woken_ = false;
+            PlanningTrigger pending_trigger_ = NONE;
+            ros::Time pending_stamp_;
+            bool planning_in_progress_ = false;
+            bool last_cycle_cancelled_ = false;
+            ros::Time planning_start_;
+            std::atomic<bool> cancelled_{false};
+            PlanningTimingStats stats_;
+    };
+};
+
+#endif //__ARBITRATOR_INCLUDE_PLANNING_SCHEDULER_HPP__
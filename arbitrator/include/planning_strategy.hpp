@@ -17,6 +17,7 @@
 #ifndef __ARBITRATOR_INCLUDE_PLANNING_STRATEGY_HPP__
 #define __ARBITRATOR_INCLUDE_PLANNING_STRATEGY_HPP__
 
+#include <atomic>
 #include <cav_msgs/ManeuverPlan.h>
 
 namespace arbitrator
@@ -34,6 +35,17 @@ namespace arbitrator
              */
             virtual cav_msgs::ManeuverPlan generate_plan() = 0;
 
+            /**
+             * \brief Generate a plausible maneuver plan which may be abandoned early
+             * \param cancelled Flag set from another thread once the result is no longer needed.
+             *      Implementations should poll it between search steps and return their best plan so far.
+             * \return A maneuver plan from the vehicle's current state
+             */
+            virtual cav_msgs::ManeuverPlan generate_plan(const std::atomic<bool>& cancelled)
+            {
+                return generate_plan();
+            }
+
             /**
              * \brief Virtual destructor provided for memory safety
              */
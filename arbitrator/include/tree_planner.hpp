@@ -44,26 +44,37 @@ namespace arbitrator
              * \param ng A reference to a NeighborGenerator implementation
              * \param ss A reference to a SearchStrategy implementation
              * \param target The desired duration of finished plans
+             * \param budget The wall-clock time the search may take before the best plan found so far
+             *      is returned. A zero budget lets the search run until the target duration is reached.
              */
             TreePlanner(CostFunction &cf, 
                 NeighborGenerator &ng, 
                 SearchStrategy &ss, 
-                ros::Duration target):
+                ros::Duration target,
+                ros::WallDuration budget = ros::WallDuration(0)):
                 cost_function_(cf),
                 neighbor_generator_(ng),
                 search_strategy_(ss),
-                target_plan_duration_(target) {};
+                target_plan_duration_(target),
+                planning_budget_(budget) {};
 
             /**
              * \brief Utilize the configured cost function, neighbor generator, 
              *      and search strategy, to generate a plan by means of tree search
              */
             cav_msgs::ManeuverPlan generate_plan();
+
+            /**
+             * \brief Tree search as above which stops expanding the tree once cancelled is set
+             *      or the planning budget is exhausted and returns the longest plan found so far
+             */
+            cav_msgs::ManeuverPlan generate_plan(const std::atomic<bool>& cancelled);
         protected:
             CostFunction &cost_function_;
             NeighborGenerator &neighbor_generator_;
             SearchStrategy &search_strategy_;
             ros::Duration target_plan_duration_;
+            ros::WallDuration planning_budget_;
     };
 };
 
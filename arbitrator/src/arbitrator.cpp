@@ -19,17 +19,21 @@
 #include <cav_srvs/PlanManeuvers.h>
 #include "arbitrator_utils.hpp"
 #include <ros/ros.h>
+#include <std_msgs/Float64.h>
 #include <exception>
 #include <cstdlib>
+#include <cmath>
 
 namespace arbitrator
 {
     void Arbitrator::run()
     {
         ROS_INFO("Aribtrator started, beginning arbitrator state machine.");
+        // Callbacks are serviced in the background so the state machine thread can block until it has work
+        spinner_.reset(new ros::AsyncSpinner(1));
+        spinner_->start();
         while (!ros::isShuttingDown())
         {
-            ros::spinOnce();
             switch (sm_->get_state()) 
             {
                 case INITIAL:
@@ -48,10 +52,14 @@ namespace arbitrator
                     ROS_INFO("Aribtrator spinning in PAUSED state.");
                     paused_state();
                     break;
+                case SHUTDOWN:
+                    shutdown_state();
+                    break;
                 default:
                     throw std::invalid_argument("State machine attempting to process an illegal state value");
             }
         }
+        spinner_->stop();
     }
     
     void Arbitrator::guidance_state_cb(const cav_msgs::GuidanceState::ConstPtr& msg) 
@@ -86,6 +94,74 @@ namespace arbitrator
             default:
                 break;
         }
+        // Wake up the state machine thread so it can act on the new state
+        scheduler_.notify();
+    }
+
+    void Arbitrator::route_event_cb(const cav_msgs::RouteEvent::ConstPtr& msg)
+    {
+        if (replan_on_route_change_)
+        {
+            ROS_INFO_STREAM("Arbitrator received route event " << static_cast<int>(msg->event) << ", requesting replan.");
+            scheduler_.request_replan(PlanningTrigger::ROUTE_CHANGE, ros::Time::now());
+        }
+    }
+
+    void Arbitrator::map_update_cb(const autoware_lanelet2_msgs::MapBin::ConstPtr& msg)
+    {
+        if (!replan_on_geofence_)
+        {
+            return;
+        }
+        // map_update is latched, an update published before the subscription was made is already planned around
+        if (msg->header.stamp < map_update_subscribe_time_)
+        {
+            ROS_DEBUG("Arbitrator ignoring map update published before it subscribed.");
+            return;
+        }
+        if (!arbitrator_utils::map_update_adds_regulations(*msg))
+        {
+            ROS_DEBUG("Arbitrator ignoring map update which adds no regulations.");
+            return;
+        }
+        ROS_INFO("Arbitrator received geofence map update, requesting replan.");
+        scheduler_.request_replan(PlanningTrigger::GEOFENCE_ACTIVATION, ros::Time::now());
+    }
+
+    void Arbitrator::twist_cb(const geometry_msgs::TwistStamped::ConstPtr& msg)
+    {
+        if (replan_speed_deviation_ <= 0.0)
+        {
+            return;
+        }
+
+        double planned_speed;
+        {
+            std::lock_guard<std::mutex> lock(plan_mutex_);
+            // Report a deviation only once per published plan
+            if (latest_plan_.maneuvers.empty() || deviation_reported_)
+            {
+                return;
+            }
+            planned_speed = arbitrator_utils::get_planned_speed(latest_plan_, ros::Time::now());
+        }
+
+        double deviation = std::fabs(msg->twist.linear.x - planned_speed);
+        if (deviation > replan_speed_deviation_)
+        {
+            {
+                std::lock_guard<std::mutex> lock(plan_mutex_);
+                deviation_reported_ = true;
+            }
+            ROS_INFO_STREAM("Vehicle speed deviates " << deviation << " m/s from current plan, requesting replan.");
+            scheduler_.request_replan(PlanningTrigger::PLAN_DEVIATION, ros::Time::now());
+        }
+    }
+
+    void Arbitrator::planning_timer_cb(const ros::TimerEvent& event)
+    {
+        // Use the scheduled time so timer latency is included in the reported jitter
+        scheduler_.request_replan(PlanningTrigger::PERIODIC, event.current_expected);
     }
 
     void Arbitrator::initial_state()
@@ -95,6 +171,16 @@ namespace arbitrator
             ROS_INFO("Arbitrator initializing on first initial state spin...");
             final_plan_pub_ = nh_->advertise<cav_msgs::ManeuverPlan>("final_maneuver_plan", 5);
             guidance_state_sub_ = nh_->subscribe<cav_msgs::GuidanceState>("guidance_state", 5, &Arbitrator::guidance_state_cb, this);
+            planning_latency_pub_ = pnh_->advertise<std_msgs::Float64>("planning_latency", 5);
+            planning_jitter_pub_ = pnh_->advertise<std_msgs::Float64>("planning_jitter", 5);
+
+            pnh_->param("replan_on_route_change", replan_on_route_change_, true);
+            pnh_->param("replan_on_geofence", replan_on_geofence_, true);
+            pnh_->param("replan_speed_deviation", replan_speed_deviation_, 0.0);
+            route_event_sub_ = nh_->subscribe<cav_msgs::RouteEvent>("route_event", 5, &Arbitrator::route_event_cb, this);
+            map_update_subscribe_time_ = ros::Time::now();
+            map_update_sub_ = nh_->subscribe<autoware_lanelet2_msgs::MapBin>("map_update", 5, &Arbitrator::map_update_cb, this);
+            twist_sub_ = nh_->subscribe<geometry_msgs::TwistStamped>("current_velocity", 5, &Arbitrator::twist_cb, this);
             initialized_ = true;
             // TODO: load plan duration from parameters file
         }
@@ -104,8 +190,21 @@ namespace arbitrator
     {
         ROS_INFO("Aribtrator beginning planning process!");
         ros::Time planning_process_start = ros::Time::now();
-        cav_msgs::ManeuverPlan plan = planning_strategy_.generate_plan();
-        if (!plan.maneuvers.empty()) 
+        PlanningTrigger trigger = scheduler_.begin_planning(planning_process_start);
+        ROS_DEBUG_STREAM("Planning cycle started by trigger " << static_cast<int>(trigger));
+
+        // Schedule the next periodic cycle relative to the start of this one so that
+        // the planning period is kept regardless of how long the search takes
+        planning_timer_ = nh_->createTimer(time_between_plans_, &Arbitrator::planning_timer_cb, this, true);
+
+        cav_msgs::ManeuverPlan plan = planning_strategy_.generate_plan(scheduler_.cancellation_flag());
+        bool cancelled = scheduler_.end_planning(ros::Time::now());
+
+        if (cancelled)
+        {
+            ROS_INFO("Arbitrator search was superseded by a newer planning trigger, replanning.");
+        }
+        else if (!plan.maneuvers.empty()) 
         {
             ros::Time plan_end_time = arbitrator_utils::get_plan_end_time(plan);
             ros::Time plan_start_time = arbitrator_utils::get_plan_start_time(plan);
@@ -120,32 +219,48 @@ namespace arbitrator
                 ROS_INFO_STREAM("Arbitrator is publishing plan " << plan.maneuver_plan_id << " of duration " << plan_duration << " as current maneuver plan");
             }
             final_plan_pub_.publish(plan);
+            std::lock_guard<std::mutex> lock(plan_mutex_);
+            latest_plan_ = plan;
+            deviation_reported_ = false;
         }
         else
         {
             ROS_WARN("Arbitrator was unable to generate a plan!");
         }
 
-        next_planning_process_start_ = planning_process_start + time_between_plans_;
+        PlanningTimingStats stats = scheduler_.get_stats();
+        std_msgs::Float64 latency_msg;
+        latency_msg.data = stats.last_latency;
+        planning_latency_pub_.publish(latency_msg);
+        std_msgs::Float64 jitter_msg;
+        jitter_msg.data = stats.last_jitter;
+        planning_jitter_pub_.publish(jitter_msg);
+        if (stats.last_latency > time_between_plans_.toSec())
+        {
+            ROS_WARN_STREAM("Arbitrator planning took " << stats.last_latency << " s, exceeding the planning period. Total deadline misses: " << stats.deadline_misses);
+        }
 
         sm_->submit_event(ArbitratorEvent::PLANNING_COMPLETE);
     }
 
     void Arbitrator::waiting_state()
     {
-        // Sleep in 100ms increments until our next planning cycle
-        // This ensures we spin() at least a few times
-        while (ros::Time::now() < next_planning_process_start_)
+        // Block until the planning timer fires or an event requests a replan. Waking up without
+        // a trigger means the state machine changed state from a callback and must be re-evaluated.
+        // The bounded wait only guards against missing a shutdown request.
+        if (scheduler_.wait_for_trigger(std::chrono::milliseconds(1000)) != PlanningTrigger::NONE)
         {
-            ros::Duration(0.1).sleep();
+            ROS_INFO("Arbitrator transitioning from WAITING to PLANNING state.");
+            sm_->submit_event(ArbitratorEvent::PLANNING_TIMER_TRIGGER);
         }
-        ROS_INFO("Arbitrator transitioning from WAITING to PLANNING state.");
-        sm_->submit_event(ArbitratorEvent::PLANNING_TIMER_TRIGGER);
     }
 
     void Arbitrator::paused_state()
     {
-        ros::Duration(0.1).sleep();
+        // Triggers are irrelevant while paused, resuming always starts a new planning cycle
+        scheduler_.wait_for_trigger(std::chrono::milliseconds(1000));
+        planning_timer_.stop();
+        scheduler_.clear_trigger();
     }
 
     void Arbitrator::shutdown_state()
@@ -58,7 +58,9 @@ int main(int argc, char** argv)
 
     double target_plan;
     pnh.param("target_duration", target_plan, 15.0);
-    arbitrator::TreePlanner tp{*cf, png, bss, ros::Duration(target_plan)};
+    double planning_budget;
+    pnh.param("planning_budget", planning_budget, 0.0);
+    arbitrator::TreePlanner tp{*cf, png, bss, ros::Duration(target_plan), ros::WallDuration(planning_budget)};
 
     double min_plan_duration;
     pnh.param("min_plan_duration", min_plan_duration, 6.0);
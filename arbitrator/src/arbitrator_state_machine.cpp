@@ -21,12 +21,14 @@ namespace arbitrator
 
     ArbitratorState ArbitratorStateMachine::get_state()
     {
+        std::lock_guard<std::mutex> lock(state_mutex_);
         return current_state;        
     }
 
 
     ArbitratorState ArbitratorStateMachine::submit_event(ArbitratorEvent event)
     {
+        std::lock_guard<std::mutex> lock(state_mutex_);
         for (auto iter = ARBITRATOR_TRANSITIONS.begin(); iter != ARBITRATOR_TRANSITIONS.end(); iter++) 
         {
             if (current_state == iter->current_state && event == iter->input_event) {
@@ -17,6 +17,11 @@
 #include "arbitrator_utils.hpp"
 #include <cav_msgs/Maneuver.h>
 #include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <ros/serialization.h>
+#include <carma_wm/TrafficControl.h>
 
 
 namespace arbitrator_utils
@@ -85,4 +90,102 @@ namespace arbitrator_utils
     {
         return GET_MANEUVER_PROPERTY(mvr, start_dist);
     }
+
+    double get_planned_speed(const cav_msgs::ManeuverPlan &plan, ros::Time time)
+    {
+        if (plan.maneuvers.empty())
+        {
+            throw std::invalid_argument("arbitrator::get_planned_speed called on empty maneuver plan");
+        }
+
+        for (const auto& mvr : plan.maneuvers)
+        {
+            ros::Time start_time = get_maneuver_start_time(mvr);
+            ros::Time end_time = get_maneuver_end_time(mvr);
+            if (time < start_time)
+            {
+                return GET_MANEUVER_PROPERTY(mvr, start_speed);
+            }
+            if (time <= end_time)
+            {
+                double duration = (end_time - start_time).toSec();
+                double ratio = duration > 0.0 ? (time - start_time).toSec() / duration : 1.0;
+                double start_speed = GET_MANEUVER_PROPERTY(mvr, start_speed);
+                double end_speed = GET_MANEUVER_PROPERTY(mvr, end_speed);
+                return start_speed + ratio * (end_speed - start_speed);
+            }
+        }
+
+        return GET_MANEUVER_PROPERTY(plan.maneuvers.back(), end_speed);
+    }
+
+    namespace
+    {
+        template <class T>
+        void hash_combine(std::size_t& seed, const T& value)
+        {
+            seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+    }
+
+    std::size_t hash_plan(const cav_msgs::ManeuverPlan &plan)
+    {
+        std::size_t seed = plan.maneuvers.size();
+        for (const auto& mvr : plan.maneuvers)
+        {
+            hash_combine(seed, static_cast<int>(mvr.type));
+            hash_combine(seed, GET_MANEUVER_PROPERTY(mvr, parameters).planning_strategic_plugin);
+            hash_combine(seed, get_maneuver_start_time(mvr).toNSec());
+            hash_combine(seed, get_maneuver_end_time(mvr).toNSec());
+            hash_combine(seed, get_maneuver_start_distance(mvr));
+            hash_combine(seed, get_maneuver_end_distance(mvr));
+            hash_combine(seed, GET_MANEUVER_PROPERTY(mvr, start_speed));
+            hash_combine(seed, GET_MANEUVER_PROPERTY(mvr, end_speed));
+        }
+        return seed;
+    }
+
+    namespace
+    {
+        std::vector<uint8_t> serialize_maneuver(const cav_msgs::Maneuver& mvr)
+        {
+            std::vector<uint8_t> buffer(ros::serialization::serializationLength(mvr));
+            ros::serialization::OStream stream(buffer.data(), buffer.size());
+            ros::serialization::serialize(stream, mvr);
+            return buffer;
+        }
+    }
+
+    bool plans_equal(const cav_msgs::ManeuverPlan &a, const cav_msgs::ManeuverPlan &b)
+    {
+        if (a.maneuvers.size() != b.maneuvers.size())
+        {
+            return false;
+        }
+        // The messages have no operator==, so compare every field through their serialized form
+        for (size_t i = 0; i < a.maneuvers.size(); i++)
+        {
+            if (serialize_maneuver(a.maneuvers[i]) != serialize_maneuver(b.maneuvers[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool map_update_adds_regulations(const autoware_lanelet2_msgs::MapBin& msg)
+    {
+        // No map is needed to tell whether regulatory elements are added, compact updates decode with placeholders
+        auto update = std::make_shared<carma_wm::TrafficControl>();
+        try
+        {
+            carma_wm::fromBinMsg(msg, update);
+        }
+        catch (const std::exception& e)
+        {
+            ROS_WARN_STREAM("Arbitrator could not decode map update: " << e.what());
+            return false;
+        }
+        return !update->update_list_.empty();
+    }
 } // namespace arbitrator_utils
@@ -15,24 +15,28 @@
  */
 
 #include "beam_search_strategy.hpp"
+#include <algorithm>
 
 namespace arbitrator
 {
     std::vector<std::pair<cav_msgs::ManeuverPlan, double>> BeamSearchStrategy::prioritize_plans(std::vector<std::pair<cav_msgs::ManeuverPlan, double>> plans) const
     {
-        std::sort(plans.begin(), 
-            plans.end(), 
-            [] (const std::pair<cav_msgs::ManeuverPlan, double>& a, const std::pair<cav_msgs::ManeuverPlan, double>& b) 
-            {
-                return a.second < b.second;
-            }
-        );
+        auto by_cost = [] (const std::pair<cav_msgs::ManeuverPlan, double>& a, const std::pair<cav_msgs::ManeuverPlan, double>& b) 
+        {
+            return a.second < b.second;
+        };
 
-        if (plans.size() > beam_width_)
+        // Only the plans inside the beam need to be ordered, the rest are discarded
+        if (beam_width_ >= 0 && plans.size() > static_cast<size_t>(beam_width_))
         {
+            std::partial_sort(plans.begin(), plans.begin() + beam_width_, plans.end(), by_cost);
             plans.resize(beam_width_);
         }
+        else
+        {
+            std::sort(plans.begin(), plans.end(), by_cost);
+        }
         
         return plans;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "planning_scheduler.hpp"
+#include <algorithm>
+
+namespace arbitrator
+{
+    void PlanningScheduler::request_replan(PlanningTrigger trigger, ros::Time stamp)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // Keep the earliest stamp so jitter reflects the oldest outstanding request
+            if (pending_trigger_ == NONE || stamp < pending_stamp_)
+            {
+                pending_stamp_ = stamp;
+            }
+            // Event triggers take precedence over the periodic trigger when reporting the reason
+            if (pending_trigger_ == NONE || pending_trigger_ == PERIODIC)
+            {
+                pending_trigger_ = trigger;
+            }
+            if (planning_in_progress_ && allow_cancellation_ && trigger != PERIODIC && !last_cycle_cancelled_)
+            {
+                cancelled_.store(true);
+            }
+        }
+        cv_.notify_all();
+    }
+
+    void PlanningScheduler::notify()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            woken_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    PlanningTrigger PlanningScheduler::wait_for_trigger(std::chrono::milliseconds max_wait)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait_for(lock, max_wait, [this] { return pending_trigger_ != NONE || woken_; });
+        woken_ = false;
+        return pending_trigger_;
+    }
+
+    void PlanningScheduler::clear_trigger()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_trigger_ = NONE;
+    }
+
+    PlanningTrigger PlanningScheduler::begin_planning(ros::Time now)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        PlanningTrigger trigger = pending_trigger_;
+        if (trigger != NONE)
+        {
+            stats_.last_jitter = std::max(0.0, (now - pending_stamp_).toSec());
+            stats_.max_jitter = std::max(stats_.max_jitter, stats_.last_jitter);
+        }
+        else
+        {
+            stats_.last_jitter = 0.0;
+        }
+        pending_trigger_ = NONE;
+        planning_in_progress_ = true;
+        planning_start_ = now;
+        cancelled_.store(false);
+        return trigger;
+    }
+
+    bool PlanningScheduler::end_planning(ros::Time now)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        planning_in_progress_ = false;
+        bool cancelled = cancelled_.exchange(false);
+        last_cycle_cancelled_ = cancelled;
+
+        stats_.cycles++;
+        stats_.last_latency = (now - planning_start_).toSec();
+        stats_.max_latency = std::max(stats_.max_latency, stats_.last_latency);
+        if (stats_.last_latency > planning_period_.toSec())
+        {
+            stats_.deadline_misses++;
+        }
+        if (cancelled)
+        {
+            stats_.cancellations++;
+        }
+        return cancelled;
+    }
+
+    const std::atomic<bool>& PlanningScheduler::cancellation_flag() const
+    {
+        return cancelled_;
+    }
+
+    PlanningTimingStats PlanningScheduler::get_stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    ros::Duration PlanningScheduler::get_planning_period() const
+    {
+        return planning_period_;
+    }
+};
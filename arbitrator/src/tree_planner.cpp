@@ -19,10 +19,36 @@
 #include <vector>
 #include <map>
 #include <limits>
+#include <unordered_set>
 
 namespace arbitrator
 {
+    namespace
+    {
+        struct PlanHash
+        {
+            std::size_t operator()(const cav_msgs::ManeuverPlan& plan) const
+            {
+                return arbitrator_utils::hash_plan(plan);
+            }
+        };
+
+        struct PlanEqual
+        {
+            bool operator()(const cav_msgs::ManeuverPlan& a, const cav_msgs::ManeuverPlan& b) const
+            {
+                return arbitrator_utils::plans_equal(a, b);
+            }
+        };
+    }
+
     cav_msgs::ManeuverPlan TreePlanner::generate_plan() 
+    {
+        std::atomic<bool> never_cancelled(false);
+        return generate_plan(never_cancelled);
+    }
+
+    cav_msgs::ManeuverPlan TreePlanner::generate_plan(const std::atomic<bool>& cancelled)
     {
         cav_msgs::ManeuverPlan root;
         std::vector<std::pair<cav_msgs::ManeuverPlan, double>> open_list;
@@ -32,28 +58,52 @@ namespace arbitrator
         cav_msgs::ManeuverPlan longest_plan = root; // Track longest plan in case target length is never reached
         ros::Duration longest_plan_duration = ros::Duration(0);
 
+        // Anytime search, give up expanding once cancelled or out of budget and return the best plan so far
+        const bool has_budget = !planning_budget_.isZero();
+        const ros::WallTime deadline = ros::WallTime::now() + planning_budget_;
+        auto out_of_time = [&]() { return cancelled.load() || (has_budget && ros::WallTime::now() >= deadline); };
+
+        // Every plan generated so far, different parents may expand into the same plan
+        std::unordered_set<cav_msgs::ManeuverPlan, PlanHash, PlanEqual> visited;
+
+        // Evaluate terminal condition, returns true if the plan meets the target duration
+        auto is_complete = [&](const cav_msgs::ManeuverPlan& plan) {
+            ros::Duration plan_duration; // zero duration
+
+            // If we're not at the root, plan_duration is nonzero (our plan should have maneuvers)
+            if (!plan.maneuvers.empty()) 
+            {
+                // get plan duration
+                plan_duration = arbitrator_utils::get_plan_end_time(plan) - arbitrator_utils::get_plan_start_time(plan); 
+            }
+            if (plan_duration >= target_plan_duration_) 
+            {
+                return true;
+            } else if (plan_duration > longest_plan_duration) {
+                longest_plan_duration = plan_duration;
+                longest_plan = plan;
+            }
+            return false;
+        };
+
         while (!open_list.empty())
         {
             std::vector<std::pair<cav_msgs::ManeuverPlan, double>> new_open_list;
+            bool stopped = false;
             for (auto it = open_list.begin(); it != open_list.end(); it++)
             {
                 // Pop the first element off the open list
-                cav_msgs::ManeuverPlan cur_plan = it->first;
-                ros::Duration plan_duration; // zero duration
-
-                // If we're not at the root, plan_duration is nonzero (our plan should have maneuvers)
-                if (!cur_plan.maneuvers.empty()) 
+                const cav_msgs::ManeuverPlan& cur_plan = it->first;
+                if (is_complete(cur_plan))
                 {
-                    // get plan duration
-                    plan_duration = arbitrator_utils::get_plan_end_time(cur_plan) - arbitrator_utils::get_plan_start_time(cur_plan); 
+                    return cur_plan;
                 }
-                // Evaluate terminal condition
-                if (plan_duration >= target_plan_duration_) 
+
+                // Remaining open plans are still evaluated above since they cost nothing to check
+                if (stopped || out_of_time())
                 {
-                    return cur_plan;
-                } else if (plan_duration > longest_plan_duration) {
-                    longest_plan_duration = plan_duration;
-                    longest_plan = cur_plan;
+                    stopped = true;
+                    continue;
                 }
 
                 // Expand it, and reprioritize
@@ -62,12 +112,28 @@ namespace arbitrator
                 // Compute cost for each child and store in open list
                 for (auto child = children.begin(); child != children.end(); child++)
                 {
+                    if (!visited.insert(*child).second)
+                    {
+                        continue;
+                    }
                     new_open_list.push_back(std::make_pair(*child, cost_function_.compute_cost_per_unit_distance(*child)));
                 }
             }
+
+            if (stopped)
+            {
+                // Children generated before the deadline are complete plans and may be the best found so far
+                for (auto it = new_open_list.begin(); it != new_open_list.end(); it++)
+                {
+                    if (is_complete(it->first))
+                    {
+                        return it->first;
+                    }
+                }
+                break;
+            }
             
-            new_open_list = search_strategy_.prioritize_plans(new_open_list);
-            open_list = new_open_list;
+            open_list = search_strategy_.prioritize_plans(std::move(new_open_list));
         }
 
 
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <carma_wm/TrafficControl.h>
+#include <lanelet2_core/utility/Units.h>
+#include <lanelet2_core/utility/Utilities.h>
+#include "arbitrator_utils.hpp"
+
+namespace arbitrator
+{
+    TEST(ArbitratorUtilsTest, testMapUpdateAddsRegulations)
+    {
+        using namespace lanelet::units::literals;
+        lanelet::LineString3d left(lanelet::utils::getId(), { lanelet::Point3d(lanelet::utils::getId(), 0, 0, 0),
+                                                              lanelet::Point3d(lanelet::utils::getId(), 0, 1, 0) });
+        lanelet::LineString3d right(lanelet::utils::getId(), { lanelet::Point3d(lanelet::utils::getId(), 1, 0, 0),
+                                                               lanelet::Point3d(lanelet::utils::getId(), 1, 1, 0) });
+        lanelet::Lanelet llt(lanelet::utils::getId(), left, right);
+        lanelet::DigitalSpeedLimitPtr speed_limit = std::make_shared<lanelet::DigitalSpeedLimit>(
+            lanelet::DigitalSpeedLimit::buildData(lanelet::utils::getId(), 5_mph, {llt}, {}, { lanelet::Participants::VehicleCar }));
+
+        // Geofence activation
+        auto activation = std::make_shared<carma_wm::TrafficControl>();
+        activation->id_ = boost::uuids::random_generator()();
+        activation->update_list_.push_back(std::make_pair(llt.id(), speed_limit));
+        autoware_lanelet2_msgs::MapBin activation_msg;
+        carma_wm::toBinMsg(activation, &activation_msg);
+        ASSERT_TRUE(arbitrator_utils::map_update_adds_regulations(activation_msg));
+
+        autoware_lanelet2_msgs::MapBin compact_activation_msg;
+        carma_wm::toCompactBinMsg(activation, &compact_activation_msg);
+        ASSERT_TRUE(arbitrator_utils::map_update_adds_regulations(compact_activation_msg));
+
+        // Geofence deactivation only removes the regulation again
+        auto deactivation = std::make_shared<carma_wm::TrafficControl>();
+        deactivation->id_ = activation->id_;
+        deactivation->remove_list_.push_back(std::make_pair(llt.id(), speed_limit));
+        autoware_lanelet2_msgs::MapBin deactivation_msg;
+        carma_wm::toBinMsg(deactivation, &deactivation_msg);
+        ASSERT_FALSE(arbitrator_utils::map_update_adds_regulations(deactivation_msg));
+
+        // Malformed update
+        autoware_lanelet2_msgs::MapBin malformed_msg;
+        malformed_msg.data = {1, 2, 3};
+        ASSERT_FALSE(arbitrator_utils::map_update_adds_regulations(malformed_msg));
+    }
+}
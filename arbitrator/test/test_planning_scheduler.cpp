@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include "planning_scheduler.hpp"
+
+namespace arbitrator
+{
+    TEST(PlanningSchedulerTest, testWaitForTrigger)
+    {
+        PlanningScheduler scheduler{ros::Duration(1.0)};
+
+        // No trigger, wait times out
+        ASSERT_EQ(PlanningTrigger::NONE, scheduler.wait_for_trigger(std::chrono::milliseconds(10)));
+
+        // Notification wakes up without a trigger
+        scheduler.notify();
+        ASSERT_EQ(PlanningTrigger::NONE, scheduler.wait_for_trigger(std::chrono::milliseconds(1000)));
+
+        // Trigger from another thread wakes up the waiting thread
+        std::thread t([&scheduler] { scheduler.request_replan(PlanningTrigger::ROUTE_CHANGE, ros::Time(10.0)); });
+        ASSERT_EQ(PlanningTrigger::ROUTE_CHANGE, scheduler.wait_for_trigger(std::chrono::milliseconds(5000)));
+        t.join();
+
+        // Event triggers are reported in favor of the periodic trigger
+        scheduler.request_replan(PlanningTrigger::PERIODIC, ros::Time(10.0));
+        ASSERT_EQ(PlanningTrigger::ROUTE_CHANGE, scheduler.begin_planning(ros::Time(10.2)));
+        scheduler.end_planning(ros::Time(10.3));
+
+        scheduler.request_replan(PlanningTrigger::PERIODIC, ros::Time(11.0));
+        scheduler.clear_trigger();
+        ASSERT_EQ(PlanningTrigger::NONE, scheduler.wait_for_trigger(std::chrono::milliseconds(10)));
+    }
+
+    TEST(PlanningSchedulerTest, testTimingStats)
+    {
+        PlanningScheduler scheduler{ros::Duration(1.0)};
+
+        scheduler.request_replan(PlanningTrigger::PERIODIC, ros::Time(10.0));
+        ASSERT_EQ(PlanningTrigger::PERIODIC, scheduler.begin_planning(ros::Time(10.1)));
+        ASSERT_FALSE(scheduler.end_planning(ros::Time(10.6)));
+
+        PlanningTimingStats stats = scheduler.get_stats();
+        ASSERT_EQ(1, stats.cycles);
+        ASSERT_EQ(0, stats.deadline_misses);
+        ASSERT_NEAR(0.5, stats.last_latency, 0.0001);
+        ASSERT_NEAR(0.1, stats.last_jitter, 0.0001);
+
+        scheduler.request_replan(PlanningTrigger::PERIODIC, ros::Time(11.0));
+        scheduler.begin_planning(ros::Time(11.0));
+        scheduler.end_planning(ros::Time(12.5));
+
+        stats = scheduler.get_stats();
+        ASSERT_EQ(2, stats.cycles);
+        ASSERT_EQ(1, stats.deadline_misses);
+        ASSERT_NEAR(1.5, stats.max_latency, 0.0001);
+        ASSERT_NEAR(0.1, stats.max_jitter, 0.0001);
+    }
+
+    TEST(PlanningSchedulerTest, testCancellation)
+    {
+        PlanningScheduler scheduler{ros::Duration(1.0)};
+
+        // Periodic triggers never cancel a search in progress
+        scheduler.begin_planning(ros::Time(10.0));
+        scheduler.request_replan(PlanningTrigger::PERIODIC, ros::Time(10.1));
+        ASSERT_FALSE(scheduler.cancellation_flag().load());
+        ASSERT_FALSE(scheduler.end_planning(ros::Time(10.2)));
+
+        // Event triggers do
+        scheduler.begin_planning(ros::Time(11.0));
+        scheduler.request_replan(PlanningTrigger::GEOFENCE_ACTIVATION, ros::Time(11.1));
+        ASSERT_TRUE(scheduler.cancellation_flag().load());
+        ASSERT_TRUE(scheduler.end_planning(ros::Time(11.2)));
+
+        // But not twice in a row
+        ASSERT_EQ(PlanningTrigger::GEOFENCE_ACTIVATION, scheduler.begin_planning(ros::Time(11.2)));
+        ASSERT_FALSE(scheduler.cancellation_flag().load());
+        scheduler.request_replan(PlanningTrigger::PLAN_DEVIATION, ros::Time(11.3));
+        ASSERT_FALSE(scheduler.cancellation_flag().load());
+        ASSERT_FALSE(scheduler.end_planning(ros::Time(11.4)));
+        ASSERT_EQ(1, scheduler.get_stats().cancellations);
+
+        // Cancellation can be disabled entirely
+        PlanningScheduler no_cancel_scheduler{ros::Duration(1.0), false};
+        no_cancel_scheduler.begin_planning(ros::Time(10.0));
+        no_cancel_scheduler.request_replan(PlanningTrigger::ROUTE_CHANGE, ros::Time(10.1));
+        ASSERT_FALSE(no_cancel_scheduler.cancellation_flag().load());
+    }
+}
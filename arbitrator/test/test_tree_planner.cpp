@@ -16,7 +16,10 @@
 
 #include "test_utils.h"
 #include "tree_planner.hpp"
+#include "arbitrator_utils.hpp"
 #include <gmock/gmock.h>
+#include <thread>
+#include <chrono>
 
 using ::testing::A;
 using ::testing::_;
@@ -225,4 +228,162 @@ namespace arbitrator
         ASSERT_EQ(ros::Time(4), plan.maneuvers[2].lane_following_maneuver.start_time);
         ASSERT_EQ(ros::Time(5), plan.maneuvers[2].lane_following_maneuver.end_time);
     }
-}
\ No newline at end of file
+
+    TEST_F(TreePlannerTest, testGeneratePlanCancelled)
+    {
+        cav_msgs::ManeuverPlan plan1;
+        cav_msgs::Maneuver mvr1;
+
+        mvr1.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        mvr1.lane_following_maneuver.start_time = ros::Time(0);
+        mvr1.lane_following_maneuver.end_time = ros::Time(2);
+        plan1.maneuvers.push_back(mvr1);
+
+        std::atomic<bool> cancelled(false);
+        // Cancel the search while the root is being expanded, the children must not be expanded further
+        // but are still considered as the best plan so far
+        EXPECT_CALL(mng, generate_neighbors(_))
+            .Times(1)
+            .WillOnce(
+                DoAll(
+                    testing::InvokeWithoutArgs([&cancelled] { cancelled.store(true); }),
+                    Return(std::vector<cav_msgs::ManeuverPlan>{plan1})
+                )
+            );
+
+        EXPECT_CALL(mcf, compute_cost_per_unit_distance(_))
+            .WillRepeatedly(
+                Return(5.0)
+            );
+
+        EXPECT_CALL(mss, prioritize_plans(_))
+            .WillRepeatedly(
+                ReturnArg<0>()
+            );
+
+        cav_msgs::ManeuverPlan plan = tp.generate_plan(cancelled);
+        ASSERT_EQ(1, plan.maneuvers.size());
+        ASSERT_EQ(ros::Time(2), plan.maneuvers[0].lane_following_maneuver.end_time);
+    }
+
+    TEST_F(TreePlannerTest, testGeneratePlanBudget)
+    {
+        // Every expansion extends the plan by one second and takes 50ms, so the 5s target
+        // can not be reached within the 120ms budget
+        TreePlanner budgeted_tp{mcf, mng, mss, ros::Duration(5), ros::WallDuration(0.12)};
+
+        EXPECT_CALL(mng, generate_neighbors(_))
+            .WillRepeatedly(
+                testing::Invoke([](cav_msgs::ManeuverPlan plan) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                    cav_msgs::Maneuver mvr;
+                    mvr.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+                    mvr.lane_following_maneuver.start_time = ros::Time(plan.maneuvers.size());
+                    mvr.lane_following_maneuver.end_time = ros::Time(plan.maneuvers.size() + 1);
+                    plan.maneuvers.push_back(mvr);
+                    return std::vector<cav_msgs::ManeuverPlan>{plan};
+                })
+            );
+
+        EXPECT_CALL(mcf, compute_cost_per_unit_distance(_))
+            .WillRepeatedly(
+                Return(5.0)
+            );
+
+        EXPECT_CALL(mss, prioritize_plans(_))
+            .WillRepeatedly(
+                ReturnArg<0>()
+            );
+
+        ros::WallTime start = ros::WallTime::now();
+        cav_msgs::ManeuverPlan plan = budgeted_tp.generate_plan();
+        ASSERT_LT((ros::WallTime::now() - start).toSec(), 0.25);
+        ASSERT_FALSE(plan.maneuvers.empty());
+        ASSERT_LT(plan.maneuvers.size(), 5);
+    }
+
+    TEST_F(TreePlannerTest, testDuplicatePlansPruned)
+    {
+        cav_msgs::ManeuverPlan plan1, plan2;
+        cav_msgs::Maneuver mvr1;
+
+        mvr1.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        mvr1.lane_following_maneuver.start_time = ros::Time(0);
+        mvr1.lane_following_maneuver.end_time = ros::Time(2);
+        plan1.maneuvers.push_back(mvr1);
+        // Same maneuvers under a different ID are the same search node
+        plan2 = plan1;
+        plan2.maneuver_plan_id = "other";
+        ASSERT_EQ(arbitrator_utils::hash_plan(plan1), arbitrator_utils::hash_plan(plan2));
+
+        {
+            InSequence seq;
+            EXPECT_CALL(mng, generate_neighbors(_))
+                .WillOnce(
+                    Return(std::vector<cav_msgs::ManeuverPlan>{plan1, plan2})
+                );
+            EXPECT_CALL(mng, generate_neighbors(_))
+                .WillRepeatedly(
+                    Return(std::vector<cav_msgs::ManeuverPlan>())
+                );
+        }
+
+        // Only one of the two identical children is costed
+        EXPECT_CALL(mcf, compute_cost_per_unit_distance(_))
+            .Times(1)
+            .WillRepeatedly(
+                Return(5.0)
+            );
+
+        EXPECT_CALL(mss, prioritize_plans(_))
+            .WillRepeatedly(
+                ReturnArg<0>()
+            );
+
+        cav_msgs::ManeuverPlan plan = tp.generate_plan();
+        ASSERT_EQ(1, plan.maneuvers.size());
+    }
+
+    TEST_F(TreePlannerTest, testPlansWithSameHashKept)
+    {
+        cav_msgs::ManeuverPlan plan1, plan2;
+        cav_msgs::Maneuver mvr1;
+
+        mvr1.type = cav_msgs::Maneuver::LANE_CHANGE;
+        mvr1.lane_change_maneuver.start_time = ros::Time(0);
+        mvr1.lane_change_maneuver.end_time = ros::Time(2);
+        mvr1.lane_change_maneuver.ending_lane_id = "1";
+        plan1.maneuvers.push_back(mvr1);
+        // Lane ids are not hashed, the plans only differ in their target lane
+        plan2 = plan1;
+        plan2.maneuvers[0].lane_change_maneuver.ending_lane_id = "2";
+        ASSERT_EQ(arbitrator_utils::hash_plan(plan1), arbitrator_utils::hash_plan(plan2));
+        ASSERT_FALSE(arbitrator_utils::plans_equal(plan1, plan2));
+
+        {
+            InSequence seq;
+            EXPECT_CALL(mng, generate_neighbors(_))
+                .WillOnce(
+                    Return(std::vector<cav_msgs::ManeuverPlan>{plan1, plan2})
+                );
+            EXPECT_CALL(mng, generate_neighbors(_))
+                .WillRepeatedly(
+                    Return(std::vector<cav_msgs::ManeuverPlan>())
+                );
+        }
+
+        // Both children are costed
+        EXPECT_CALL(mcf, compute_cost_per_unit_distance(_))
+            .Times(2)
+            .WillRepeatedly(
+                Return(5.0)
+            );
+
+        EXPECT_CALL(mss, prioritize_plans(_))
+            .WillRepeatedly(
+                ReturnArg<0>()
+            );
+
+        tp.generate_plan();
+    }
+}
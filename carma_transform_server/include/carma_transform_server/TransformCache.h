@@ -0,0 +1,159 @@
+#pragma once
+
+/*
+ * Copyright (C) 2018-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <ros/ros.h>
+#include <tf2/buffer_core.h>
+#include <tf2_msgs/TFMessage.h>
+#include <geometry_msgs/TransformStamped.h>
+#include <carma_transform_server/GetTransforms.h>
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+/**
+ * \class TransformCache
+ * \brief Resolves transforms from a tf2 buffer, caching the results which can be reused.
+ *
+ * Transforms between frames connected only by static transforms are cached until the static transforms change.
+ * When a maximum interpolation gap is set, recent results for the frame pairs added with addInterpolationPair are kept
+ * so that requests between two results at most that gap apart are answered by interpolating them instead of searching
+ * the tf tree. The interpolated transform only matches the one of the buffer if the buffer holds no sample between
+ * the two results, so interpolation is disabled by default.
+ *
+ * Not thread safe, the TransformServer only uses it from the ros::spin thread.
+ */
+class TransformCache
+{
+  public:
+    // Recently resolved transforms of a frame pair ordered by stamp
+    using TransformHistory = std::deque<geometry_msgs::TransformStamped>;
+
+    /**
+     * \brief Lookup counters
+     */
+    struct LookupStats
+    {
+      uint64_t requests = 0;
+      uint64_t static_hits = 0;
+      uint64_t interpolation_hits = 0;
+      uint64_t failures = 0;
+      double total_latency = 0.0;  // Seconds
+      double max_latency = 0.0;    // Seconds
+    };
+
+    /**
+     * \brief Constructor
+     *
+     * \param[in] buffer The buffer holding the transform tree. Must outlive the cache
+     */
+    explicit TransformCache(const tf2::BufferCore& buffer);
+
+    /**
+     * \brief Keeps a history of the resolved transforms from child_frame to parent_frame for interpolation
+     */
+    void addInterpolationPair(const std::string& parent_frame, const std::string& child_frame);
+
+    /**
+     * \brief Sets the maximum number of transforms kept per frame pair
+     */
+    void setInterpolationCacheSize(size_t size);
+
+    /**
+     * \brief Sets the largest gap between two cached transforms which may be interpolated. Zero, the default,
+     *        disables interpolation.
+     */
+    void setMaxInterpolationGap(const ros::Duration& gap);
+
+    /**
+     * \brief Records the static frames of a /tf_static message and invalidates the static cache
+     */
+    void addStaticTransforms(const tf2_msgs::TFMessage& msg);
+
+    /**
+     * \brief Resolves the transform between two frames using the caches before falling back to the tf buffer
+     *
+     * \param[in] parent_frame - The frame to transform into
+     * \param[in] child_frame - The frame to transform from
+     * \param[in] stamp - The time of the transform. ros::Time(0) requests the latest transform
+     * \param[out] transform - The resolved transform
+     *
+     * \return One of the cav_srvs::GetTransform::Response error codes
+     */
+    uint8_t lookupTransform(const std::string& parent_frame, const std::string& child_frame, const ros::Time& stamp,
+                            geometry_msgs::TransformStamped& transform);
+
+    /**
+     * \brief Resolves each frame pair of a get_transforms request in the same way as lookupTransform
+     *
+     * \return False if the request arrays differ in length
+     */
+    bool lookupTransforms(const carma_transform_server::GetTransforms::Request& req,
+                          carma_transform_server::GetTransforms::Response& res);
+
+    /**
+     * \brief Returns true if the frames are connected only by static transforms
+     */
+    bool isStaticPair(const std::string& parent_frame, const std::string& child_frame) const;
+
+    /**
+     * \brief Finds the transform at stamp in the history either exactly or by interpolating the two closest samples
+     *
+     * \param[in] max_gap - The largest gap between the two samples which may be interpolated
+     *
+     * \return True if the history covered the stamp
+     */
+    static bool interpolate(const TransformHistory& history, const ros::Time& stamp, const ros::Duration& max_gap,
+                            geometry_msgs::TransformStamped& transform);
+
+    /**
+     * \brief Inserts a resolved transform into the history keeping it ordered by stamp and at most max_size long
+     */
+    static void addToHistory(TransformHistory& history, const geometry_msgs::TransformStamped& transform,
+                             size_t max_size);
+
+    const LookupStats& getStats() const;
+
+  private:
+    /**
+     * \brief Resolves a transform from the tf buffer, falling back to the latest transform if the stamp cannot be
+     *        extrapolated
+     */
+    uint8_t lookupBuffer(const std::string& parent_frame, const std::string& child_frame, const ros::Time& stamp,
+                         geometry_msgs::TransformStamped& transform) const;
+
+    /**
+     * \brief Builds the key used for a frame pair in the caches
+     */
+    static std::string pairKey(const std::string& parent_frame, const std::string& child_frame);
+
+    const tf2::BufferCore& buffer_;
+
+    // Parent of each frame published on /tf_static
+    std::unordered_map<std::string, std::string> static_parents_;
+    // Resolved transforms between frames connected only by static transforms. Keyed by pairKey
+    std::unordered_map<std::string, geometry_msgs::TransformStamped> static_cache_;
+
+    // Frame pairs which keep a history for interpolation. Keyed by pairKey
+    std::unordered_map<std::string, TransformHistory> interpolation_cache_;
+    // Maximum number of transforms kept per frame pair
+    size_t interpolation_cache_size_ = 100;
+    // Largest gap between two cached transforms which may be interpolated, zero disables interpolation
+    ros::Duration max_interpolation_gap_ = ros::Duration(0);
+
+    LookupStats stats_;
+};
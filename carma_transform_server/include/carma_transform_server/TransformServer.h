@@ -18,14 +18,19 @@
 
 #include <ros/ros.h>
 #include <tf2_ros/transform_listener.h>
+#include <tf2_msgs/TFMessage.h>
 #include <cav_srvs/GetTransform.h>
+#include <carma_transform_server/GetTransforms.h>
+#include <carma_transform_server/TransformCache.h>
 
 /**
  * \class TransformServer
  * \brief ROS Node which maintains a tf2 transform tree which can be accessed by other nodes.
  *
  * The get_transform service can be used to obtain coordinate transformations between two frames.
+ * The get_transforms service resolves many frame pairs in a single call.
  * Only transforms published on the /tf or /tf_static topics are recorded by this node.
+ * Lookups go through a TransformCache, see there for the cached transforms.
  */
 class TransformServer
 {
@@ -37,9 +42,18 @@ class TransformServer
     tf2_ros::Buffer tfBuffer_;
     // tf2 listeners. Subscribes to the /tf and /tf_static topics
     tf2_ros::TransformListener tfListener_;
+    // Caches the lookups into tfBuffer_
+    TransformCache cache_;
 
     // get_transform service server
     ros::ServiceServer get_transform_service_;
+    // get_transforms service server
+    ros::ServiceServer get_transforms_service_;
+
+    // Subscriber to /tf_static used to track which frames are static
+    ros::Subscriber tf_static_sub_;
+    // Timer which logs the lookup statistics
+    ros::Timer stats_timer_;
 
   public:
     /**
@@ -68,4 +82,26 @@ class TransformServer
       * \return True when the callback completes
       */
     bool get_transform_cb(cav_srvs::GetTransform::Request  &req, cav_srvs::GetTransform::Response &res);
-};
\ No newline at end of file
+
+    /**
+      * \brief Callback function to the get_transforms ros service.
+      * \details Resolves each requested frame pair in the same way as get_transform_cb
+      *
+      * \param[in] req - The service request
+      * \param[out] res - The service response
+      *
+      * \return False if the request arrays differ in length
+      */
+    bool get_transforms_cb(carma_transform_server::GetTransforms::Request &req,
+                           carma_transform_server::GetTransforms::Response &res);
+
+    /**
+      * \brief Callback for /tf_static which records the static frames and invalidates the static cache
+      */
+    void tfStaticCallback(const tf2_msgs::TFMessageConstPtr& msg);
+
+    /**
+      * \brief Logs the lookup latency and cache hit rates
+      */
+    void logStats(const ros::TimerEvent& event);
+};
@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2018-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <carma_transform_server/TransformCache.h>
+#include <cav_srvs/GetTransform.h>
+#include <tf2/exceptions.h>
+#include <tf2_geometry_msgs/tf2_geometry_msgs.h>
+#include <tf2/LinearMath/Quaternion.h>
+#include <algorithm>
+#include <iterator>
+#include <unordered_set>
+
+TransformCache::TransformCache(const tf2::BufferCore& buffer) : buffer_(buffer) {
+
+}
+
+std::string TransformCache::pairKey(const std::string& parent_frame, const std::string& child_frame) {
+  return parent_frame + " " + child_frame;
+}
+
+void TransformCache::addInterpolationPair(const std::string& parent_frame, const std::string& child_frame) {
+  interpolation_cache_[pairKey(parent_frame, child_frame)];
+}
+
+void TransformCache::setInterpolationCacheSize(size_t size) {
+  interpolation_cache_size_ = std::max<size_t>(size, 1);
+}
+
+void TransformCache::setMaxInterpolationGap(const ros::Duration& gap) {
+  max_interpolation_gap_ = gap;
+}
+
+const TransformCache::LookupStats& TransformCache::getStats() const {
+  return stats_;
+}
+
+bool TransformCache::lookupTransforms(const carma_transform_server::GetTransforms::Request& req,
+                                      carma_transform_server::GetTransforms::Response& res) {
+  if (req.parent_frames.size() != req.child_frames.size() || req.parent_frames.size() != req.stamps.size()) {
+    ROS_WARN("| Transform Server | TRANSFORM | get_transforms request arrays must have the same length");
+    return false;
+  }
+
+  res.transforms.resize(req.parent_frames.size());
+  res.error_status.resize(req.parent_frames.size());
+  for (size_t i = 0; i < req.parent_frames.size(); i++) {
+    res.error_status[i] = lookupTransform(req.parent_frames[i], req.child_frames[i], req.stamps[i], res.transforms[i]);
+  }
+  return true;
+}
+
+uint8_t TransformCache::lookupTransform(const std::string& parent_frame, const std::string& child_frame,
+                                        const ros::Time& stamp, geometry_msgs::TransformStamped& transform) {
+  ros::WallTime start = ros::WallTime::now();
+  stats_.requests++;
+
+  uint8_t status = cav_srvs::GetTransform::Response::NO_ERROR;
+  std::string key = pairKey(parent_frame, child_frame);
+
+  const bool interpolation_enabled = max_interpolation_gap_ > ros::Duration(0) && !stamp.isZero();
+  auto static_it = static_cache_.find(key);
+  auto history_it = interpolation_enabled ? interpolation_cache_.find(key) : interpolation_cache_.end();
+  if (static_it != static_cache_.end()) {
+    transform = static_it->second;
+    transform.header.stamp = stamp;
+    stats_.static_hits++;
+  } else if (history_it != interpolation_cache_.end() &&
+             interpolate(history_it->second, stamp, max_interpolation_gap_, transform)) {
+    stats_.interpolation_hits++;
+  } else {
+    status = lookupBuffer(parent_frame, child_frame, stamp, transform);
+
+    if (status == cav_srvs::GetTransform::Response::NO_ERROR) {
+      if (isStaticPair(parent_frame, child_frame)) {
+        // Static transforms never change until a new /tf_static message arrives
+        static_cache_[key] = transform;
+      } else if (history_it != interpolation_cache_.end()) {
+        addToHistory(history_it->second, transform, interpolation_cache_size_);
+      }
+    } else if (status == cav_srvs::GetTransform::Response::NO_TRANSFORM_EXISTS) {
+      stats_.failures++;
+    }
+  }
+
+  double latency = (ros::WallTime::now() - start).toSec();
+  stats_.total_latency += latency;
+  stats_.max_latency = std::max(stats_.max_latency, latency);
+  return status;
+}
+
+uint8_t TransformCache::lookupBuffer(const std::string& parent_frame, const std::string& child_frame,
+                                     const ros::Time& stamp, geometry_msgs::TransformStamped& transform) const {
+  try{
+    transform = buffer_.lookupTransform(parent_frame, child_frame, stamp);
+    return cav_srvs::GetTransform::Response::NO_ERROR;
+  } catch (tf2::ExtrapolationException& ex) {
+    ROS_WARN("| Transform Server | TRANSFORM | transform_server could not extrapolate requested transform. Using latest transform available%s", ex.what());
+
+    try {
+      transform = buffer_.lookupTransform(parent_frame, child_frame, ros::Time(0));
+      return cav_srvs::GetTransform::Response::COULD_NOT_EXTRAPOLATE;
+    } catch (tf2::TransformException &ex) {
+      ROS_WARN("| Transform Server | TRANSFORM | Invalid transform request made to transform_server: %s", ex.what());
+      return cav_srvs::GetTransform::Response::NO_TRANSFORM_EXISTS;
+    }
+
+  } catch (tf2::TransformException &ex) {
+    ROS_WARN("| Transform Server | TRANSFORM | Invalid transform request made to transform_server: %s", ex.what());
+    return cav_srvs::GetTransform::Response::NO_TRANSFORM_EXISTS;
+  }
+}
+
+bool TransformCache::isStaticPair(const std::string& parent_frame, const std::string& child_frame) const {
+  // Collect the frames reachable from the parent through static transforms
+  std::unordered_set<std::string> parent_ancestors;
+  std::string frame = parent_frame;
+  parent_ancestors.insert(frame);
+  for (auto it = static_parents_.find(frame); it != static_parents_.end(); it = static_parents_.find(frame)) {
+    frame = it->second;
+    if (!parent_ancestors.insert(frame).second) {
+      break; // Guard against cycles
+    }
+  }
+
+  // The pair is static if the child reaches one of those frames through static transforms
+  frame = child_frame;
+  for (size_t depth = 0; depth <= static_parents_.size(); depth++) {
+    if (parent_ancestors.count(frame)) {
+      return true;
+    }
+    auto it = static_parents_.find(frame);
+    if (it == static_parents_.end()) {
+      return false;
+    }
+    frame = it->second;
+  }
+  return false;
+}
+
+bool TransformCache::interpolate(const TransformHistory& history, const ros::Time& stamp, const ros::Duration& max_gap,
+                                 geometry_msgs::TransformStamped& transform) {
+  auto after = std::lower_bound(history.begin(), history.end(), stamp,
+    [](const geometry_msgs::TransformStamped& t, const ros::Time& time) { return t.header.stamp < time; });
+
+  if (after == history.end()) {
+    return false;
+  }
+  if (after->header.stamp == stamp) {
+    transform = *after;
+    return true;
+  }
+  if (after == history.begin()) {
+    return false;
+  }
+
+  auto before = std::prev(after);
+  ros::Duration gap = after->header.stamp - before->header.stamp;
+  if (gap > max_gap) {
+    return false;
+  }
+
+  double ratio = (stamp - before->header.stamp).toSec() / gap.toSec();
+
+  tf2::Vector3 t0, t1;
+  tf2::fromMsg(before->transform.translation, t0);
+  tf2::fromMsg(after->transform.translation, t1);
+  tf2::Quaternion q0, q1;
+  tf2::fromMsg(before->transform.rotation, q0);
+  tf2::fromMsg(after->transform.rotation, q1);
+
+  transform.header = before->header;
+  transform.header.stamp = stamp;
+  transform.child_frame_id = before->child_frame_id;
+  transform.transform.translation = tf2::toMsg(t0.lerp(t1, ratio));
+  transform.transform.rotation = tf2::toMsg(q0.slerp(q1, ratio));
+  return true;
+}
+
+void TransformCache::addToHistory(TransformHistory& history, const geometry_msgs::TransformStamped& transform,
+                                  size_t max_size) {
+  auto pos = std::upper_bound(history.begin(), history.end(), transform.header.stamp,
+    [](const ros::Time& time, const geometry_msgs::TransformStamped& t) { return time < t.header.stamp; });
+
+  if (pos != history.begin() && std::prev(pos)->header.stamp == transform.header.stamp) {
+    return; // Already cached
+  }
+  history.insert(pos, transform);
+
+  while (history.size() > max_size) {
+    history.pop_front();
+  }
+}
+
+void TransformCache::addStaticTransforms(const tf2_msgs::TFMessage& msg) {
+  for (const auto& transform : msg.transforms) {
+    static_parents_[transform.child_frame_id] = transform.header.frame_id;
+  }
+  static_cache_.clear();
+}
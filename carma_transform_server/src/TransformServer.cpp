@@ -15,41 +15,75 @@
  */
 
 #include <carma_transform_server/TransformServer.h>
-#include <tf2_ros/transform_listener.h>
-#include <tf2_geometry_msgs/tf2_geometry_msgs.h>
-#include <tf2/LinearMath/Quaternion.h>
-#include <tf2/LinearMath/Matrix3x3.h>
+#include <algorithm>
+#include <sstream>
 
-TransformServer::TransformServer(int argc, char **argv) : tfListener_(tfBuffer_){
+TransformServer::TransformServer(int argc, char **argv) : tfListener_(tfBuffer_), cache_(tfBuffer_){
 
 }
 
 bool TransformServer::get_transform_cb(cav_srvs::GetTransform::Request  &req, cav_srvs::GetTransform::Response &res) {
-  try{
-    res.transform = tfBuffer_.lookupTransform(req.parent_frame, req.child_frame, req.stamp);
-    res.error_status = res.NO_ERROR;
-  } catch (tf2::ExtrapolationException& ex) {
-    ROS_WARN("| Transform Server | TRANSFORM | transform_server could not extrapolate requested transform. Using latest transform available%s", ex.what());
-
-    try {
-      res.transform = tfBuffer_.lookupTransform(req.parent_frame, req.child_frame, ros::Time(0));
-      res.error_status = res.COULD_NOT_EXTRAPOLATE;
-    } catch (tf2::TransformException &ex) {
-      res.error_status = res.NO_TRANSFORM_EXISTS;
-      ROS_WARN("| Transform Server | TRANSFORM | Invalid transform request made to transform_server: %s", ex.what());
-    }
+  res.error_status = cache_.lookupTransform(req.parent_frame, req.child_frame, req.stamp, res.transform);
+  return true;
+}
 
-  } catch (tf2::TransformException &ex) {
-    res.error_status = res.NO_TRANSFORM_EXISTS;
-    ROS_WARN("| Transform Server | TRANSFORM | Invalid transform request made to transform_server: %s", ex.what());
-  }
+bool TransformServer::get_transforms_cb(carma_transform_server::GetTransforms::Request &req,
+                                        carma_transform_server::GetTransforms::Response &res) {
+  return cache_.lookupTransforms(req, res);
+}
 
-return true;
+void TransformServer::tfStaticCallback(const tf2_msgs::TFMessageConstPtr& msg) {
+  cache_.addStaticTransforms(*msg);
+}
+
+void TransformServer::logStats(const ros::TimerEvent& event) {
+  const TransformCache::LookupStats& stats = cache_.getStats();
+  if (stats.requests == 0) {
+    return;
+  }
+  double requests = static_cast<double>(stats.requests);
+  ROS_INFO("| Transform Server | STATS | requests: %lu static hit rate: %.3f interpolation hit rate: %.3f failures: %lu "
+           "mean latency: %.1f us max latency: %.1f us",
+           stats.requests, stats.static_hits / requests, stats.interpolation_hits / requests, stats.failures,
+           stats.total_latency / requests * 1e6, stats.max_latency * 1e6);
 }
 
 int TransformServer::run() {
+  ros::NodeHandle pnh("~");
+
+  // Frame pairs given as "parent child" which keep a history of resolved transforms
+  std::vector<std::string> interpolation_pairs = { "map base_link", "earth map" };
+  pnh.param("interpolation_cache_pairs", interpolation_pairs, interpolation_pairs);
+  for (const auto& pair : interpolation_pairs) {
+    std::istringstream stream(pair);
+    std::string parent_frame, child_frame;
+    if (!(stream >> parent_frame >> child_frame)) {
+      ROS_WARN("| Transform Server | TRANSFORM | Ignoring invalid interpolation cache pair: %s", pair.c_str());
+      continue;
+    }
+    cache_.addInterpolationPair(parent_frame, child_frame);
+  }
+
+  int cache_size = 100;
+  pnh.param("interpolation_cache_size", cache_size, cache_size);
+  cache_.setInterpolationCacheSize(static_cast<size_t>(std::max(cache_size, 1)));
+
+  // Interpolated transforms may differ from those of the tf buffer so interpolation is disabled unless set
+  double max_gap = 0.0;
+  pnh.param("max_interpolation_gap", max_gap, max_gap);
+  cache_.setMaxInterpolationGap(ros::Duration(std::max(max_gap, 0.0)));
+
+  double stats_period = 30.0;
+  pnh.param("stats_log_period", stats_period, stats_period);
+
+  tf_static_sub_ = node_.subscribe("/tf_static", 100, &TransformServer::tfStaticCallback, this);
+  if (stats_period > 0) {
+    stats_timer_ = node_.createTimer(ros::Duration(stats_period), &TransformServer::logStats, this);
+  }
+
   // Setup get_transform service server
   get_transform_service_ = node_.advertiseService("get_transform", &TransformServer::get_transform_cb, this);
+  get_transforms_service_ = node_.advertiseService("get_transforms", &TransformServer::get_transforms_cb, this);
 
   // Spin
   ros::spin();
@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2018-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <carma_transform_server/TransformCache.h>
+#include <cav_srvs/GetTransform.h>
+#include <tf2/LinearMath/Matrix3x3.h>
+#include <tf2/LinearMath/Quaternion.h>
+#include <tf2_geometry_msgs/tf2_geometry_msgs.h>
+#include <cmath>
+
+namespace
+{
+geometry_msgs::TransformStamped makeTransform(const std::string& parent, const std::string& child, double stamp,
+                                              double x, double yaw = 0.0)
+{
+  geometry_msgs::TransformStamped t;
+  t.header.frame_id = parent;
+  t.header.stamp = ros::Time(stamp);
+  t.child_frame_id = child;
+  t.transform.translation.x = x;
+  tf2::Quaternion q;
+  q.setRPY(0, 0, yaw);
+  t.transform.rotation = tf2::toMsg(q);
+  return t;
+}
+
+double getYaw(const geometry_msgs::TransformStamped& t)
+{
+  tf2::Quaternion q;
+  tf2::fromMsg(t.transform.rotation, q);
+  double roll, pitch, yaw;
+  tf2::Matrix3x3(q).getRPY(roll, pitch, yaw);
+  return yaw;
+}
+
+// Fills the buffer with map->base_link every 0.1 s from 10 s to 11 s. The vehicle accelerates (x = t^2) and turns at a
+// constant rate so interpolating over several buffer samples differs from the buffer itself.
+void fillBuffer(tf2::BufferCore& buffer)
+{
+  for (int i = 0; i <= 10; i++)
+  {
+    double t = 10.0 + 0.1 * i;
+    buffer.setTransform(makeTransform("map", "base_link", t, t * t, 0.1 * i), "test");
+  }
+  buffer.setTransform(makeTransform("base_link", "lidar", 0.0, 1.5), "test", true);
+}
+
+void expectSameTransform(const geometry_msgs::TransformStamped& expected,
+                         const geometry_msgs::TransformStamped& actual, double tolerance = 1e-9)
+{
+  EXPECT_EQ(expected.header.stamp, actual.header.stamp);
+  EXPECT_NEAR(expected.transform.translation.x, actual.transform.translation.x, tolerance);
+  EXPECT_NEAR(expected.transform.translation.y, actual.transform.translation.y, tolerance);
+  EXPECT_NEAR(getYaw(expected), getYaw(actual), tolerance);
+}
+}  // namespace
+
+TEST(TransformCacheTest, addToHistory)
+{
+  TransformCache::TransformHistory history;
+
+  TransformCache::addToHistory(history, makeTransform("map", "base_link", 2.0, 2.0), 3);
+  TransformCache::addToHistory(history, makeTransform("map", "base_link", 1.0, 1.0), 3);
+  TransformCache::addToHistory(history, makeTransform("map", "base_link", 3.0, 3.0), 3);
+  // Duplicate stamps are ignored
+  TransformCache::addToHistory(history, makeTransform("map", "base_link", 2.0, 20.0), 3);
+
+  ASSERT_EQ(3u, history.size());
+  EXPECT_EQ(ros::Time(1.0), history[0].header.stamp);
+  EXPECT_EQ(ros::Time(2.0), history[1].header.stamp);
+  EXPECT_NEAR(2.0, history[1].transform.translation.x, 1e-9);
+  EXPECT_EQ(ros::Time(3.0), history[2].header.stamp);
+
+  // The oldest transform is dropped once the history is full
+  TransformCache::addToHistory(history, makeTransform("map", "base_link", 4.0, 4.0), 3);
+  ASSERT_EQ(3u, history.size());
+  EXPECT_EQ(ros::Time(2.0), history.front().header.stamp);
+  EXPECT_EQ(ros::Time(4.0), history.back().header.stamp);
+}
+
+TEST(TransformCacheTest, interpolate)
+{
+  TransformCache::TransformHistory history;
+  TransformCache::addToHistory(history, makeTransform("map", "base_link", 1.0, 0.0, 0.0), 10);
+  TransformCache::addToHistory(history, makeTransform("map", "base_link", 1.1, 1.0, 0.2), 10);
+  TransformCache::addToHistory(history, makeTransform("map", "base_link", 2.0, 5.0, 0.2), 10);
+
+  geometry_msgs::TransformStamped out;
+  ros::Duration max_gap(0.5);
+
+  // Exact stamp
+  ASSERT_TRUE(TransformCache::interpolate(history, ros::Time(1.1), max_gap, out));
+  EXPECT_NEAR(1.0, out.transform.translation.x, 1e-9);
+
+  // Between two samples
+  ASSERT_TRUE(TransformCache::interpolate(history, ros::Time(1.025), max_gap, out));
+  EXPECT_EQ(ros::Time(1.025), out.header.stamp);
+  EXPECT_EQ("map", out.header.frame_id);
+  EXPECT_EQ("base_link", out.child_frame_id);
+  EXPECT_NEAR(0.25, out.transform.translation.x, 1e-6);
+  EXPECT_NEAR(0.05, getYaw(out), 1e-6);
+
+  // Samples further apart than the gap
+  EXPECT_FALSE(TransformCache::interpolate(history, ros::Time(1.5), max_gap, out));
+  ASSERT_TRUE(TransformCache::interpolate(history, ros::Time(1.5), ros::Duration(1.0), out));
+  EXPECT_NEAR(1.0 + 4.0 * 0.4 / 0.9, out.transform.translation.x, 1e-6);
+
+  // Outside of the history
+  EXPECT_FALSE(TransformCache::interpolate(history, ros::Time(0.9), max_gap, out));
+  EXPECT_FALSE(TransformCache::interpolate(history, ros::Time(2.1), max_gap, out));
+  EXPECT_FALSE(TransformCache::interpolate(TransformCache::TransformHistory(), ros::Time(1.0), max_gap, out));
+}
+
+TEST(TransformCacheTest, isStaticPair)
+{
+  tf2::BufferCore buffer;
+  TransformCache cache(buffer);
+
+  tf2_msgs::TFMessage msg;
+  msg.transforms.push_back(makeTransform("base_link", "lidar", 0.0, 1.5));
+  msg.transforms.push_back(makeTransform("base_link", "camera", 0.0, 2.0));
+  msg.transforms.push_back(makeTransform("earth", "map", 0.0, 100.0));
+  cache.addStaticTransforms(msg);
+
+  EXPECT_TRUE(cache.isStaticPair("base_link", "lidar"));
+  EXPECT_TRUE(cache.isStaticPair("lidar", "base_link"));
+  EXPECT_TRUE(cache.isStaticPair("lidar", "camera"));
+  EXPECT_TRUE(cache.isStaticPair("earth", "map"));
+  EXPECT_TRUE(cache.isStaticPair("lidar", "lidar"));
+
+  // map->base_link is not static
+  EXPECT_FALSE(cache.isStaticPair("map", "base_link"));
+  EXPECT_FALSE(cache.isStaticPair("map", "lidar"));
+  EXPECT_FALSE(cache.isStaticPair("earth", "lidar"));
+}
+
+TEST(TransformCacheTest, staticTransformsAreCached)
+{
+  tf2::BufferCore buffer;
+  fillBuffer(buffer);
+  TransformCache cache(buffer);
+
+  tf2_msgs::TFMessage msg;
+  msg.transforms.push_back(makeTransform("base_link", "lidar", 0.0, 1.5));
+  cache.addStaticTransforms(msg);
+
+  geometry_msgs::TransformStamped out;
+  ASSERT_EQ(cav_srvs::GetTransform::Response::NO_ERROR, cache.lookupTransform("base_link", "lidar", ros::Time(10.0), out));
+  ASSERT_EQ(cav_srvs::GetTransform::Response::NO_ERROR, cache.lookupTransform("base_link", "lidar", ros::Time(10.5), out));
+  EXPECT_EQ(ros::Time(10.5), out.header.stamp);
+  EXPECT_NEAR(1.5, out.transform.translation.x, 1e-9);
+  EXPECT_EQ(2u, cache.getStats().requests);
+  EXPECT_EQ(1u, cache.getStats().static_hits);
+}
+
+TEST(TransformCacheTest, lookupErrors)
+{
+  tf2::BufferCore buffer;
+  fillBuffer(buffer);
+  TransformCache cache(buffer);
+
+  geometry_msgs::TransformStamped out;
+  EXPECT_EQ(cav_srvs::GetTransform::Response::COULD_NOT_EXTRAPOLATE,
+            cache.lookupTransform("map", "base_link", ros::Time(20.0), out));
+  EXPECT_NEAR(11.0 * 11.0, out.transform.translation.x, 1e-6);
+
+  EXPECT_EQ(cav_srvs::GetTransform::Response::NO_TRANSFORM_EXISTS,
+            cache.lookupTransform("map", "unknown", ros::Time(10.0), out));
+  EXPECT_EQ(1u, cache.getStats().failures);
+}
+
+TEST(TransformCacheTest, lookupTransforms)
+{
+  tf2::BufferCore buffer;
+  fillBuffer(buffer);
+  TransformCache cache(buffer);
+
+  carma_transform_server::GetTransforms::Request req;
+  carma_transform_server::GetTransforms::Response res;
+  req.parent_frames = { "map", "map", "map" };
+  req.child_frames = { "base_link", "lidar" };
+  req.stamps = { ros::Time(10.0), ros::Time(10.5), ros::Time(10.0) };
+  EXPECT_FALSE(cache.lookupTransforms(req, res));
+
+  req.child_frames.push_back("unknown");
+  ASSERT_TRUE(cache.lookupTransforms(req, res));
+  ASSERT_EQ(3u, res.transforms.size());
+  ASSERT_EQ(3u, res.error_status.size());
+
+  EXPECT_EQ(carma_transform_server::GetTransforms::Response::NO_ERROR, res.error_status[0]);
+  expectSameTransform(buffer.lookupTransform("map", "base_link", ros::Time(10.0)), res.transforms[0]);
+  EXPECT_EQ(carma_transform_server::GetTransforms::Response::NO_ERROR, res.error_status[1]);
+  expectSameTransform(buffer.lookupTransform("map", "lidar", ros::Time(10.5)), res.transforms[1]);
+  EXPECT_EQ(carma_transform_server::GetTransforms::Response::NO_TRANSFORM_EXISTS, res.error_status[2]);
+}
+
+TEST(TransformCacheTest, matchesBufferByDefault)
+{
+  tf2::BufferCore buffer;
+  fillBuffer(buffer);
+  TransformCache cache(buffer);
+  cache.addInterpolationPair("map", "base_link");
+
+  // Interpolation is disabled unless a gap is set so every lookup is resolved by the buffer
+  geometry_msgs::TransformStamped out;
+  for (int i = 0; i <= 40; i++)
+  {
+    double t = 10.0 + 0.025 * i;
+    ASSERT_EQ(cav_srvs::GetTransform::Response::NO_ERROR, cache.lookupTransform("map", "base_link", ros::Time(t), out));
+    expectSameTransform(buffer.lookupTransform("map", "base_link", ros::Time(t)), out);
+  }
+  EXPECT_EQ(0u, cache.getStats().interpolation_hits);
+}
+
+TEST(TransformCacheTest, interpolationComparedToBuffer)
+{
+  tf2::BufferCore buffer;
+  fillBuffer(buffer);
+  TransformCache cache(buffer);
+  cache.addInterpolationPair("map", "base_link");
+  cache.setMaxInterpolationGap(ros::Duration(0.5));
+
+  geometry_msgs::TransformStamped out;
+
+  // Cached transforms at two neighbouring buffer samples interpolate exactly as the buffer does
+  ASSERT_EQ(cav_srvs::GetTransform::Response::NO_ERROR, cache.lookupTransform("map", "base_link", ros::Time(10.2), out));
+  ASSERT_EQ(cav_srvs::GetTransform::Response::NO_ERROR, cache.lookupTransform("map", "base_link", ros::Time(10.3), out));
+  EXPECT_EQ(0u, cache.getStats().interpolation_hits);
+
+  for (double t : { 10.22, 10.25, 10.29 })
+  {
+    ASSERT_EQ(cav_srvs::GetTransform::Response::NO_ERROR, cache.lookupTransform("map", "base_link", ros::Time(t), out));
+    expectSameTransform(buffer.lookupTransform("map", "base_link", ros::Time(t)), out, 1e-6);
+  }
+  EXPECT_EQ(3u, cache.getStats().interpolation_hits);
+
+  // Cached transforms further apart skip the buffer samples between them, so accelerating motion is not reproduced
+  TransformCache sparse_cache(buffer);
+  sparse_cache.addInterpolationPair("map", "base_link");
+  sparse_cache.setMaxInterpolationGap(ros::Duration(0.6));
+  ASSERT_EQ(cav_srvs::GetTransform::Response::NO_ERROR, sparse_cache.lookupTransform("map", "base_link", ros::Time(10.4), out));
+  ASSERT_EQ(cav_srvs::GetTransform::Response::NO_ERROR, sparse_cache.lookupTransform("map", "base_link", ros::Time(10.9), out));
+  EXPECT_EQ(0u, sparse_cache.getStats().interpolation_hits);
+
+  ASSERT_EQ(cav_srvs::GetTransform::Response::NO_ERROR, sparse_cache.lookupTransform("map", "base_link", ros::Time(10.65), out));
+  EXPECT_EQ(1u, sparse_cache.getStats().interpolation_hits);
+  geometry_msgs::TransformStamped expected = buffer.lookupTransform("map", "base_link", ros::Time(10.65));
+  // (10.4^2 + 10.9^2) / 2 against 10.65^2 + 0.05^2 from the buffer
+  EXPECT_NEAR((10.4 * 10.4 + 10.9 * 10.9) / 2.0, out.transform.translation.x, 1e-6);
+  EXPECT_NEAR(10.65 * 10.65 + 0.0025, expected.transform.translation.x, 1e-6);
+  EXPECT_GT(std::abs(expected.transform.translation.x - out.transform.translation.x), 0.01);
+  // The turn rate is constant so the rotation still matches
+  EXPECT_NEAR(getYaw(expected), getYaw(out), 1e-6);
+}
+
+// Run all the tests
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
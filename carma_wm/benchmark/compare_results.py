@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+
+#  Copyright (C) 2020 LEIDOS.
+#
+#  Licensed under the Apache License, Version 2.0 (the "License"); you may not
+#  use this file except in compliance with the License. You may obtain a copy of
+#  the License at
+#
+#  http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+#  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+#  License for the specific language governing permissions and limitations under
+#  the License.
+
+# Compares two Google Benchmark JSON result files, such as those written by the run_carma_wm_benchmarks target on two
+# commits, and prints the relative change of each benchmark.
+#
+# Usage: compare_results.py baseline.json contender.json [--threshold PERCENT]
+#
+# When a threshold is given the script exits with status 1 if any benchmark slowed down by more than that percentage.
+
+import argparse
+import json
+import sys
+
+
+def load_times(path):
+    """Returns a dict of benchmark name to cpu time in ns, preferring the median of repeated runs"""
+    with open(path) as f:
+        results = json.load(f)
+
+    scale = {'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+    times = {}
+    medians = {}
+    for bench in results['benchmarks']:
+        time = bench['cpu_time'] * scale[bench.get('time_unit', 'ns')]
+        if bench.get('run_type') == 'aggregate':
+            if bench.get('aggregate_name') == 'median':
+                medians[bench['run_name']] = time
+        else:
+            times.setdefault(bench.get('run_name', bench['name']), time)
+    times.update(medians)
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare two Google Benchmark JSON result files')
+    parser.add_argument('baseline')
+    parser.add_argument('contender')
+    parser.add_argument('--threshold', type=float, help='Fail if any benchmark slows down by more than this percentage')
+    args = parser.parse_args()
+
+    baseline = load_times(args.baseline)
+    contender = load_times(args.contender)
+
+    regressions = []
+    width = max([len(name) for name in baseline] + [9])
+    print('%-*s %14s %14s %9s' % (width, 'Benchmark', 'Baseline ns', 'Contender ns', 'Change'))
+    for name in sorted(set(baseline) | set(contender)):
+        if name not in baseline or name not in contender:
+            print('%-*s %14s %14s %9s' % (width, name, baseline.get(name, '-'), contender.get(name, '-'), 'n/a'))
+            continue
+        change = 100.0 * (contender[name] - baseline[name]) / baseline[name]
+        print('%-*s %14.1f %14.1f %+8.1f%%' % (width, name, baseline[name], contender[name], change))
+        if args.threshold is not None and change > args.threshold:
+            regressions.append(name)
+
+    if regressions:
+        print('\n%d benchmark(s) regressed by more than %.1f%%: %s' % (len(regressions), args.threshold,
+                                                                      ', '.join(regressions)))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
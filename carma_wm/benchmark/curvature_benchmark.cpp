@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <carma_wm/CurvatureCache.h>
+#include <carma_wm/Geometry.h>
+#include "synthetic_map.h"
+
+namespace carma_wm
+{
+namespace
+{
+// 200 lanelets of 25m
+constexpr int ROAD_SEGMENTS = 200;
+constexpr double WINDOW_LENGTH = 5000.0;
+
+const std::vector<lanelet::ConstLanelet>& getWindingRoad()
+{
+  static std::vector<lanelet::ConstLanelet> lanelets = []() {
+    auto llts = benchmark_helpers::buildSyntheticWindingRoad(ROAD_SEGMENTS);
+    for (const auto& llt : llts)
+    {
+      llt.centerline();  // Centerlines are computed once by lanelet2 so keep that out of the measurements
+    }
+    return llts;
+  }();
+  return lanelets;
+}
+}  // namespace
+
+/*!
+ * \brief Curvature of the full 5km window recomputed by getLocalCurvatures on every query
+ */
+static void BM_CurvatureWindowLocalCurvatures(benchmark::State& state)
+{
+  const auto& lanelets = getWindingRoad();
+  for (auto _ : state)
+  {
+    double sum = 0;
+    for (const auto& segment : geometry::getLocalCurvatures(lanelets))
+    {
+      for (double curvature : std::get<1>(segment))
+      {
+        sum += curvature;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+}
+BENCHMARK(BM_CurvatureWindowLocalCurvatures)->Unit(benchmark::kMicrosecond);
+
+/*!
+ * \brief Curvature of the full 5km window streamed from a warm cache, with the smoothing window given by the argument
+ */
+static void BM_CurvatureWindowCached(benchmark::State& state)
+{
+  const auto& lanelets = getWindingRoad();
+  CurvatureCache cache(state.range(0));
+  for (const auto& llt : lanelets)
+  {
+    cache.getProfile(llt, 1);
+  }
+
+  size_t points = 0;
+  for (auto _ : state)
+  {
+    double sum = 0;
+    points = 0;
+    for (const auto& point : cache.window(lanelets, 0, WINDOW_LENGTH, 1))
+    {
+      sum += point.curvature;
+      points++;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.counters["points"] = points;
+}
+BENCHMARK(BM_CurvatureWindowCached)->Arg(0)->Arg(5)->Unit(benchmark::kMicrosecond);
+
+/*!
+ * \brief Cost of building the profiles for the 5km window the first time, or after every map update
+ */
+static void BM_CurvatureWindowColdCache(benchmark::State& state)
+{
+  const auto& lanelets = getWindingRoad();
+  size_t map_version = 0;
+  CurvatureCache cache(state.range(0));
+  for (auto _ : state)
+  {
+    double sum = 0;
+    map_version++;
+    for (const auto& point : cache.window(lanelets, 0, WINDOW_LENGTH, map_version))
+    {
+      sum += point.curvature;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+}
+BENCHMARK(BM_CurvatureWindowColdCache)->Arg(0)->Arg(5)->Unit(benchmark::kMicrosecond);
+
+}  // namespace carma_wm
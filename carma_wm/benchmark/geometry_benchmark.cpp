@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <carma_wm/Geometry.h>
+#include <lanelet2_core/geometry/Point.h>
+#include <cmath>
+#include <vector>
+
+namespace carma_wm
+{
+namespace
+{
+/*!
+ * \brief Segment matching as previously done by geometry::matchSegment, with a square root for every distance and
+ *        the angle between vectors computed through acos
+ */
+TrackPos legacyTrackPos(const lanelet::BasicPoint2d& p, const lanelet::BasicPoint2d& seg_start,
+                        const lanelet::BasicPoint2d& seg_end)
+{
+  Eigen::Vector2d start_to_p = p - seg_start;
+  Eigen::Vector2d start_to_end = seg_end - seg_start;
+  double interior_angle = geometry::getAngleBetweenVectors(start_to_p, start_to_end);
+  double start_to_p_mag = start_to_p.norm();
+  double d = (start_to_p[0] * start_to_end[1]) - (start_to_p[1] * start_to_end[0]);
+  double sign = d >= 0 ? 1.0 : -1.0;
+  return TrackPos(start_to_p_mag * std::cos(interior_angle), start_to_p_mag * std::sin(interior_angle) * sign);
+}
+
+bool legacySelectFirstSegment(const TrackPos& first, const TrackPos& second, double first_length, double second_length)
+{
+  const bool first_in = (0 <= first.downtrack && first.downtrack < first_length);
+  const bool second_in = (0 <= second.downtrack && second.downtrack < second_length);
+  if (first_in != second_in)
+  {
+    return first_in;
+  }
+  return !first_in || first.crosstrack <= second.crosstrack;
+}
+
+TrackPos legacyMatchSegment(const lanelet::BasicPoint2d& p, const lanelet::BasicLineString2d& line_string)
+{
+  double min_distance = lanelet::geometry::distance2d(p, line_string[0]);
+  size_t best_point_index = 0;
+  double best_accumulated_length = 0;
+  double best_last_accumulated_length = 0;
+  double best_seg_length = 0;
+  double best_last_seg_length = 0;
+  double last_seg_length = 0;
+  double accumulated_length = 0;
+  double last_accumulated_length = 0;
+  for (size_t i = 0; i < line_string.size(); i++)
+  {
+    double seg_length = 0;
+    if (i < line_string.size() - 1)
+    {
+      seg_length = lanelet::geometry::distance2d(line_string[i], line_string[i + 1]);
+    }
+    double distance = lanelet::geometry::distance2d(p, line_string[i]);
+    if (distance < min_distance)
+    {
+      min_distance = distance;
+      best_point_index = i;
+      best_accumulated_length = accumulated_length;
+      best_last_accumulated_length = last_accumulated_length;
+      best_seg_length = seg_length;
+      best_last_seg_length = last_seg_length;
+    }
+    last_accumulated_length = accumulated_length;
+    accumulated_length += seg_length;
+    last_seg_length = seg_length;
+  }
+
+  if (best_point_index == 0)
+  {
+    return legacyTrackPos(p, line_string[0], line_string[1]);
+  }
+  if (best_point_index == line_string.size() - 1)
+  {
+    TrackPos pos = legacyTrackPos(p, line_string[line_string.size() - 2], line_string[line_string.size() - 1]);
+    pos.downtrack += best_last_accumulated_length;
+    return pos;
+  }
+  TrackPos first = legacyTrackPos(p, line_string[best_point_index - 1], line_string[best_point_index]);
+  TrackPos second = legacyTrackPos(p, line_string[best_point_index], line_string[best_point_index + 1]);
+  if (legacySelectFirstSegment(first, second, best_last_seg_length, best_seg_length))
+  {
+    first.downtrack += best_last_accumulated_length;
+    return first;
+  }
+  second.downtrack += best_accumulated_length;
+  return second;
+}
+
+/*!
+ * \brief Centerline of a gently curving road with a point every meter, the query points alongside it
+ */
+struct MatchFixture
+{
+  explicit MatchFixture(size_t points)
+  {
+    double length = 0;
+    for (size_t i = 0; i < points; i++)
+    {
+      line_string.emplace_back(i, 20.0 * std::sin(i * 0.01));
+      x.push_back(line_string.back()[0]);
+      y.push_back(line_string.back()[1]);
+      if (i > 0)
+      {
+        length += (line_string[i] - line_string[i - 1]).norm();
+      }
+      accumulated_lengths.push_back(length);
+    }
+    for (size_t i = 0; i < 64; i++)
+    {
+      const double downtrack = (i + 0.5) * points / 64.0;
+      queries.emplace_back(downtrack, 20.0 * std::sin(downtrack * 0.01) + (i % 2 == 0 ? 1.5 : -1.5));
+    }
+  }
+
+  lanelet::BasicLineString2d line_string;
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> accumulated_lengths;
+  std::vector<lanelet::BasicPoint2d, Eigen::aligned_allocator<lanelet::BasicPoint2d>> queries;
+};
+}  // namespace
+
+static void BM_MatchSegmentLegacy(benchmark::State& state)
+{
+  MatchFixture fixture(state.range(0));
+  for (auto _ : state)
+  {
+    for (const auto& query : fixture.queries)
+    {
+      benchmark::DoNotOptimize(legacyMatchSegment(query, fixture.line_string));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * fixture.queries.size());
+}
+BENCHMARK(BM_MatchSegmentLegacy)->Arg(3)->Arg(100)->Arg(1000)->Arg(10000);
+
+static void BM_MatchSegmentLineString(benchmark::State& state)
+{
+  MatchFixture fixture(state.range(0));
+  for (auto _ : state)
+  {
+    for (const auto& query : fixture.queries)
+    {
+      benchmark::DoNotOptimize(geometry::matchSegment(query, fixture.line_string));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * fixture.queries.size());
+}
+BENCHMARK(BM_MatchSegmentLineString)->Arg(3)->Arg(100)->Arg(1000)->Arg(10000);
+
+static void BM_MatchSegmentArrays(benchmark::State& state)
+{
+  MatchFixture fixture(state.range(0));
+  for (auto _ : state)
+  {
+    for (const auto& query : fixture.queries)
+    {
+      benchmark::DoNotOptimize(geometry::matchSegment(query, fixture.x.data(), fixture.y.data(), fixture.x.size(),
+                                                      fixture.accumulated_lengths.data()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * fixture.queries.size());
+}
+BENCHMARK(BM_MatchSegmentArrays)->Arg(3)->Arg(100)->Arg(1000)->Arg(10000);
+
+}  // namespace carma_wm
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <carma_wm/MapSnapshot.h>
+#include <lanelet2_extension/utility/message_conversion.h>
+#include <cstdio>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "synthetic_map.h"
+
+namespace carma_wm
+{
+namespace
+{
+const autoware_lanelet2_msgs::MapBin& getSyntheticMapMsg()
+{
+  static autoware_lanelet2_msgs::MapBin msg = []() {
+    autoware_lanelet2_msgs::MapBin m;
+    lanelet::utils::conversion::toBinMsg(benchmark_helpers::buildSyntheticMap(4, 500), &m);
+    return m;
+  }();
+  return msg;
+}
+
+void runListeners(int listeners, const std::function<void()>& listener)
+{
+  std::vector<std::thread> threads;
+  for (int i = 0; i < listeners; i++)
+  {
+    threads.emplace_back(listener);
+  }
+  for (auto& t : threads)
+  {
+    t.join();
+  }
+}
+}  // namespace
+
+/*!
+ * \brief Startup with the full map published to every listener. Each listening node receives its own copy of the
+ *        message and decodes it.
+ */
+static void BM_MapStartupFromMessage(benchmark::State& state)
+{
+  const auto& msg = getSyntheticMapMsg();
+  for (auto _ : state)
+  {
+    runListeners(state.range(0), [&msg]() {
+      autoware_lanelet2_msgs::MapBin received(msg);  // Copy delivered by the ROS transport
+      lanelet::LaneletMapPtr map(new lanelet::LaneletMap);
+      lanelet::utils::conversion::fromBinMsg(received, map);
+      benchmark::DoNotOptimize(map);
+    });
+  }
+  state.counters["map_bytes"] = msg.data.size();
+  state.counters["bytes_delivered"] = static_cast<double>(msg.data.size()) * state.range(0);
+}
+BENCHMARK(BM_MapStartupFromMessage)->Arg(1)->Arg(20)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+/*!
+ * \brief Startup with the map written once to a snapshot which every listener maps and then decodes.
+ *        Only the delivery of the map differs from BM_MapStartupFromMessage, the decode cost is the same
+ */
+static void BM_MapStartupFromSnapshot(benchmark::State& state)
+{
+  const auto& msg = getSyntheticMapMsg();
+  const std::string path = "/tmp/carma_wm_benchmark_snapshot.bin";
+  uint64_t version = 0;
+  for (auto _ : state)
+  {
+    writeMapSnapshot(path, msg.data, ++version);
+    auto announcement = makeMapSnapshotAnnouncement(path, version);
+    runListeners(state.range(0), [&announcement]() {
+      MappedMapSnapshot snapshot(getMapSnapshotPath(announcement));
+      lanelet::LaneletMapPtr map = snapshot.decodeMap();
+      benchmark::DoNotOptimize(map);
+    });
+  }
+  std::remove(path.c_str());
+  state.counters["map_bytes"] = msg.data.size();
+  state.counters["bytes_delivered"] = static_cast<double>(makeMapSnapshotAnnouncement(path, version).data.size()) * state.range(0);
+}
+BENCHMARK(BM_MapStartupFromSnapshot)->Arg(1)->Arg(20)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}  // namespace carma_wm
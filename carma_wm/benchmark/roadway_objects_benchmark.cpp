@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <carma_wm/CARMAWorldModel.h>
+
+namespace carma_wm
+{
+namespace
+{
+/*!
+ * \brief Builds a roadway obstacle list similar to the output of the environment perception stack, each object
+ *        carrying a few seconds of predicted states
+ */
+cav_msgs::RoadwayObstacleListPtr buildObstacleList(int object_count, int predictions_per_object)
+{
+  cav_msgs::RoadwayObstacleListPtr msg(new cav_msgs::RoadwayObstacleList);
+  msg->roadway_obstacles.resize(object_count);
+  for (int i = 0; i < object_count; i++)
+  {
+    auto& obs = msg->roadway_obstacles[i];
+    obs.object.id = i;
+    obs.lanelet_id = 100 + i;
+    obs.down_track = 10.0 * i;
+    obs.object.predictions.resize(predictions_per_object);
+    for (int j = 0; j < predictions_per_object; j++)
+    {
+      obs.object.predictions[j].predicted_position.position.x = 10.0 * i + j;
+    }
+  }
+  return msg;
+}
+
+constexpr int PREDICTIONS_PER_OBJECT = 50;  // 5s of predictions at 10Hz
+}  // namespace
+
+// Per planning cycle cost of reading the objects through the by value interface
+static void BM_RoadwayObjectsCopy(benchmark::State& state)
+{
+  CARMAWorldModel cmw;
+  cmw.setRoadwayObstacleList(buildObstacleList(state.range(0), PREDICTIONS_PER_OBJECT));
+  for (auto _ : state)
+  {
+    double sum = 0;
+    for (const auto& obs : cmw.getRoadwayObjects())
+    {
+      sum += obs.down_track;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RoadwayObjectsCopy)->Arg(10)->Arg(50)->Arg(200);
+
+// Per planning cycle cost of reading the objects through the shared snapshot
+static void BM_RoadwayObjectsSnapshot(benchmark::State& state)
+{
+  CARMAWorldModel cmw;
+  cmw.setRoadwayObstacleList(buildObstacleList(state.range(0), PREDICTIONS_PER_OBJECT));
+  for (auto _ : state)
+  {
+    double sum = 0;
+    for (const auto& obs : *cmw.getRoadwayObjectsSnapshot())
+    {
+      sum += obs.down_track;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RoadwayObjectsSnapshot)->Arg(10)->Arg(50)->Arg(200);
+
+// Cost of receiving an update through the vector setter, which copies the objects into a new message
+static void BM_SetRoadwayObjects(benchmark::State& state)
+{
+  CARMAWorldModel cmw;
+  auto msg = buildObstacleList(state.range(0), PREDICTIONS_PER_OBJECT);
+  for (auto _ : state)
+  {
+    cmw.setRoadwayObjects(msg->roadway_obstacles);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SetRoadwayObjects)->Arg(10)->Arg(50)->Arg(200);
+
+// Cost of receiving an update as done by WMListener, which shares the received message
+static void BM_SetRoadwayObstacleList(benchmark::State& state)
+{
+  CARMAWorldModel cmw;
+  cav_msgs::RoadwayObstacleListConstPtr msg = buildObstacleList(state.range(0), PREDICTIONS_PER_OBJECT);
+  for (auto _ : state)
+  {
+    cmw.setRoadwayObstacleList(msg);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SetRoadwayObstacleList)->Arg(10)->Arg(50)->Arg(200);
+
+}  // namespace carma_wm
@@ -0,0 +1,201 @@
+#pragma once
+
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cmath>
+#include <vector>
+#include <cav_msgs/RoadwayObstacleList.h>
+#include <cav_msgs/TrajectoryPlan.h>
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/utility/Utilities.h>
+#include <carma_wm/CARMAWorldModel.h>
+
+/*!
+ * Generators of synthetic inputs shared by the carma_wm benchmarks
+ */
+namespace carma_wm
+{
+namespace benchmark_helpers
+{
+/*!
+ * \brief Builds parallel straight lanes split into fixed length segments which share their bounds. Lane l runs along
+ *        x = (l + 0.5) * lane_width in the +y direction and segment s of lane l is at index l * segments + s.
+ */
+inline lanelet::Lanelets buildSyntheticLanelets(int lanes, int segments, double segment_length = 25.0,
+                                                double lane_width = 3.7)
+{
+  std::vector<std::vector<lanelet::Point3d>> points(lanes + 1);
+  for (int b = 0; b <= lanes; b++)
+  {
+    for (int s = 0; s <= segments; s++)
+    {
+      points[b].emplace_back(lanelet::utils::getId(), b * lane_width, s * segment_length, 0.0);
+    }
+  }
+
+  std::vector<std::vector<lanelet::LineString3d>> bounds(lanes + 1);
+  for (int b = 0; b <= lanes; b++)
+  {
+    for (int s = 0; s < segments; s++)
+    {
+      lanelet::LineString3d ls(lanelet::utils::getId(), { points[b][s], points[b][s + 1] });
+      ls.attributes()[lanelet::AttributeName::Type] = lanelet::AttributeValueString::LineThin;
+      ls.attributes()[lanelet::AttributeName::Subtype] = lanelet::AttributeValueString::Dashed;
+      bounds[b].push_back(ls);
+    }
+  }
+
+  lanelet::Lanelets llts;
+  for (int l = 0; l < lanes; l++)
+  {
+    for (int s = 0; s < segments; s++)
+    {
+      lanelet::Lanelet llt(lanelet::utils::getId(), bounds[l][s], bounds[l + 1][s]);
+      llt.attributes()[lanelet::AttributeName::Type] = lanelet::AttributeValueString::Lanelet;
+      llt.attributes()[lanelet::AttributeName::Subtype] = lanelet::AttributeValueString::Road;
+      llt.attributes()[lanelet::AttributeName::Location] = lanelet::AttributeValueString::Urban;
+      llt.attributes()[lanelet::AttributeName::OneWay] = "yes";
+      llts.push_back(llt);
+    }
+  }
+  return llts;
+}
+
+/*!
+ * \brief Builds a map of parallel straight lanes, see buildSyntheticLanelets
+ */
+inline lanelet::LaneletMapPtr buildSyntheticMap(int lanes, int segments, double segment_length = 25.0, double lane_width = 3.7)
+{
+  return lanelet::utils::createMap(buildSyntheticLanelets(lanes, segments, segment_length, lane_width), {});
+}
+
+/*!
+ * \brief Loads a map of parallel straight lanes into cmw with a route along the full length of the first lane
+ *
+ * \return The lanelets of the map, see buildSyntheticLanelets
+ */
+inline lanelet::Lanelets setSyntheticRoute(CARMAWorldModel& cmw, int lanes, int segments, double segment_length = 25.0,
+                                           double lane_width = 3.7)
+{
+  lanelet::Lanelets llts = buildSyntheticLanelets(lanes, segments, segment_length, lane_width);
+  cmw.setMap(lanelet::utils::createMap(llts, {}));
+  auto route = cmw.getMapRoutingGraph()->getRoute(llts.front(), llts[segments - 1]);
+  cmw.setRoute(std::make_shared<lanelet::routing::Route>(std::move(*route)));
+  return llts;
+}
+
+/*!
+ * \brief Builds an obstacle list with objects spread evenly over the given lanelets. Each 4m x 2m object drives along
+ *        the center of its lanelet at 10m/s with predictions every 100ms.
+ */
+inline cav_msgs::RoadwayObstacleList buildSyntheticObstacles(const lanelet::Lanelets& llts, int object_count,
+                                                             int predictions_per_object = 50)
+{
+  cav_msgs::RoadwayObstacleList msg;
+  msg.roadway_obstacles.resize(object_count);
+  for (int i = 0; i < object_count; i++)
+  {
+    const lanelet::Lanelet& llt = llts[(static_cast<size_t>(i) * llts.size()) / object_count];
+    const lanelet::BasicPoint2d start = llt.centerline().front().basicPoint2d();
+    const lanelet::BasicPoint2d end = llt.centerline().back().basicPoint2d();
+    const lanelet::BasicPoint2d center = 0.5 * (start + end);
+    const lanelet::BasicPoint2d heading = (end - start).normalized();
+    const double yaw = std::atan2(heading.y(), heading.x());
+
+    auto& obs = msg.roadway_obstacles[i];
+    obs.lanelet_id = llt.id();
+    obs.object.id = i;
+    obs.object.size.x = 4.0;
+    obs.object.size.y = 2.0;
+    obs.object.size.z = 1.5;
+    obs.object.pose.pose.position.x = center.x();
+    obs.object.pose.pose.position.y = center.y();
+    obs.object.pose.pose.orientation.z = std::sin(yaw / 2.0);
+    obs.object.pose.pose.orientation.w = std::cos(yaw / 2.0);
+    obs.object.velocity.twist.linear.x = 10.0 * heading.x();
+    obs.object.velocity.twist.linear.y = 10.0 * heading.y();
+
+    obs.object.predictions.resize(predictions_per_object);
+    for (int j = 0; j < predictions_per_object; j++)
+    {
+      auto& pred = obs.object.predictions[j];
+      pred.header.stamp.fromNSec((j + 1) * 100000000ULL);
+      pred.predicted_position = obs.object.pose.pose;
+      pred.predicted_position.position.x += (j + 1) * heading.x();
+      pred.predicted_position.position.y += (j + 1) * heading.y();
+    }
+  }
+  return msg;
+}
+
+/*!
+ * \brief Builds a trajectory along the center of the first lane of buildSyntheticLanelets at the given speed with
+ *        points every 100ms
+ */
+inline cav_msgs::TrajectoryPlan buildSyntheticTrajectory(int points, double speed = 10.0, double lane_width = 3.7)
+{
+  cav_msgs::TrajectoryPlan plan;
+  plan.trajectory_points.resize(points);
+  for (int i = 0; i < points; i++)
+  {
+    plan.trajectory_points[i].x = lane_width / 2.0;
+    plan.trajectory_points[i].y = speed * 0.1 * i;
+    plan.trajectory_points[i].target_time = 100 * i;
+  }
+  return plan;
+}
+
+/*!
+ * \brief Builds a single lane winding road as a continuous sequence of lanelets. The heading oscillates every 500m so the
+ *        centerline curvature keeps changing. Bounds have a point every point_spacing meters.
+ */
+inline std::vector<lanelet::ConstLanelet> buildSyntheticWindingRoad(int segments, double segment_length = 25.0,
+                                                                    double point_spacing = 1.0,
+                                                                    double lane_width = 3.7)
+{
+  const int points_per_segment = static_cast<int>(segment_length / point_spacing);
+  std::vector<lanelet::Point3d> left, right;
+  double x = 0, y = 0;
+  for (int i = 0; i <= segments * points_per_segment; i++)
+  {
+    const double heading = 0.3 * std::sin(2.0 * M_PI * i * point_spacing / 500.0);
+    const double nx = -std::sin(heading) * lane_width / 2.0;
+    const double ny = std::cos(heading) * lane_width / 2.0;
+    left.emplace_back(lanelet::utils::getId(), x + nx, y + ny, 0.0);
+    right.emplace_back(lanelet::utils::getId(), x - nx, y - ny, 0.0);
+    x += std::cos(heading) * point_spacing;
+    y += std::sin(heading) * point_spacing;
+  }
+
+  std::vector<lanelet::ConstLanelet> llts;
+  for (int s = 0; s < segments; s++)
+  {
+    auto first = s * points_per_segment;
+    lanelet::LineString3d left_ls(lanelet::utils::getId(), lanelet::Points3d(left.begin() + first,
+                                                                             left.begin() + first + points_per_segment + 1));
+    lanelet::LineString3d right_ls(lanelet::utils::getId(), lanelet::Points3d(right.begin() + first,
+                                                                              right.begin() + first + points_per_segment + 1));
+    lanelet::Lanelet llt(lanelet::utils::getId(), left_ls, right_ls);
+    llt.attributes()[lanelet::AttributeName::Type] = lanelet::AttributeValueString::Lanelet;
+    llt.attributes()[lanelet::AttributeName::Subtype] = lanelet::AttributeValueString::Road;
+    llts.push_back(llt);
+  }
+  return llts;
+}
+
+}  // namespace benchmark_helpers
+}  // namespace carma_wm
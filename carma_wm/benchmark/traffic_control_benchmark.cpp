@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <carma_wm/TrafficControl.h>
+#include <boost/uuid/uuid_generators.hpp>
+#include "synthetic_map.h"
+
+namespace carma_wm
+{
+namespace
+{
+struct TrafficControlFixture
+{
+  lanelet::LaneletMapPtr map;
+  std::shared_ptr<TrafficControl> gf_ptr;
+};
+
+/*!
+ * \brief Builds a geofence which replaces the speed limit of affected_lanelets lanelets, as produced by WMBroadcaster
+ *        when a digital speed limit geofence activates
+ */
+TrafficControlFixture buildSpeedLimitUpdate(int affected_lanelets)
+{
+  using namespace lanelet::units::literals;
+  TrafficControlFixture fixture;
+  fixture.map = benchmark_helpers::buildSyntheticMap(1, affected_lanelets);
+
+  lanelet::Lanelets llts(fixture.map->laneletLayer.begin(), fixture.map->laneletLayer.end());
+  auto old_limit = std::make_shared<lanelet::DigitalSpeedLimit>(
+      lanelet::DigitalSpeedLimit::buildData(lanelet::utils::getId(), 35_mph, llts, {}, { lanelet::Participants::VehicleCar }));
+  auto new_limit = std::make_shared<lanelet::DigitalSpeedLimit>(
+      lanelet::DigitalSpeedLimit::buildData(lanelet::utils::getId(), 15_mph, llts, {}, { lanelet::Participants::VehicleCar }));
+
+  fixture.gf_ptr = std::make_shared<TrafficControl>();
+  fixture.gf_ptr->id_ = boost::uuids::random_generator()();
+  for (const auto& llt : llts)
+  {
+    fixture.map->update(fixture.map->laneletLayer.get(llt.id()), old_limit);
+    fixture.gf_ptr->remove_list_.emplace_back(llt.id(), old_limit);
+    fixture.gf_ptr->update_list_.emplace_back(llt.id(), new_limit);
+  }
+  return fixture;
+}
+}  // namespace
+
+static void BM_TrafficControlArchiveEncode(benchmark::State& state)
+{
+  auto fixture = buildSpeedLimitUpdate(state.range(0));
+  autoware_lanelet2_msgs::MapBin msg;
+  for (auto _ : state)
+  {
+    toBinMsg(fixture.gf_ptr, &msg);
+    benchmark::DoNotOptimize(msg.data.data());
+  }
+  state.counters["msg_bytes"] = msg.data.size();
+  state.SetBytesProcessed(state.iterations() * msg.data.size());
+}
+BENCHMARK(BM_TrafficControlArchiveEncode)->Arg(1)->Arg(10)->Arg(100);
+
+static void BM_TrafficControlCompactEncode(benchmark::State& state)
+{
+  auto fixture = buildSpeedLimitUpdate(state.range(0));
+  autoware_lanelet2_msgs::MapBin msg;
+  for (auto _ : state)
+  {
+    toCompactBinMsg(fixture.gf_ptr, &msg);
+    benchmark::DoNotOptimize(msg.data.data());
+  }
+  state.counters["msg_bytes"] = msg.data.size();
+  state.SetBytesProcessed(state.iterations() * msg.data.size());
+}
+BENCHMARK(BM_TrafficControlCompactEncode)->Arg(1)->Arg(10)->Arg(100);
+
+static void BM_TrafficControlArchiveDecode(benchmark::State& state)
+{
+  auto fixture = buildSpeedLimitUpdate(state.range(0));
+  autoware_lanelet2_msgs::MapBin msg;
+  toBinMsg(fixture.gf_ptr, &msg);
+  for (auto _ : state)
+  {
+    auto received = std::make_shared<TrafficControl>();
+    fromBinMsg(msg, received);
+    benchmark::DoNotOptimize(received);
+  }
+  state.counters["msg_bytes"] = msg.data.size();
+  state.SetBytesProcessed(state.iterations() * msg.data.size());
+}
+BENCHMARK(BM_TrafficControlArchiveDecode)->Arg(1)->Arg(10)->Arg(100);
+
+static void BM_TrafficControlCompactDecode(benchmark::State& state)
+{
+  auto fixture = buildSpeedLimitUpdate(state.range(0));
+  autoware_lanelet2_msgs::MapBin msg;
+  toCompactBinMsg(fixture.gf_ptr, &msg);
+  for (auto _ : state)
+  {
+    auto received = std::make_shared<TrafficControl>();
+    fromBinMsg(msg, received, fixture.map);
+    benchmark::DoNotOptimize(received);
+  }
+  state.counters["msg_bytes"] = msg.data.size();
+  state.SetBytesProcessed(state.iterations() * msg.data.size());
+}
+BENCHMARK(BM_TrafficControlCompactDecode)->Arg(1)->Arg(10)->Arg(100);
+
+}  // namespace carma_wm
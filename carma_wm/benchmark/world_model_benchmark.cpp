@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <carma_wm/CARMAWorldModel.h>
+#include <carma_wm/collision_detection.h>
+#include "synthetic_map.h"
+
+namespace carma_wm
+{
+namespace
+{
+constexpr double SEGMENT_LENGTH = 25.0;
+constexpr double LANE_WIDTH = 3.7;
+constexpr int QUERY_POINTS = 1024;
+
+// Points spread along the route and slightly off the centerline so consecutive queries hit different segments
+std::vector<lanelet::BasicPoint2d> routeQueryPoints(int segments)
+{
+  std::vector<lanelet::BasicPoint2d> points;
+  points.reserve(QUERY_POINTS);
+  for (int i = 0; i < QUERY_POINTS; i++)
+  {
+    double downtrack = (segments * SEGMENT_LENGTH * i) / QUERY_POINTS;
+    points.emplace_back(LANE_WIDTH / 2.0 + 0.5 * std::sin(i), downtrack);
+  }
+  return points;
+}
+
+void setMapCounters(benchmark::State& state, int lanes, int segments)
+{
+  state.counters["lanelets"] = lanes * segments;
+  state.counters["route_m"] = segments * SEGMENT_LENGTH;
+}
+}  // namespace
+
+// Downtrack and crosstrack of a point, as computed by most plugins every planning cycle
+// Args: lane count, route length in segments
+static void BM_RouteTrackPosPoint(benchmark::State& state)
+{
+  const int lanes = state.range(0);
+  const int segments = state.range(1);
+  CARMAWorldModel cmw;
+  benchmark_helpers::setSyntheticRoute(cmw, lanes, segments, SEGMENT_LENGTH, LANE_WIDTH);
+  auto points = routeQueryPoints(segments);
+
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(cmw.routeTrackPos(points[i]));
+    i = (i + 1) % points.size();
+  }
+  setMapCounters(state, lanes, segments);
+}
+BENCHMARK(BM_RouteTrackPosPoint)->Args({ 1, 10 })->Args({ 1, 100 })->Args({ 1, 1000 })->Args({ 4, 1000 });
+
+// Track position of the start of the last lanelet on the route
+static void BM_RouteTrackPosLanelet(benchmark::State& state)
+{
+  const int lanes = state.range(0);
+  const int segments = state.range(1);
+  CARMAWorldModel cmw;
+  auto llts = benchmark_helpers::setSyntheticRoute(cmw, lanes, segments, SEGMENT_LENGTH, LANE_WIDTH);
+  lanelet::ConstLanelet last = llts[segments - 1];
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(cmw.routeTrackPos(last));
+  }
+  setMapCounters(state, lanes, segments);
+}
+BENCHMARK(BM_RouteTrackPosLanelet)->Args({ 1, 10 })->Args({ 1, 100 })->Args({ 1, 1000 })->Args({ 4, 1000 });
+
+// Objects in the lane ahead of the vehicle with objects spread over two lanes
+// Args: route length in segments, object count
+static void BM_GetInLaneObjects(benchmark::State& state)
+{
+  const int segments = state.range(0);
+  const int object_count = state.range(1);
+  CARMAWorldModel cmw;
+  auto llts = benchmark_helpers::setSyntheticRoute(cmw, 2, segments, SEGMENT_LENGTH, LANE_WIDTH);
+  cmw.setRoadwayObjects(benchmark_helpers::buildSyntheticObstacles(llts, object_count).roadway_obstacles);
+  lanelet::ConstLanelet first = llts.front();
+
+  size_t found = 0;
+  for (auto _ : state)
+  {
+    auto objects = cmw.getInLaneObjects(first, LANE_AHEAD);
+    found = objects.size();
+    benchmark::DoNotOptimize(objects.data());
+  }
+  setMapCounters(state, 2, segments);
+  state.counters["objects"] = object_count;
+  state.counters["in_lane"] = found;
+  state.SetItemsProcessed(state.iterations() * object_count);
+}
+BENCHMARK(BM_GetInLaneObjects)
+    ->Args({ 100, 10 })
+    ->Args({ 100, 100 })
+    ->Args({ 100, 1000 })
+    ->Args({ 1000, 100 })
+    ->Unit(benchmark::kMicrosecond);
+
+// Collision check of a 5s trajectory against every object, each with 5s of predictions
+// Args: object count
+static void BM_WorldCollisionDetection(benchmark::State& state)
+{
+  const int object_count = state.range(0);
+  auto llts = benchmark_helpers::buildSyntheticLanelets(2, 20, SEGMENT_LENGTH, LANE_WIDTH);
+  auto obstacles = benchmark_helpers::buildSyntheticObstacles(llts, object_count);
+  auto plan = benchmark_helpers::buildSyntheticTrajectory(50, 10.0, LANE_WIDTH);
+
+  geometry_msgs::Vector3 size;
+  size.x = 4.0;
+  size.y = 2.0;
+  size.z = 1.5;
+  geometry_msgs::Twist velocity;
+  velocity.linear.x = 10.0;
+
+  size_t collisions = 0;
+  for (auto _ : state)
+  {
+    auto result = collision_detection::WorldCollisionDetection(obstacles, plan, size, velocity, 5000);
+    collisions = result.size();
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.counters["objects"] = object_count;
+  state.counters["collisions"] = collisions;
+  state.SetItemsProcessed(state.iterations() * object_count);
+}
+BENCHMARK(BM_WorldCollisionDetection)->Arg(1)->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond);
+
+}  // namespace carma_wm
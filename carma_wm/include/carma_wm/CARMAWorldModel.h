@@ -24,6 +24,9 @@
 #include <cav_msgs/RoadwayObstacle.h>
 #include <cav_msgs/RoadwayObstacleList.h>
 #include "TrackPos.h"
+#include "RoadwayObstacleSnapshot.h"
+#include <atomic>
+#include <memory>
 
 namespace carma_wm
 {
@@ -52,7 +55,8 @@ public:
    */
   ~CARMAWorldModel();
 
-  /*! \brief Set the current map
+  /*! \brief Set the current map. Must also be called after the map has been modified in place so the map version
+   *         advances
    *
    *  \param map A shared pointer to the map which will share ownership to this object
    */
@@ -73,9 +77,18 @@ public:
   /*! \brief Update internal records of roadway objects. These objects MUST be guaranteed to be on the road. 
    * 
    * These are detected by the sensor fusion node and are passed as objects compatible with lanelet 
+   *
+   * The new list is published atomically so this function is safe to call while other threads query the world model
    */
   void setRoadwayObjects(const std::vector<cav_msgs::RoadwayObstacle>& rw_objs);
 
+  /*! \brief Update internal records of roadway objects with the objects held by a received message. The message is
+   *         shared rather than copied. The same requirements as setRoadwayObjects apply
+   *
+   * \param msg The message holding the roadway objects
+   */
+  void setRoadwayObstacleList(const cav_msgs::RoadwayObstacleListConstPtr& msg);
+
   /**
    * \brief This function is called by distanceToObjectBehindInLane or distanceToObjectAheadInLane. 
    * Gets Downtrack distance to AND copy of the closest object on the same lane as the given point. Also returns crosstrack
@@ -106,6 +119,12 @@ public:
 
   lanelet::LaneletMapConstPtr getMap() const override;
 
+  size_t getMapVersion() const override;
+
+  size_t getRouteVersion() const override;
+
+  size_t getRoadwayObjectsVersion() const override;
+
   LaneletRouteConstPtr getRoute() const override;
 
   LaneletRoutingGraphConstPtr getMapRoutingGraph() const override;
@@ -115,6 +134,8 @@ public:
 
   std::vector<cav_msgs::RoadwayObstacle> getRoadwayObjects() const override;
 
+  RoadwayObstacleSnapshotConstPtr getRoadwayObjectsSnapshot() const override;
+
   std::vector<cav_msgs::RoadwayObstacle> getInLaneObjects(const lanelet::ConstLanelet& lanelet, const LaneSection& section = LANE_AHEAD) const override;
 
   lanelet::Optional<lanelet::Lanelet> getIntersectingLanelet (const cav_msgs::ExternalObject& object) const override;
@@ -160,6 +181,12 @@ private:
   IndexedDistanceMap shortest_path_distance_map_;
   lanelet::LaneletMapUPtr shortest_path_filtered_centerline_view_;  // Lanelet map view of shortest path center lines
                                                                     // only
-  std::vector<cav_msgs::RoadwayObstacle> roadway_objects_; // 
+  size_t map_version_ = 0;    // Incremented by each call to setMap
+  size_t route_version_ = 0;  // Incremented by each call to setRoute
+
+  // Roadway objects are replaced as a whole with std::atomic_store so they can be updated without the lock held by
+  // planners. Readers load the snapshot once and keep using it even if a newer one is published in the meantime
+  RoadwayObstacleSnapshotConstPtr roadway_objects_ = std::make_shared<const RoadwayObstacleSnapshot>();
+  std::atomic<size_t> roadway_objects_version_{ 0 };  // Version of the most recent snapshot
 };
 }  // namespace carma_wm
\ No newline at end of file
@@ -0,0 +1,203 @@
+#pragma once
+
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstddef>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+#include <lanelet2_core/primitives/Lanelet.h>
+
+namespace carma_wm
+{
+/*!
+ * \brief Curvature of every point on a single lanelet centerline, computed in 2d
+ */
+struct LaneletCurvatureProfile
+{
+  std::vector<double> downtracks;  // Along-centerline distance of each point from the start of the lanelet
+  std::vector<double> curvatures;  // Curvature at each point in 1/m
+  double length = 0;               // Length of the centerline
+};
+
+/*!
+ * \brief Downtrack and curvature of a centerline point visited by a CurvatureWindow
+ */
+struct CurvaturePoint
+{
+  double downtrack = 0;
+  double curvature = 0;
+};
+
+class CurvatureCache;
+
+/*!
+ * \brief Range of centerline curvatures between two downtrack distances along a sequence of lanelets
+ *
+ * Downtrack is measured from the start of the first lanelet, with each lanelet starting at the end of the one before
+ * it. The first point of a lanelet is skipped when it continues the previous lanelet so each location is visited once.
+ * Iterating does not allocate once every lanelet in the window has a cached profile.
+ *
+ * The window references the cache and lanelet list it was created from, both must outlive it.
+ */
+class CurvatureWindow
+{
+public:
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = CurvaturePoint;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const CurvaturePoint*;
+    using reference = const CurvaturePoint&;
+
+    reference operator*() const
+    {
+      return current_;
+    }
+
+    pointer operator->() const
+    {
+      return &current_;
+    }
+
+    const_iterator& operator++();
+
+    const_iterator operator++(int)
+    {
+      const_iterator previous = *this;
+      ++(*this);
+      return previous;
+    }
+
+    bool operator==(const const_iterator& other) const
+    {
+      return lanelet_index_ == other.lanelet_index_ && point_index_ == other.point_index_;
+    }
+
+    bool operator!=(const const_iterator& other) const
+    {
+      return !(*this == other);
+    }
+
+  private:
+    friend class CurvatureWindow;
+
+    const_iterator(const CurvatureWindow* window, size_t lanelet_index);
+
+    // Moves to the next lanelet which extends past the window start, or to the end of the window
+    void enterLanelet();
+
+    // Loads the current point or moves to the end if it is past the window
+    void loadPoint();
+
+    void setEnd();
+
+    const CurvatureWindow* window_ = nullptr;
+    const LaneletCurvatureProfile* profile_ = nullptr;
+    size_t lanelet_index_ = 0;
+    size_t point_index_ = 0;
+    double lanelet_start_ = 0;
+    CurvaturePoint current_;
+  };
+
+  const_iterator begin() const;
+
+  const_iterator end() const;
+
+private:
+  friend class CurvatureCache;
+
+  CurvatureWindow(CurvatureCache* cache, const std::vector<lanelet::ConstLanelet>* lanelets, double start, double end,
+                  size_t map_version);
+
+  CurvatureCache* cache_;
+  const std::vector<lanelet::ConstLanelet>* lanelets_;
+  double start_;
+  double end_;
+  size_t map_version_;
+};
+
+/*!
+ * \brief Per lanelet cache of centerline curvature profiles
+ *
+ * Profiles are computed the first time a lanelet is requested and kept until the map version changes, so planners
+ * evaluating overlapping windows along the route only compute the curvature of each lanelet once. Curvature at a
+ * centerline point is the 3 point curvature from geometry::computeCurvature. The end points of a centerline take the
+ * value of their interior neighbour since the adjacent lanelet is not known when the profile is built. When smoothing
+ * is enabled each curvature is replaced by the average over the neighbouring points, which is done once when the
+ * profile is built.
+ *
+ * NOTE: This class is not thread safe. Each user should hold its own cache.
+ */
+class CurvatureCache
+{
+public:
+  /*!
+   * \brief Constructor
+   *
+   * \param smoothing_window Number of points on each side of a centerline point averaged into its curvature. 0 leaves
+   *                         the curvatures unsmoothed
+   */
+  explicit CurvatureCache(size_t smoothing_window = 0);
+
+  /*!
+   * \brief Returns the curvature profile of the provided lanelet, computing it if it is not cached
+   *
+   * \param lanelet The lanelet whose centerline curvature is needed
+   * \param map_version The version of the map the lanelet belongs to, see WorldModel::getMapVersion. All cached
+   *                    profiles are dropped when it changes
+   *
+   * \throw std::invalid_argument If the lanelet has no centerline
+   *
+   * \return The cached profile. It remains valid until the map version changes or the cache is cleared
+   */
+  const LaneletCurvatureProfile& getProfile(const lanelet::ConstLanelet& lanelet, size_t map_version);
+
+  /*!
+   * \brief Returns the curvatures between start and end downtrack along the provided lanelets
+   *
+   * \param lanelets The continuous sequence of lanelets to walk, such as a section of the route shortest path
+   * \param start The downtrack distance from the start of the first lanelet where the window begins
+   * \param end The downtrack distance from the start of the first lanelet where the window ends
+   * \param map_version The version of the map the lanelets belong to, see WorldModel::getMapVersion
+   *
+   * \return A window which can be iterated in a range based for loop
+   */
+  CurvatureWindow window(const std::vector<lanelet::ConstLanelet>& lanelets, double start, double end,
+                         size_t map_version);
+
+  /*!
+   * \brief Drops all cached profiles
+   */
+  void clear();
+
+  /*!
+   * \brief Returns the number of cached profiles
+   */
+  size_t size() const;
+
+private:
+  LaneletCurvatureProfile buildProfile(const lanelet::ConstLanelet& lanelet) const;
+
+  size_t smoothing_window_;
+  size_t map_version_ = 0;
+  std::unordered_map<lanelet::Id, LaneletCurvatureProfile> profiles_;
+};
+
+}  // namespace carma_wm
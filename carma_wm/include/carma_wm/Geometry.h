@@ -85,6 +85,28 @@ TrackPos trackPos(const lanelet::BasicPoint2d& p, const lanelet::BasicPoint2d& s
 std::tuple<TrackPos, lanelet::BasicSegment2d> matchSegment(const lanelet::BasicPoint2d& p,
                                                            const lanelet::BasicLineString2d& line_string);
 
+/**
+ * \brief Version of matchSegment operating on a line string stored as separate contiguous x and y arrays.
+ *
+ * The nearest point is found from squared distances in a single vectorizable pass so callers matching many points
+ * against the same line should keep it in this layout. If the along-line distance to each point is already known it can
+ * be provided through accumulated_lengths and no segment lengths are computed. The returned downtrack is then offset by
+ * accumulated_lengths[0], which allows the arrays to describe a section of a longer line.
+ *
+ * \param point The 2d point to match with a segment
+ * \param x The x coordinates of the line string points
+ * \param y The y coordinates of the line string points
+ * \param size The number of points in the line string
+ * \param accumulated_lengths Optional along-line distance to each of the size points. May be nullptr
+ *
+ * \throw std::invalid_argument if line string contains fewer than 2 points
+ *
+ * \return An std::tuple where the first element is the TrackPos of the point and the second element is the index of the
+ * first point of the matched segment
+ */
+std::tuple<TrackPos, size_t> matchSegment(const lanelet::BasicPoint2d& p, const double* x, const double* y, size_t size,
+                                          const double* accumulated_lengths = nullptr);
+
 /*! \brief Returns a list of lists of local (3-point) curvatures, computed in 2d. Each continuous segment of the
  * lanelets' centerlines is one elemtent in the first list. Where each lane change occurs along the list of lanelets a
  * new list of curvatures is started.
@@ -99,6 +121,9 @@ std::tuple<TrackPos, lanelet::BasicSegment2d> matchSegment(const lanelet::BasicP
  * \throw std::invalid_argument If one of the provided lanelets cannot have its centerline computed
  *
  * \return A list of continuous centerline segments and their respective curvatures
+ *
+ * NOTE: The curvatures are recomputed on every call. Callers repeatedly evaluating the same lanelets should use
+ * CurvatureCache instead
  */
 std::vector<std::tuple<size_t, std::vector<double>>>
 getLocalCurvatures(const std::vector<lanelet::ConstLanelet>& lanelets);
@@ -0,0 +1,134 @@
+#pragma once
+
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <lanelet2_core/LaneletMap.h>
+#include <autoware_lanelet2_msgs/MapBin.h>
+
+namespace carma_wm
+{
+/*
+ * Map snapshot transport
+ *
+ * Instead of publishing the serialized map on semantic_map, the broadcaster can write it once to a snapshot file and
+ * publish a small message announcing the file. This only changes how the serialized map reaches the listeners: the
+ * payload is the same Boost archive as the one of the full map message, and every listener still deserializes it into
+ * its own lanelet map. The transport saves sending a copy of the map to every subscriber, not the decode time or the
+ * memory of each listener's map.
+ */
+
+/*!
+ * \brief Value of MapBin::format_version identifying a message which announces a map snapshot instead of carrying the
+ *        serialized map. The data field of such a message holds the path of the snapshot file.
+ */
+extern const char* const MAP_SNAPSHOT_FORMAT;
+
+/*!
+ * \brief Version of the snapshot file layout. Bumped whenever MapSnapshotHeader or the payload encoding changes.
+ */
+constexpr uint32_t MAP_SNAPSHOT_FILE_VERSION = 1;
+
+/*!
+ * \brief Fixed size header at the start of every snapshot file. The payload which follows is the same binary archive
+ *        produced by lanelet::utils::conversion::toBinMsg so it can be produced once and shared with the ROS message.
+ */
+struct MapSnapshotHeader
+{
+  char magic[8];             // "CARMAMAP"
+  uint32_t file_version;     // MAP_SNAPSHOT_FILE_VERSION
+  uint32_t header_size;      // sizeof(MapSnapshotHeader)
+  uint64_t map_version;      // Monotonic version assigned by the writer
+  uint64_t payload_size;     // Bytes following the header
+  uint64_t payload_checksum; // FNV-1a hash of the payload
+};
+
+/*!
+ * \brief FNV-1a hash of a serialized map. Used to validate snapshot payloads and to recognize a map which has already
+ *        been received.
+ */
+uint64_t mapPayloadChecksum(const char* data, size_t size);
+
+/*!
+ * \brief Writes a serialized map to a snapshot file. The snapshot is written next to the target and renamed into place
+ *        so readers never observe a partially written file and existing mappings of an older snapshot stay valid.
+ *        Placing the file under /dev/shm keeps it in shared memory.
+ *
+ * \param path The snapshot file to write
+ * \param payload Serialized map as found in the data field of a MapBin message
+ * \param map_version Version number stored in the snapshot header
+ *
+ * \throw std::runtime_error if the file could not be written
+ */
+void writeMapSnapshot(const std::string& path, const std::vector<int8_t>& payload, uint64_t map_version);
+
+/*!
+ * \brief Builds the small MapBin message announcing the snapshot at path
+ */
+autoware_lanelet2_msgs::MapBin makeMapSnapshotAnnouncement(const std::string& path, uint64_t map_version);
+
+/*!
+ * \brief Returns true if the provided message announces a snapshot rather than carrying the serialized map
+ */
+bool isMapSnapshotAnnouncement(const autoware_lanelet2_msgs::MapBin& msg);
+
+/*!
+ * \brief Returns the snapshot path held by an announcement message
+ */
+std::string getMapSnapshotPath(const autoware_lanelet2_msgs::MapBin& msg);
+
+/*!
+ * \brief Read only memory mapping of a map snapshot file
+ *
+ * Every listener maps the same file so the serialized map is held once in the page cache instead of being copied into
+ * a ROS message for each listener. The map itself still has to be deserialized with decodeMap.
+ */
+class MappedMapSnapshot
+{
+public:
+  /*!
+   * \brief Maps and validates the snapshot at path
+   *
+   * \throw std::runtime_error if the file cannot be mapped or is not a valid snapshot
+   */
+  explicit MappedMapSnapshot(const std::string& path);
+
+  ~MappedMapSnapshot();
+
+  MappedMapSnapshot(const MappedMapSnapshot&) = delete;
+  MappedMapSnapshot& operator=(const MappedMapSnapshot&) = delete;
+
+  uint64_t getMapVersion() const;
+
+  const char* getPayload() const;
+
+  size_t getPayloadSize() const;
+
+  /*!
+   * \brief Deserializes the snapshot into a new lanelet map. This costs as much as decoding the full map message.
+   */
+  lanelet::LaneletMapPtr decodeMap() const;
+
+private:
+  void* mapping_ = nullptr;
+  size_t mapping_size_ = 0;
+  const MapSnapshotHeader* header_ = nullptr;
+};
+
+}  // namespace carma_wm
@@ -0,0 +1,103 @@
+#pragma once
+
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <memory>
+#include <vector>
+#include <cav_msgs/RoadwayObstacle.h>
+#include <cav_msgs/RoadwayObstacleList.h>
+
+namespace carma_wm
+{
+/*! \brief Immutable set of roadway objects received by the world model in a single update
+ *
+ * The snapshot holds the RoadwayObstacleList message it was created from, so obstacles and their predictions are
+ * never copied out of the message. Snapshots are shared through RoadwayObstacleSnapshotConstPtr and remain valid for as
+ * long as a user holds them, regardless of later updates to the world model.
+ */
+class RoadwayObstacleSnapshot
+{
+public:
+  using const_iterator = std::vector<cav_msgs::RoadwayObstacle>::const_iterator;
+
+  /*! \brief Constructor
+   *
+   * \param msg The message holding the obstacles. A null message results in an empty snapshot
+   * \param version The roadway objects version of this snapshot, see WorldModel::getRoadwayObjectsVersion
+   */
+  explicit RoadwayObstacleSnapshot(cav_msgs::RoadwayObstacleListConstPtr msg = nullptr, size_t version = 0)
+    : msg_(msg ? msg : emptyList()), version_(version)
+  {
+  }
+
+  /*! \brief Returns the obstacles held by this snapshot
+   */
+  const std::vector<cav_msgs::RoadwayObstacle>& obstacles() const
+  {
+    return msg_->roadway_obstacles;
+  }
+
+  /*! \brief Returns the message the obstacles are held in
+   */
+  const cav_msgs::RoadwayObstacleListConstPtr& message() const
+  {
+    return msg_;
+  }
+
+  size_t version() const
+  {
+    return version_;
+  }
+
+  const_iterator begin() const
+  {
+    return obstacles().begin();
+  }
+
+  const_iterator end() const
+  {
+    return obstacles().end();
+  }
+
+  size_t size() const
+  {
+    return obstacles().size();
+  }
+
+  bool empty() const
+  {
+    return obstacles().empty();
+  }
+
+  const cav_msgs::RoadwayObstacle& operator[](size_t index) const
+  {
+    return obstacles()[index];
+  }
+
+private:
+  static const cav_msgs::RoadwayObstacleListConstPtr& emptyList()
+  {
+    static const cav_msgs::RoadwayObstacleListConstPtr empty(new cav_msgs::RoadwayObstacleList);
+    return empty;
+  }
+
+  cav_msgs::RoadwayObstacleListConstPtr msg_;
+  size_t version_;
+};
+
+using RoadwayObstacleSnapshotConstPtr = std::shared_ptr<const RoadwayObstacleSnapshot>;
+}  // namespace carma_wm
@@ -46,11 +46,23 @@ public:
                  id_(id), update_list_(update_list), remove_list_(remove_list){}  
 
   boost::uuids::uuid id_;  // Unique id of this geofence
+  // Ids of every geofence whose changes were merged into this update, in the order they were applied. Empty for the
+  // update of a single geofence. Only carried by the compact format.
+  std::vector<boost::uuids::uuid> batched_ids_;
   // elements needed for broadcasting to the rest of map users
   std::vector<std::pair<lanelet::Id, lanelet::RegulatoryElementPtr>> update_list_;
   std::vector<std::pair<lanelet::Id, lanelet::RegulatoryElementPtr>> remove_list_;
+  // Placeholder lanelets and areas referenced by regulatory elements decoded from the compact format without a map.
+  // Regulatory elements only hold weak references to lanelets and areas so they are kept alive here.
+  std::vector<lanelet::Lanelet> placeholder_lanelets_;
+  std::vector<lanelet::Area> placeholder_areas_;
 };
 
+/*!
+ * \brief Value of MapBin::format_version identifying a TrafficControl encoded with toCompactBinMsg
+ */
+extern const char* const TRAFFIC_CONTROL_COMPACT_FORMAT;
+
 /**
  * [Converts carma_wm::TrafficControl object to ROS message. Similar implementation to 
  * lanelet2_extension::utility::message_conversion::toBinMsg]
@@ -66,10 +78,34 @@ void toBinMsg(std::shared_ptr<carma_wm::TrafficControl> gf_ptr, autoware_lanelet
  * lanelet2_extension::utility::message_conversion::fromBinMsg]
  * @param msg [ROS message for geofence]
  * @param gf_ptr [Ptr to converted Geofence object]
+ * @param map [Optional map used to resolve elements when msg uses the compact format, see fromCompactBinMsg]
  * NOTE: When converting the geofence object, the converter only fills its relevant map update
  * fields (update_list, remove_list) as the ROS msg doesn't hold any other data field in the object.
  */
-void fromBinMsg(const autoware_lanelet2_msgs::MapBin& msg, std::shared_ptr<carma_wm::TrafficControl> gf_ptr);
+void fromBinMsg(const autoware_lanelet2_msgs::MapBin& msg, std::shared_ptr<carma_wm::TrafficControl> gf_ptr,
+                lanelet::LaneletMapPtr map = nullptr);
+
+/**
+ * [Converts carma_wm::TrafficControl object to a compact delta ROS message]
+ * @param gf_ptr [Ptr to Geofence data]
+ * @param msg [converted ROS message. "format_version" and "data" fields are filled]
+ * NOTE: Unlike toBinMsg, which archives the full object graph of every regulatory element including the lanelets
+ * and points it refers to, the compact format only carries each distinct regulatory element once with its id,
+ * attributes and the ids of the primitives it refers to. Receivers resolve those ids against their own map.
+ * \throw std::invalid_argument if a regulatory element refers to a lanelet or area which no longer exists
+ */
+void toCompactBinMsg(std::shared_ptr<carma_wm::TrafficControl> gf_ptr, autoware_lanelet2_msgs::MapBin* msg);
+
+/**
+ * [Decodes a message produced by toCompactBinMsg directly from its data buffer. Called by fromBinMsg]
+ * @param msg [ROS message for geofence]
+ * @param gf_ptr [Ptr to converted Geofence object]
+ * @param map [Map used to resolve regulatory elements and the primitives they refer to. If null, the referenced
+ *             primitives are represented by placeholders which only carry their ids]
+ * \throw std::invalid_argument if the data is malformed or refers to primitives missing from map
+ */
+void fromCompactBinMsg(const autoware_lanelet2_msgs::MapBin& msg, std::shared_ptr<carma_wm::TrafficControl> gf_ptr,
+                       lanelet::LaneletMapPtr map = nullptr);
 
 
 }  // namespace carma_wm
@@ -37,6 +37,12 @@ class WMListenerWorker;  // Forward declaration of worker class
  * in the constructor. When used in a multi-threading case users can ensure threadsafe operation though usage of the
  * getLock function
  *
+ * The map and route are only modified while the lock is held. Roadway objects are updated independently without the
+ * lock: each update publishes a complete new list so getRoadwayObjects never waits for users holding the lock and never
+ * returns a partially updated list. In multi-threaded mode they are also received on their own thread, so a map update
+ * waiting for the lock does not delay them. Each part of the world model has its own version number which can be used
+ * to detect changes.
+ *
  * NOTE: At the moment the mechanism of route communication in ROS is not defined therefore it is a TODO: to implement
  * full route support
  */
@@ -47,7 +53,8 @@ public:
    * \brief Constructor which can be used to specify threading behavior of this class
    *
    * By default this object follows node threading behavior (ie. waiting for ros::spin())
-   * If the object is operating in multi-threaded mode a ros::AsyncSpinner is used to implement a background thread.
+   * If the object is operating in multi-threaded mode ros::AsyncSpinners are used to implement background threads, one
+   * for the map and one for roadway objects.
    *
    * \param multi_thread If true this object will subscribe using background threads. Defaults to false
    */
@@ -95,14 +102,19 @@ public:
   std::unique_lock<std::mutex> getLock(bool pre_locked = true);
 
 private:
-  // Callback function that uses lock to edit the map
+  // Callback functions that use lock to edit the map
+  void mapCallback(const autoware_lanelet2_msgs::MapBinConstPtr& map_msg);
   void mapUpdateCallback(const autoware_lanelet2_msgs::MapBinConstPtr& geofence_msg);
-  ros::Subscriber roadway_objects_sub_;
   ros::Subscriber map_update_sub_;
   std::unique_ptr<WMListenerWorker> worker_;
   ros::CARMANodeHandle nh_;
   ros::CallbackQueue async_queue_;
   std::unique_ptr<ros::AsyncSpinner> wm_spinner_;
+  // Roadway objects are served by their own queue and spinner so they never wait behind a map callback blocked on the lock
+  ros::CARMANodeHandle objects_nh_;
+  ros::CallbackQueue objects_queue_;
+  std::unique_ptr<ros::AsyncSpinner> objects_spinner_;
+  ros::Subscriber roadway_objects_sub_;
   ros::Subscriber map_sub_;
   ros::Subscriber route_sub_;
   const bool multi_threaded_;
@@ -46,6 +46,29 @@ public:
    */
   void mapCallback(const autoware_lanelet2_msgs::MapBinConstPtr& map_msg);
 
+  /*!
+   * \brief Decodes the map carried or announced by a map message. The world model is not modified so this may be called
+   *        without holding the world model lock
+   *
+   * \param map_msg The map message to decode
+   *
+   * \return The decoded map or nullptr if an announced snapshot could not be loaded
+   */
+  lanelet::LaneletMapPtr decodeMap(const autoware_lanelet2_msgs::MapBinConstPtr& map_msg) const;
+
+  /*!
+   * \brief Replaces the world model map. The user map callback is not triggered so that callers holding the world
+   *        model lock can release it first and then call invokeMapCallback()
+   *
+   * \param map The new map
+   */
+  void setMap(lanelet::LaneletMapPtr map);
+
+  /*!
+   * \brief Triggers the user map callback if one is set
+   */
+  void invokeMapCallback() const;
+
   /*!
    * \brief Callback for new map update messages (geofence). Updates the underlying map
    *
@@ -59,9 +82,9 @@ public:
   void routeCallback();
 
   /*!
-   * \brief Callback for roadway objects msg
+   * \brief Callback for roadway objects msg. Safe to call while the world model is being queried
    */
-  void roadwayObjectListCallback(const cav_msgs::RoadwayObstacleList& msg);
+  void roadwayObjectListCallback(const cav_msgs::RoadwayObstacleListConstPtr& msg);
 
   /*!
    * \brief Allows user to set a callback to be triggered when a map update is received
@@ -32,6 +32,7 @@
 #include <cav_msgs/ExternalObject.h>
 #include <cav_msgs/ExternalObjectList.h>
 #include "TrackPos.h"
+#include "RoadwayObstacleSnapshot.h"
 
 namespace carma_wm
 {
@@ -131,6 +132,19 @@ public:
    */
   virtual lanelet::LaneletMapConstPtr getMap() const = 0;
 
+  /*! \brief Get the version of the current map. The version is incremented every time the map is replaced or updated,
+   * including geofence updates, so data derived from the map can be cached until it changes
+   *
+   * \return The map version. 0 if no map has been loaded
+   */
+  virtual size_t getMapVersion() const = 0;
+
+  /*! \brief Get the version of the current route. Incremented every time the route is replaced
+   *
+   * \return The route version. 0 if no route has been loaded
+   */
+  virtual size_t getRouteVersion() const = 0;
+
   /*! \brief Get a pointer to the current route. If the underlying route has changed the pointer will also need to be
    * reacquired
    *
@@ -148,11 +162,30 @@ public:
   virtual LaneletRoutingGraphConstPtr getMapRoutingGraph() const = 0;
 
   /*! \brief Get most recent roadway objects - all objects on the road detected by perception stack.
+   *
+   * Roadway objects are updated independently of the map and route. A call always returns one complete list, even
+   * while an update is in progress, and does not require the WMListener lock.
    *
    * \return Vector list of RoadwayObstacle which are lanelet compatible. Empty vector if no object found.
    */
   virtual std::vector<cav_msgs::RoadwayObstacle> getRoadwayObjects() const = 0;
 
+  /*! \brief Get most recent roadway objects without copying them. Prefer this over getRoadwayObjects when the objects
+   * are only read.
+   *
+   * The returned snapshot is immutable and stays valid while it is held, even after the world model receives newer
+   * objects. Like getRoadwayObjects it does not require the WMListener lock.
+   *
+   * \return Shared pointer to the current snapshot. Never null, the snapshot is empty if no objects were received
+   */
+  virtual RoadwayObstacleSnapshotConstPtr getRoadwayObjectsSnapshot() const = 0;
+
+  /*! \brief Get the version of the roadway objects. Incremented every time a new list of objects is received.
+   *
+   * \return The roadway objects version. 0 if no objects have been received
+   */
+  virtual size_t getRoadwayObjectsVersion() const = 0;
+
   /*! \brief Get a pointer to the traffic rules object used internally by the world model and considered the carma
    * system default
    *
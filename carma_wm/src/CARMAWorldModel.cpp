@@ -205,12 +205,15 @@ TrackPos CARMAWorldModel::routeTrackPos(const lanelet::BasicPoint2d& point) cons
     // There is a guarantee from the earlier if statements that near_points[0] will always be located at an index within
     // the exclusive range (0,lineString_1.size() - 1) so no need for range checks
 
-    lanelet::BasicLineString2d subSegment = lanelet::BasicLineString2d(
-        { lineString_1[p_i - 1].basicPoint(), lineString_1[p_i].basicPoint(), lineString_1[p_i + 1].basicPoint() });
+    // The along-line distances of the three points are already stored in the distance map so the matched downtrack
+    // is measured from the start of the centerline
+    const double sub_x[3] = { lineString_1[p_i - 1].x(), lineString_1[p_i].x(), lineString_1[p_i + 1].x() };
+    const double sub_y[3] = { lineString_1[p_i - 1].y(), lineString_1[p_i].y(), lineString_1[p_i + 1].y() };
+    const double sub_lengths[3] = { shortest_path_distance_map_.distanceToPointAlongElement(ls_i, p_i - 1),
+                                    shortest_path_distance_map_.distanceToPointAlongElement(ls_i, p_i),
+                                    shortest_path_distance_map_.distanceToPointAlongElement(ls_i, p_i + 1) };
 
-    tp = std::get<0>(geometry::matchSegment(point, subSegment));  // Get track pos along centerline
-
-    tp.downtrack += shortest_path_distance_map_.distanceToPointAlongElement(ls_i, p_i - 1);
+    tp = std::get<0>(geometry::matchSegment(point, sub_x, sub_y, 3, sub_lengths));  // Get track pos along centerline
 
     bestRouteSegId = lineString_1.id();
   }
@@ -263,6 +266,16 @@ lanelet::LaneletMapConstPtr CARMAWorldModel::getMap() const
   return std::static_pointer_cast<lanelet::LaneletMap const>(semantic_map_);  // Cast pointer to const variant
 }
 
+size_t CARMAWorldModel::getMapVersion() const
+{
+  return map_version_;
+}
+
+size_t CARMAWorldModel::getRouteVersion() const
+{
+  return route_version_;
+}
+
 LaneletRouteConstPtr CARMAWorldModel::getRoute() const
 {
   return std::static_pointer_cast<const lanelet::routing::Route>(route_);  // Cast pointer to const variant
@@ -271,6 +284,7 @@ LaneletRouteConstPtr CARMAWorldModel::getRoute() const
 void CARMAWorldModel::setMap(lanelet::LaneletMapPtr map)
 {
   semantic_map_ = map;
+  map_version_++;
   // Build routing graph from map
   TrafficRulesConstPtr traffic_rules = *(getTrafficRules(lanelet::Participants::Vehicle));
 
@@ -286,6 +300,7 @@ lanelet::LaneletMapPtr CARMAWorldModel::getMutableMap() const
 void CARMAWorldModel::setRoute(LaneletRoutePtr route)
 {
   route_ = route;
+  route_version_++;
 
   lanelet::ConstLanelets path_lanelets(route_->shortestPath().begin(), route_->shortestPath().end());
 
@@ -455,12 +470,31 @@ CARMAWorldModel::toRoadwayObstacle(const cav_msgs::ExternalObject& object) const
 
 void CARMAWorldModel::setRoadwayObjects(const std::vector<cav_msgs::RoadwayObstacle>& rw_objs)
 {
-  roadway_objects_ = rw_objs;
+  cav_msgs::RoadwayObstacleListPtr msg(new cav_msgs::RoadwayObstacleList);
+  msg->roadway_obstacles = rw_objs;
+  setRoadwayObstacleList(msg);
+}
+
+void CARMAWorldModel::setRoadwayObstacleList(const cav_msgs::RoadwayObstacleListConstPtr& msg)
+{
+  // Publish a new snapshot rather than modifying the current one so readers holding the old snapshot are unaffected
+  auto snapshot = std::make_shared<const RoadwayObstacleSnapshot>(msg, ++roadway_objects_version_);
+  std::atomic_store(&roadway_objects_, snapshot);
 }
 
 std::vector<cav_msgs::RoadwayObstacle> CARMAWorldModel::getRoadwayObjects() const
 {
-  return roadway_objects_;
+  return getRoadwayObjectsSnapshot()->obstacles();
+}
+
+RoadwayObstacleSnapshotConstPtr CARMAWorldModel::getRoadwayObjectsSnapshot() const
+{
+  return std::atomic_load(&roadway_objects_);
+}
+
+size_t CARMAWorldModel::getRoadwayObjectsVersion() const
+{
+  return getRoadwayObjectsSnapshot()->version();
 }
 
 std::vector<cav_msgs::RoadwayObstacle> CARMAWorldModel::getInLaneObjects(const lanelet::ConstLanelet& lanelet, const LaneSection& section) const
@@ -469,13 +503,14 @@ std::vector<cav_msgs::RoadwayObstacle> CARMAWorldModel::getInLaneObjects(const l
   std::vector<lanelet::ConstLanelet> lane = getLane(lanelet, section);
   
   // Check if any roadway object is registered
-  if (roadway_objects_.size() == 0)
+  const auto objects = getRoadwayObjectsSnapshot();
+  if (objects->empty())
   {
     return std::vector<cav_msgs::RoadwayObstacle>{};
   }
 
   // Initialize useful variables
-  std::vector<cav_msgs::RoadwayObstacle> lane_objects, roadway_objects_copy = roadway_objects_; 
+  std::vector<cav_msgs::RoadwayObstacle> lane_objects;
   
   /*
   * Get all in lane objects
@@ -487,7 +522,7 @@ std::vector<cav_msgs::RoadwayObstacle> CARMAWorldModel::getInLaneObjects(const l
 
   // Create an index queue for roadway objects to quickly pop the idx if associated 
   // lanelet is found. This is to reduce number of objects to check as we check new lanelets
-  for (int i = 0; i < roadway_objects_copy.size(); i++)
+  for (int i = 0; i < objects->size(); i++)
   {
     obj_idxs_queue.push(i);
   }
@@ -504,7 +539,7 @@ std::vector<cav_msgs::RoadwayObstacle> CARMAWorldModel::getInLaneObjects(const l
       checked_queue_items++;
 
       // Check if the object is in the lanelet
-      auto curr_obj = roadway_objects_copy[curr_idx];
+      const cav_msgs::RoadwayObstacle& curr_obj = (*objects)[curr_idx];
       if (curr_obj.lanelet_id == llt.id())
       {
         // found intersecting lanelet for this object
@@ -563,7 +598,8 @@ lanelet::Optional<double> CARMAWorldModel::distToNearestObjInLane(const lanelet:
   }
 
   // return empty if there is no object nearby
-  if (roadway_objects_.size() == 0)
+  const auto roadway_objects = getRoadwayObjectsSnapshot();
+  if (roadway_objects->empty())
     return boost::none;
   
   // Get the lanelet of this point
@@ -581,7 +617,7 @@ lanelet::Optional<double> CARMAWorldModel::distToNearestObjInLane(const lanelet:
 
   // Record the closest distance out of all polygons, 4 points each
   double min_dist = INFINITY;
-  for (auto obj: roadway_objects_)
+  for (const auto& obj: *roadway_objects)
   {
     lanelet::BasicPolygon2d object_polygon = 
       geometry::objectToMapPolygon(obj.object.pose.pose, obj.object.size);
@@ -606,7 +642,7 @@ lanelet::Optional<std::tuple<TrackPos,cav_msgs::RoadwayObstacle>> CARMAWorldMode
   }
 
   // return empty if there is no object nearby
-  if (roadway_objects_.size() == 0)
+  if (getRoadwayObjectsSnapshot()->empty())
     return boost::none;
   
   // Get the lanelet of this point
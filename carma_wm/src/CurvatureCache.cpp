@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <carma_wm/CurvatureCache.h>
+#include <carma_wm/Geometry.h>
+#include <lanelet2_core/geometry/Point.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace carma_wm
+{
+namespace
+{
+// Maximum gap between the end of a lanelet and the start of the next for them to be considered continuous. Matches
+// geometry::getLocalCurvatures
+constexpr double CONTINUITY_TOLERANCE = 0.1;
+}  // namespace
+
+CurvatureWindow::const_iterator::const_iterator(const CurvatureWindow* window, size_t lanelet_index)
+  : window_(window), lanelet_index_(lanelet_index)
+{
+  enterLanelet();
+}
+
+void CurvatureWindow::const_iterator::enterLanelet()
+{
+  const auto& lanelets = *window_->lanelets_;
+  while (lanelet_index_ < lanelets.size())
+  {
+    profile_ = &window_->cache_->getProfile(lanelets[lanelet_index_], window_->map_version_);
+
+    if (lanelet_start_ + profile_->length < window_->start_)
+    {  // Lanelet ends before the window
+      lanelet_start_ += profile_->length;
+      lanelet_index_++;
+      continue;
+    }
+
+    point_index_ = 0;
+    if (lanelet_index_ > 0 &&
+        lanelet::geometry::distance2d(lanelet::utils::to2D(lanelets[lanelet_index_ - 1].centerline().back()),
+                                      lanelet::utils::to2D(lanelets[lanelet_index_].centerline().front())) <=
+            CONTINUITY_TOLERANCE)
+    {  // The first point is the same location as the last point of the previous lanelet
+      point_index_ = 1;
+    }
+
+    if (lanelet_start_ < window_->start_)
+    {
+      auto first_in_window = std::lower_bound(profile_->downtracks.begin(), profile_->downtracks.end(),
+                                              window_->start_ - lanelet_start_);
+      point_index_ = std::max(point_index_, static_cast<size_t>(first_in_window - profile_->downtracks.begin()));
+    }
+
+    if (point_index_ < profile_->downtracks.size())
+    {
+      loadPoint();
+      return;
+    }
+
+    lanelet_start_ += profile_->length;
+    lanelet_index_++;
+  }
+
+  setEnd();
+}
+
+void CurvatureWindow::const_iterator::loadPoint()
+{
+  const double downtrack = lanelet_start_ + profile_->downtracks[point_index_];
+  if (downtrack > window_->end_)
+  {
+    setEnd();
+    return;
+  }
+  current_.downtrack = downtrack;
+  current_.curvature = profile_->curvatures[point_index_];
+}
+
+void CurvatureWindow::const_iterator::setEnd()
+{
+  lanelet_index_ = window_->lanelets_->size();
+  point_index_ = 0;
+  profile_ = nullptr;
+}
+
+CurvatureWindow::const_iterator& CurvatureWindow::const_iterator::operator++()
+{
+  point_index_++;
+  if (point_index_ < profile_->downtracks.size())
+  {
+    loadPoint();
+    return *this;
+  }
+
+  lanelet_start_ += profile_->length;
+  lanelet_index_++;
+  enterLanelet();
+  return *this;
+}
+
+CurvatureWindow::CurvatureWindow(CurvatureCache* cache, const std::vector<lanelet::ConstLanelet>* lanelets,
+                                 double start, double end, size_t map_version)
+  : cache_(cache), lanelets_(lanelets), start_(start), end_(end), map_version_(map_version)
+{
+}
+
+CurvatureWindow::const_iterator CurvatureWindow::begin() const
+{
+  return const_iterator(this, 0);
+}
+
+CurvatureWindow::const_iterator CurvatureWindow::end() const
+{
+  return const_iterator(this, lanelets_->size());
+}
+
+CurvatureCache::CurvatureCache(size_t smoothing_window) : smoothing_window_(smoothing_window)
+{
+}
+
+const LaneletCurvatureProfile& CurvatureCache::getProfile(const lanelet::ConstLanelet& lanelet, size_t map_version)
+{
+  if (map_version != map_version_)
+  {
+    profiles_.clear();
+    map_version_ = map_version;
+  }
+
+  auto it = profiles_.find(lanelet.id());
+  if (it != profiles_.end())
+  {
+    return it->second;
+  }
+
+  return profiles_.emplace(lanelet.id(), buildProfile(lanelet)).first->second;
+}
+
+CurvatureWindow CurvatureCache::window(const std::vector<lanelet::ConstLanelet>& lanelets, double start, double end,
+                                       size_t map_version)
+{
+  return CurvatureWindow(this, &lanelets, start, end, map_version);
+}
+
+void CurvatureCache::clear()
+{
+  profiles_.clear();
+}
+
+size_t CurvatureCache::size() const
+{
+  return profiles_.size();
+}
+
+LaneletCurvatureProfile CurvatureCache::buildProfile(const lanelet::ConstLanelet& lanelet) const
+{
+  auto centerline = lanelet::utils::to2D(lanelet.centerline());
+  if (centerline.empty())
+  {
+    throw std::invalid_argument("Provided lanelet contains no centerline");
+  }
+
+  const size_t size = centerline.size();
+  LaneletCurvatureProfile profile;
+  profile.downtracks.resize(size);
+  profile.curvatures.assign(size, 0.0);
+
+  profile.downtracks[0] = 0;
+  for (size_t i = 1; i < size; i++)
+  {
+    profile.downtracks[i] = profile.downtracks[i - 1] + lanelet::geometry::distance2d(centerline[i - 1], centerline[i]);
+  }
+  profile.length = profile.downtracks.back();
+
+  if (size < 3)
+  {  // Not enough points to measure curvature so the lanelet is treated as straight
+    return profile;
+  }
+
+  for (size_t i = 1; i < size - 1; i++)
+  {
+    profile.curvatures[i] = geometry::computeCurvature(centerline[i - 1].basicPoint(), centerline[i].basicPoint(),
+                                                       centerline[i + 1].basicPoint());
+  }
+  profile.curvatures[0] = profile.curvatures[1];
+  profile.curvatures[size - 1] = profile.curvatures[size - 2];
+
+  if (smoothing_window_ > 0)
+  {
+    std::vector<double> sums(size + 1, 0.0);
+    for (size_t i = 0; i < size; i++)
+    {
+      sums[i + 1] = sums[i] + profile.curvatures[i];
+    }
+    for (size_t i = 0; i < size; i++)
+    {
+      const size_t first = i >= smoothing_window_ ? i - smoothing_window_ : 0;
+      const size_t last = std::min(size - 1, i + smoothing_window_);
+      profile.curvatures[i] = (sums[last + 1] - sums[first]) / (last - first + 1);
+    }
+  }
+
+  return profile;
+}
+
+}  // namespace carma_wm
@@ -18,6 +18,8 @@
 #include <lanelet2_core/geometry/Point.h>
 #include <tf2/LinearMath/Transform.h>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
+#include <cmath>
+#include <limits>
 
 namespace carma_wm
 {
@@ -38,27 +40,28 @@ double getAngleBetweenVectors(const Eigen::Vector2d& vec1, const Eigen::Vector2d
 TrackPos trackPos(const lanelet::BasicPoint2d& p, const lanelet::BasicPoint2d& seg_start,
                   const lanelet::BasicPoint2d& seg_end)
 {
-  Eigen::Vector2d vec_to_p(p);
-  Eigen::Vector2d vec_to_start(seg_start);
-  Eigen::Vector2d vec_to_end(seg_end);
-
   // Get vector from start to external point
-  Eigen::Vector2d start_to_p = vec_to_p - vec_to_start;
+  const double start_to_p_x = p[0] - seg_start[0];
+  const double start_to_p_y = p[1] - seg_start[1];
 
   // Get vector from start to end point
-  Eigen::Vector2d start_to_end = vec_to_end - vec_to_start;
+  const double start_to_end_x = seg_end[0] - seg_start[0];
+  const double start_to_end_y = seg_end[1] - seg_start[1];
 
-  // Get angle between both vectors
-  double interior_angle = getAngleBetweenVectors(start_to_p, start_to_end);
+  const double seg_length = std::sqrt(start_to_end_x * start_to_end_x + start_to_end_y * start_to_end_y);
+  if (seg_length == 0)
+  {  // A degenerate segment has no direction so the whole distance is treated as downtrack
+    return TrackPos(std::sqrt(start_to_p_x * start_to_p_x + start_to_p_y * start_to_p_y), 0);
+  }
 
-  // Calculate downtrack distance
-  double start_to_p_mag = start_to_p.norm();
-  double downtrack_dist = start_to_p_mag * std::cos(interior_angle);
+  // Downtrack is the projection of start_to_p onto the segment
+  const double downtrack_dist = (start_to_p_x * start_to_end_x + start_to_p_y * start_to_end_y) / seg_length;
 
   /**
-   * Calculate the sign of the crosstrack distance by projecting the points to 2d
+   * Calculate the crosstrack distance and its sign from the 2d cross product
    * d = (p_x - s_x)(e_y - s_y) - (p_y - s_y)(e_x - s_x)
    * Equivalent to d = (start_to_p.x * start_to_end.y) - (start_to_p.y * start_to_end.x)
+   * If d is positive then the point is to the right if it is negative the point is to the left
    *
    * Code below based on math equation described at
    * https://math.stackexchange.com/questions/274712/calculate-on-which-side-of-a-straight-line-is-a-given-point-located
@@ -69,14 +72,9 @@ TrackPos trackPos(const lanelet::BasicPoint2d& p, const lanelet::BasicPoint2d& s
    * Attribution here is in line with Stack Overflow's Attribution policy cc-by-sa found here:
    * https://stackoverflow.blog/2009/06/25/attribution-required/
    */
+  const double d = (start_to_p_x * start_to_end_y) - (start_to_p_y * start_to_end_x);
 
-  double d = (start_to_p[0] * start_to_end[1]) - (start_to_p[1] * start_to_end[0]);
-  double sign = d >= 0 ? 1.0 : -1.0;  // If d is positive then the point is to the right if it is negative the point is
-                                      // to the left
-
-  double crosstrack = start_to_p_mag * std::sin(interior_angle) * sign;
-
-  return TrackPos(downtrack_dist, crosstrack);
+  return TrackPos(downtrack_dist, d / seg_length);
 }
 
 TrackPos trackPos(const lanelet::ConstLanelet& lanelet, const lanelet::BasicPoint2d& point)
@@ -146,93 +144,167 @@ bool selectFirstSegment(const TrackPos& first_seg_trackPos, const TrackPos& seco
   }
 }
 
-std::tuple<TrackPos, lanelet::BasicSegment2d> matchSegment(const lanelet::BasicPoint2d& p,
-                                                           const lanelet::BasicLineString2d& line_string)
+namespace
 {
-  if (line_string.size() < 2)
+// Number of independent minimum searches interleaved by nearestPointIndex
+constexpr size_t MATCH_LANES = 4;
+
+/*!
+ * \brief Returns the index of the first point nearest to (px, py). Point i is located at (x[i * Stride], y[i * Stride])
+ *        so the same kernel serves separate coordinate arrays (Stride 1) and interleaved Eigen points (Stride 2).
+ *
+ * Each lane tracks the nearest point among the indices congruent to it. The lanes are updated with selects rather
+ * than branches and only depend on themselves, which lets the compiler vectorize the loop body. Squared distances are
+ * compared so no square root is taken.
+ */
+template <size_t Stride>
+size_t nearestPointIndex(double px, double py, const double* x, const double* y, size_t size)
+{
+  double lane_min[MATCH_LANES];
+  size_t lane_index[MATCH_LANES];
+  for (size_t l = 0; l < MATCH_LANES; l++)
   {
-    throw std::invalid_argument("Provided with linestring containing fewer than 2 points");
+    lane_min[l] = std::numeric_limits<double>::infinity();
+    lane_index[l] = 0;
   }
 
-  lanelet::BasicSegment2d best_segment =
-      std::make_pair(line_string[0], line_string[1]);  // Default to starting segment if no match is found
-  auto point_2d = lanelet::utils::to2D(p);
-
-  double min_distance = lanelet::geometry::distance2d(point_2d, line_string[0]);
-  size_t best_point_index = 0;
-  double best_accumulated_length = 0;
-  double best_last_accumulated_length = 0;
-  double best_seg_length = 0;
-  double best_last_seg_length = 0;
-  double last_seg_length = 0;
-
-  double accumulated_length = 0;
-  double last_accumulated_length = 0;
-  for (size_t i = 0; i < line_string.size(); i++)
-  {  // Iterate over line string to find nearest point
-    double seg_length = 0;
-    if (i < line_string.size() - 1)
+  size_t i = 0;
+  for (; i + MATCH_LANES <= size; i += MATCH_LANES)
+  {
+    for (size_t l = 0; l < MATCH_LANES; l++)
     {
-      seg_length = lanelet::geometry::distance2d(line_string[i], line_string[i + 1]);  // Compute segment length
+      const double dx = x[(i + l) * Stride] - px;
+      const double dy = y[(i + l) * Stride] - py;
+      const double dist_sq = dx * dx + dy * dy;
+      const bool closer = dist_sq < lane_min[l];
+      lane_min[l] = closer ? dist_sq : lane_min[l];
+      lane_index[l] = closer ? i + l : lane_index[l];
     }
+  }
 
-    double distance = lanelet::geometry::distance2d(p, line_string[i]);  // Compute from current point to external point
-    if (distance < min_distance)
-    {  // If this distance is below minimum discovered so far then update minimum
-      min_distance = distance;
-      best_point_index = i;
-      best_accumulated_length = accumulated_length;
-      best_last_accumulated_length = last_accumulated_length;  // Record accumulated lengths to each segment
-      best_seg_length = seg_length;
-      best_last_seg_length = last_seg_length;
+  // Combine the lanes keeping the lowest index on ties to match a single front to back scan
+  size_t best_index = 0;
+  double best_dist_sq = std::numeric_limits<double>::infinity();
+  for (size_t l = 0; l < MATCH_LANES; l++)
+  {
+    if (lane_min[l] < best_dist_sq || (lane_min[l] == best_dist_sq && lane_index[l] < best_index))
+    {
+      best_dist_sq = lane_min[l];
+      best_index = lane_index[l];
     }
+  }
 
-    last_accumulated_length = accumulated_length;  // Update accumulated lenths
-    accumulated_length += seg_length;
-    last_seg_length = seg_length;
+  for (; i < size; i++)
+  {
+    const double dx = x[i * Stride] - px;
+    const double dy = y[i * Stride] - py;
+    const double dist_sq = dx * dx + dy * dy;
+    if (dist_sq < best_dist_sq)
+    {
+      best_dist_sq = dist_sq;
+      best_index = i;
+    }
   }
 
+  return best_index;
+}
+
+template <size_t Stride>
+std::tuple<TrackPos, size_t> matchSegmentImpl(const lanelet::BasicPoint2d& p, const double* x, const double* y,
+                                              size_t size, const double* accumulated_lengths)
+{
+  if (size < 2)
+  {
+    throw std::invalid_argument("Provided with linestring containing fewer than 2 points");
+  }
+
+  const size_t best_point_index = nearestPointIndex<Stride>(p[0], p[1], x, y, size);
+
+  auto point = [&](size_t i) { return lanelet::BasicPoint2d(x[i * Stride], y[i * Stride]); };
+
+  auto seg_length = [&](size_t i) {
+    if (accumulated_lengths)
+    {
+      return accumulated_lengths[i + 1] - accumulated_lengths[i];
+    }
+    const double dx = x[(i + 1) * Stride] - x[i * Stride];
+    const double dy = y[(i + 1) * Stride] - y[i * Stride];
+    return std::sqrt(dx * dx + dy * dy);
+  };
+
+  // Along-line distance to the start of segment i. Only summed up to the matched segment when not precomputed
+  auto distance_to_segment = [&](size_t i) {
+    if (accumulated_lengths)
+    {
+      return accumulated_lengths[i];
+    }
+    double length = 0;
+    for (size_t j = 0; j < i; j++)
+    {
+      length += seg_length(j);
+    }
+    return length;
+  };
+
   // Minimum point has been found next step is to determine which segment it should go with using the following rules.
   // If the minimum point is the first point then use the first segment
   // If the minimum point is the last point then use the last segment
-  // If the minimum point is within the downtrack bounds of one segment but not the other then use the one it is within
-  // If the minimum point is within the downtrack bounds of both segments then use the one with the smallest crosstrack
-  // distance If the minimum point is within the downtrack bounds of both segments and has exactly equal crosstrack
-  // bounds with each segment then use the first one
+  // Otherwise let selectFirstSegment decide between the segments before and after the minimum point
+  size_t best_segment = 0;
   TrackPos best_pos(0, 0);
   if (best_point_index == 0)
   {
-    best_pos = trackPos(p, line_string[0], line_string[1]);
-    best_segment = std::make_pair(line_string[0], line_string[1]);
+    best_pos = trackPos(p, point(0), point(1));
   }
-  else if (best_point_index == line_string.size() - 1)
+  else if (best_point_index == size - 1)
   {
-    best_pos = trackPos(p, line_string[line_string.size() - 2], line_string[line_string.size() - 1]);
-    best_pos.downtrack += best_last_accumulated_length;
-    best_segment = std::make_pair(line_string[line_string.size() - 2], line_string[line_string.size() - 1]);
+    best_segment = size - 2;
+    best_pos = trackPos(p, point(size - 2), point(size - 1));
   }
   else
   {
-    TrackPos first_seg_trackPos = trackPos(p, line_string[best_point_index - 1], line_string[best_point_index]);
-    TrackPos second_seg_trackPos = trackPos(p, line_string[best_point_index], line_string[best_point_index + 1]);
-    if (selectFirstSegment(first_seg_trackPos, second_seg_trackPos, best_last_seg_length, best_seg_length))
+    TrackPos first_seg_trackPos = trackPos(p, point(best_point_index - 1), point(best_point_index));
+    TrackPos second_seg_trackPos = trackPos(p, point(best_point_index), point(best_point_index + 1));
+    if (selectFirstSegment(first_seg_trackPos, second_seg_trackPos, seg_length(best_point_index - 1),
+                           seg_length(best_point_index)))
     {
+      best_segment = best_point_index - 1;
       best_pos = first_seg_trackPos;
-      best_pos.downtrack += best_last_accumulated_length;
-      best_segment = std::make_pair(line_string[best_point_index - 1], line_string[best_point_index]);
     }
     else
     {
+      best_segment = best_point_index;
       best_pos = second_seg_trackPos;
-      best_pos.downtrack += best_accumulated_length;
-      best_segment = std::make_pair(line_string[best_point_index], line_string[best_point_index + 1]);
     }
   }
 
-  // couldn't find a matching segment, so use the first segment within the downtrack range of.
-  // Or the starting segment assuming we are before the route
+  best_pos.downtrack += distance_to_segment(best_segment);
+
   return std::make_tuple(best_pos, best_segment);
 }
+}  // namespace
+
+std::tuple<TrackPos, lanelet::BasicSegment2d> matchSegment(const lanelet::BasicPoint2d& p,
+                                                           const lanelet::BasicLineString2d& line_string)
+{
+  if (line_string.size() < 2)
+  {
+    throw std::invalid_argument("Provided with linestring containing fewer than 2 points");
+  }
+
+  // Eigen stores each point as a contiguous x, y pair so the points are scanned in place with a stride of 2
+  const double* data = line_string[0].data();
+  auto result = matchSegmentImpl<2>(p, data, data + 1, line_string.size(), nullptr);
+
+  const size_t segment = std::get<1>(result);
+  return std::make_tuple(std::get<0>(result), std::make_pair(line_string[segment], line_string[segment + 1]));
+}
+
+std::tuple<TrackPos, size_t> matchSegment(const lanelet::BasicPoint2d& p, const double* x, const double* y, size_t size,
+                                          const double* accumulated_lengths)
+{
+  return matchSegmentImpl<1>(p, x, y, size, accumulated_lengths);
+}
 
 // NOTE: See Geometry.h header file for details on source of logic in this function
 double computeCurvature(const lanelet::BasicPoint2d& p1, const lanelet::BasicPoint2d& p2,
@@ -259,7 +331,7 @@ getLocalCurvatures(const std::vector<lanelet::ConstLanelet>& lanelets)
   for (size_t n = 0; n < lanelets.size(); n++)
   {
     lanelet::ConstLanelet ll = lanelets[n];
-    auto mutableCenterLine = lanelet::utils::to2D(ll.centerline()).basicLineString();
+    auto mutableCenterLine = lanelet::utils::to2D(ll.centerline());  // Points are read in place rather than copied
 
     if (mutableCenterLine.empty())
     {
@@ -276,7 +348,7 @@ getLocalCurvatures(const std::vector<lanelet::ConstLanelet>& lanelets)
       }
       else if (n != 0 && i <= 1)
       {
-        new_segment_needed = lanelet::geometry::distance2d(prevEndPoint, mutableCenterLine[i]) > 0.1;
+        new_segment_needed = lanelet::geometry::distance2d(prevEndPoint, mutableCenterLine[i].basicPoint()) > 0.1;
       }
 
       if (new_segment_needed && i == 0)
@@ -287,20 +359,20 @@ getLocalCurvatures(const std::vector<lanelet::ConstLanelet>& lanelets)
       }
       else if (new_segment_needed && i == 1)
       {
-        first_2d = mutableCenterLine[i - 1];
-        second_2d = mutableCenterLine[i];
-        third_2d = mutableCenterLine[i + 1];
+        first_2d = mutableCenterLine[i - 1].basicPoint();
+        second_2d = mutableCenterLine[i].basicPoint();
+        third_2d = mutableCenterLine[i + 1].basicPoint();
         std::get<1>(vec.back()).push_back(computeCurvature(first_2d, second_2d, third_2d));
         continue;
       }
 
       first_2d = second_2d;
       second_2d = third_2d;
-      third_2d = mutableCenterLine[i + 1];
+      third_2d = mutableCenterLine[i + 1].basicPoint();
       std::get<1>(vec.back()).push_back(computeCurvature(first_2d, second_2d, third_2d));
     }
     
-    prevEndPoint = mutableCenterLine.back();
+    prevEndPoint = mutableCenterLine.back().basicPoint();
   }
 
   return vec;
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <carma_wm/MapSnapshot.h>
+#include <lanelet2_io/io_handlers/Serialize.h>
+#include <lanelet2_core/utility/Utilities.h>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace carma_wm
+{
+const char* const MAP_SNAPSHOT_FORMAT = "carma_map_snapshot";
+
+namespace
+{
+const char SNAPSHOT_MAGIC[8] = { 'C', 'A', 'R', 'M', 'A', 'M', 'A', 'P' };
+}  // namespace
+
+uint64_t mapPayloadChecksum(const char* data, size_t size)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < size; i++)
+  {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+void writeMapSnapshot(const std::string& path, const std::vector<int8_t>& payload, uint64_t map_version)
+{
+  const char* data = reinterpret_cast<const char*>(payload.data());
+
+  MapSnapshotHeader header;
+  std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+  header.file_version = MAP_SNAPSHOT_FILE_VERSION;
+  header.header_size = sizeof(MapSnapshotHeader);
+  header.map_version = map_version;
+  header.payload_size = payload.size();
+  header.payload_checksum = mapPayloadChecksum(data, payload.size());
+
+  std::string tmp_path = path + ".tmp." + std::to_string(getpid());
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(data, payload.size());
+    if (!out)
+    {
+      std::remove(tmp_path.c_str());
+      throw std::runtime_error("Failed to write map snapshot to " + tmp_path);
+    }
+  }
+
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0)
+  {
+    std::remove(tmp_path.c_str());
+    throw std::runtime_error("Failed to move map snapshot into place at " + path);
+  }
+}
+
+autoware_lanelet2_msgs::MapBin makeMapSnapshotAnnouncement(const std::string& path, uint64_t map_version)
+{
+  autoware_lanelet2_msgs::MapBin msg;
+  msg.format_version = MAP_SNAPSHOT_FORMAT;
+  msg.map_version = std::to_string(map_version);
+  msg.data.assign(path.begin(), path.end());
+  return msg;
+}
+
+bool isMapSnapshotAnnouncement(const autoware_lanelet2_msgs::MapBin& msg)
+{
+  return msg.format_version == MAP_SNAPSHOT_FORMAT;
+}
+
+std::string getMapSnapshotPath(const autoware_lanelet2_msgs::MapBin& msg)
+{
+  return std::string(msg.data.begin(), msg.data.end());
+}
+
+MappedMapSnapshot::MappedMapSnapshot(const std::string& path)
+{
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    throw std::runtime_error("Failed to open map snapshot " + path);
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(MapSnapshotHeader))
+  {
+    close(fd);
+    throw std::runtime_error("Map snapshot " + path + " is too small to be valid");
+  }
+
+  mapping_size_ = st.st_size;
+  mapping_ = mmap(nullptr, mapping_size_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);  // The mapping keeps the file alive
+  if (mapping_ == MAP_FAILED)
+  {
+    mapping_ = nullptr;
+    throw std::runtime_error("Failed to map map snapshot " + path);
+  }
+
+  header_ = static_cast<const MapSnapshotHeader*>(mapping_);
+
+  std::string error;
+  if (std::memcmp(header_->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0)
+  {
+    error = "is not a map snapshot";
+  }
+  else if (header_->file_version != MAP_SNAPSHOT_FILE_VERSION || header_->header_size != sizeof(MapSnapshotHeader))
+  {
+    error = "has unsupported version " + std::to_string(header_->file_version);
+  }
+  else if (header_->payload_size != mapping_size_ - sizeof(MapSnapshotHeader))
+  {
+    error = "is truncated";
+  }
+  else if (mapPayloadChecksum(getPayload(), getPayloadSize()) != header_->payload_checksum)
+  {
+    error = "failed checksum validation";
+  }
+
+  if (!error.empty())
+  {
+    munmap(mapping_, mapping_size_);
+    mapping_ = nullptr;
+    throw std::runtime_error("Map snapshot " + path + " " + error);
+  }
+}
+
+MappedMapSnapshot::~MappedMapSnapshot()
+{
+  if (mapping_)
+  {
+    munmap(mapping_, mapping_size_);
+  }
+}
+
+uint64_t MappedMapSnapshot::getMapVersion() const
+{
+  return header_->map_version;
+}
+
+const char* MappedMapSnapshot::getPayload() const
+{
+  return static_cast<const char*>(mapping_) + sizeof(MapSnapshotHeader);
+}
+
+size_t MappedMapSnapshot::getPayloadSize() const
+{
+  return header_->payload_size;
+}
+
+lanelet::LaneletMapPtr MappedMapSnapshot::decodeMap() const
+{
+  boost::iostreams::stream<boost::iostreams::array_source> stream(getPayload(), getPayloadSize());
+  boost::archive::binary_iarchive ia(stream);
+
+  lanelet::LaneletMapPtr map(new lanelet::LaneletMap);
+  ia >> *map;
+  // Same trailer as written by lanelet::utils::conversion::toBinMsg
+  lanelet::Id id_counter;
+  ia >> id_counter;
+  lanelet::utils::registerId(id_counter);
+  return map;
+}
+
+}  // namespace carma_wm
@@ -17,9 +17,415 @@
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <carma_wm/TrafficControl.h>
+#include <lanelet2_core/primitives/RegulatoryElement.h>
+#include <unordered_map>
 
 namespace carma_wm
 {
+const char* const TRAFFIC_CONTROL_COMPACT_FORMAT = "carma_traffic_control_compact";
+
+/*
+ * Compact format layout. All integers are little endian, strings are a uint32 length followed by the bytes.
+ *
+ *   uint8  version
+ *   uint8  geofence uuid[16]
+ *   version 2 only: uint32 batched geofence count, followed by their uuid[16]
+ *   uint32 regem count, followed by each distinct regulatory element:
+ *            int64 id
+ *            uint32 attribute count, followed by (string key, string value) pairs
+ *            uint32 role count, followed by (string role, uint32 parameter count, (uint8 kind, int64 id) * count)
+ *   uint32 remove count, followed by (int64 lanelet id, uint32 regem index) pairs
+ *   uint32 update count, followed by (int64 lanelet id, uint32 regem index) pairs
+ */
+namespace
+{
+constexpr uint8_t COMPACT_VERSION = 1;
+// Adds the ids of the geofences merged into a batched update. Single geofence updates keep the version 1 layout.
+constexpr uint8_t COMPACT_BATCHED_VERSION = 2;
+
+// Kind of primitive referenced by a regulatory element parameter
+enum ParameterKind : uint8_t
+{
+  POINT = 0,
+  LINESTRING = 1,
+  LINESTRING_INVERTED = 2,
+  POLYGON = 3,
+  POLYGON_INVERTED = 4,
+  LANELET = 5,
+  LANELET_INVERTED = 6,
+  AREA = 7
+};
+
+class CompactWriter
+{
+public:
+  explicit CompactWriter(std::vector<int8_t>& out) : out_(out) {}
+
+  void u8(uint8_t v)
+  {
+    out_.push_back(static_cast<int8_t>(v));
+  }
+
+  void u32(uint32_t v)
+  {
+    for (int i = 0; i < 4; i++)
+      u8(static_cast<uint8_t>(v >> (8 * i)));
+  }
+
+  void i64(int64_t v)
+  {
+    uint64_t u = static_cast<uint64_t>(v);
+    for (int i = 0; i < 8; i++)
+      u8(static_cast<uint8_t>(u >> (8 * i)));
+  }
+
+  void str(const std::string& v)
+  {
+    u32(v.size());
+    out_.insert(out_.end(), v.begin(), v.end());
+  }
+
+private:
+  std::vector<int8_t>& out_;
+};
+
+class CompactReader
+{
+public:
+  explicit CompactReader(const std::vector<int8_t>& in) : data_(reinterpret_cast<const uint8_t*>(in.data())), size_(in.size()) {}
+
+  uint8_t u8()
+  {
+    require(1);
+    return data_[pos_++];
+  }
+
+  uint32_t u32()
+  {
+    require(4);
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++)
+      v |= static_cast<uint32_t>(data_[pos_++]) << (8 * i);
+    return v;
+  }
+
+  int64_t i64()
+  {
+    require(8);
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++)
+      v |= static_cast<uint64_t>(data_[pos_++]) << (8 * i);
+    return static_cast<int64_t>(v);
+  }
+
+  std::string str()
+  {
+    uint32_t len = u32();
+    require(len);
+    std::string v(reinterpret_cast<const char*>(data_ + pos_), len);
+    pos_ += len;
+    return v;
+  }
+
+  // Counts are bounded by the remaining bytes so corrupt data cannot trigger huge allocations
+  uint32_t count(size_t min_entry_size)
+  {
+    uint32_t n = u32();
+    if (min_entry_size * n > size_ - pos_)
+      throw std::invalid_argument("Compact traffic control message is truncated");
+    return n;
+  }
+
+private:
+  void require(size_t n) const
+  {
+    if (n > size_ - pos_)
+      throw std::invalid_argument("Compact traffic control message is truncated");
+  }
+
+  const uint8_t* data_;
+  size_t size_;
+  size_t pos_ = 0;
+};
+
+// Writes the kind and id of each regulatory element parameter
+class ParameterWriter : public boost::static_visitor<void>
+{
+public:
+  explicit ParameterWriter(CompactWriter& writer) : writer_(writer) {}
+
+  void operator()(const lanelet::Point3d& p) const
+  {
+    write(POINT, p.id());
+  }
+  void operator()(const lanelet::LineString3d& ls) const
+  {
+    write(ls.inverted() ? LINESTRING_INVERTED : LINESTRING, ls.id());
+  }
+  void operator()(const lanelet::Polygon3d& poly) const
+  {
+    write(poly.inverted() ? POLYGON_INVERTED : POLYGON, poly.id());
+  }
+  void operator()(const lanelet::WeakLanelet& weak_llt) const
+  {
+    if (weak_llt.expired())
+      throw std::invalid_argument("Regulatory element refers to a lanelet which no longer exists");
+    lanelet::Lanelet llt = weak_llt.lock();
+    write(llt.inverted() ? LANELET_INVERTED : LANELET, llt.id());
+  }
+  void operator()(const lanelet::WeakArea& weak_area) const
+  {
+    if (weak_area.expired())
+      throw std::invalid_argument("Regulatory element refers to an area which no longer exists");
+    write(AREA, weak_area.lock().id());
+  }
+
+private:
+  void write(ParameterKind kind, lanelet::Id id) const
+  {
+    writer_.u8(kind);
+    writer_.i64(id);
+  }
+
+  CompactWriter& writer_;
+};
+
+void writeRegem(CompactWriter& writer, const lanelet::RegulatoryElement& regem)
+{
+  writer.i64(regem.id());
+
+  const lanelet::AttributeMap& attributes = regem.attributes();
+  writer.u32(attributes.size());
+  for (const auto& attribute : attributes)
+  {
+    writer.str(attribute.first);
+    writer.str(attribute.second.value());
+  }
+
+  const lanelet::RuleParameterMap& parameters = regem.constData()->parameters;
+  writer.u32(parameters.size());
+  ParameterWriter parameter_writer(writer);
+  for (const auto& role : parameters)
+  {
+    writer.str(role.first);
+    writer.u32(role.second.size());
+    for (const auto& parameter : role.second)
+    {
+      boost::apply_visitor(parameter_writer, parameter);
+    }
+  }
+}
+
+template <typename Layer>
+auto getFromLayer(Layer& layer, lanelet::Id id) -> decltype(layer.get(id))
+{
+  if (!layer.exists(id))
+    throw std::invalid_argument("Compact traffic control message refers to primitive " + std::to_string(id) +
+                                " which is not in the map");
+  return layer.get(id);
+}
+
+lanelet::RuleParameter readParameter(CompactReader& reader, const lanelet::LaneletMapPtr& map, TrafficControl& gf)
+{
+  uint8_t kind = reader.u8();
+  lanelet::Id id = reader.i64();
+
+  switch (kind)
+  {
+    case POINT:
+      return map ? getFromLayer(map->pointLayer, id) : lanelet::Point3d(id, 0, 0, 0);
+    case LINESTRING:
+    case LINESTRING_INVERTED:
+    {
+      lanelet::LineString3d ls = map ? getFromLayer(map->lineStringLayer, id) : lanelet::LineString3d(id, {});
+      return kind == LINESTRING_INVERTED ? ls.invert() : ls;
+    }
+    case POLYGON:
+    case POLYGON_INVERTED:
+    {
+      lanelet::Polygon3d poly = map ? getFromLayer(map->polygonLayer, id) : lanelet::Polygon3d(id, {});
+      return kind == POLYGON_INVERTED ? poly.invert() : poly;
+    }
+    case LANELET:
+    case LANELET_INVERTED:
+    {
+      lanelet::Lanelet llt;
+      if (map)
+      {
+        llt = getFromLayer(map->laneletLayer, id);
+      }
+      else
+      {
+        llt = lanelet::Lanelet(id, lanelet::LineString3d(), lanelet::LineString3d());
+        gf.placeholder_lanelets_.push_back(llt);
+      }
+      return lanelet::WeakLanelet(kind == LANELET_INVERTED ? llt.invert() : llt);
+    }
+    case AREA:
+    {
+      lanelet::Area area;
+      if (map)
+      {
+        area = getFromLayer(map->areaLayer, id);
+      }
+      else
+      {
+        area = lanelet::Area(id, {});
+        gf.placeholder_areas_.push_back(area);
+      }
+      return lanelet::WeakArea(area);
+    }
+    default:
+      throw std::invalid_argument("Compact traffic control message has unknown parameter kind " + std::to_string(kind));
+  }
+}
+
+lanelet::RegulatoryElementPtr readRegem(CompactReader& reader, const lanelet::LaneletMapPtr& map, TrafficControl& gf)
+{
+  auto data = std::make_shared<lanelet::RegulatoryElementData>(reader.i64());
+
+  uint32_t attribute_count = reader.count(8);
+  for (uint32_t i = 0; i < attribute_count; i++)
+  {
+    std::string key = reader.str();
+    data->attributes[key] = reader.str();
+  }
+
+  uint32_t role_count = reader.count(8);
+  for (uint32_t i = 0; i < role_count; i++)
+  {
+    std::string role = reader.str();
+    uint32_t parameter_count = reader.count(9);
+    lanelet::RuleParameters parameters;
+    parameters.reserve(parameter_count);
+    for (uint32_t j = 0; j < parameter_count; j++)
+    {
+      parameters.push_back(readParameter(reader, map, gf));
+    }
+    data->parameters[role] = parameters;
+  }
+
+  // Elements the receiver already knows are used as is so they stay consistent with its map
+  if (map && map->regulatoryElementLayer.exists(data->id))
+  {
+    return map->regulatoryElementLayer.get(data->id);
+  }
+
+  auto subtype = data->attributes.find(lanelet::AttributeNamesString::Subtype);
+  if (subtype == data->attributes.end())
+  {
+    return std::make_shared<lanelet::GenericRegulatoryElement>(data);
+  }
+  return lanelet::RegulatoryElementFactory::create(subtype->second.value(), data);
+}
+
+void readPairs(CompactReader& reader, const std::vector<lanelet::RegulatoryElementPtr>& regems,
+               std::vector<std::pair<lanelet::Id, lanelet::RegulatoryElementPtr>>& out)
+{
+  uint32_t count = reader.count(12);
+  out.reserve(out.size() + count);
+  for (uint32_t i = 0; i < count; i++)
+  {
+    lanelet::Id llt_id = reader.i64();
+    uint32_t idx = reader.u32();
+    if (idx >= regems.size())
+      throw std::invalid_argument("Compact traffic control message has invalid regulatory element index");
+    out.emplace_back(llt_id, regems[idx]);
+  }
+}
+}  // namespace
+
+void toCompactBinMsg(std::shared_ptr<carma_wm::TrafficControl> gf_ptr, autoware_lanelet2_msgs::MapBin* msg)
+{
+  if (msg == nullptr)
+  {
+    ROS_ERROR_STREAM(__FUNCTION__ << ": msg is null pointer!");
+    return;
+  }
+
+  // Each regulatory element is written once even if it applies to many lanelets
+  std::vector<lanelet::RegulatoryElementPtr> regems;
+  std::unordered_map<lanelet::Id, uint32_t> regem_index;
+  auto index_of = [&](const lanelet::RegulatoryElementPtr& regem) {
+    auto it = regem_index.find(regem->id());
+    if (it != regem_index.end())
+      return it->second;
+    regem_index[regem->id()] = regems.size();
+    regems.push_back(regem);
+    return static_cast<uint32_t>(regems.size() - 1);
+  };
+
+  std::vector<std::pair<lanelet::Id, uint32_t>> removes, updates;
+  removes.reserve(gf_ptr->remove_list_.size());
+  updates.reserve(gf_ptr->update_list_.size());
+  for (const auto& pair : gf_ptr->remove_list_)
+    removes.emplace_back(pair.first, index_of(pair.second));
+  for (const auto& pair : gf_ptr->update_list_)
+    updates.emplace_back(pair.first, index_of(pair.second));
+
+  msg->format_version = TRAFFIC_CONTROL_COMPACT_FORMAT;
+  msg->data.clear();
+  CompactWriter writer(msg->data);
+  writer.u8(gf_ptr->batched_ids_.empty() ? COMPACT_VERSION : COMPACT_BATCHED_VERSION);
+  for (auto byte : gf_ptr->id_)
+    writer.u8(byte);
+  if (!gf_ptr->batched_ids_.empty())
+  {
+    writer.u32(gf_ptr->batched_ids_.size());
+    for (const auto& id : gf_ptr->batched_ids_)
+      for (auto byte : id)
+        writer.u8(byte);
+  }
+
+  writer.u32(regems.size());
+  for (const auto& regem : regems)
+    writeRegem(writer, *regem);
+
+  for (const auto* list : { &removes, &updates })
+  {
+    writer.u32(list->size());
+    for (const auto& pair : *list)
+    {
+      writer.i64(pair.first);
+      writer.u32(pair.second);
+    }
+  }
+}
+
+void fromCompactBinMsg(const autoware_lanelet2_msgs::MapBin& msg, std::shared_ptr<carma_wm::TrafficControl> gf_ptr,
+                       lanelet::LaneletMapPtr map)
+{
+  if (!gf_ptr)
+  {
+    ROS_ERROR_STREAM(__FUNCTION__ << ": gf_ptr is null pointer!");
+    return;
+  }
+
+  CompactReader reader(msg.data);
+  uint8_t version = reader.u8();
+  if (version != COMPACT_VERSION && version != COMPACT_BATCHED_VERSION)
+    throw std::invalid_argument("Unsupported compact traffic control message version " + std::to_string(version));
+
+  for (auto& byte : gf_ptr->id_)
+    byte = reader.u8();
+  if (version == COMPACT_BATCHED_VERSION)
+  {
+    uint32_t id_count = reader.count(16);
+    gf_ptr->batched_ids_.resize(id_count);
+    for (auto& id : gf_ptr->batched_ids_)
+      for (auto& byte : id)
+        byte = reader.u8();
+  }
+
+  uint32_t regem_count = reader.count(16);
+  std::vector<lanelet::RegulatoryElementPtr> regems;
+  regems.reserve(regem_count);
+  for (uint32_t i = 0; i < regem_count; i++)
+    regems.push_back(readRegem(reader, map, *gf_ptr));
+
+  readPairs(reader, regems, gf_ptr->remove_list_);
+  readPairs(reader, regems, gf_ptr->update_list_);
+}
 
 void toBinMsg(std::shared_ptr<carma_wm::TrafficControl> gf_ptr, autoware_lanelet2_msgs::MapBin* msg)
 {
@@ -37,7 +443,8 @@ void toBinMsg(std::shared_ptr<carma_wm::TrafficControl> gf_ptr, autoware_lanelet
   msg->data.assign(data_str.begin(), data_str.end());
 }
 
-void fromBinMsg(const autoware_lanelet2_msgs::MapBin& msg, std::shared_ptr<carma_wm::TrafficControl> gf_ptr)
+void fromBinMsg(const autoware_lanelet2_msgs::MapBin& msg, std::shared_ptr<carma_wm::TrafficControl> gf_ptr,
+                lanelet::LaneletMapPtr map)
 {
   if (!gf_ptr)
   {
@@ -45,6 +452,12 @@ void fromBinMsg(const autoware_lanelet2_msgs::MapBin& msg, std::shared_ptr<carma
     return;
   }
 
+  if (msg.format_version == TRAFFIC_CONTROL_COMPACT_FORMAT)
+  {
+    fromCompactBinMsg(msg, gf_ptr, map);
+    return;
+  }
+
   std::string data_str;
   data_str.assign(msg.data.begin(), msg.data.end());
   
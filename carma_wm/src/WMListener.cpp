@@ -16,7 +16,7 @@
 
 #include <new>
 #include <carma_wm/WMListener.h>
-#include "WMListenerWorker.h"
+#include <carma_wm/WMListenerWorker.h>
 
 namespace carma_wm
 {
@@ -29,17 +29,22 @@ WMListener::WMListener(bool multi_thread) : worker_(std::unique_ptr<WMListenerWo
   {
     ROS_DEBUG_STREAM("WMListener: Using multi-threaded subscription");
     nh_.setCallbackQueue(&async_queue_);
+    objects_nh_.setCallbackQueue(&objects_queue_);
   }
   map_update_sub_= nh_.subscribe("map_update", 1, &WMListener::mapUpdateCallback, this);
-  map_sub_ = nh_.subscribe("semantic_map", 1, &WMListenerWorker::mapCallback, worker_.get());
+  map_sub_ = nh_.subscribe("semantic_map", 1, &WMListener::mapCallback, this);
   // route_sub_ = nh_.subscribe("route", 1, &WMListenerWorker::routeCallback, worker_.get()); // TODO uncomment when
   // route message is defined
-  roadway_objects_sub_ = nh_.subscribe("roadway_objects", 1, &WMListenerWorker::roadwayObjectListCallback, worker_.get());
-  // Set up AsyncSpinner for multi-threaded use case
+  // Roadway objects are published atomically by the world model so they are not delayed by users holding the lock.
+  // They have their own queue so they are also not delayed by map callbacks waiting for the lock
+  roadway_objects_sub_ = objects_nh_.subscribe("roadway_objects", 1, &WMListenerWorker::roadwayObjectListCallback, worker_.get());
+  // Set up AsyncSpinners for multi-threaded use case
   if (multi_threaded_)
   {
     wm_spinner_ = std::unique_ptr<ros::AsyncSpinner>(new ros::AsyncSpinner(1, &async_queue_));
     wm_spinner_->start();
+    objects_spinner_ = std::unique_ptr<ros::AsyncSpinner>(new ros::AsyncSpinner(1, &objects_queue_));
+    objects_spinner_->start();
   }
 }
 
@@ -48,15 +53,34 @@ WMListener::~WMListener()
   if (multi_threaded_)
   {
     wm_spinner_->stop();
+    objects_spinner_->stop();
   }
 }
 
 WorldModelConstPtr WMListener::getWorldModel()
 {
-  const std::lock_guard<std::mutex> lock(mw_mutex_);
+  // The world model instance is created with the worker and never replaced so no lock is needed
   return worker_->getWorldModel();
 }
 
+void WMListener::mapCallback(const autoware_lanelet2_msgs::MapBinConstPtr& map_msg)
+{
+  // Decoding is the expensive part of a new map and does not touch the world model, so users are only blocked while the
+  // decoded map is swapped in
+  lanelet::LaneletMapPtr new_map = worker_->decodeMap(map_msg);
+  if (!new_map)
+  {
+    return;
+  }
+  {
+    const std::lock_guard<std::mutex> lock(mw_mutex_);
+    worker_->setMap(new_map);
+  }
+  // The user callback runs without the lock so it may call getLock() or getWorldModel() and does not hold up the other
+  // world model callbacks
+  worker_->invokeMapCallback();
+}
+
 void WMListener::mapUpdateCallback(const autoware_lanelet2_msgs::MapBinConstPtr& geofence_msg)
 {
   const std::lock_guard<std::mutex> lock(mw_mutex_);
@@ -15,7 +15,8 @@
  */
 
 #include <lanelet2_extension/utility/message_conversion.h>
-#include "WMListenerWorker.h"
+#include <carma_wm/MapSnapshot.h>
+#include <carma_wm/WMListenerWorker.h>
 
 namespace carma_wm
 {
@@ -39,12 +40,54 @@ WorldModelConstPtr WMListenerWorker::getWorldModel() const
 
 void WMListenerWorker::mapCallback(const autoware_lanelet2_msgs::MapBinConstPtr& map_msg)
 {
-  lanelet::LaneletMapPtr new_map(new lanelet::LaneletMap);
+  lanelet::LaneletMapPtr new_map = decodeMap(map_msg);
+  if (new_map)
+  {
+    setMap(new_map);
+    invokeMapCallback();
+  }
+}
+
+lanelet::LaneletMapPtr WMListenerWorker::decodeMap(const autoware_lanelet2_msgs::MapBinConstPtr& map_msg) const
+{
+  lanelet::LaneletMapPtr new_map;
+
+  if (isMapSnapshotAnnouncement(*map_msg))
+  {
+    // The broadcaster wrote the map once to a shared snapshot instead of sending it, decode it from the mapped file
+    std::string path = getMapSnapshotPath(*map_msg);
+    try
+    {
+      MappedMapSnapshot snapshot(path);
+      if (std::to_string(snapshot.getMapVersion()) != map_msg->map_version)
+      {
+        ROS_WARN_STREAM("Map snapshot " << path << " has version " << snapshot.getMapVersion() << " but version "
+                                        << map_msg->map_version << " was announced. Using the snapshot on disk");
+      }
+      new_map = snapshot.decodeMap();
+    }
+    catch (const std::runtime_error& e)
+    {
+      ROS_ERROR_STREAM("Failed to load announced map snapshot: " << e.what());
+      return nullptr;
+    }
+  }
+  else
+  {
+    new_map.reset(new lanelet::LaneletMap);
+    lanelet::utils::conversion::fromBinMsg(*map_msg, new_map);
+  }
 
-  lanelet::utils::conversion::fromBinMsg(*map_msg, new_map);
+  return new_map;
+}
 
-  world_model_->setMap(new_map);
+void WMListenerWorker::setMap(lanelet::LaneletMapPtr map)
+{
+  world_model_->setMap(map);
+}
 
+void WMListenerWorker::invokeMapCallback() const
+{
   // Call user defined map callback
   if (map_callback_)
   {
@@ -55,8 +98,21 @@ void WMListenerWorker::mapUpdateCallback(const autoware_lanelet2_msgs::MapBinCon
 {
   // convert ros msg to geofence object
   auto gf_ptr = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl());
-  carma_wm::fromBinMsg(*geofence_msg, gf_ptr);
+  try
+  {
+    // Compact updates are resolved against this node's map
+    carma_wm::fromBinMsg(*geofence_msg, gf_ptr, world_model_->getMutableMap());
+  }
+  catch (const std::invalid_argument& e)
+  {
+    ROS_ERROR_STREAM("Failed to decode map update: " << e.what());
+    return;
+  }
   ROS_INFO_STREAM("New Map Update Received with Geofence Id:" << gf_ptr->id_);
+  for (const auto& id : gf_ptr->batched_ids_)
+  {
+    ROS_INFO_STREAM("Map Update includes the changes of Geofence Id:" << id);
+  }
 
   ROS_INFO_STREAM("Geofence id" << gf_ptr->id_ << " requests removal of size: " << gf_ptr->remove_list_.size());
   for (auto pair : gf_ptr->remove_list_)
@@ -128,10 +184,10 @@ void WMListenerWorker::newRegemUpdateHelper(lanelet::Lanelet parent_llt, lanelet
   }
 }
 
-void WMListenerWorker::roadwayObjectListCallback(const cav_msgs::RoadwayObstacleList& msg)
+void WMListenerWorker::roadwayObjectListCallback(const cav_msgs::RoadwayObstacleListConstPtr& msg)
 {
   // this topic publishes only the objects that are on the road
-  world_model_->setRoadwayObjects(msg.roadway_obstacles);
+  world_model_->setRoadwayObstacleList(msg);
 }
 
 void WMListenerWorker::routeCallback()
@@ -21,6 +21,7 @@
 #include <lanelet2_traffic_rules/TrafficRulesFactory.h>
 #include <lanelet2_core/Attribute.h>
 #include <tf2/LinearMath/Quaternion.h>
+#include <thread>
 #include "TestHelpers.h"
 #include <lanelet2_extension/regulatory_elements/PassingControlLine.h>
 
@@ -975,4 +976,111 @@ TEST(CARMAWorldModelTest, toRoadwayObstacle)
 
   ASSERT_FALSE(!!result);
 }
+
+TEST(CARMAWorldModelTest, getMapVersion)
+{
+  CARMAWorldModel cmw;
+  ASSERT_EQ(0u, cmw.getMapVersion());
+  ASSERT_EQ(0u, cmw.getRouteVersion());
+  ASSERT_EQ(0u, cmw.getRoadwayObjectsVersion());
+
+  addStraightRoute(cmw);
+  ASSERT_EQ(1u, cmw.getMapVersion());
+  ASSERT_EQ(1u, cmw.getRouteVersion());
+
+  // Setting the same map after an in place update also advances the version
+  cmw.setMap(cmw.getMutableMap());
+  ASSERT_EQ(2u, cmw.getMapVersion());
+  ASSERT_EQ(1u, cmw.getRouteVersion());
+
+  // Each part is versioned independently
+  cmw.setRoadwayObjects({});
+  ASSERT_EQ(1u, cmw.getRoadwayObjectsVersion());
+  ASSERT_EQ(2u, cmw.getMapVersion());
+  ASSERT_EQ(1u, cmw.getRouteVersion());
+}
+
+TEST(CARMAWorldModelTest, concurrentRoadwayObjectsUpdate)
+{
+  CARMAWorldModel cmw;
+  const size_t updates = 2000;
+
+  // Every object in a list carries the list size as its id so a partially updated list can be detected
+  std::thread writer([&cmw, updates]() {
+    for (size_t i = 1; i <= updates; i++)
+    {
+      std::vector<cav_msgs::RoadwayObstacle> objects(i % 50 + 1);
+      for (auto& obj : objects)
+      {
+        obj.object.id = objects.size();
+      }
+      cmw.setRoadwayObjects(objects);
+    }
+  });
+
+  // Failures are recorded rather than asserted so the writer is always joined
+  bool version_decreased = false;
+  bool torn_list = false;
+  size_t last_version = 0;
+  while (last_version < updates)
+  {
+    const size_t version = cmw.getRoadwayObjectsVersion();
+    version_decreased |= version < last_version;
+    last_version = version;
+
+    auto objects = cmw.getRoadwayObjects();
+    for (const auto& obj : objects)
+    {
+      torn_list |= obj.object.id != objects.size();
+    }
+  }
+  writer.join();
+
+  ASSERT_FALSE(version_decreased);
+  ASSERT_FALSE(torn_list);
+
+  ASSERT_EQ(updates, cmw.getRoadwayObjectsVersion());
+  ASSERT_EQ(updates % 50 + 1, cmw.getRoadwayObjects().size());
+}
+
+TEST(CARMAWorldModelTest, getRoadwayObjectsSnapshot)
+{
+  CARMAWorldModel cmw;
+
+  auto empty = cmw.getRoadwayObjectsSnapshot();
+  ASSERT_TRUE(!!empty);
+  ASSERT_TRUE(empty->empty());
+  ASSERT_EQ(0u, empty->version());
+
+  cav_msgs::RoadwayObstacleListPtr msg(new cav_msgs::RoadwayObstacleList);
+  msg->roadway_obstacles.resize(3);
+  msg->roadway_obstacles[1].object.id = 7;
+  cmw.setRoadwayObstacleList(msg);
+
+  // The snapshot shares the received message instead of copying it
+  auto snapshot = cmw.getRoadwayObjectsSnapshot();
+  ASSERT_EQ(msg.get(), snapshot->message().get());
+  ASSERT_EQ(&msg->roadway_obstacles, &snapshot->obstacles());
+  ASSERT_EQ(3u, snapshot->size());
+  ASSERT_EQ(7u, (*snapshot)[1].object.id);
+  ASSERT_EQ(1u, snapshot->version());
+  ASSERT_EQ(1u, cmw.getRoadwayObjectsVersion());
+
+  // The by value interface returns the same objects
+  auto objects = cmw.getRoadwayObjects();
+  ASSERT_EQ(3u, objects.size());
+  ASSERT_EQ(7u, objects[1].object.id);
+
+  // Older snapshots are unaffected by later updates
+  cmw.setRoadwayObjects({});
+  ASSERT_EQ(3u, snapshot->size());
+  ASSERT_EQ(1u, snapshot->version());
+  ASSERT_TRUE(cmw.getRoadwayObjectsSnapshot()->empty());
+  ASSERT_EQ(2u, cmw.getRoadwayObjectsSnapshot()->version());
+
+  // A null message clears the objects
+  cmw.setRoadwayObstacleList(nullptr);
+  ASSERT_TRUE(cmw.getRoadwayObjectsSnapshot()->empty());
+  ASSERT_EQ(3u, cmw.getRoadwayObjectsVersion());
+}
 }  // namespace carma_wm
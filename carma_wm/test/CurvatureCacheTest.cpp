@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gmock/gmock.h>
+#include <carma_wm/CurvatureCache.h>
+#include <cmath>
+#include "TestHelpers.h"
+
+namespace carma_wm
+{
+namespace
+{
+/*!
+ * \brief Builds continuous lanelets turning left along a circle of the provided radius. Each lanelet covers angle
+ *        radians with a bound point every angle / (points - 1) radians
+ */
+std::vector<lanelet::ConstLanelet> getArcLanelets(double radius, size_t count, double angle, size_t points)
+{
+  std::vector<lanelet::Point3d> left, right;
+  const size_t total_points = count * (points - 1) + 1;
+  for (size_t i = 0; i < total_points; i++)
+  {
+    const double theta = i * angle / (points - 1);
+    left.push_back(getPoint((radius - 1.5) * std::cos(theta), (radius - 1.5) * std::sin(theta), 0));
+    right.push_back(getPoint((radius + 1.5) * std::cos(theta), (radius + 1.5) * std::sin(theta), 0));
+  }
+
+  std::vector<lanelet::ConstLanelet> lanelets;
+  for (size_t l = 0; l < count; l++)
+  {
+    const size_t first = l * (points - 1);
+    std::vector<lanelet::Point3d> llt_left(left.begin() + first, left.begin() + first + points);
+    std::vector<lanelet::Point3d> llt_right(right.begin() + first, right.begin() + first + points);
+    lanelets.push_back(lanelet::utils::toConst(getLanelet(llt_left, llt_right)));
+  }
+  return lanelets;
+}
+}  // namespace
+
+TEST(CurvatureCacheTest, getProfile)
+{
+  auto lanelets = getArcLanelets(50.0, 1, 0.5, 11);
+  CurvatureCache cache;
+
+  const LaneletCurvatureProfile& profile = cache.getProfile(lanelets[0], 1);
+  ASSERT_EQ(1u, cache.size());
+  ASSERT_EQ(lanelets[0].centerline().size(), profile.curvatures.size());
+  ASSERT_EQ(profile.curvatures.size(), profile.downtracks.size());
+  ASSERT_NEAR(0.0, profile.downtracks.front(), 0.000001);
+  ASSERT_NEAR(25.0, profile.length, 0.1);
+  ASSERT_NEAR(profile.length, profile.downtracks.back(), 0.000001);
+  for (size_t i = 0; i < profile.curvatures.size(); i++)
+  {
+    ASSERT_NEAR(0.02, profile.curvatures[i], 0.002);
+    if (i > 0)
+    {
+      ASSERT_LT(profile.downtracks[i - 1], profile.downtracks[i]);
+    }
+  }
+
+  // Cached profile is returned until the map version changes
+  ASSERT_EQ(&profile, &cache.getProfile(lanelets[0], 1));
+  ASSERT_EQ(1u, cache.size());
+
+  auto other = getArcLanelets(50.0, 1, 0.5, 11);
+  cache.getProfile(other[0], 2);
+  ASSERT_EQ(1u, cache.size());
+
+  cache.clear();
+  ASSERT_EQ(0u, cache.size());
+
+  ///// Test exception
+  lanelet::Lanelet ll_empty;
+  ASSERT_THROW(cache.getProfile(lanelet::utils::toConst(ll_empty), 2), std::invalid_argument);
+}
+
+TEST(CurvatureCacheTest, window)
+{
+  auto lanelets = getArcLanelets(50.0, 3, 0.5, 11);
+  CurvatureCache cache;
+
+  ///// Whole route visits each centerline point once
+  size_t total_points = 0;
+  double total_length = 0;
+  for (const auto& llt : lanelets)
+  {
+    total_points += llt.centerline().size();
+    total_length += cache.getProfile(llt, 1).length;
+  }
+
+  size_t count = 0;
+  double last_downtrack = -1;
+  for (const auto& point : cache.window(lanelets, 0, total_length, 1))
+  {
+    ASSERT_LT(last_downtrack, point.downtrack);
+    ASSERT_NEAR(0.02, point.curvature, 0.002);
+    last_downtrack = point.downtrack;
+    count++;
+  }
+  ASSERT_EQ(total_points - 2, count);  // Shared points between the lanelets are visited once
+  ASSERT_NEAR(total_length, last_downtrack, 0.000001);
+  ASSERT_EQ(3u, cache.size());
+
+  ///// Window inside the route only visits the points within it
+  auto window = cache.window(lanelets, 21.0, 55.0, 1);
+  auto it = window.begin();
+  ASSERT_NE(window.end(), it);
+  ASSERT_LE(21.0, it->downtrack);
+  ASSERT_GT(23.5, it->downtrack);
+  for (; it != window.end(); it++)
+  {
+    ASSERT_LE(21.0, it->downtrack);
+    ASSERT_GE(55.0, it->downtrack);
+    last_downtrack = it->downtrack;
+  }
+  ASSERT_LT(52.5, last_downtrack);
+
+  ///// Windows outside the route are empty
+  auto before = cache.window(lanelets, -10.0, -5.0, 1);
+  ASSERT_EQ(before.end(), before.begin());
+  auto after = cache.window(lanelets, total_length + 1.0, total_length + 5.0, 1);
+  ASSERT_EQ(after.end(), after.begin());
+
+  std::vector<lanelet::ConstLanelet> no_lanelets;
+  auto empty = cache.window(no_lanelets, 0.0, 10.0, 1);
+  ASSERT_EQ(empty.end(), empty.begin());
+}
+
+TEST(CurvatureCacheTest, smoothing)
+{
+  // Straight lanelet followed by a lanelet turning left
+  auto pl1 = getPoint(-1, 0, 0);
+  auto pl2 = getPoint(-1, 5, 0);
+  auto pl3 = getPoint(-1, 10, 0);
+  auto pl4 = getPoint(-2, 15, 0);
+  auto pl5 = getPoint(-4, 20, 0);
+  auto pr1 = getPoint(1, 0, 0);
+  auto pr2 = getPoint(1, 5, 0);
+  auto pr3 = getPoint(1, 10, 0);
+  auto pr4 = getPoint(0, 15, 0);
+  auto pr5 = getPoint(-2, 20, 0);
+  auto llt = lanelet::utils::toConst(getLanelet({ pl1, pl2, pl3, pl4, pl5 }, { pr1, pr2, pr3, pr4, pr5 }));
+
+  CurvatureCache raw_cache;
+  CurvatureCache smoothed_cache(1);
+  const auto& raw = raw_cache.getProfile(llt, 1);
+  const auto& smoothed = smoothed_cache.getProfile(llt, 1);
+
+  ASSERT_EQ(raw.curvatures.size(), smoothed.curvatures.size());
+  ASSERT_EQ(raw.downtracks, smoothed.downtracks);
+  const size_t last = raw.curvatures.size() - 1;
+  ASSERT_NEAR((raw.curvatures[0] + raw.curvatures[1]) / 2.0, smoothed.curvatures[0], 0.000001);
+  for (size_t i = 1; i < last; i++)
+  {
+    ASSERT_NEAR((raw.curvatures[i - 1] + raw.curvatures[i] + raw.curvatures[i + 1]) / 3.0, smoothed.curvatures[i],
+                0.000001);
+  }
+  ASSERT_NEAR((raw.curvatures[last - 1] + raw.curvatures[last]) / 2.0, smoothed.curvatures[last], 0.000001);
+}
+
+}  // namespace carma_wm
@@ -535,6 +535,66 @@ TEST(GeometryTest, trackPos_line_string)
   ASSERT_EQ(pc, std::get<1>(result).second);
 }
 
+TEST(GeometryTest, trackPos_line_string_arrays)
+{
+  // Zig zag line with a point at each meter of downtrack
+  lanelet::BasicLineString2d ls;
+  std::vector<double> x, y, accumulated_lengths;
+  double length = 10.0;  // Offset the lengths as if the line continued another line
+  for (int i = 0; i < 11; i++)
+  {
+    ls.emplace_back(i % 2 == 0 ? 0.0 : 0.5, i);
+    x.push_back(ls.back()[0]);
+    y.push_back(ls.back()[1]);
+    if (i > 0)
+    {
+      length += (ls[i] - ls[i - 1]).norm();
+    }
+    accumulated_lengths.push_back(length);
+  }
+
+  for (double px = -1.0; px <= 1.5; px += 0.25)
+  {
+    for (double py = -1.5; py <= 11.5; py += 0.25)
+    {
+      auto point = getBasicPoint(px, py);
+      auto expected = geometry::matchSegment(point, ls);
+
+      auto result = geometry::matchSegment(point, x.data(), y.data(), x.size());
+      size_t segment = std::get<1>(result);
+      ASSERT_NEAR(std::get<0>(expected).downtrack, std::get<0>(result).downtrack, 0.000001);
+      ASSERT_NEAR(std::get<0>(expected).crosstrack, std::get<0>(result).crosstrack, 0.000001);
+      ASSERT_EQ(std::get<1>(expected).first, ls[segment]);
+      ASSERT_EQ(std::get<1>(expected).second, ls[segment + 1]);
+
+      // Precomputed lengths give the same match offset by the first length
+      result = geometry::matchSegment(point, x.data(), y.data(), x.size(), accumulated_lengths.data());
+      ASSERT_NEAR(std::get<0>(expected).downtrack + 10.0, std::get<0>(result).downtrack, 0.000001);
+      ASSERT_NEAR(std::get<0>(expected).crosstrack, std::get<0>(result).crosstrack, 0.000001);
+      ASSERT_EQ(segment, std::get<1>(result));
+    }
+  }
+
+  ///// Points equally distant from several line points match the first of them
+  std::vector<double> square_x = { 0, 1, 1, 0, 0 };
+  std::vector<double> square_y = { 0, 0, 1, 1, 0 };
+  auto result = geometry::matchSegment(getBasicPoint(0.5, 0.5), square_x.data(), square_y.data(), square_x.size());
+  ASSERT_EQ(0u, std::get<1>(result));
+  ASSERT_NEAR(0.5, std::get<0>(result).downtrack, 0.000001);
+  ASSERT_NEAR(-0.5, std::get<0>(result).crosstrack, 0.000001);
+
+  ///// Repeated points produce a zero length segment, matched the same as by the line string version
+  std::vector<double> repeated_x = { 0, 0, 0, 0 };
+  std::vector<double> repeated_y = { 0, 1, 1, 2 };
+  result = geometry::matchSegment(getBasicPoint(0.5, 1.5), repeated_x.data(), repeated_y.data(), repeated_x.size());
+  ASSERT_EQ(0u, std::get<1>(result));
+  ASSERT_NEAR(1.5, std::get<0>(result).downtrack, 0.000001);
+  ASSERT_NEAR(0.5, std::get<0>(result).crosstrack, 0.000001);
+
+  ///// Test exception throw on single point
+  ASSERT_THROW(geometry::matchSegment(getBasicPoint(1.0, 2.5), x.data(), y.data(), 1), std::invalid_argument);
+}
+
 TEST(CARMAWorldModelTest, objectToMapPolygon)
 {
   geometry_msgs::Pose pose;
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gmock/gmock.h>
+#include <carma_wm/MapSnapshot.h>
+#include <lanelet2_extension/utility/message_conversion.h>
+#include <carma_wm/WMListenerWorker.h>
+#include <cstdio>
+#include <fstream>
+#include "TestHelpers.h"
+
+namespace carma_wm
+{
+namespace
+{
+lanelet::LaneletMapPtr getSnapshotTestMap()
+{
+  auto pl1 = getPoint(0, 0, 0);
+  auto pl2 = getPoint(0, 1, 0);
+  auto pl3 = getPoint(0, 2, 0);
+  auto pr1 = getPoint(1, 0, 0);
+  auto pr2 = getPoint(1, 1, 0);
+  auto pr3 = getPoint(1, 2, 0);
+  auto ll_1 = getLanelet({ pl1, pl2 }, { pr1, pr2 });
+  auto ll_2 = getLanelet({ pl2, pl3 }, { pr2, pr3 });
+  return lanelet::utils::createMap({ ll_1, ll_2 }, {});
+}
+}  // namespace
+
+TEST(MapSnapshotTest, writeAndMap)
+{
+  auto map = getSnapshotTestMap();
+  autoware_lanelet2_msgs::MapBin msg;
+  lanelet::utils::conversion::toBinMsg(map, &msg);
+
+  const std::string path = "map_snapshot_test.bin";
+  writeMapSnapshot(path, msg.data, 7);
+
+  {
+    MappedMapSnapshot snapshot(path);
+    ASSERT_EQ(7u, snapshot.getMapVersion());
+    ASSERT_EQ(msg.data.size(), snapshot.getPayloadSize());
+
+    auto loaded = snapshot.decodeMap();
+    ASSERT_EQ(2u, loaded->laneletLayer.size());
+    for (auto llt : map->laneletLayer)
+    {
+      ASSERT_NE(loaded->laneletLayer.end(), loaded->laneletLayer.find(llt.id()));
+    }
+  }
+
+  // Rewriting replaces the snapshot in place
+  writeMapSnapshot(path, msg.data, 8);
+  MappedMapSnapshot snapshot(path);
+  ASSERT_EQ(8u, snapshot.getMapVersion());
+
+  std::remove(path.c_str());
+}
+
+TEST(MapSnapshotTest, invalidSnapshot)
+{
+  ASSERT_THROW(MappedMapSnapshot("does_not_exist.bin"), std::runtime_error);
+
+  const std::string path = "map_snapshot_invalid.bin";
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "this is not a snapshot but it is long enough to hold a header";
+  }
+  ASSERT_THROW(MappedMapSnapshot snapshot(path), std::runtime_error);
+
+  // Corrupt the payload of a valid snapshot
+  autoware_lanelet2_msgs::MapBin msg;
+  lanelet::utils::conversion::toBinMsg(getSnapshotTestMap(), &msg);
+  writeMapSnapshot(path, msg.data, 1);
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(sizeof(MapSnapshotHeader) + 10);
+    file.put('x');
+  }
+  ASSERT_THROW(MappedMapSnapshot snapshot(path), std::runtime_error);
+
+  std::remove(path.c_str());
+}
+
+TEST(MapSnapshotTest, announcement)
+{
+  auto msg = makeMapSnapshotAnnouncement("/dev/shm/map.bin", 3);
+  ASSERT_TRUE(isMapSnapshotAnnouncement(msg));
+  ASSERT_EQ("/dev/shm/map.bin", getMapSnapshotPath(msg));
+  ASSERT_EQ("3", msg.map_version);
+
+  autoware_lanelet2_msgs::MapBin full_msg;
+  lanelet::utils::conversion::toBinMsg(getSnapshotTestMap(), &full_msg);
+  ASSERT_FALSE(isMapSnapshotAnnouncement(full_msg));
+}
+
+TEST(MapSnapshotTest, listenerLoadsAnnouncedSnapshot)
+{
+  autoware_lanelet2_msgs::MapBin msg;
+  lanelet::utils::conversion::toBinMsg(getSnapshotTestMap(), &msg);
+
+  const std::string path = "map_snapshot_listener.bin";
+  writeMapSnapshot(path, msg.data, 1);
+
+  WMListenerWorker wmlw;
+  bool flag = false;
+  wmlw.setMapCallback([&flag]() { flag = true; });
+
+  // Missing snapshot leaves the world model untouched
+  autoware_lanelet2_msgs::MapBinConstPtr missing(
+      new autoware_lanelet2_msgs::MapBin(makeMapSnapshotAnnouncement("missing_snapshot.bin", 1)));
+  wmlw.mapCallback(missing);
+  ASSERT_FALSE((bool)(wmlw.getWorldModel()->getMap()));
+  ASSERT_FALSE(flag);
+
+  autoware_lanelet2_msgs::MapBinConstPtr announcement(
+      new autoware_lanelet2_msgs::MapBin(makeMapSnapshotAnnouncement(path, 1)));
+  wmlw.mapCallback(announcement);
+  ASSERT_TRUE((bool)(wmlw.getWorldModel()->getMap()));
+  ASSERT_EQ(2u, wmlw.getWorldModel()->getMap()->laneletLayer.size());
+  ASSERT_TRUE(flag);
+
+  std::remove(path.c_str());
+}
+
+}  // namespace carma_wm
@@ -91,4 +91,94 @@ TEST(TrafficControl, TrafficControlBinMsgTest)
                                                                                     // but again, they are same elements
 }
 
+TEST(TrafficControl, TrafficControlCompactBinMsgTest)
+{
+  using namespace lanelet::units::literals;
+  auto p1 = getPoint(0, 0, 0);
+  auto p2 = getPoint(0, 1, 0);
+  auto p3 = getPoint(1, 1, 0);
+  auto p4 = getPoint(1, 0, 0);
+  auto p5 = getPoint(0, 2, 0);
+  auto p6 = getPoint(1, 2, 0);
+
+  lanelet::LineString3d left_ls_1(lanelet::utils::getId(), { p1, p2 });
+  lanelet::LineString3d right_ls_1(lanelet::utils::getId(), { p4, p3 });
+  lanelet::LineString3d left_ls_2(lanelet::utils::getId(), { p2, p5 });
+  lanelet::LineString3d right_ls_2(lanelet::utils::getId(), { p3, p6 });
+  auto ll_1 = getLanelet(left_ls_1, right_ls_1);
+  auto ll_2 = getLanelet(left_ls_2, right_ls_2);
+
+  lanelet::DigitalSpeedLimitPtr speed_limit_old = std::make_shared<lanelet::DigitalSpeedLimit>(lanelet::DigitalSpeedLimit::buildData(9100, 25_mph, {ll_1, ll_2}, {},
+                                                     { lanelet::Participants::VehicleCar }));
+  lanelet::DigitalSpeedLimitPtr speed_limit_new = std::make_shared<lanelet::DigitalSpeedLimit>(lanelet::DigitalSpeedLimit::buildData(9101, 5_mph, {ll_1, ll_2}, {},
+                                                     { lanelet::Participants::VehicleCar }));
+  lanelet::PassingControlLinePtr pcl = std::make_shared<lanelet::PassingControlLine>(lanelet::PassingControlLine::buildData(
+    9102, { left_ls_1.invert() }, {}, { lanelet::Participants::VehicleCar }));
+  ll_1.addRegulatoryElement(speed_limit_old);
+  ll_2.addRegulatoryElement(speed_limit_old);
+
+  lanelet::LaneletMapPtr map = lanelet::utils::createMap({ ll_1, ll_2 }, {});
+
+  auto gf_ptr = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl());
+  gf_ptr->id_ = boost::uuids::random_generator()();
+  gf_ptr->remove_list_.push_back(std::make_pair(ll_1.id(), speed_limit_old));
+  gf_ptr->remove_list_.push_back(std::make_pair(ll_2.id(), speed_limit_old));
+  gf_ptr->update_list_.push_back(std::make_pair(ll_1.id(), speed_limit_new));
+  gf_ptr->update_list_.push_back(std::make_pair(ll_2.id(), speed_limit_new));
+  gf_ptr->update_list_.push_back(std::make_pair(ll_1.id(), pcl));
+
+  autoware_lanelet2_msgs::MapBin compact_msg;
+  carma_wm::toCompactBinMsg(gf_ptr, &compact_msg);
+  ASSERT_EQ(TRAFFIC_CONTROL_COMPACT_FORMAT, compact_msg.format_version);
+
+  // The compact message does not carry the geometry of the referenced lanelets
+  autoware_lanelet2_msgs::MapBin archive_msg;
+  carma_wm::toBinMsg(gf_ptr, &archive_msg);
+  ASSERT_LT(compact_msg.data.size(), archive_msg.data.size());
+
+  // Decode against the receiver's map
+  auto data_received = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl());
+  carma_wm::fromBinMsg(compact_msg, data_received, map);
+
+  ASSERT_EQ(gf_ptr->id_, data_received->id_);
+  ASSERT_TRUE(data_received->batched_ids_.empty());
+  ASSERT_EQ(2, data_received->remove_list_.size());
+  ASSERT_EQ(3, data_received->update_list_.size());
+  // Known elements resolve to the map's own instance
+  ASSERT_EQ(map->regulatoryElementLayer.get(9100), data_received->remove_list_[0].second);
+  ASSERT_EQ(data_received->remove_list_[0].second, data_received->remove_list_[1].second);
+  ASSERT_EQ(ll_2.id(), data_received->update_list_[1].first);
+
+  auto new_limit = std::dynamic_pointer_cast<lanelet::DigitalSpeedLimit>(data_received->update_list_[0].second);
+  ASSERT_TRUE(!!new_limit);
+  ASSERT_EQ(9101, new_limit->id());
+  ASSERT_NEAR(speed_limit_new->speed_limit_.value(), new_limit->speed_limit_.value(), 0.0001);
+  ASSERT_EQ(data_received->update_list_[0].second, data_received->update_list_[1].second);
+
+  auto new_pcl = std::dynamic_pointer_cast<lanelet::PassingControlLine>(data_received->update_list_[2].second);
+  ASSERT_TRUE(!!new_pcl);
+  ASSERT_EQ(1, new_pcl->controlLine().size());
+  ASSERT_EQ(left_ls_1.id(), new_pcl->controlLine()[0].id());
+  ASSERT_TRUE(new_pcl->controlLine()[0].inverted());
+  ASSERT_EQ(pcl->passableFromRight(lanelet::Participants::VehicleCar), new_pcl->passableFromRight(lanelet::Participants::VehicleCar));
+  ASSERT_EQ(pcl->passableFromLeft(lanelet::Participants::VehicleCar), new_pcl->passableFromLeft(lanelet::Participants::VehicleCar));
+
+  // Without a map the references are placeholders which keep their ids
+  auto data_no_map = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl());
+  carma_wm::fromBinMsg(compact_msg, data_no_map);
+  ASSERT_EQ(3, data_no_map->update_list_.size());
+  ASSERT_EQ(lanelet::DigitalSpeedLimit::RuleName, data_no_map->remove_list_[0].second->attribute(lanelet::AttributeName::Subtype).value());
+  ASSERT_NE(gf_ptr->remove_list_[0].second, data_no_map->remove_list_[0].second);
+  ASSERT_EQ(9100, data_no_map->remove_list_[0].second->id());
+
+  // Unknown primitives and truncated data are rejected
+  lanelet::LaneletMapPtr empty_map(new lanelet::LaneletMap);
+  auto rejected = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl());
+  ASSERT_THROW(carma_wm::fromBinMsg(compact_msg, rejected, empty_map), std::invalid_argument);
+
+  autoware_lanelet2_msgs::MapBin truncated = compact_msg;
+  truncated.data.resize(truncated.data.size() / 2);
+  ASSERT_THROW(carma_wm::fromBinMsg(truncated, rejected), std::invalid_argument);
+}
+
 }  // namespace carma_wm_ctrl
\ No newline at end of file
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <ros/ros.h>
+#include <functional>
+#include <lanelet2_extension/utility/message_conversion.h>
+#include <carma_wm/WMListener.h>
+#include <carma_wm/CARMAWorldModel.h>
+#include <cav_msgs/RoadwayObstacleList.h>
+#include "TestHelpers.h"
+
+namespace carma_wm
+{
+namespace
+{
+// Waits up to timeout seconds for the condition to become true
+bool waitFor(const std::function<bool()>& condition, double timeout)
+{
+  ros::WallTime end = ros::WallTime::now() + ros::WallDuration(timeout);
+  while (!condition())
+  {
+    if (ros::WallTime::now() > end)
+    {
+      return false;
+    }
+    ros::WallDuration(0.01).sleep();
+  }
+  return true;
+}
+}  // namespace
+
+TEST(WMListenerTest, roadwayObjectsNotBlockedByMapLock)
+{
+  WMListener wml(true);
+  WorldModelConstPtr wm = wml.getWorldModel();
+
+  ros::NodeHandle nh;
+  ros::Publisher map_pub = nh.advertise<autoware_lanelet2_msgs::MapBin>("semantic_map", 1, true);
+  ros::Publisher objects_pub = nh.advertise<cav_msgs::RoadwayObstacleList>("roadway_objects", 1, true);
+  ASSERT_TRUE(waitFor([&]() { return map_pub.getNumSubscribers() > 0 && objects_pub.getNumSubscribers() > 0; }, 10.0));
+
+  CARMAWorldModel cwm;
+  addStraightRoute(cwm);
+  autoware_lanelet2_msgs::MapBin map_msg;
+  lanelet::utils::conversion::toBinMsg(lanelet::utils::removeConst(cwm.getMap()), &map_msg);
+
+  cav_msgs::RoadwayObstacleList objects;
+  objects.roadway_obstacles.resize(1);
+  objects.roadway_obstacles[0].object.id = 7;
+
+  size_t objects_version = wm->getRoadwayObjectsVersion();
+  {
+    // Hold the map lock as a planner would. The map callback blocks on it and occupies the map spinner thread
+    std::unique_lock<std::mutex> lock = wml.getLock();
+    map_pub.publish(map_msg);
+    ros::WallDuration(0.5).sleep();
+
+    objects_pub.publish(objects);
+    ASSERT_TRUE(waitFor([&]() { return wm->getRoadwayObjectsVersion() > objects_version; }, 5.0));
+    ASSERT_EQ(1u, wm->getRoadwayObjects().size());
+    EXPECT_EQ(7, wm->getRoadwayObjects()[0].object.id);
+
+    // The map is still waiting for the lock
+    EXPECT_FALSE((bool)wm->getMap());
+  }
+
+  EXPECT_TRUE(waitFor([&]() {
+    std::unique_lock<std::mutex> lock = wml.getLock();
+    return (bool)wm->getMap();
+  }, 5.0));
+}
+
+}  // namespace carma_wm
+
+// Run all the tests
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "wm_listener_test");
+  return RUN_ALL_TESTS();
+}
@@ -17,7 +17,7 @@
 #include <gmock/gmock.h>
 #include <iostream>
 #include <lanelet2_extension/utility/message_conversion.h>
-#include <../src/WMListenerWorker.h>
+#include <carma_wm/WMListenerWorker.h>
 #include <carma_wm/CARMAWorldModel.h>
 #include <lanelet2_core/geometry/LineString.h>
 #include <lanelet2_traffic_rules/TrafficRulesFactory.h>
@@ -78,6 +78,14 @@ TEST(WMListenerWorkerTest, mapCallback)
   wmlw.mapCallback(map_msg_ptr);
 
   ASSERT_TRUE(flag);
+
+  ///// Test setMap leaves the user callback to invokeMapCallback
+  flag = false;
+  wmlw.setMap(map_ptr);
+  ASSERT_FALSE(flag);
+
+  wmlw.invokeMapCallback();
+  ASSERT_TRUE(flag);
 }
 
 TEST(WMListenerWorkerTest, routeCallback)
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <carma_wm_ctrl/WMBroadcaster.h>
+#include <carma_utils/timers/testing/TestTimerFactory.h>
+#include <lanelet2_extension/utility/message_conversion.h>
+#include <lanelet2_core/utility/Utilities.h>
+#include <vector>
+
+namespace carma_wm_ctrl
+{
+namespace
+{
+const char* const MAP_GEOREF = "+proj=tmerc +lat_0=39.46636844371259 +lon_0=-76.16919523566943 +k=1 +x_0=0 +y_0=0 "
+                               "+datum=WGS84 +units=m +vunits=m +no_defs";
+const double LANE_WIDTH = 3.7;
+const double SEGMENT_LENGTH = 25.0;
+const int LANES = 4;
+const int SEGMENTS = 200;
+
+/*!
+ * \brief Builds a map of parallel straight lanes split into fixed length segments which share their bounds
+ */
+lanelet::LaneletMapPtr buildCorridorMap()
+{
+  std::vector<std::vector<lanelet::Point3d>> points(LANES + 1);
+  for (int b = 0; b <= LANES; b++)
+  {
+    for (int s = 0; s <= SEGMENTS; s++)
+    {
+      points[b].emplace_back(lanelet::utils::getId(), b * LANE_WIDTH, s * SEGMENT_LENGTH, 0.0);
+    }
+  }
+
+  lanelet::Lanelets llts;
+  std::vector<lanelet::LineString3d> prev_bounds;
+  for (int b = 0; b <= LANES; b++)
+  {
+    std::vector<lanelet::LineString3d> bounds;
+    for (int s = 0; s < SEGMENTS; s++)
+    {
+      lanelet::LineString3d ls(lanelet::utils::getId(), { points[b][s], points[b][s + 1] });
+      ls.attributes()[lanelet::AttributeName::Type] = lanelet::AttributeValueString::LineThin;
+      ls.attributes()[lanelet::AttributeName::Subtype] = lanelet::AttributeValueString::Dashed;
+      bounds.push_back(ls);
+    }
+    for (size_t s = 0; b > 0 && s < bounds.size(); s++)
+    {
+      lanelet::Lanelet llt(lanelet::utils::getId(), prev_bounds[s], bounds[s]);
+      llt.attributes()[lanelet::AttributeName::Type] = lanelet::AttributeValueString::Lanelet;
+      llt.attributes()[lanelet::AttributeName::Subtype] = lanelet::AttributeValueString::Road;
+      llt.attributes()[lanelet::AttributeName::Location] = lanelet::AttributeValueString::Urban;
+      llt.attributes()[lanelet::AttributeName::OneWay] = "yes";
+      llts.push_back(llt);
+    }
+    prev_bounds = bounds;
+  }
+  return lanelet::utils::createMap(llts, {});
+}
+
+/*!
+ * \brief Builds count speed limit TCMs, each covering two consecutive segments of one lane
+ */
+std::vector<cav_msgs::TrafficControlMessageV01> buildSpeedLimitTCMs(int count)
+{
+  std::vector<cav_msgs::TrafficControlMessageV01> msgs;
+  for (int i = 0; i < count; i++)
+  {
+    cav_msgs::TrafficControlMessageV01 msg;
+    msg.id.id[0] = static_cast<uint8_t>(i & 0xFF);
+    msg.id.id[1] = static_cast<uint8_t>((i >> 8) & 0xFF);
+    msg.geometry.proj = MAP_GEOREF;
+    double x = ((i % LANES) + 0.5) * LANE_WIDTH;
+    double y = ((i / LANES) % (SEGMENTS - 1)) * SEGMENT_LENGTH;
+    cav_msgs::PathNode pt;
+    pt.x = x; pt.y = y + 0.5 * SEGMENT_LENGTH;
+    msg.geometry.nodes.push_back(pt);
+    pt.y = y + 1.5 * SEGMENT_LENGTH;
+    msg.geometry.nodes.push_back(pt);
+    msg.params.detail.choice = cav_msgs::TrafficControlDetail::MAXSPEED_CHOICE;
+    msg.params.detail.maxspeed = 15;
+    msgs.push_back(msg);
+  }
+  return msgs;
+}
+}  // namespace
+
+/*!
+ * \brief Throughput of converting a burst of TCMs into geofences against a loaded map, as happens when the
+ *        broadcaster first connects to a traffic control server
+ */
+static void BM_GeofenceIngest(benchmark::State& state)
+{
+  WMBroadcaster wmb([](const autoware_lanelet2_msgs::MapBin&) {}, [](const autoware_lanelet2_msgs::MapBin&) {},
+                    std::make_unique<carma_utils::timers::testing::TestTimerFactory>());
+
+  autoware_lanelet2_msgs::MapBin map_msg;
+  lanelet::utils::conversion::toBinMsg(buildCorridorMap(), &map_msg);
+  wmb.baseMapCallback(autoware_lanelet2_msgs::MapBinConstPtr(new autoware_lanelet2_msgs::MapBin(map_msg)));
+
+  std_msgs::String georef;
+  georef.data = MAP_GEOREF;
+  wmb.geoReferenceCallback(georef);
+
+  auto msgs = buildSpeedLimitTCMs(state.range(0));
+  for (auto _ : state)
+  {
+    for (const auto& msg : msgs)
+    {
+      auto gf_ptr = wmb.geofenceFromMsg(msg);
+      benchmark::DoNotOptimize(gf_ptr);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * msgs.size());
+}
+BENCHMARK(BM_GeofenceIngest)->Arg(1)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
+
+}  // namespace carma_wm_ctrl
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <carma_wm_ctrl/GeofenceScheduler.h>
+#include <carma_utils/timers/testing/TestTimerFactory.h>
+#include <boost/uuid/uuid_generators.hpp>
+#include <vector>
+
+namespace carma_wm_ctrl
+{
+namespace
+{
+/*!
+ * \brief Builds count geofences active daily between 2 and 3 seconds after midnight of a schedule from 1 to 8 seconds.
+ *        Every geofence shares the same activation tick as happens when a corridor of work zones starts together.
+ */
+std::vector<std::shared_ptr<Geofence>> buildGeofences(int count)
+{
+  std::vector<std::shared_ptr<Geofence>> geofences;
+  geofences.reserve(count);
+  for (int i = 0; i < count; i++)
+  {
+    auto gf_ptr = std::make_shared<Geofence>();
+    gf_ptr->id_ = boost::uuids::random_generator()();
+    gf_ptr->schedules.push_back(GeofenceSchedule(ros::Time(1), ros::Time(8), ros::Duration(2), ros::Duration(1.1),
+                                                 ros::Duration(0), ros::Duration(1), ros::Duration(2)));
+    geofences.push_back(gf_ptr);
+  }
+  return geofences;
+}
+
+std::unique_ptr<GeofenceScheduler> buildScheduler()
+{
+  // The tick timer is kept out of the measurement by giving it a period beyond the simulated time
+  auto scheduler = std::make_unique<GeofenceScheduler>(std::make_unique<carma_utils::timers::testing::TestTimerFactory>(),
+                                                       ros::Duration(1000));
+  scheduler->onGeofenceActive([](std::shared_ptr<Geofence> gf_ptr) { benchmark::DoNotOptimize(gf_ptr); });
+  scheduler->onGeofenceInactive([](std::shared_ptr<Geofence> gf_ptr) { benchmark::DoNotOptimize(gf_ptr); });
+  return scheduler;
+}
+}  // namespace
+
+/*!
+ * \brief Cost of scheduling a burst of geofences
+ */
+static void BM_GeofenceSchedulerAdd(benchmark::State& state)
+{
+  auto geofences = buildGeofences(state.range(0));
+  ros::Time::setNow(ros::Time(0));
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto scheduler = buildScheduler();
+    state.ResumeTiming();
+    for (const auto& gf_ptr : geofences)
+    {
+      scheduler->addGeofence(gf_ptr);
+    }
+    state.PauseTiming();
+    scheduler.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * geofences.size());
+}
+BENCHMARK(BM_GeofenceSchedulerAdd)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+/*!
+ * \brief Cost of activating and then deactivating every scheduled geofence on shared ticks
+ */
+static void BM_GeofenceSchedulerDispatch(benchmark::State& state)
+{
+  auto geofences = buildGeofences(state.range(0));
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    ros::Time::setNow(ros::Time(0));
+    auto scheduler = buildScheduler();
+    for (const auto& gf_ptr : geofences)
+    {
+      scheduler->addGeofence(gf_ptr);
+    }
+    state.ResumeTiming();
+
+    ros::Time::setNow(ros::Time(2.0));
+    scheduler->dispatchDueEvents(ros::Time(2.0));
+    ros::Time::setNow(ros::Time(3.0));
+    scheduler->dispatchDueEvents(ros::Time(3.0));
+
+    state.PauseTiming();
+    scheduler.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * geofences.size() * 2);
+}
+BENCHMARK(BM_GeofenceSchedulerDispatch)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+}  // namespace carma_wm_ctrl
@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <carma_wm_ctrl/MapConformer.h>
+#include "GridMap.h"
+
+namespace carma_wm_ctrl
+{
+/*!
+ * \brief Compliance pass over a 20000 lanelet map with the provided number of inference threads
+ */
+static void BM_EnsureCompliance(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto map = carma_wm::getGridMap(20, 1000);
+    state.ResumeTiming();
+
+    lanelet::MapConformer::ensureCompliance(map, state.range(0));
+    benchmark::DoNotOptimize(map);
+  }
+}
+BENCHMARK(BM_EnsureCompliance)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}  // namespace carma_wm_ctrl
@@ -18,7 +18,8 @@
 #include <ros/time.h>
 #include <mutex>
 #include <memory>
-#include <unordered_map>
+#include <queue>
+#include <vector>
 #include <carma_wm_ctrl/Geofence.h>
 #include <carma_utils/timers/Timer.h>
 #include <carma_utils/timers/TimerFactory.h>
@@ -28,6 +29,10 @@ namespace carma_wm_ctrl
 /**
  * @brief A GeofenceScheduler is responsable for notifying the user when a geofence is active or inactive according to
  * its schedule
+ *
+ * Upcoming activations and deactivations are kept in a min-heap ordered by time and dispatched by a single periodic
+ * tick timer. Every event which is due on a tick is handled in one batch, so thousands of geofences cost a heap entry
+ * each rather than an OS timer each. The activity callbacks are invoked without holding the scheduler lock.
  */
 class GeofenceScheduler
 {
@@ -35,13 +40,30 @@ class GeofenceScheduler
   using TimerFactory = carma_utils::timers::TimerFactory;
   using TimerPtr = std::unique_ptr<Timer>;
 
+  /**
+   * @brief A pending activation or deactivation of one schedule of a geofence
+   */
+  struct ScheduledEvent
+  {
+    ros::Time time;
+    uint64_t sequence;  // Insertion order used to dispatch events due at the same time in FIFO order
+    bool is_start;
+    std::shared_ptr<Geofence> gf_ptr;
+    unsigned int schedule_id;
+
+    bool operator>(const ScheduledEvent& other) const
+    {
+      return time != other.time ? time > other.time : sequence > other.sequence;
+    }
+  };
+
   std::mutex mutex_;
   std::unique_ptr<TimerFactory> timerFactory_;
-  std::unordered_map<uint32_t, std::pair<TimerPtr, bool>> timers_;  // Pairing of timers with their Id and valid status
-  std::unique_ptr<Timer> deletion_timer_;
+  std::priority_queue<ScheduledEvent, std::vector<ScheduledEvent>, std::greater<ScheduledEvent>> events_;
+  uint64_t next_sequence_ = 0;
+  std::unique_ptr<Timer> tick_timer_;
   std::function<void(std::shared_ptr<Geofence>)> active_callback_;
   std::function<void(std::shared_ptr<Geofence>)> inactive_callback_;
-  uint32_t next_id_ = 0;  // Timer id counter
 
 public:
   /**
@@ -49,8 +71,9 @@ public:
    * for goefence activity.
    *
    * @param timerFactory A pointer to a TimerFactory which can be used to generate timers for geofence triggers.
+   * @param tick_period Period at which due geofence events are dispatched. Bounds the activation latency.
    */
-  GeofenceScheduler(std::unique_ptr<TimerFactory> timerFactory);
+  GeofenceScheduler(std::unique_ptr<TimerFactory> timerFactory, ros::Duration tick_period = ros::Duration(0.1));
 
   /**
    * @brief Add a geofence to the scheduler. This will cause it to trigger an event when it becomes active or goes
@@ -74,37 +97,29 @@ public:
   void onGeofenceInactive(std::function<void(std::shared_ptr<Geofence>)> inactive_callback);
 
   /**
-   * @brief Clears the expired timers from the memory of this scheduler
+   * @brief Dispatches every activation and deactivation due at or before now. This is called by the tick timer and
+   *        may also be used to drive the scheduler directly.
+   *
+   * @param now The current time
    */
-  void clearTimers();
+  void dispatchDueEvents(const ros::Time& now);
 
-private:
   /**
-   * @brief Generates the next id to be used for a timer
-   *
-   * @return The next available timer id
+   * @brief Returns the number of activations and deactivations waiting to be dispatched
    */
-  uint32_t nextId();
+  size_t pendingEvents();
 
+private:
   /**
-   * @brief The callback which is triggered when a geofence becomes active
-   *        This will call the user set active_callback set from the onGeofenceActive function
-   *
-   * @param event The record of the timer event causing this to trigger
-   * @param gf The geofence which is being activated
-   * @param schedule_id index number of the schedule being used corresponding to this geofence
-   * @param timer_id The id of the timer which caused this callback to occur
+   * @brief Queues an event. Requires mutex_.
    */
-  void startGeofenceCallback(const ros::TimerEvent& event, std::shared_ptr<Geofence> gf_ptr, const unsigned int schedule_id, const int32_t timer_id);
+  void pushEvent(const ros::Time& time, bool is_start, std::shared_ptr<Geofence> gf_ptr, unsigned int schedule_id);
+
   /**
-   * @brief The callback which is triggered when a geofence becomes in-active
-   *        This will call the user set inactive_callback set from the onGeofenceInactive function
+   * @brief Queues the next activation of the provided schedule if there is one. Requires mutex_.
    *
-   * @param event The record of the timer event causing this to trigger
-   * @param gf The geofence which is being un-activated
-   * @param schedule_id index number of the schedule being used corresponding to this geofence
-   * @param timer_id The id of the timer which caused this callback to occur
+   * @return False if the schedule has no active or upcoming control period
    */
-  void endGeofenceCallback(const ros::TimerEvent& event, std::shared_ptr<Geofence> gf_ptr, const unsigned int schedule_id, const int32_t timer_id);
+  bool scheduleNextStart(const ros::Time& now, std::shared_ptr<Geofence> gf_ptr, unsigned int schedule_id);
 };
-}  // namespace carma_wm_ctrl
\ No newline at end of file
+}  // namespace carma_wm_ctrl
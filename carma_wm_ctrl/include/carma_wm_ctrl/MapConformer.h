@@ -42,8 +42,12 @@ namespace MapConformer
  * CarmaUSTrafficRules supports the existing SpeedLimit definition and allows DigitalSpeedLimits to be overlayed on
  * that.
  *
+ * The regulations of each lanelet are inferred in parallel. The resulting changes are then applied to the map in a
+ * single thread in layer order, so the result does not depend on the number of threads.
+ *
  * @param map A pointer to the map which will be modified in place
+ * @param num_threads Maximum number of threads used for inference. 0 uses the hardware concurrency.
  */
-void ensureCompliance(lanelet::LaneletMapPtr map);
+void ensureCompliance(lanelet::LaneletMapPtr map, size_t num_threads = 0);
 };  // namespace MapConformer
 }  // namespace lanelet
\ No newline at end of file
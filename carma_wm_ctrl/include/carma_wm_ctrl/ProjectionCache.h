@@ -0,0 +1,71 @@
+#pragma once
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <proj.h>
+
+namespace carma_wm_ctrl
+{
+/*!
+ * \brief Cache of PROJ transformations from geofence CRSs into a single target georeference
+ *
+ * PROJ objects may not be shared between threads, so each cache owns its own PROJ context and is meant to be used
+ * by one thread only. Changing the target georeference drops every cached transformation.
+ */
+class ProjectionCache
+{
+public:
+  ProjectionCache();
+
+  ~ProjectionCache();
+
+  ProjectionCache(const ProjectionCache&) = delete;
+  ProjectionCache& operator=(const ProjectionCache&) = delete;
+
+  /*!
+   * \brief Returns the transformation from source_proj to target_proj, creating it on first use
+   *
+   * \throw lanelet::InvalidObjectStateError if the transformation could not be created
+   */
+  PJ* get(const std::string& source_proj, const std::string& target_proj);
+
+  /*!
+   * \brief Transforms the provided x and y arrays in place from source_proj to target_proj
+   *
+   * \throw lanelet::InvalidObjectStateError if the transformation could not be created
+   */
+  void transform(const std::string& source_proj, const std::string& target_proj, double* xs, double* ys, size_t count);
+
+  size_t size() const;
+
+private:
+  struct PJDeleter
+  {
+    void operator()(PJ* pj) const
+    {
+      proj_destroy(pj);
+    }
+  };
+  using PJPtr = std::unique_ptr<PJ, PJDeleter>;
+
+  PJ_CONTEXT* context_;
+  std::string target_proj_;
+  std::unordered_map<std::string, PJPtr> transformations_;
+};
+}  // namespace carma_wm_ctrl
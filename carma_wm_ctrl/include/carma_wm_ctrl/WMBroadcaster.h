@@ -35,6 +35,9 @@
 #include <carma_wm/TrafficControl.h>
 #include <std_msgs/String.h>
 #include <unordered_set>
+#include <condition_variable>
+#include <deque>
+#include <thread>
 
 namespace carma_wm_ctrl
 {
@@ -58,6 +61,11 @@ public:
    */
   WMBroadcaster(const PublishMapCallback& map_pub, const PublishMapUpdateCallback& map_update_pub, std::unique_ptr<carma_utils::timers::TimerFactory> timer_factory);
 
+  /*!
+   * \brief Destructor. Stops the geofence ingest workers
+   */
+  ~WMBroadcaster();
+
   /*!
    * \brief Callback to set the base map when it has been loaded
    *
@@ -76,10 +84,44 @@ public:
   /*!
    * \brief Callback to add a geofence to the map. Currently only supports version 1 TrafficControlMessage
    *
+   * The lanelets containing the geofence points are found against an immutable snapshot of the base map without
+   * holding the map lock. Only the successor filtering over the current map, the construction of the geofence regems
+   * and its scheduling are serialized with map changes. When ingest
+   * workers are enabled the message is queued and this call returns immediately.
+   *
    * \param geofence_msg The ROS msg of the geofence to add. 
    */
   void geofenceCallback(const cav_msgs::TrafficControlMessage& geofence_msg);
 
+  /*!
+   * \brief Sets the number of worker threads which process geofence messages. With 0 (the default) messages are
+   *        processed on the thread calling geofenceCallback. Should be called once before messages are received.
+   */
+  void setIngestThreads(size_t threads);
+
+  /*!
+   * \brief Blocks until every geofence message queued for the ingest workers has been processed
+   */
+  void waitForIngest();
+
+  /*!
+   * \brief Enables batching of map updates. When enabled, geofences which activate or deactivate are applied to the
+   *        map immediately but their updates are only published as a single message by flushMapUpdates
+   */
+  void setMapUpdateBatching(bool enabled);
+
+  /*!
+   * \brief Enables the compact format for map updates, see carma_wm::toCompactBinMsg. Compact updates are smaller but
+   *        every listener must hold all the primitives they refer to, otherwise it drops the update. Disabled by default
+   *        so map updates carry the full archive which any listener can decode.
+   */
+  void setCompactMapUpdates(bool enabled);
+
+  /*!
+   * \brief Publishes the net effect of the map updates accumulated since the last flush, if any
+   */
+  void flushMapUpdates();
+
   /*!
    * \brief Adds a geofence to the current map and publishes the ROS msg
    */
@@ -105,6 +147,14 @@ public:
    */
   void setMaxLaneWidth(double max_lane_width);
 
+  /*!
+   * \brief Sets the path of the map snapshot file. When set, the compliant map is written once to this file and
+   *        only a small announcement message is published, so listeners read the map from the file instead of each
+   *        receiving a copy of it. Each listener still decodes the map. An empty path (the default) publishes the
+   *        full map message.
+   */
+  void setMapSnapshotPath(const std::string& path);
+
   /*!
    * \brief Returns geofence object from TrafficControlMessageV01 ROS Msg
    * \param geofence_msg The ROS msg that contains geofence information
@@ -114,16 +164,85 @@ public:
   std::shared_ptr<Geofence> geofenceFromMsg(const cav_msgs::TrafficControlMessageV01& geofence_msg);
 
 private:
+  /*!
+   * \brief Immutable view of the base map used to find the lanelets affected by geofences without holding the map lock.
+   *        It is replaced, never modified, when the base map or its georeference change.
+   */
+  struct IngestSnapshot
+  {
+    lanelet::LaneletMapConstPtr map;
+    std::string georef;
+  };
+
+  /*!
+   * \brief Lanelets of the snapshot map found for a geofence before the successor filtering, which depends on the
+   *        regems of current_map_ and so is done under the map lock
+   */
+  struct AffectedCandidates
+  {
+    // Lanelets affected by the geofence up to its last point
+    std::unordered_set<lanelet::ConstLanelet> affected;
+    // Lanelets containing the last point, only affected if they follow one of the above
+    std::unordered_set<lanelet::ConstLanelet> last_point;
+  };
+
+  /*!
+   * \brief Returns the current ingest snapshot
+   * \throw InvalidObjectStateError if base_map is not set or the base_map's georeference is empty
+   */
+  std::shared_ptr<const IngestSnapshot> getIngestSnapshot();
+
+  /*!
+   * \brief Finds the lanelets of the snapshot map possibly affected by the geofence. Safe to call without the map lock.
+   */
+  AffectedCandidates findAffectedCandidates(const cav_msgs::TrafficControlMessageV01& tcmV01, const IngestSnapshot& snapshot) const;
+
+  /*!
+   * \brief Returns the lanelets of current_map_ affected by the geofence from the candidates found on the snapshot map.
+   *        Requires map_mutex_.
+   */
+  lanelet::ConstLaneletOrAreas resolveAffectedParts(const AffectedCandidates& candidates);
+
+  /*!
+   * \brief Returns the routing graph of current_map_, rebuilding it if a geofence changed the regems it depends on.
+   *        Requires map_mutex_.
+   */
+  const lanelet::routing::RoutingGraph& getCurrentRoutingGraph();
+
+  /*!
+   * \brief Flags the routing graph for rebuild if the regem changes of gf_ptr can affect lanelet relations.
+   *        Requires map_mutex_.
+   */
+  void markRoutingGraphOutdated(std::shared_ptr<Geofence> gf_ptr);
+
+  /*!
+   * \brief Builds the geofence of msg_v01 over affected parts of current_map_. Requires map_mutex_.
+   */
+  std::shared_ptr<Geofence> buildGeofence(const cav_msgs::TrafficControlMessageV01& msg_v01, const lanelet::ConstLaneletOrAreas& affected_parts) const;
+
+  /*!
+   * \brief Runs the staged ingest of a single geofence message
+   */
+  void ingestGeofence(const cav_msgs::TrafficControlMessageV01& msg_v01);
+
+  void ingestWorker();
+
+  /*!
+   * \brief Publishes or queues the map update produced by gf_ptr. Requires map_mutex_.
+   */
+  void publishMapUpdate(std::shared_ptr<Geofence> gf_ptr);
+
   void addRegulatoryComponent(std::shared_ptr<Geofence> gf_ptr) const;
   void addBackRegulatoryComponent(std::shared_ptr<Geofence> gf_ptr) const;
   void removeGeofenceHelper(std::shared_ptr<Geofence> gf_ptr) const;
   void addGeofenceHelper(std::shared_ptr<Geofence> gf_ptr) const;
   bool shouldChangeControlLine(const lanelet::ConstLaneletOrArea& el,const lanelet::RegulatoryElementConstPtr& regem, std::shared_ptr<Geofence> gf_ptr) const;
   void addPassingControlLineFromMsg(std::shared_ptr<Geofence> gf_ptr, const cav_msgs::TrafficControlMessageV01& msg_v01, const std::vector<lanelet::Lanelet>& affected_llts) const; 
-  std::unordered_set<lanelet::Lanelet> filterSuccessorLanelets(const std::unordered_set<lanelet::Lanelet>& possible_lanelets, const std::unordered_set<lanelet::Lanelet>& root_lanelets);
+  std::unordered_set<lanelet::ConstLanelet> filterSuccessorLanelets(const std::unordered_set<lanelet::ConstLanelet>& possible_lanelets, const std::unordered_set<lanelet::ConstLanelet>& root_lanelets);
   lanelet::LaneletMapPtr base_map_;
   lanelet::LaneletMapPtr current_map_;
   std::unordered_set<std::string>  checked_geofence_ids_;
+  std::mutex checked_geofence_ids_mutex_;
   std::vector<lanelet::LaneletMapPtr> cached_maps_;
   std::mutex map_mutex_;
   PublishMapCallback map_pub_;
@@ -131,6 +250,26 @@ private:
   GeofenceScheduler scheduler_;
   std::string base_map_georef_;
   double max_lane_width_;
+  std::string map_snapshot_path_;
+  std::shared_ptr<const IngestSnapshot> ingest_snapshot_;
+  lanelet::traffic_rules::TrafficRulesUPtr traffic_rules_car_;
+  lanelet::routing::RoutingGraphUPtr current_routing_graph_;
+  bool routing_graph_outdated_ = true;
+  bool batch_map_updates_ = false;
+  bool compact_map_updates_ = false;
+  std::vector<std::shared_ptr<carma_wm::TrafficControl>> pending_map_updates_;
+  // Geofence ingest workers
+  std::vector<std::thread> ingest_threads_;
+  std::deque<cav_msgs::TrafficControlMessageV01> ingest_queue_;
+  size_t ingest_in_flight_ = 0;
+  bool ingest_shutdown_ = false;
+  std::mutex ingest_mutex_;
+  std::condition_variable ingest_cv_;
+  std::condition_variable ingest_idle_cv_;
+  uint64_t map_version_ = 0;
+  // Checksum of the last received base map and its compliant form, used to skip the conformer when it is resent
+  uint64_t base_map_checksum_ = 0;
+  autoware_lanelet2_msgs::MapBin compliant_map_msg_;
 };
 }  // namespace carma_wm_ctrl
 
@@ -18,42 +18,36 @@
 
 namespace carma_wm_ctrl
 {
-using std::placeholders::_1;
-
-GeofenceScheduler::GeofenceScheduler(std::unique_ptr<TimerFactory> timerFactory)
+GeofenceScheduler::GeofenceScheduler(std::unique_ptr<TimerFactory> timerFactory, ros::Duration tick_period)
   : timerFactory_(std::move(timerFactory))
 {
-  // Create repeating loop to clear geofence timers which are no longer needed
-  deletion_timer_ =
-      timerFactory_->buildTimer(nextId(), ros::Duration(1), std::bind(&GeofenceScheduler::clearTimers, this));
+  // Single repeating timer which dispatches every geofence event as it becomes due
+  tick_timer_ =
+      timerFactory_->buildTimer(0, tick_period, [this](const ros::TimerEvent&) { dispatchDueEvents(ros::Time::now()); });
 }
 
-uint32_t GeofenceScheduler::nextId()
+void GeofenceScheduler::pushEvent(const ros::Time& time, bool is_start, std::shared_ptr<Geofence> gf_ptr,
+                                  unsigned int schedule_id)
 {
-  next_id_++;
-  return next_id_;
+  events_.push(ScheduledEvent{ time, next_sequence_++, is_start, gf_ptr, schedule_id });
 }
 
-void GeofenceScheduler::clearTimers()
+bool GeofenceScheduler::scheduleNextStart(const ros::Time& now, std::shared_ptr<Geofence> gf_ptr,
+                                          unsigned int schedule_id)
 {
-  std::lock_guard<std::mutex> guard(mutex_);
-  auto it = timers_.begin();
-
-  // Erase all expired timers_ using iterators to ensure operation is safe
-  while (it != timers_.end())
+  auto interval_info = gf_ptr->schedules[schedule_id].getNextInterval(now);
+  ros::Time startTime = interval_info.second;
+  if (!interval_info.first && startTime == ros::Time(0))
   {
-    // Check if timer is marked for deletion
-    if (it->second.second)
-    {
-      // erase() function returns the iterator of the next
-      // to last deleted element.
-      it = timers_.erase(it);
-    }
-    else
-    {
-      it++;
-    }
+    return false;
   }
+  // If this geofence is currently active set the start time to now
+  if (interval_info.first)
+  {
+    startTime = now;
+  }
+  pushEvent(startTime, true, gf_ptr, schedule_id);
+  return true;
 }
 
 void GeofenceScheduler::addGeofence(std::shared_ptr<Geofence> gf_ptr)
@@ -62,87 +56,66 @@ void GeofenceScheduler::addGeofence(std::shared_ptr<Geofence> gf_ptr)
 
   ROS_INFO_STREAM("Attempting to add Geofence with Id: " << gf_ptr->id_);
 
-  // Create timer for next start time
-  for (auto schedule_idx = 0; schedule_idx < gf_ptr->schedules.size(); schedule_idx++)
+  ros::Time now = ros::Time::now();
+  // Queue the next start time of each schedule
+  for (unsigned int schedule_idx = 0; schedule_idx < gf_ptr->schedules.size(); schedule_idx++)
   {
-    auto interval_info = gf_ptr->schedules[schedule_idx].getNextInterval(ros::Time::now());
-    ros::Time startTime = interval_info.second;
-    if (!interval_info.first && startTime == ros::Time(0))
+    if (!scheduleNextStart(now, gf_ptr, schedule_idx))
     {
       ROS_WARN_STREAM(
           "Failed to add geofence as its schedule did not contain an active or upcoming control period. GF Id: "
           << gf_ptr->id_);
       return;
     }
-    // If this geofence is currently active set the start time to now
-    if (interval_info.first)
-    {
-      startTime = ros::Time::now();
-    }
-
-    int32_t timer_id = nextId();
-
-    // Build timer to trigger when this geofence becomes active
-    TimerPtr timer = timerFactory_->buildTimer(
-        timer_id, startTime - ros::Time::now(),
-        std::bind(&GeofenceScheduler::startGeofenceCallback, this, _1, gf_ptr, schedule_idx, timer_id), true, true);
-
-    timers_[timer_id] = std::make_pair(std::move(timer), false);  // Add start timer to map by Id
   }
 }
 
-void GeofenceScheduler::startGeofenceCallback(const ros::TimerEvent& event, std::shared_ptr<Geofence> gf_ptr, const unsigned int schedule_id, const int32_t timer_id)
-{
-  std::lock_guard<std::mutex> guard(mutex_);
-  ros::Time endTime = ros::Time::now() + gf_ptr->schedules[schedule_id].control_span_;
-
-  ROS_INFO_STREAM("Activating Geofence with Id: " << gf_ptr->id_);
-
-  active_callback_(gf_ptr);
-
-  // Build timer to trigger when this geofence becomes inactive
-  int32_t ending_timer_id = nextId();
-  TimerPtr timer = timerFactory_->buildTimer(
-      ending_timer_id, endTime - ros::Time::now(),
-      std::bind(&GeofenceScheduler::endGeofenceCallback, this, _1, gf_ptr, schedule_id, ending_timer_id), true, true);
-  timers_[ending_timer_id] = std::make_pair(std::move(timer), false);  // Add end timer to map by Id
-
-  timers_[timer_id].second = true;  // Mark start timer for deletion
-}
-
-void GeofenceScheduler::endGeofenceCallback(const ros::TimerEvent& event, std::shared_ptr<Geofence> gf_ptr, const unsigned int schedule_id, const int32_t timer_id)
+void GeofenceScheduler::dispatchDueEvents(const ros::Time& now)
 {
-  std::lock_guard<std::mutex> guard(mutex_);
-
-  ROS_INFO_STREAM("Deactivating Geofence with Id: " << gf_ptr->id_);
-
-  inactive_callback_(gf_ptr);
-  timers_[timer_id].second = true;  // Mark timer for deletion
-
-  // Determine if a new timer is needed for this geofence
-  auto interval_info = gf_ptr->schedules[schedule_id].getNextInterval(ros::Time::now());
-  ros::Time startTime = interval_info.second;
-
-  // If this geofence should currently be active set the start time to now
-  if (interval_info.first)
+  std::vector<ScheduledEvent> due;
+  std::function<void(std::shared_ptr<Geofence>)> active_callback;
+  std::function<void(std::shared_ptr<Geofence>)> inactive_callback;
   {
-    startTime = ros::Time::now();
+    std::lock_guard<std::mutex> guard(mutex_);
+    while (!events_.empty() && events_.top().time <= now)
+    {
+      due.push_back(events_.top());
+      events_.pop();
+    }
+    active_callback = active_callback_;
+    inactive_callback = inactive_callback_;
   }
 
-  if (!interval_info.first && startTime == ros::Time(0))
+  // Callbacks are invoked without the lock so they may add geofences or take their own locks
+  for (const auto& event : due)
   {
-    // No more active periods for this geofence so return
-    return;
-  }
+    if (event.is_start)
+    {
+      ROS_INFO_STREAM("Activating Geofence with Id: " << event.gf_ptr->id_);
+      if (active_callback)
+        active_callback(event.gf_ptr);
 
-  // Build timer to trigger when this geofence becomes active
-  int32_t start_timer_id = nextId();
+      // Queue the deactivation of this control period
+      std::lock_guard<std::mutex> guard(mutex_);
+      pushEvent(now + event.gf_ptr->schedules[event.schedule_id].control_span_, false, event.gf_ptr, event.schedule_id);
+    }
+    else
+    {
+      ROS_INFO_STREAM("Deactivating Geofence with Id: " << event.gf_ptr->id_);
+      if (inactive_callback)
+        inactive_callback(event.gf_ptr);
 
-  TimerPtr timer = timerFactory_->buildTimer(
-      start_timer_id, startTime - ros::Time::now(),
-      std::bind(&GeofenceScheduler::startGeofenceCallback, this, _1, gf_ptr, schedule_id, start_timer_id), true, true);
+      // Queue the next control period of this geofence if there is one
+      std::lock_guard<std::mutex> guard(mutex_);
+      scheduleNextStart(now, event.gf_ptr, event.schedule_id);
+    }
+  }
+}
 
-  timers_[start_timer_id] = std::make_pair(std::move(timer), false);  // Add start timer to map by Id
+size_t GeofenceScheduler::pendingEvents()
+{
+  std::lock_guard<std::mutex> guard(mutex_);
+  return events_.size();
 }
 
 void GeofenceScheduler::onGeofenceActive(std::function<void(std::shared_ptr<Geofence>)> active_callback)
@@ -156,4 +129,4 @@ void GeofenceScheduler::onGeofenceInactive(std::function<void(std::shared_ptr<Ge
   std::lock_guard<std::mutex> guard(mutex_);
   inactive_callback_ = inactive_callback;
 }
-}  // namespace carma_wm_ctrl
\ No newline at end of file
+}  // namespace carma_wm_ctrl
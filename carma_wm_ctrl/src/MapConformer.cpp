@@ -22,6 +22,10 @@
 #include <lanelet2_extension/regulatory_elements/PassingControlLine.h>
 #include <carma_wm_ctrl/MapConformer.h>
 #include <ros/ros.h>
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <unordered_map>
 
 namespace lanelet
 {
@@ -89,6 +93,17 @@ std::vector<lanelet::traffic_rules::TrafficRulesUPtr> getAllGermanTrafficRules()
   return german_traffic_rules_set;
 }
 
+/**
+ * @brief Returns the german traffic rules shared by every compliance pass. The rules are stateless so they are built
+ *        once and may be queried from several threads.
+ */
+const std::vector<lanelet::traffic_rules::TrafficRulesUPtr>& getDefaultTrafficRules()
+{
+  // Use german traffic rules as default as they most closely match the generic traffic rules
+  static const std::vector<lanelet::traffic_rules::TrafficRulesUPtr> default_traffic_rules = getAllGermanTrafficRules();
+  return default_traffic_rules;
+}
+
 /**
  * @brief Helper function to get a value from a map or return a default value when key is not present
  *
@@ -235,39 +250,6 @@ PassingControlLinePtr buildControlLine(LineString3d& bound, const LaneChangeType
   }
 }
 
-/**
- * @brief Generate RegionAccessRules from the inferred regulations in the provided map and lanelet
- *
- * @param lanelet The lanelet to generate the rules for
- * @param map The map which the lanelet is part of
- * @param default_traffic_rules The set of traffic rules to treat as guidance for interpreting the map
- */
-void addInferredAccessRule(Lanelet& lanelet, lanelet::LaneletMapPtr map,
-                           const std::vector<lanelet::traffic_rules::TrafficRulesUPtr>& default_traffic_rules)
-{
-  auto access_rules = lanelet.regulatoryElementsAs<RegionAccessRule>();
-  // If the lanelet does not have an access rule then add one based on the generic traffic rules
-  if (access_rules.size() == 0)
-  {  // No access rule detected so add one
-
-    // We want to check for all participants which are currently supported
-    std::vector<std::string> allowed_participants;
-
-    for (const auto& rules : default_traffic_rules)
-    {
-      if (rules->canPass(lanelet))
-      {
-        allowed_participants.emplace_back(rules->participant());
-      }
-    }
-
-    std::shared_ptr<RegionAccessRule> rar(new RegionAccessRule(
-        RegionAccessRule::buildData(lanelet::utils::getId(), { lanelet }, {}, allowed_participants)));
-    lanelet.addRegulatoryElement(rar);
-    map->add(rar);
-  }
-}
-
 /**
  * @brief Generate RegionAccessRules from the inferred regulations in the provided map and area
  *
@@ -301,82 +283,6 @@ void addInferredAccessRule(Area& area, lanelet::LaneletMapPtr map,
   }
 }
 
-/**
- * @brief Generate PassingControlLines from the inferred regulations in the provided map and lanelet
- *
- * @param lanelet The lanelet to generate control lines for
- * @param map The map which the lanelet is part of
- */
-void addInferredPassingControlLine(Lanelet& lanelet, lanelet::LaneletMapPtr map)
-{
-  // Since this class is only designed to add passing control lines based on lane changes
-  // we will always assume the participant is a vehicle
-  std::string participant(lanelet::Participants::Vehicle);
-
-  LineString3d left_bound = lanelet.leftBound();
-  LineString3d right_bound = lanelet.rightBound();
-
-  // Determine possibility of lane change for left and right bounds
-  LaneChangeType left_type = getChangeType(left_bound.attribute(AttributeName::Type).value(),
-                                           left_bound.attribute(AttributeName::Subtype).value(), participant);
-  LaneChangeType right_type = getChangeType(right_bound.attribute(AttributeName::Type).value(),
-                                            right_bound.attribute(AttributeName::Subtype).value(), participant);
-
-  auto local_control_lines = lanelet.regulatoryElementsAs<PassingControlLine>();
-
-  bool foundLeft = false;
-  bool foundRight = false;
-
-  // Iterate over all regulatory elements in the map to determine if there is an existing regulation for this
-  // lanelet's bounds
-  for (auto reg_elem : map->regulatoryElementLayer)
-  {
-    if (reg_elem->attribute(AttributeName::Subtype).value() != PassingControlLine::RuleName)
-    {
-      continue;
-    }
-
-    auto pcl = std::static_pointer_cast<PassingControlLine>(reg_elem);
-    for (auto sub_line : pcl->controlLine())
-    {
-      bool shouldAdd = false;
-      
-      if (left_bound.id() == sub_line.id() && !foundLeft)
-      {
-        foundLeft = true;
-        shouldAdd = !lanelet::utils::contains(local_control_lines, pcl);
-      }
-      else if (right_bound.id() == sub_line.id() && !foundRight)
-      {
-        foundRight = true;
-        shouldAdd = !lanelet::utils::contains(local_control_lines, pcl);
-      }
-      // Check if our lanelet contains this control line
-      // If it does not then add it
-      if (shouldAdd)
-      {
-        lanelet.addRegulatoryElement(pcl);
-      }
-    }
-    
-  }
-
-  // If no existing regulation was found for this lanelet's right or left bound then create a new one and add it to
-  // the lanelet and the map
-  if (!foundLeft)
-  {
-    PassingControlLinePtr pcl_left = buildControlLine(left_bound, left_type, participant);
-    lanelet.addRegulatoryElement(pcl_left);
-    map->add(pcl_left);
-  }
-  if (!foundRight)
-  {
-    PassingControlLinePtr pcl_right = buildControlLine(right_bound, right_type, participant);
-    lanelet.addRegulatoryElement(pcl_right);
-    map->add(pcl_right);
-  }
-}
-
 /**
  * @brief Generate PassingControlLines from the inferred regulations in the provided map and area
  *
@@ -441,55 +347,180 @@ void addInferredPassingControlLine(Area& area, lanelet::LaneletMapPtr map)
   }
 }
 
+// Minimum number of lanelets given to a thread. Smaller maps are not worth the cost of starting threads.
+constexpr size_t MIN_LANELETS_PER_THREAD = 512;
+
 /**
- * @brief Generate DirectionOfTravel from the inferred regulations in the provided map and lanelet
- *        Only adds a regulatory element if the direction of travel is not one_way as that is the default
- *
- * @param lanelet The lanelet to generate directions of travel for
- * @param map The map which the lanelet is part of
- * @param default_traffic_rules The set of traffic rules to treat as guidance for interpreting the map
+ * @brief Regulations inferred for a single lanelet, computed without modifying the map
  */
-void addInferredDirectionOfTravel(Lanelet& lanelet, lanelet::LaneletMapPtr map,
-                                  const std::vector<lanelet::traffic_rules::TrafficRulesUPtr>& default_traffic_rules)
+struct LaneletInference
 {
-  auto direction_of_travel = lanelet.regulatoryElementsAs<DirectionOfTravel>();
-  // If the lanelet does not have an access rule then add one based on the generic traffic rules
-  if (direction_of_travel.size() == 0)
-  {  // No direction detected so need to check if one is required
+  bool add_access_rule = false;
+  std::vector<std::string> access_participants;
+  LaneChangeType left_type = LaneChangeType::None;
+  LaneChangeType right_type = LaneChangeType::None;
+  bool add_direction_of_travel = false;
+  std::vector<std::string> bidirectional_participants;
+};
 
-    // We want to check for all participants which are currently supported
-    std::vector<std::string> allowed_participants;
+/**
+ * @brief Infers the regulations implied by the lanelet's markings and attributes. Only reads the lanelet so it may run
+ *        concurrently for different lanelets of the same map.
+ *        Only bi-directional travel is recorded as one way is the default.
+ */
+LaneletInference inferLaneletRegulations(const Lanelet& lanelet,
+                                         const std::vector<lanelet::traffic_rules::TrafficRulesUPtr>& default_traffic_rules)
+{
+  LaneletInference inference;
+
+  if (lanelet.regulatoryElementsAs<RegionAccessRule>().empty())
+  {
+    inference.add_access_rule = true;
+    for (const auto& rules : default_traffic_rules)
+    {
+      if (rules->canPass(lanelet))
+      {
+        inference.access_participants.emplace_back(rules->participant());
+      }
+    }
+  }
 
+  std::string participant(lanelet::Participants::Vehicle);
+  ConstLineString3d left_bound = lanelet.leftBound();
+  ConstLineString3d right_bound = lanelet.rightBound();
+  inference.left_type = getChangeType(left_bound.attribute(AttributeName::Type).value(),
+                                      left_bound.attribute(AttributeName::Subtype).value(), participant);
+  inference.right_type = getChangeType(right_bound.attribute(AttributeName::Type).value(),
+                                       right_bound.attribute(AttributeName::Subtype).value(), participant);
+
+  if (lanelet.regulatoryElementsAs<DirectionOfTravel>().empty())
+  {
     for (const auto& rules : default_traffic_rules)
     {
       if (!rules->isOneWay(lanelet))
-      {  // Check if this lanelet is not oneway
-        allowed_participants.emplace_back(rules->participant());
+      {
+        inference.bidirectional_participants.emplace_back(rules->participant());
       }
     }
+    inference.add_direction_of_travel = !inference.bidirectional_participants.empty();
+  }
 
-    if (allowed_participants.size() > 0)
-    {  // Only add bi-directional regulations
-      std::shared_ptr<DirectionOfTravel> rar(new DirectionOfTravel(DirectionOfTravel::buildData(
-          lanelet::utils::getId(), { lanelet }, DirectionOfTravel::BiDirectional, allowed_participants)));
-      lanelet.addRegulatoryElement(rar);
-      map->add(rar);
+  return inference;
+}
+
+/**
+ * @brief Runs inferLaneletRegulations over all lanelets, splitting them between up to num_threads threads
+ */
+std::vector<LaneletInference> inferAllLaneletRegulations(const std::vector<Lanelet>& lanelets, size_t num_threads)
+{
+  const auto& default_traffic_rules = getDefaultTrafficRules();
+  std::vector<LaneletInference> inferences(lanelets.size());
+
+  auto infer_range = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++)
+    {
+      inferences[i] = inferLaneletRegulations(lanelets[i], default_traffic_rules);
     }
+  };
+
+  if (num_threads == 0)
+  {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  num_threads = std::max<size_t>(1, std::min(num_threads, lanelets.size() / MIN_LANELETS_PER_THREAD));
+
+  // Each worker writes a disjoint range of the results. Futures propagate any exception to this thread.
+  std::vector<std::future<void>> workers;
+  size_t chunk = (lanelets.size() + num_threads - 1) / num_threads;
+  for (size_t begin = chunk; begin < lanelets.size(); begin += chunk)
+  {
+    workers.push_back(std::async(std::launch::async, infer_range, begin, std::min(begin + chunk, lanelets.size())));
+  }
+  infer_range(0, std::min(chunk, lanelets.size()));
+  for (auto& worker : workers)
+  {
+    worker.get();
   }
+
+  return inferences;
+}
+
+/**
+ * @brief Adds the passing control line covering bound to the lanelet, creating it if no control line covers the
+ *        bound yet
+ *
+ * @param control_lines Index of the first control line of the map covering each line string id
+ */
+void commitPassingControlLine(Lanelet& lanelet, LineString3d bound, LaneChangeType type, lanelet::LaneletMapPtr map,
+                              std::unordered_map<Id, PassingControlLinePtr>& control_lines)
+{
+  auto existing = control_lines.find(bound.id());
+  if (existing != control_lines.end())
+  {
+    if (!lanelet::utils::contains(lanelet.regulatoryElementsAs<PassingControlLine>(), existing->second))
+    {
+      lanelet.addRegulatoryElement(existing->second);
+    }
+    return;
+  }
+
+  PassingControlLinePtr pcl = buildControlLine(bound, type, lanelet::Participants::Vehicle);
+  lanelet.addRegulatoryElement(pcl);
+  map->add(pcl);
+  control_lines.emplace(bound.id(), pcl);
 }
 
 }  // namespace
 
-void ensureCompliance(lanelet::LaneletMapPtr map)
+void ensureCompliance(lanelet::LaneletMapPtr map, size_t num_threads)
 {
-  auto default_traffic_rules = getAllGermanTrafficRules();  // Use german traffic rules as default as they most closely
-                                                            // match the generic traffic rules
-  // Handle lanelets
-  for (auto lanelet : map->laneletLayer)
+  const auto& default_traffic_rules = getDefaultTrafficRules();
+
+  // Inference only reads the map so it runs for all lanelets in parallel
+  std::vector<Lanelet> lanelets(map->laneletLayer.begin(), map->laneletLayer.end());
+  std::vector<LaneletInference> inferences = inferAllLaneletRegulations(lanelets, num_threads);
+
+  // Index the existing passing control lines by the line strings they cover instead of searching the regulatory
+  // element layer for every lanelet
+  std::unordered_map<Id, PassingControlLinePtr> control_lines;
+  for (auto reg_elem : map->regulatoryElementLayer)
   {
-    addInferredAccessRule(lanelet, map, default_traffic_rules);
-    addInferredPassingControlLine(lanelet, map);
-    addInferredDirectionOfTravel(lanelet, map, default_traffic_rules);
+    if (reg_elem->attribute(AttributeName::Subtype).value() != PassingControlLine::RuleName)
+    {
+      continue;
+    }
+    auto pcl = std::static_pointer_cast<PassingControlLine>(reg_elem);
+    for (auto sub_line : pcl->controlLine())
+    {
+      control_lines.emplace(sub_line.id(), pcl);
+    }
+  }
+
+  // Changes are committed serially in layer order so new regulatory elements get the same ids on every run and
+  // neighbouring lanelets share the control line of their common bound
+  for (size_t i = 0; i < lanelets.size(); i++)
+  {
+    Lanelet& lanelet = lanelets[i];
+    const LaneletInference& inference = inferences[i];
+
+    if (inference.add_access_rule)
+    {
+      std::shared_ptr<RegionAccessRule> rar(new RegionAccessRule(
+          RegionAccessRule::buildData(lanelet::utils::getId(), { lanelet }, {}, inference.access_participants)));
+      lanelet.addRegulatoryElement(rar);
+      map->add(rar);
+    }
+
+    commitPassingControlLine(lanelet, lanelet.leftBound(), inference.left_type, map, control_lines);
+    commitPassingControlLine(lanelet, lanelet.rightBound(), inference.right_type, map, control_lines);
+
+    if (inference.add_direction_of_travel)
+    {
+      std::shared_ptr<DirectionOfTravel> dot(new DirectionOfTravel(DirectionOfTravel::buildData(
+          lanelet::utils::getId(), { lanelet }, DirectionOfTravel::BiDirectional, inference.bidirectional_participants)));
+      lanelet.addRegulatoryElement(dot);
+      map->add(dot);
+    }
   }
 
   // Handle areas
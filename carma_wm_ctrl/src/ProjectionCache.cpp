@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <carma_wm_ctrl/ProjectionCache.h>
+#include <lanelet2_core/Exceptions.h>
+
+namespace carma_wm_ctrl
+{
+ProjectionCache::ProjectionCache() : context_(proj_context_create())
+{
+}
+
+ProjectionCache::~ProjectionCache()
+{
+  transformations_.clear();  // Transformations must be released before their context
+  proj_context_destroy(context_);
+}
+
+PJ* ProjectionCache::get(const std::string& source_proj, const std::string& target_proj)
+{
+  if (target_proj != target_proj_)
+  {
+    transformations_.clear();
+    target_proj_ = target_proj;
+  }
+
+  auto it = transformations_.find(source_proj);
+  if (it != transformations_.end())
+  {
+    return it->second.get();
+  }
+
+  PJ* pj = proj_create_crs_to_crs(context_, source_proj.c_str(), target_proj.c_str(), NULL);
+  if (pj == nullptr)
+  {
+    throw lanelet::InvalidObjectStateError(std::string("Failed to create transformation from geofence projection ") +
+                                           source_proj + " to the map georeference");
+  }
+  transformations_.emplace(source_proj, PJPtr(pj));
+  return pj;
+}
+
+void ProjectionCache::transform(const std::string& source_proj, const std::string& target_proj, double* xs, double* ys,
+                                size_t count)
+{
+  PJ* pj = get(source_proj, target_proj);
+  // z is not currently used
+  proj_trans_generic(pj, PJ_FWD, xs, sizeof(double), count, ys, sizeof(double), count, nullptr, 0, 0, nullptr, 0, 0);
+}
+
+size_t ProjectionCache::size() const
+{
+  return transformations_.size();
+}
+
+}  // namespace carma_wm_ctrl
@@ -31,12 +31,98 @@
 #include <lanelet2_extension/utility/utilities.h>
 #include <algorithm>
 #include <carma_wm/Geometry.h>
+#include <carma_wm/MapSnapshot.h>
+#include <carma_wm_ctrl/ProjectionCache.h>
+#include <map>
 #include <math.h>
 
 namespace carma_wm_ctrl
 {
 using std::placeholders::_1;
 
+namespace
+{
+// The compact format spares listeners the full object graph of each regulatory element, but a listener whose map lacks
+// one of the referenced primitives cannot decode it. The full archive is self contained so it stays the default.
+void toMapUpdateMsg(std::shared_ptr<carma_wm::TrafficControl> send_data, autoware_lanelet2_msgs::MapBin* msg,
+                    bool compact)
+{
+  if (!compact)
+  {
+    carma_wm::toBinMsg(send_data, msg);
+    return;
+  }
+  try
+  {
+    carma_wm::toCompactBinMsg(send_data, msg);
+  }
+  catch (const std::invalid_argument& e)
+  {
+    ROS_ERROR_STREAM("Failed to encode compact map update, falling back to the full archive: " << e.what());
+    *msg = autoware_lanelet2_msgs::MapBin();
+    carma_wm::toBinMsg(send_data, msg);
+  }
+}
+
+/*!
+ * \brief Combines consecutive map updates into one with the same net effect. Listeners apply the removals of an update
+ *        before its additions, so each lanelet/regem pair only keeps its change if it is not reverted within the batch.
+ *        The merged update carries the id of every geofence involved, its id_ is the one of the first.
+ */
+std::shared_ptr<carma_wm::TrafficControl> mergeMapUpdates(const std::vector<std::shared_ptr<carma_wm::TrafficControl>>& updates)
+{
+  struct PairChange
+  {
+    bool first_is_update;
+    bool last_is_update;
+    lanelet::RegulatoryElementPtr regem;
+  };
+  std::map<std::pair<lanelet::Id, lanelet::Id>, PairChange> changes;
+  std::vector<std::pair<lanelet::Id, lanelet::Id>> order;  // Order in which the pairs were first changed
+  auto record = [&](const std::pair<lanelet::Id, lanelet::RegulatoryElementPtr>& pair, bool is_update) {
+    auto key = std::make_pair(pair.first, pair.second->id());
+    auto it = changes.find(key);
+    if (it == changes.end())
+    {
+      changes.emplace(key, PairChange{ is_update, is_update, pair.second });
+      order.push_back(key);
+    }
+    else
+    {
+      it->second.last_is_update = is_update;
+      it->second.regem = pair.second;
+    }
+  };
+
+  for (const auto& update : updates)
+  {
+    for (const auto& pair : update->remove_list_) record(pair, false);
+    for (const auto& pair : update->update_list_) record(pair, true);
+  }
+
+  auto merged = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl(updates.front()->id_, {}, {}));
+  for (const auto& update : updates)
+  {
+    if (std::find(merged->batched_ids_.begin(), merged->batched_ids_.end(), update->id_) == merged->batched_ids_.end())
+      merged->batched_ids_.push_back(update->id_);
+  }
+  if (merged->batched_ids_.size() == 1)
+    merged->batched_ids_.clear();  // Updates of a single geofence are sent as such
+  for (const auto& key : order)
+  {
+    const PairChange& change = changes.at(key);
+    // A pair removed then added again, or added then removed again, ends up as it started
+    if (change.first_is_update != change.last_is_update)
+      continue;
+    if (change.last_is_update)
+      merged->update_list_.emplace_back(key.first, change.regem);
+    else
+      merged->remove_list_.emplace_back(key.first, change.regem);
+  }
+  return merged;
+}
+}  // namespace
+
 
 WMBroadcaster::WMBroadcaster(const PublishMapCallback& map_pub, const PublishMapUpdateCallback& map_update_pub, std::unique_ptr<carma_utils::timers::TimerFactory> timer_factory)
   : map_pub_(map_pub), map_update_pub_(map_update_pub), scheduler_(std::move(timer_factory))
@@ -45,6 +131,19 @@ WMBroadcaster::WMBroadcaster(const PublishMapCallback& map_pub, const PublishMap
   scheduler_.onGeofenceInactive(std::bind(&WMBroadcaster::removeGeofence, this, _1));
 };
 
+WMBroadcaster::~WMBroadcaster()
+{
+  {
+    std::lock_guard<std::mutex> guard(ingest_mutex_);
+    ingest_shutdown_ = true;
+  }
+  ingest_cv_.notify_all();
+  for (auto& t : ingest_threads_)
+  {
+    t.join();
+  }
+}
+
 void WMBroadcaster::baseMapCallback(const autoware_lanelet2_msgs::MapBinConstPtr& map_msg)
 {
   std::lock_guard<std::mutex> guard(map_mutex_);
@@ -61,32 +160,82 @@ void WMBroadcaster::baseMapCallback(const autoware_lanelet2_msgs::MapBinConstPtr
     ROS_WARN("WMBroadcaster::baseMapCallback called multiple times in the same node");
   }
 
-  lanelet::LaneletMapPtr new_map(new lanelet::LaneletMap);
-  lanelet::LaneletMapPtr new_map_to_change(new lanelet::LaneletMap);
+  uint64_t checksum = carma_wm::mapPayloadChecksum(reinterpret_cast<const char*>(map_msg->data.data()),
+                                                    map_msg->data.size());
+  if (base_map_ && checksum == base_map_checksum_)
+  {
+    // The same map was received again. base_map_ is already compliant so only the broadcaster's copy is reset.
+    ROS_INFO("WMBroadcaster::baseMapCallback received an unchanged map, skipping compliance checks");
+  }
+  else
+  {
+    lanelet::LaneletMapPtr new_map(new lanelet::LaneletMap);
+    lanelet::utils::conversion::fromBinMsg(*map_msg, new_map);
+
+    base_map_ = new_map;  // Store map
+    lanelet::MapConformer::ensureCompliance(base_map_);     // Update map to ensure it complies with expectations
+
+    lanelet::utils::conversion::toBinMsg(base_map_, &compliant_map_msg_);
+    base_map_checksum_ = checksum;
 
-  lanelet::utils::conversion::fromBinMsg(*map_msg, new_map);
-  lanelet::utils::conversion::fromBinMsg(*map_msg, new_map_to_change);
+    // base_map_ is never modified past this point and shares its ids with current_map_ so the geometric lookups of
+    // geofence points can run against it without the lock
+    auto snapshot = std::make_shared<IngestSnapshot>();
+    snapshot->map = base_map_;
+    snapshot->georef = base_map_georef_;
+    ingest_snapshot_ = snapshot;
+  }
+
+  // The broadcaster makes changes to its own copy which is decoded from the compliant map so that it
+  // shares the ids of any elements added by the conformer with the published map
+  current_map_.reset(new lanelet::LaneletMap);
+  lanelet::utils::conversion::fromBinMsg(compliant_map_msg_, current_map_);
+  routing_graph_outdated_ = true;
 
-  base_map_ = new_map;  // Store map
-  current_map_ = new_map_to_change; // broadcaster makes changes to this
+  map_version_++;
 
-  lanelet::MapConformer::ensureCompliance(base_map_);     // Update map to ensure it complies with expectations
-  lanelet::MapConformer::ensureCompliance(current_map_);
+  if (!map_snapshot_path_.empty())
+  {
+    try
+    {
+      // Write the map once and only announce its location to listeners
+      carma_wm::writeMapSnapshot(map_snapshot_path_, compliant_map_msg_.data, map_version_);
+      map_pub_(carma_wm::makeMapSnapshotAnnouncement(map_snapshot_path_, map_version_));
+      return;
+    }
+    catch (const std::runtime_error& e)
+    {
+      ROS_ERROR_STREAM("Failed to write map snapshot, publishing the full map instead: " << e.what());
+    }
+  }
 
   // Publish map
-  autoware_lanelet2_msgs::MapBin compliant_map_msg;
-  lanelet::utils::conversion::toBinMsg(base_map_, &compliant_map_msg);
-  map_pub_(compliant_map_msg);
+  map_pub_(compliant_map_msg_);
 };
 
+void WMBroadcaster::setMapSnapshotPath(const std::string& path)
+{
+  std::lock_guard<std::mutex> guard(map_mutex_);
+  map_snapshot_path_ = path;
+}
+
 std::shared_ptr<Geofence> WMBroadcaster::geofenceFromMsg(const cav_msgs::TrafficControlMessageV01& msg_v01)
+{
+  // Get affected lanelet or areas by converting the georeference and querying the map using points in the geofence
+  auto affected_parts = getAffectedLaneletOrAreas(msg_v01);
+
+  std::lock_guard<std::mutex> guard(map_mutex_);
+  return buildGeofence(msg_v01, affected_parts);
+}
+
+std::shared_ptr<Geofence> WMBroadcaster::buildGeofence(const cav_msgs::TrafficControlMessageV01& msg_v01,
+                                                       const lanelet::ConstLaneletOrAreas& affected_parts) const
 {
   auto gf_ptr = std::make_shared<Geofence>(Geofence());
   // Get ID
   std::copy(msg_v01.id.id.begin(), msg_v01.id.id.end(), gf_ptr->id_.begin());
 
-  // Get affected lanelet or areas by converting the georeference and querying the map using points in the geofence
-  gf_ptr->affected_parts_ = getAffectedLaneletOrAreas(msg_v01);
+  gf_ptr->affected_parts_ = affected_parts;
 
   std::vector<lanelet::Lanelet> affected_llts;
   std::vector<lanelet::Area> affected_areas;
@@ -222,32 +371,130 @@ void WMBroadcaster::addPassingControlLineFromMsg(std::shared_ptr<Geofence> gf_pt
 // currently only supports geofence message version 1: TrafficControlMessageV01 
 void WMBroadcaster::geofenceCallback(const cav_msgs::TrafficControlMessage& geofence_msg)
 {
-  std::lock_guard<std::mutex> guard(map_mutex_);
   // quickly check if the id has been added
   if (geofence_msg.choice != cav_msgs::TrafficControlMessage::TCMV01)
     return;
 
   boost::uuids::uuid id;
   std::copy(geofence_msg.tcmV01.id.id.begin(), geofence_msg.tcmV01.id.id.end(), id.begin());
-  if (checked_geofence_ids_.find(boost::uuids::to_string(id)) != checked_geofence_ids_.end())
-    return;
-  
-  checked_geofence_ids_.insert(boost::uuids::to_string(id));
-  auto gf_ptr = geofenceFromMsg(geofence_msg.tcmV01);
-  if (gf_ptr->affected_parts_.size() == 0)
   {
-    ROS_WARN_STREAM("There is no applicable component in map for the new geofence message received by WMBroadcaster with id: " << gf_ptr->id_);
-    return;
+    std::lock_guard<std::mutex> guard(checked_geofence_ids_mutex_);
+    if (!checked_geofence_ids_.insert(boost::uuids::to_string(id)).second)
+      return;
   }
-  scheduler_.addGeofence(gf_ptr);  // Add the geofence to the scheduler
-  ROS_INFO_STREAM("New geofence message received by WMBroadcaster with id: " << gf_ptr->id_);
-  
+
+  {
+    std::lock_guard<std::mutex> guard(ingest_mutex_);
+    if (!ingest_threads_.empty())
+    {
+      ingest_queue_.push_back(geofence_msg.tcmV01);
+      ingest_in_flight_++;
+      ingest_cv_.notify_one();
+      return;
+    }
+  }
+  ingestGeofence(geofence_msg.tcmV01);
 };
 
+void WMBroadcaster::ingestGeofence(const cav_msgs::TrafficControlMessageV01& msg_v01)
+{
+  while (true)
+  {
+    // Projection and lookup of the lanelets containing the geofence points run against the snapshot without holding
+    // the map lock
+    auto snapshot = getIngestSnapshot();
+    AffectedCandidates candidates = findAffectedCandidates(msg_v01, *snapshot);
+
+    // Successor filtering and the construction of the regems over current_map_ are serialized with map changes
+    std::lock_guard<std::mutex> guard(map_mutex_);
+    if (snapshot != ingest_snapshot_)
+    {
+      continue;  // The base map or its georeference changed while the geofence was processed
+    }
+    lanelet::ConstLaneletOrAreas affected_parts = resolveAffectedParts(candidates);
+    if (affected_parts.empty())
+    {
+      boost::uuids::uuid id;
+      std::copy(msg_v01.id.id.begin(), msg_v01.id.id.end(), id.begin());
+      ROS_WARN_STREAM("There is no applicable component in map for the new geofence message received by WMBroadcaster with id: " << id);
+      return;
+    }
+    auto gf_ptr = buildGeofence(msg_v01, affected_parts);
+    scheduler_.addGeofence(gf_ptr);  // Add the geofence to the scheduler
+    ROS_INFO_STREAM("New geofence message received by WMBroadcaster with id: " << gf_ptr->id_);
+    return;
+  }
+}
+
+void WMBroadcaster::ingestWorker()
+{
+  while (true)
+  {
+    cav_msgs::TrafficControlMessageV01 msg_v01;
+    {
+      std::unique_lock<std::mutex> lock(ingest_mutex_);
+      ingest_cv_.wait(lock, [this]() { return ingest_shutdown_ || !ingest_queue_.empty(); });
+      if (ingest_shutdown_)
+        return;
+      msg_v01 = std::move(ingest_queue_.front());
+      ingest_queue_.pop_front();
+    }
+
+    try
+    {
+      ingestGeofence(msg_v01);
+    }
+    catch (const std::exception& e)
+    {
+      ROS_ERROR_STREAM("WMBroadcaster failed to process geofence message: " << e.what());
+    }
+
+    std::lock_guard<std::mutex> guard(ingest_mutex_);
+    if (--ingest_in_flight_ == 0)
+    {
+      ingest_idle_cv_.notify_all();
+    }
+  }
+}
+
+void WMBroadcaster::setIngestThreads(size_t threads)
+{
+  std::lock_guard<std::mutex> guard(ingest_mutex_);
+  for (size_t i = ingest_threads_.size(); i < threads; i++)
+  {
+    ingest_threads_.emplace_back(&WMBroadcaster::ingestWorker, this);
+  }
+}
+
+void WMBroadcaster::waitForIngest()
+{
+  std::unique_lock<std::mutex> lock(ingest_mutex_);
+  ingest_idle_cv_.wait(lock, [this]() { return ingest_in_flight_ == 0; });
+}
+
 void WMBroadcaster::geoReferenceCallback(const std_msgs::String& geo_ref)
 {
   std::lock_guard<std::mutex> guard(map_mutex_);
   base_map_georef_ = geo_ref.data;
+  if (ingest_snapshot_ && ingest_snapshot_->georef != base_map_georef_)
+  {
+    auto snapshot = std::make_shared<IngestSnapshot>(*ingest_snapshot_);
+    snapshot->georef = base_map_georef_;
+    ingest_snapshot_ = snapshot;
+  }
+}
+
+std::shared_ptr<const WMBroadcaster::IngestSnapshot> WMBroadcaster::getIngestSnapshot()
+{
+  std::lock_guard<std::mutex> guard(map_mutex_);
+  if (!ingest_snapshot_)
+  {
+    throw lanelet::InvalidObjectStateError(std::string("Base lanelet map is not loaded to the WMBroadcaster"));
+  }
+  if (ingest_snapshot_->georef == "")
+    throw lanelet::InvalidObjectStateError(std::string("Base lanelet map has empty proj string loaded as georeference. Therefore, WMBroadcaster failed to\n ") +
+                                          std::string("get transformation between the geofence and the map"));
+  return ingest_snapshot_;
 }
 
 void WMBroadcaster::setMaxLaneWidth(double max_lane_width)
@@ -258,38 +505,94 @@ void WMBroadcaster::setMaxLaneWidth(double max_lane_width)
 // currently only supports geofence message version 1: TrafficControlMessageV01 
 lanelet::ConstLaneletOrAreas WMBroadcaster::getAffectedLaneletOrAreas(const cav_msgs::TrafficControlMessageV01& tcmV01)
 {
-  if (!current_map_)
+  auto snapshot = getIngestSnapshot();
+  auto candidates = findAffectedCandidates(tcmV01, *snapshot);
+
+  std::lock_guard<std::mutex> guard(map_mutex_);
+  return resolveAffectedParts(candidates);
+}
+
+lanelet::ConstLaneletOrAreas WMBroadcaster::resolveAffectedParts(const AffectedCandidates& candidates)
+{
+  // The snapshot shares its ids with current_map_
+  auto to_current = [this](const std::unordered_set<lanelet::ConstLanelet>& llts) {
+    std::unordered_set<lanelet::ConstLanelet> current;
+    for (const auto& llt : llts)
+    {
+      current.insert(current_map_->laneletLayer.get(llt.id()));
+    }
+    return current;
+  };
+
+  std::unordered_set<lanelet::ConstLanelet> affected_lanelets = to_current(candidates.affected);
+  std::unordered_set<lanelet::ConstLanelet> filtered = filterSuccessorLanelets(to_current(candidates.last_point), affected_lanelets);
+  affected_lanelets.insert(filtered.begin(), filtered.end());
+
+  // Currently only returning lanelet, but this could be expanded to LanelerOrArea compound object 
+  // by implementing non-const version of that LaneletOrArea
+  lanelet::ConstLaneletOrAreas affected_parts;
+  affected_parts.insert(affected_parts.end(), affected_lanelets.begin(), affected_lanelets.end());
+  return affected_parts;
+}
+
+const lanelet::routing::RoutingGraph& WMBroadcaster::getCurrentRoutingGraph()
+{
+  if (!traffic_rules_car_)
   {
-    throw lanelet::InvalidObjectStateError(std::string("Base lanelet map is not loaded to the WMBroadcaster"));
+    traffic_rules_car_ = lanelet::traffic_rules::TrafficRulesFactory::create(
+        lanelet::traffic_rules::CarmaUSTrafficRules::Location, lanelet::Participants::VehicleCar);
   }
-  if (base_map_georef_ == "")
-    throw lanelet::InvalidObjectStateError(std::string("Base lanelet map has empty proj string loaded as georeference. Therefore, WMBroadcaster failed to\n ") +
-                                          std::string("get transformation between the geofence and the map"));
+  if (!current_routing_graph_ || routing_graph_outdated_)
+  {
+    current_routing_graph_ = lanelet::routing::RoutingGraph::build(*current_map_, *traffic_rules_car_);
+    routing_graph_outdated_ = false;
+  }
+  return *current_routing_graph_;
+}
 
-  PJ* geofence_in_map_proj = proj_create_crs_to_crs(PJ_DEFAULT_CTX, tcmV01.geometry.proj.c_str(), base_map_georef_.c_str(), NULL);
-  
-  // convert all geofence points into our map's frame
-  std::vector<lanelet::Point3d> gf_pts;
-  for (auto pt : tcmV01.geometry.nodes)
+WMBroadcaster::AffectedCandidates WMBroadcaster::findAffectedCandidates(const cav_msgs::TrafficControlMessageV01& tcmV01,
+                                                                        const IngestSnapshot& snapshot) const
+{
+  // PROJ objects cannot be shared between threads so every thread keeps its own transformations
+  static thread_local ProjectionCache projection_cache;
+
+  AffectedCandidates candidates;
+  size_t num_nodes = tcmV01.geometry.nodes.size();
+  if (num_nodes == 0)
+  {
+    return candidates;
+  }
+
+  // convert all geofence points into our map's frame in one call
+  std::vector<double> xs, ys;
+  xs.reserve(num_nodes);
+  ys.reserve(num_nodes);
+  for (const auto& pt : tcmV01.geometry.nodes)
   {
-    PJ_COORD c {{pt.x, pt.y, 0, 0}}; // z is not currently used
-    PJ_COORD c_out;
-    c_out = proj_trans(geofence_in_map_proj, PJ_FWD, c);
-    gf_pts.push_back(lanelet::Point3d{current_map_->pointLayer.uniqueId(), c_out.xyz.x, c_out.xyz.y});
+    xs.push_back(pt.x);
+    ys.push_back(pt.y);
+  }
+  projection_cache.transform(tcmV01.geometry.proj, snapshot.georef, xs.data(), ys.data(), num_nodes);
+
+  std::vector<lanelet::BasicPoint2d> gf_pts;
+  gf_pts.reserve(num_nodes);
+  for (size_t i = 0; i < num_nodes; i++)
+  {
+    gf_pts.emplace_back(xs[i], ys[i]);
   }
 
   // Logic to detect which part is affected
 
-  std::unordered_set<lanelet::Lanelet> affected_lanelets;
+  std::unordered_set<lanelet::ConstLanelet>& affected_lanelets = candidates.affected;
   for (int idx = 0; idx < gf_pts.size(); idx ++)
   {
-    std::unordered_set<lanelet::Lanelet> possible_lanelets;
+    std::unordered_set<lanelet::ConstLanelet> possible_lanelets;
     // get nearest few nearest llts within max_lane_width_
     // which actually house this geofence_point
-    auto searchFunc = [&](const lanelet::BoundingBox2d& lltBox, const lanelet::Lanelet& llt) 
+    auto searchFunc = [&](const lanelet::BoundingBox2d& lltBox, const lanelet::ConstLanelet& llt) 
     {
-      bool should_stop_searching = boost::geometry::distance(gf_pts[idx].basicPoint2d(), llt.polygon2d()) > max_lane_width_;
-      if (!should_stop_searching && boost::geometry::within(gf_pts[idx].basicPoint2d(), llt.polygon2d()))
+      bool should_stop_searching = boost::geometry::distance(gf_pts[idx], llt.polygon2d()) > max_lane_width_;
+      if (!should_stop_searching && boost::geometry::within(gf_pts[idx], llt.polygon2d()))
       {
         possible_lanelets.insert(llt);
       }
@@ -297,20 +600,20 @@ lanelet::ConstLaneletOrAreas WMBroadcaster::getAffectedLaneletOrAreas(const cav_
     };
 
     // this call updates possible_lanelets
-    current_map_->laneletLayer.nearestUntil(gf_pts[idx], searchFunc);
+    snapshot.map->laneletLayer.nearestUntil(gf_pts[idx], searchFunc);
 
-    // among these llts, filter the ones that are on same direction as the geofence using routing
+    // among these llts, the ones that are on same direction as the geofence are filtered using routing
+    // by resolveAffectedParts, as the routing graph depends on the regems of the current map
     if (idx + 1 == gf_pts.size()) // we only check this for the last gf_pt after saving everything
     {
-      std::unordered_set<lanelet::Lanelet> filtered = filterSuccessorLanelets(possible_lanelets, affected_lanelets);
-      affected_lanelets.insert(filtered.begin(), filtered.end());
+      candidates.last_point = std::move(possible_lanelets);
       break;
     } 
 
     // check if each lines connecting end points of the llt is crossing with the line connecting current and next gf_pts
     for (auto llt: possible_lanelets)
     {
-      lanelet::BasicLineString2d gf_dir_line({gf_pts[idx].basicPoint2d(), gf_pts[idx+1].basicPoint2d()});
+      lanelet::BasicLineString2d gf_dir_line({gf_pts[idx], gf_pts[idx+1]});
       lanelet::BasicLineString2d llt_boundary({(llt.leftBound2d().end() -1)->basicPoint2d(), (llt.rightBound2d().end() - 1)->basicPoint2d()});
       
       // record the llts that are on the same dir
@@ -319,15 +622,15 @@ lanelet::ConstLaneletOrAreas WMBroadcaster::getAffectedLaneletOrAreas(const cav_
         affected_lanelets.insert(llt);
       }
       // check condition if two geofence points are in one lanelet then check matching direction and record it also
-      else if (boost::geometry::within(gf_pts[idx+1].basicPoint2d(), llt.polygon2d()) && 
+      else if (boost::geometry::within(gf_pts[idx+1], llt.polygon2d()) && 
               affected_lanelets.find(llt) == affected_lanelets.end())
       { 
         lanelet::BasicPoint2d median({((llt.leftBound2d().end() - 1)->basicPoint2d().x() + (llt.rightBound2d().end() - 1)->basicPoint2d().x())/2 , 
                                       ((llt.leftBound2d().end() - 1)->basicPoint2d().y() + (llt.rightBound2d().end() - 1)->basicPoint2d().y())/2});
         // turn into vectors
         Eigen::Vector2d vec_to_median(median);
-        Eigen::Vector2d vec_to_gf_start(gf_pts[idx].basicPoint2d());
-        Eigen::Vector2d vec_to_gf_end(gf_pts[idx + 1].basicPoint2d());
+        Eigen::Vector2d vec_to_gf_start(gf_pts[idx]);
+        Eigen::Vector2d vec_to_gf_end(gf_pts[idx + 1]);
 
         // Get vector from start to external point
         Eigen::Vector2d start_to_median = vec_to_median - vec_to_gf_start;
@@ -343,33 +646,28 @@ lanelet::ConstLaneletOrAreas WMBroadcaster::getAffectedLaneletOrAreas(const cav_
     }
   }
   
-  // Currently only returning lanelet, but this could be expanded to LanelerOrArea compound object 
-  // by implementing non-const version of that LaneletOrArea
-  lanelet::ConstLaneletOrAreas affected_parts;
-  affected_parts.insert(affected_parts.end(), affected_lanelets.begin(), affected_lanelets.end());
-  return affected_parts;
+  return candidates;
 }
 
 // helper function that filters successor lanelets of root_lanelets from possible_lanelets
-std::unordered_set<lanelet::Lanelet> WMBroadcaster::filterSuccessorLanelets(const std::unordered_set<lanelet::Lanelet>& possible_lanelets, const std::unordered_set<lanelet::Lanelet>& root_lanelets)
+std::unordered_set<lanelet::ConstLanelet> WMBroadcaster::filterSuccessorLanelets(const std::unordered_set<lanelet::ConstLanelet>& possible_lanelets,
+                                                                                 const std::unordered_set<lanelet::ConstLanelet>& root_lanelets)
 {
-  std::unordered_set<lanelet::Lanelet> filtered_lanelets;
+  std::unordered_set<lanelet::ConstLanelet> filtered_lanelets;
   // we utilize routes to filter llts that are overlapping but not connected
-  lanelet::traffic_rules::TrafficRulesUPtr traffic_rules_car = lanelet::traffic_rules::TrafficRulesFactory::create(
-  lanelet::traffic_rules::CarmaUSTrafficRules::Location, lanelet::Participants::VehicleCar);
-  lanelet::routing::RoutingGraphUPtr map_graph = lanelet::routing::RoutingGraph::build(*current_map_, *traffic_rules_car);
+  const lanelet::routing::RoutingGraph& map_graph = getCurrentRoutingGraph();
   
   // as this is the last lanelet 
   // we have to filter the llts that are only geometrically overlapping yet not connected to prev llts
   for (auto recorded_llt: root_lanelets)
   {
-    for (auto following_llt: map_graph->following(recorded_llt, false))
+    for (auto following_llt: map_graph.following(recorded_llt, false))
     {
-      auto mutable_llt = current_map_->laneletLayer.get(following_llt.id());
-      auto it = possible_lanelets.find(mutable_llt);
+      lanelet::ConstLanelet current_llt = current_map_->laneletLayer.get(following_llt.id());
+      auto it = possible_lanelets.find(current_llt);
       if (it != possible_lanelets.end())
       {
-        filtered_lanelets.insert(mutable_llt);
+        filtered_lanelets.insert(*it);
       }
     }
   }
@@ -479,13 +777,10 @@ void WMBroadcaster::addGeofence(std::shared_ptr<Geofence> gf_ptr)
   
   // Process the geofence object to populate update remove lists
   addGeofenceHelper(gf_ptr);
+  markRoutingGraphOutdated(gf_ptr);
   
   // publish
-  autoware_lanelet2_msgs::MapBin gf_msg;
-  auto send_data = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl(gf_ptr->id_, gf_ptr->update_list_, gf_ptr->remove_list_));
-  carma_wm::toBinMsg(send_data, &gf_msg);
-  map_update_pub_(gf_msg);
-  
+  publishMapUpdate(gf_ptr);
 };
 
 void WMBroadcaster::removeGeofence(std::shared_ptr<Geofence> gf_ptr)
@@ -495,15 +790,73 @@ void WMBroadcaster::removeGeofence(std::shared_ptr<Geofence> gf_ptr)
   
   // Process the geofence object to populate update remove lists
   removeGeofenceHelper(gf_ptr);
+  markRoutingGraphOutdated(gf_ptr);
 
   // publish
-  autoware_lanelet2_msgs::MapBin gf_msg_revert;
-  auto send_data = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl(gf_ptr->id_, gf_ptr->update_list_, gf_ptr->remove_list_));
-  
-  carma_wm::toBinMsg(send_data, &gf_msg_revert);
-  map_update_pub_(gf_msg_revert);
+  publishMapUpdate(gf_ptr);
 };
 
+void WMBroadcaster::markRoutingGraphOutdated(std::shared_ptr<Geofence> gf_ptr)
+{
+  // Speed limits only change routing costs, which filterSuccessorLanelets does not use. Any other regem
+  // (such as passing control lines) may change the relations between lanelets so the graph is rebuilt on next use
+  if (gf_ptr->update_list_.empty() && gf_ptr->remove_list_.empty())
+  {
+    return;
+  }
+  if (!gf_ptr->regulatory_element_ ||
+      gf_ptr->regulatory_element_->attribute(lanelet::AttributeName::Subtype).value() != lanelet::DigitalSpeedLimit::RuleName)
+  {
+    routing_graph_outdated_ = true;
+  }
+}
+
+void WMBroadcaster::publishMapUpdate(std::shared_ptr<Geofence> gf_ptr)
+{
+  auto send_data = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl(gf_ptr->id_, gf_ptr->update_list_, gf_ptr->remove_list_));
+  if (batch_map_updates_)
+  {
+    pending_map_updates_.push_back(send_data);
+    return;
+  }
+
+  autoware_lanelet2_msgs::MapBin gf_msg;
+  toMapUpdateMsg(send_data, &gf_msg, compact_map_updates_);
+  map_update_pub_(gf_msg);
+}
+
+void WMBroadcaster::setMapUpdateBatching(bool enabled)
+{
+  std::lock_guard<std::mutex> guard(map_mutex_);
+  batch_map_updates_ = enabled;
+}
+
+void WMBroadcaster::setCompactMapUpdates(bool enabled)
+{
+  std::lock_guard<std::mutex> guard(map_mutex_);
+  compact_map_updates_ = enabled;
+}
+
+void WMBroadcaster::flushMapUpdates()
+{
+  autoware_lanelet2_msgs::MapBin gf_msg;
+  {
+    std::lock_guard<std::mutex> guard(map_mutex_);
+    if (pending_map_updates_.empty())
+      return;
+
+    std::shared_ptr<carma_wm::TrafficControl> send_data = pending_map_updates_.size() == 1 ?
+                                                          pending_map_updates_.front() :
+                                                          mergeMapUpdates(pending_map_updates_);
+    pending_map_updates_.clear();
+    if (send_data->remove_list_.empty() && send_data->update_list_.empty())
+      return;  // The accumulated updates cancelled each other out
+
+    toMapUpdateMsg(send_data, &gf_msg, compact_map_updates_);
+  }
+  map_update_pub_(gf_msg);
+}
+
 // helper function that detects the type of geofence and delegates
 void WMBroadcaster::addGeofenceHelper(std::shared_ptr<Geofence> gf_ptr) const
 {
@@ -17,6 +17,7 @@
 #include <carma_wm_ctrl/WMBroadcaster.h>
 #include <carma_utils/timers/ROSTimerFactory.h>
 #include <carma_wm_ctrl/WMBroadcasterNode.h>
+#include <algorithm>
 
 namespace carma_wm_ctrl
 {
@@ -29,7 +30,10 @@ void WMBroadcasterNode::publishMap(const autoware_lanelet2_msgs::MapBin& map_msg
 
 void WMBroadcasterNode::publishMapUpdate(const autoware_lanelet2_msgs::MapBin& geofence_msg) const
 {
-  map_update_pub_.publish(geofence_msg);
+  // Stamped so subscribers can tell a fresh update from the one latched before they subscribed
+  autoware_lanelet2_msgs::MapBin stamped_msg = geofence_msg;
+  stamped_msg.header.stamp = ros::Time::now();
+  map_update_pub_.publish(stamped_msg);
 }
 
 WMBroadcasterNode::WMBroadcasterNode()
@@ -52,6 +56,27 @@ int WMBroadcasterNode::run()
   double lane_max_width;
   pnh_.getParam("max_lane_width", lane_max_width);
   wmb_.setMaxLaneWidth(lane_max_width);
+
+  std::string map_snapshot_path;
+  pnh_.param<std::string>("map_snapshot_path", map_snapshot_path, "");
+  wmb_.setMapSnapshotPath(map_snapshot_path);
+
+  int geofence_ingest_threads;
+  pnh_.param<int>("geofence_ingest_threads", geofence_ingest_threads, 0);
+  wmb_.setIngestThreads(std::max(0, geofence_ingest_threads));
+
+  bool batch_map_updates;
+  pnh_.param<bool>("batch_map_updates", batch_map_updates, false);
+  wmb_.setMapUpdateBatching(batch_map_updates);
+
+  bool compact_map_updates;
+  pnh_.param<bool>("compact_map_updates", compact_map_updates, false);
+  wmb_.setCompactMapUpdates(compact_map_updates);
+  // Map updates of geofences activating during the same spin period are published together
+  ros::CARMANodeHandle::setSpinCallback([this]() -> bool {
+    wmb_.flushMapUpdates();
+    return true;
+  });
   
   // Spin
   cnh_.setSpinRate(10);
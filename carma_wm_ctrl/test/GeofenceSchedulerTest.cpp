@@ -153,4 +153,58 @@ TEST(GeofenceScheduler, addGeofence)
   ASSERT_EQ(first_id_hashed, last_inactive_gf.load());
 }
 
+
+TEST(GeofenceScheduler, batchDispatch)
+{
+  ros::Time::setNow(ros::Time(0));  // Set current time
+  // Tick far beyond the test horizon so only the explicit dispatches below fire events
+  GeofenceScheduler scheduler(std::make_unique<TestTimerFactory>(), ros::Duration(1000));
+  uint32_t active_call_count = 0;
+  uint32_t inactive_call_count = 0;
+  scheduler.onGeofenceActive([&](std::shared_ptr<Geofence> gf_ptr) { active_call_count++; });
+  scheduler.onGeofenceInactive([&](std::shared_ptr<Geofence> gf_ptr) { inactive_call_count++; });
+
+  // Many geofences sharing the same activation time
+  const uint32_t num_geofences = 1000;
+  for (uint32_t i = 0; i < num_geofences; i++)
+  {
+    auto gf_ptr = std::make_shared<Geofence>(Geofence());
+    gf_ptr->id_ = boost::uuids::random_generator()();
+    gf_ptr->schedules.push_back(
+        GeofenceSchedule(ros::Time(1),  // Schedule between 1 and 8
+                         ros::Time(8),
+                         ros::Duration(2),    // Starts at 2
+                         ros::Duration(3.5),  // Ends at by 5.5
+                         ros::Duration(0),    // repetition start 0 offset, so still start at 2
+                         ros::Duration(1),    // Duration of 1 and interval of 2 so active durations are (2-3 and 4-5)
+                         ros::Duration(2)));
+    scheduler.addGeofence(gf_ptr);
+  }
+  ASSERT_EQ(num_geofences, scheduler.pendingEvents());
+
+  scheduler.dispatchDueEvents(ros::Time(1.5));
+  ASSERT_EQ(0, active_call_count);
+
+  // All activations are handled in one batch and each queues its deactivation
+  ros::Time::setNow(ros::Time(2.0));
+  scheduler.dispatchDueEvents(ros::Time(2.0));
+  ASSERT_EQ(num_geofences, active_call_count);
+  ASSERT_EQ(0, inactive_call_count);
+  ASSERT_EQ(num_geofences, scheduler.pendingEvents());
+
+  ros::Time::setNow(ros::Time(3.0));
+  scheduler.dispatchDueEvents(ros::Time(3.0));
+  ASSERT_EQ(num_geofences, inactive_call_count);
+  ASSERT_EQ(num_geofences, scheduler.pendingEvents());  // Next control period at 4
+
+  // Expired geofences leave nothing behind
+  ros::Time::setNow(ros::Time(4.0));
+  scheduler.dispatchDueEvents(ros::Time(4.0));
+  ros::Time::setNow(ros::Time(9.0));
+  scheduler.dispatchDueEvents(ros::Time(9.0));
+  ASSERT_EQ(2 * num_geofences, active_call_count);
+  ASSERT_EQ(2 * num_geofences, inactive_call_count);
+  ASSERT_EQ(0, scheduler.pendingEvents());
+}
+
 }  // namespace carma_wm_ctrl
\ No newline at end of file
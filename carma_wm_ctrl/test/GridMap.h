@@ -0,0 +1,63 @@
+#pragma once
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <vector>
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/Attribute.h>
+#include <lanelet2_core/utility/Utilities.h>
+
+/**
+ * Map fixture shared by the unit tests and the benchmarks. Kept free of gtest so the benchmarks can include it.
+ */
+namespace carma_wm
+{
+/**
+ * @brief Builds a map of parallel one way lanes split into 25m segments which share their bounds
+ */
+inline lanelet::LaneletMapPtr getGridMap(int lanes, int segments)
+{
+  std::vector<std::vector<lanelet::LineString3d>> bounds(lanes + 1);
+  for (int b = 0; b <= lanes; b++)
+  {
+    lanelet::Point3d prev(lanelet::utils::getId(), b * 3.7, 0.0, 0.0);
+    for (int s = 0; s < segments; s++)
+    {
+      lanelet::Point3d next(lanelet::utils::getId(), b * 3.7, (s + 1) * 25.0, 0.0);
+      lanelet::LineString3d ls(lanelet::utils::getId(), { prev, next });
+      ls.attributes()[lanelet::AttributeName::Type] = lanelet::AttributeValueString::LineThin;
+      ls.attributes()[lanelet::AttributeName::Subtype] = lanelet::AttributeValueString::Dashed;
+      bounds[b].push_back(ls);
+      prev = next;
+    }
+  }
+
+  lanelet::Lanelets llts;
+  for (int l = 0; l < lanes; l++)
+  {
+    for (int s = 0; s < segments; s++)
+    {
+      lanelet::Lanelet llt(lanelet::utils::getId(), bounds[l][s], bounds[l + 1][s]);
+      llt.attributes()[lanelet::AttributeName::Type] = lanelet::AttributeValueString::Lanelet;
+      llt.attributes()[lanelet::AttributeName::Subtype] = lanelet::AttributeValueString::Road;
+      llt.attributes()[lanelet::AttributeName::Location] = lanelet::AttributeValueString::Urban;
+      llt.attributes()[lanelet::AttributeName::OneWay] = "yes";
+      llts.push_back(llt);
+    }
+  }
+  return lanelet::utils::createMap(llts, {});
+}
+}  // namespace carma_wm
@@ -16,8 +16,10 @@
 
 #include <gmock/gmock.h>
 #include <carma_wm_ctrl/MapConformer.h>
+#include <algorithm>
 #include <lanelet2_extension/traffic_rules/CarmaUSTrafficRules.h>
 #include "TestHelpers.h"
+#include "GridMap.h"
 
 using ::testing::_;
 using ::testing::A;
@@ -176,4 +178,45 @@ TEST(MapConformer, ensureCompliance)
     count++;
   }
 }
-}  // namespace carma_wm_ctrl
\ No newline at end of file
+
+TEST(MapConformer, ensureComplianceParallel)
+{
+  const int lanes = 4;
+  const int segments = 400;  // Enough lanelets for the inference to be split between threads
+  auto serial_map = carma_wm::getGridMap(lanes, segments);
+  auto parallel_map = carma_wm::getGridMap(lanes, segments);
+
+  lanelet::MapConformer::ensureCompliance(serial_map, 1);
+  lanelet::MapConformer::ensureCompliance(parallel_map, 4);
+
+  // One access rule per lanelet and one control line per bound, shared by the lanelets on either side of it
+  const size_t expected_regulations = lanes * segments + (lanes + 1) * segments;
+  ASSERT_EQ(expected_regulations, serial_map->regulatoryElementLayer.size());
+  ASSERT_EQ(expected_regulations, parallel_map->regulatoryElementLayer.size());
+
+  for (auto ll : parallel_map->laneletLayer)
+  {
+    auto control_lines = ll.regulatoryElementsAs<lanelet::PassingControlLine>();
+    ASSERT_EQ(2, control_lines.size());
+    ASSERT_EQ(1, ll.regulatoryElementsAs<lanelet::RegionAccessRule>().size());
+    ASSERT_TRUE(lanelet::PassingControlLine::boundPassable(ll.leftBound(), control_lines, true,
+                                                           lanelet::Participants::Vehicle));
+
+    // The lanelet to the right uses the same control line for the shared bound
+    for (auto right : parallel_map->laneletLayer.findUsages(ll.rightBound()))
+    {
+      if (right.id() == ll.id())
+      {
+        continue;
+      }
+      auto right_lines = right.regulatoryElementsAs<lanelet::PassingControlLine>();
+      ASSERT_TRUE(std::any_of(right_lines.begin(), right_lines.end(),
+                              [&](const lanelet::PassingControlLinePtr& pcl) { return pcl == control_lines[0] || pcl == control_lines[1]; }));
+    }
+  }
+
+  // Running again over a compliant map adds nothing
+  lanelet::MapConformer::ensureCompliance(parallel_map, 4);
+  ASSERT_EQ(expected_regulations, parallel_map->regulatoryElementLayer.size());
+}
+}  // namespace carma_wm_ctrl
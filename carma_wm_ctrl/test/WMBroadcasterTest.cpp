@@ -18,6 +18,7 @@
 #include <carma_wm_ctrl/GeofenceSchedule.h>
 #include <carma_wm_ctrl/Geofence.h>
 #include <carma_wm/TrafficControl.h>
+#include <carma_wm/MapSnapshot.h>
 #include <carma_wm_ctrl/GeofenceScheduler.h>
 #include <carma_wm_ctrl/WMBroadcaster.h>
 #include <lanelet2_extension/utility/message_conversion.h>
@@ -29,6 +30,7 @@
 #include <carma_utils/timers/testing/TestTimer.h>
 #include <carma_utils/timers/testing/TestTimerFactory.h>
 #include <algorithm>
+#include <cstdio>
 
 #include <cav_msgs/TrafficControlMessage.h>
 #include <boost/uuid/uuid_generators.hpp>
@@ -87,6 +89,73 @@ TEST(WMBroadcaster, baseMapCallback)
   ASSERT_EQ(1, base_map_call_count);
 }
 
+TEST(WMBroadcaster, baseMapCallbackUnchangedMap)
+{
+  ros::Time::setNow(ros::Time(0));  // Set current time
+
+  std::vector<autoware_lanelet2_msgs::MapBin> published;
+  WMBroadcaster wmb([&](const autoware_lanelet2_msgs::MapBin& map_bin) { published.push_back(map_bin); },
+                    [](const autoware_lanelet2_msgs::MapBin& map_bin) {}, std::make_unique<TestTimerFactory>());
+
+  auto map = carma_wm::getDisjointRouteMap();
+
+  autoware_lanelet2_msgs::MapBin msg;
+  lanelet::utils::conversion::toBinMsg(map, &msg);
+
+  autoware_lanelet2_msgs::MapBinConstPtr map_msg_ptr(new autoware_lanelet2_msgs::MapBin(msg));
+
+  // Resending the same map republishes the compliant map without running the conformer again
+  wmb.baseMapCallback(map_msg_ptr);
+  wmb.baseMapCallback(map_msg_ptr);
+  ASSERT_EQ(2, published.size());
+  ASSERT_EQ(published[0].data, published[1].data);
+
+  lanelet::LaneletMapPtr compliant_map(new lanelet::LaneletMap);
+  lanelet::utils::conversion::fromBinMsg(published[1], compliant_map);
+  ASSERT_EQ(14, compliant_map->regulatoryElementLayer.size());
+
+  // A different map is processed again
+  map->laneletLayer.get(10003).attributes()[lanelet::AttributeName::OneWay] = "yes";
+  lanelet::utils::conversion::toBinMsg(map, &msg);
+  wmb.baseMapCallback(autoware_lanelet2_msgs::MapBinConstPtr(new autoware_lanelet2_msgs::MapBin(msg)));
+  ASSERT_EQ(3, published.size());
+  ASSERT_NE(published[1].data, published[2].data);
+}
+
+TEST(WMBroadcaster, baseMapCallbackSnapshot)
+{
+  ros::Time::setNow(ros::Time(0));  // Set current time
+
+  const std::string path = "wm_broadcaster_snapshot.bin";
+  size_t base_map_call_count = 0;
+  WMBroadcaster wmb(
+      [&](const autoware_lanelet2_msgs::MapBin& map_bin) {
+        // Only the snapshot location is published
+        ASSERT_TRUE(carma_wm::isMapSnapshotAnnouncement(map_bin));
+        ASSERT_EQ(path, carma_wm::getMapSnapshotPath(map_bin));
+
+        carma_wm::MappedMapSnapshot snapshot(path);
+        ASSERT_EQ(std::to_string(snapshot.getMapVersion()), map_bin.map_version);
+        ASSERT_EQ(4, snapshot.decodeMap()->laneletLayer.size());  // Verify the map can be decoded
+
+        base_map_call_count++;
+      }, [](const autoware_lanelet2_msgs::MapBin& map_bin) {},
+      std::make_unique<TestTimerFactory>());
+  wmb.setMapSnapshotPath(path);
+
+  auto map = carma_wm::getDisjointRouteMap();
+
+  autoware_lanelet2_msgs::MapBin msg;
+  lanelet::utils::conversion::toBinMsg(map, &msg);
+
+  autoware_lanelet2_msgs::MapBinConstPtr map_msg_ptr(new autoware_lanelet2_msgs::MapBin(msg));
+
+  wmb.baseMapCallback(map_msg_ptr);
+  ASSERT_EQ(1, base_map_call_count);
+
+  std::remove(path.c_str());
+}
+
 // here test the proj string transform test
 TEST(WMBroadcaster, getAffectedLaneletOrAreasFromTransform)
 {
@@ -150,6 +219,21 @@ TEST(WMBroadcaster, getAffectedLaneletOrAreasFromTransform)
   
   affected_parts = wmb.getAffectedLaneletOrAreas(gf_msg);
   ASSERT_EQ(affected_parts.size(), 2); // newly added ones should not be considered to be on the lanelet
+
+  // Repeated geofences reuse the cached transformation and give the same result
+  affected_parts = wmb.getAffectedLaneletOrAreas(gf_msg);
+  ASSERT_EQ(affected_parts.size(), 2);
+
+  // A new georeference invalidates the cached transformation. With the geofence frame used as the map frame
+  // the geofence points are no longer shifted onto the lanelets
+  base_map_proj.data = geofence_proj_string;
+  wmb.geoReferenceCallback(base_map_proj);
+  affected_parts = wmb.getAffectedLaneletOrAreas(gf_msg);
+  ASSERT_EQ(affected_parts.size(), 0);
+
+  // Invalid projections are reported instead of silently producing a null transformation
+  gf_msg.geometry.proj = "+proj=not_a_projection";
+  EXPECT_THROW(wmb.getAffectedLaneletOrAreas(gf_msg), lanelet::InvalidObjectStateError);
 }
 
 // here test assuming the georeference proj strings are the same
@@ -487,6 +571,159 @@ TEST(WMBroadcaster, addAndRemoveGeofence)
 
 }
 
+TEST(WMBroadcaster, batchedMapUpdates)
+{
+  using namespace lanelet::units::literals;
+  std::vector<autoware_lanelet2_msgs::MapBin> published;
+  WMBroadcaster wmb(
+      [](const autoware_lanelet2_msgs::MapBin& map_bin) {},
+      [&](const autoware_lanelet2_msgs::MapBin& geofence_bin) { published.push_back(geofence_bin); },
+      std::make_unique<TestTimerFactory>());
+
+  auto map = carma_wm::getBroadcasterTestMap();
+  lanelet::DigitalSpeedLimitPtr old_speed_limit = std::make_shared<lanelet::DigitalSpeedLimit>(lanelet::DigitalSpeedLimit::buildData(lanelet::InvalId, 5_mph, {}, {},
+                                                     { lanelet::Participants::VehicleCar }));
+  map->update(map->laneletLayer.get(10000), old_speed_limit);
+
+  autoware_lanelet2_msgs::MapBin msg;
+  lanelet::utils::conversion::toBinMsg(map, &msg);
+  autoware_lanelet2_msgs::MapBinConstPtr map_msg_ptr(new autoware_lanelet2_msgs::MapBin(msg));
+  wmb.baseMapCallback(map_msg_ptr);
+  std_msgs::String sample_proj_string;
+  std::string proj_string = "+proj=tmerc +lat_0=39.46636844371259 +lon_0=-76.16919523566943 +k=1 +x_0=0 +y_0=0 +datum=WGS84 +units=m +vunits=m +no_defs";
+  sample_proj_string.data = proj_string;
+  wmb.geoReferenceCallback(sample_proj_string);
+
+  cav_msgs::TrafficControlMessageV01 gf_msg;
+  boost::uuids::uuid id = boost::uuids::random_generator()();
+  std::copy(id.begin(), id.end(), gf_msg.id.id.begin());
+  gf_msg.geometry.proj = proj_string;
+  cav_msgs::PathNode pt;
+  pt.x = 0.5; pt.y = 0.5; pt.z = 0;
+  gf_msg.geometry.nodes.push_back(pt);
+  pt.x = 0.5; pt.y = 1.5; pt.z = 0;
+  gf_msg.geometry.nodes.push_back(pt);
+  gf_msg.params.detail.choice = cav_msgs::TrafficControlDetail::MAXSPEED_CHOICE;
+  gf_msg.params.detail.maxspeed = 10;
+  auto gf_ptr = wmb.geofenceFromMsg(gf_msg);
+  ASSERT_EQ(gf_ptr->affected_parts_.size(), 2);
+  boost::uuids::uuid id2 = boost::uuids::random_generator()();
+  std::copy(id2.begin(), id2.end(), gf_msg.id.id.begin());
+  gf_msg.params.detail.maxspeed = 20;
+  auto gf_ptr2 = wmb.geofenceFromMsg(gf_msg);
+
+  // Map updates carry the full archive by default
+  wmb.addGeofence(gf_ptr);
+  wmb.removeGeofence(gf_ptr);
+  ASSERT_EQ(published.size(), 2);
+  ASSERT_NE(published[0].format_version, carma_wm::TRAFFIC_CONTROL_COMPACT_FORMAT);
+  published.clear();
+
+  // Only the compact format carries the ids of merged geofences
+  wmb.setCompactMapUpdates(true);
+  wmb.setMapUpdateBatching(true);
+  wmb.flushMapUpdates();
+  ASSERT_EQ(published.size(), 0);  // Nothing to publish yet
+
+  // Activation is applied to the map right away but only published on flush
+  wmb.addGeofence(gf_ptr);
+  ASSERT_EQ(published.size(), 0);
+  wmb.flushMapUpdates();
+  ASSERT_EQ(published.size(), 1);
+  ASSERT_EQ(published.back().format_version, carma_wm::TRAFFIC_CONTROL_COMPACT_FORMAT);
+  auto data_received = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl());
+  carma_wm::fromBinMsg(published.back(), data_received);
+  ASSERT_EQ(data_received->id_, id);
+  ASSERT_TRUE(data_received->batched_ids_.empty());  // Sent as the update of a single geofence
+  ASSERT_EQ(data_received->update_list_.size(), 2);  // New speed limit on both lanelets
+  ASSERT_EQ(data_received->remove_list_.size(), 1);  // Old speed limit of 10000
+
+  // Changes which revert each other within the same tick are not published
+  wmb.removeGeofence(gf_ptr);
+  wmb.addGeofence(gf_ptr);
+  wmb.flushMapUpdates();
+  ASSERT_EQ(published.size(), 1);
+
+  // Several updates in the same tick are merged into their net effect
+  wmb.removeGeofence(gf_ptr);
+  wmb.addGeofence(gf_ptr);
+  wmb.removeGeofence(gf_ptr);
+  wmb.flushMapUpdates();
+  ASSERT_EQ(published.size(), 2);
+  data_received = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl());
+  carma_wm::fromBinMsg(published.back(), data_received);
+  ASSERT_EQ(data_received->update_list_.size(), 1);  // Old speed limit put back on 10000
+  ASSERT_EQ(data_received->update_list_[0].first, 10000);
+  ASSERT_EQ(data_received->update_list_[0].second->id(), old_speed_limit->id());
+  ASSERT_EQ(data_received->remove_list_.size(), 2);  // New speed limit removed from both lanelets
+
+  // The merged update of several geofences keeps the id of each
+  wmb.addGeofence(gf_ptr);
+  wmb.addGeofence(gf_ptr2);
+  wmb.flushMapUpdates();
+  ASSERT_EQ(published.size(), 3);
+  data_received = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl());
+  carma_wm::fromBinMsg(published.back(), data_received);
+  ASSERT_EQ(data_received->id_, id);
+  ASSERT_EQ(data_received->batched_ids_.size(), 2);
+  ASSERT_EQ(data_received->batched_ids_[0], id);
+  ASSERT_EQ(data_received->batched_ids_[1], id2);
+}
+
+TEST(WMBroadcaster, geofenceIngestWorkers)
+{
+  std::atomic<uint32_t> active_call_count(0);
+  WMBroadcaster wmb(
+      [](const autoware_lanelet2_msgs::MapBin& map_bin) {},
+      [&](const autoware_lanelet2_msgs::MapBin& geofence_bin) { active_call_count.store(active_call_count.load() + 1); },
+      std::make_unique<TestTimerFactory>());
+  wmb.setIngestThreads(3);
+
+  auto map = carma_wm::getDisjointRouteMap();
+  autoware_lanelet2_msgs::MapBin msg;
+  lanelet::utils::conversion::toBinMsg(map, &msg);
+  autoware_lanelet2_msgs::MapBinConstPtr map_msg_ptr(new autoware_lanelet2_msgs::MapBin(msg));
+  wmb.baseMapCallback(map_msg_ptr);
+
+  // geofence's origin (0,0) is at base_map's (10,10)
+  std_msgs::String base_map_proj;
+  base_map_proj.data = "+proj=tmerc +lat_0=39.46636844371259 +lon_0=-76.16919523566943 +k=1 +x_0=0 +y_0=0 +datum=WGS84 +units=m +vunits=m +no_defs";
+  wmb.geoReferenceCallback(base_map_proj);
+
+  cav_msgs::TrafficControlMessage gf_msg;
+  gf_msg.choice = cav_msgs::TrafficControlMessage::TCMV01;
+  gf_msg.tcmV01.geometry.proj = "+proj=tmerc +lat_0=39.46645851394806215 +lon_0=-76.16907903057393980 +k=1 +x_0=0 +y_0=0 +datum=WGS84 +units=m +vunits=m +no_defs";
+  cav_msgs::PathNode pt;
+  pt.x = -8.5; pt.y = -9.5; pt.z = 0;
+  gf_msg.tcmV01.geometry.nodes.push_back(pt);
+  pt.x = -8.5; pt.y = -8.5; pt.z = 0;
+  gf_msg.tcmV01.geometry.nodes.push_back(pt);
+  // Active between 2 and 3
+  gf_msg.tcmV01.params.schedule.start = ros::Time(1);
+  gf_msg.tcmV01.params.schedule.end = ros::Time(8);
+  cav_msgs::DailySchedule daily_schedule;
+  daily_schedule.begin = ros::Duration(2);
+  daily_schedule.duration = ros::Duration(1.1);
+  gf_msg.tcmV01.params.schedule.between.push_back(daily_schedule);
+  gf_msg.tcmV01.params.schedule.repeat.offset = ros::Duration(0);
+  gf_msg.tcmV01.params.schedule.repeat.span = ros::Duration(1);
+  gf_msg.tcmV01.params.schedule.repeat.period = ros::Duration(2);
+
+  ros::Time::setNow(ros::Time(0));
+  const uint32_t num_geofences = 10;
+  for (uint32_t i = 0; i < num_geofences; i++)
+  {
+    boost::uuids::uuid id = boost::uuids::random_generator()();
+    std::copy(id.begin(), id.end(), gf_msg.tcmV01.id.id.begin());
+    wmb.geofenceCallback(gf_msg);
+  }
+  wmb.geofenceCallback(gf_msg);  // Repeated ids are ignored
+  wmb.waitForIngest();
+
+  ros::Time::setNow(ros::Time(2.1));  // Every geofence has started by now
+  ASSERT_TRUE(carma_utils::testing::waitForEqOrTimeout(10.0, num_geofences, active_call_count));
+}
+
 TEST(WMBroadcaster, GeofenceBinMsgTest)
 {
   using namespace lanelet::units::literals;
@@ -15,6 +15,7 @@
  */
 
 #include <ros/ros.h>
+#include <memory>
 #include <boost/shared_ptr.hpp>
 #include <carma_utils/CARMAUtils.h>
 #include <tf2/LinearMath/Quaternion.h>
@@ -23,6 +24,7 @@
 #include <geometry_msgs/PoseStamped.h>
 #include <autoware_msgs/NDTStat.h>
 #include "ndt_reliability_counter.h"
+#include "pose_arbitrator.h"
 
 namespace localizer
 {
@@ -72,14 +74,23 @@ namespace localizer
             // reliability counter
             NDTReliabilityCounter counter;
 
+            // time synchronized selection used in auto mode
+            std::unique_ptr<PoseArbitrator> arbitrator_;
+            ros::Timer output_timer_;
+            ros::Timer stats_timer_;
+
             // callbacks
             void ndtPoseCallback(const geometry_msgs::PoseStampedConstPtr& msg);
             void gnssPoseCallback(const geometry_msgs::PoseStampedConstPtr& msg);
             void ndtScoreCallback(const autoware_msgs::NDTStatConstPtr& msg);
 
+            // timer callbacks used in auto mode
+            void outputTimerCallback(const ros::TimerEvent& event);
+            void statsTimerCallback(const ros::TimerEvent& event);
+
             // helper function
-            void publishPoseStamped(const geometry_msgs::PoseStampedConstPtr& msg);
-            void publishTransform(const geometry_msgs::PoseStampedConstPtr& msg);
+            void publishPoseStamped(const geometry_msgs::PoseStamped& msg);
+            void publishTransform(const geometry_msgs::PoseStamped& msg);
 
     };
 	
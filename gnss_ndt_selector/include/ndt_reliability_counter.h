@@ -1,3 +1,5 @@
+#pragma once
+
 /*
  * Copyright (C) 2019-2020 LEIDOS.
  *
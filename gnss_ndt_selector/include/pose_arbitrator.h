@@ -0,0 +1,132 @@
+#pragma once
+
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <deque>
+#include <cstdint>
+#include <ros/time.h>
+#include <geometry_msgs/PoseStamped.h>
+#include "ndt_reliability_counter.h"
+
+namespace localizer
+{
+    enum class PoseSource {
+        NONE = 0,
+        NDT = 1,
+        GNSS = 2,
+    };
+
+    struct PoseArbitratorConfig
+    {
+        // number of poses kept for each source
+        size_t buffer_size {50};
+        // largest stamp difference in seconds between an ndt score and the ndt pose it belongs to
+        double score_match_tolerance {0.01};
+        // largest gap in seconds between two poses of a source which may be interpolated
+        double max_interpolation_gap {0.5};
+        // how far in seconds the output lags the current time so late scores can still be matched
+        double output_delay {0.1};
+        // time in seconds over which the output moves from the old source to the new one after a switch
+        double blend_duration {0.5};
+        // if above this number, this ndt msg is not reliable
+        double score_upper_limit {2.0};
+        // if receiving this number of continuous unreliable score, current ndt matching result is not reliable
+        int unreliable_message_upper_limit {3};
+    };
+
+    struct PoseArbitratorStats
+    {
+        uint64_t outputs {0};
+        uint64_t ndt_outputs {0};
+        uint64_t gnss_outputs {0};
+        uint64_t source_switches {0};
+        // scores which never matched an ndt pose before it left the buffer
+        uint64_t unmatched_scores {0};
+        // age in seconds of the newest pose of the selected source when an output was produced
+        double total_latency {0.0};
+        double max_latency {0.0};
+    };
+
+    /**
+     * Time synchronized selection between ndt and gnss poses.
+     *
+     * Poses of both sources are buffered by stamp and each ndt score is matched to the ndt pose with the same stamp
+     * before it is fed to the NDTReliabilityCounter, so a late score can only affect the pose it was computed for.
+     * Outputs are produced on demand for a time slightly in the past by interpolating the buffered poses of the
+     * selected source. Past the newest pose of the source that pose is output with its own stamp for up to
+     * max_interpolation_gap, so consumers can see its age. After a source switch the output is blended from the old
+     * source to the new one, unless the old source was ndt dropped as unreliable. Gnss is only replaced by ndt when it
+     * has no data while ndt is reliable.
+     */
+    class PoseArbitrator
+    {
+        public:
+
+            explicit PoseArbitrator(const PoseArbitratorConfig& config = PoseArbitratorConfig());
+
+            void addNDTPose(const geometry_msgs::PoseStamped& pose);
+            void addNDTScore(const ros::Time& stamp, double score);
+            void addGNSSPose(const geometry_msgs::PoseStamped& pose);
+
+            // computes the output pose for now - output_delay, returns false if no source covers that time
+            bool getPose(const ros::Time& now, geometry_msgs::PoseStamped& pose);
+
+            PoseSource getSource() const;
+            const PoseArbitratorStats& getStats() const;
+
+        private:
+
+            struct NDTSample
+            {
+                geometry_msgs::PoseStamped pose;
+                bool scored {false};
+                bool reliable {false};
+            };
+
+            struct Score
+            {
+                ros::Time stamp;
+                double score;
+            };
+
+            PoseArbitratorConfig config_;
+            NDTReliabilityCounter counter_;
+
+            std::deque<NDTSample> ndt_poses_;
+            std::deque<geometry_msgs::PoseStamped> gnss_poses_;
+            // scores which arrived before their pose
+            std::deque<Score> pending_scores_;
+
+            PoseSource source_ {PoseSource::NONE};
+            PoseSource blend_from_ {PoseSource::NONE};
+            ros::Time blend_start_;
+
+            PoseArbitratorStats stats_;
+
+            // applies the score to the sample and updates the reliability counter
+            void applyScore(NDTSample& sample, double score);
+            // newest scored ndt sample at or before the given time, nullptr if there is none
+            const NDTSample* newestScoredNDT(const ros::Time& time) const;
+            // chooses the source for the given time from the reliability of the surrounding ndt poses
+            PoseSource selectSource(const ros::Time& time) const;
+            // pose of the source at the given time, false if the source does not cover the time
+            bool sourcePose(PoseSource source, const ros::Time& time, geometry_msgs::PoseStamped& pose) const;
+    };
+
+    // interpolates between two poses, ratio 0 gives a and 1 gives b
+    geometry_msgs::Pose interpolatePose(const geometry_msgs::Pose& a, const geometry_msgs::Pose& b, double ratio);
+}
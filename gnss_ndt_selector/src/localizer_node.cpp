@@ -15,28 +15,29 @@
  */
 
 #include "localizer.h"
+#include <algorithm>
 
 namespace localizer
 {
 	Localizer::Localizer(){}
 
-	void Localizer::publishTransform(const geometry_msgs::PoseStampedConstPtr& msg)
+	void Localizer::publishTransform(const geometry_msgs::PoseStamped& msg)
 	{
 		geometry_msgs::TransformStamped transformStamped;
-		transformStamped.header.stamp = msg->header.stamp;
+		transformStamped.header.stamp = msg.header.stamp;
 		transformStamped.header.frame_id = "map";
 		transformStamped.child_frame_id = "base_link";
-		transformStamped.transform.translation.x = msg->pose.position.x;
-		transformStamped.transform.translation.y = msg->pose.position.y;
-		transformStamped.transform.translation.z = msg->pose.position.z;
-		transformStamped.transform.rotation.x = msg->pose.orientation.x;
-		transformStamped.transform.rotation.y = msg->pose.orientation.y;
-		transformStamped.transform.rotation.z = msg->pose.orientation.z;
-		transformStamped.transform.rotation.w = msg->pose.orientation.w;
+		transformStamped.transform.translation.x = msg.pose.position.x;
+		transformStamped.transform.translation.y = msg.pose.position.y;
+		transformStamped.transform.translation.z = msg.pose.position.z;
+		transformStamped.transform.rotation.x = msg.pose.orientation.x;
+		transformStamped.transform.rotation.y = msg.pose.orientation.y;
+		transformStamped.transform.rotation.z = msg.pose.orientation.z;
+		transformStamped.transform.rotation.w = msg.pose.orientation.w;
 		br_.sendTransform(transformStamped);
 	}
 
-    void Localizer::publishPoseStamped(const geometry_msgs::PoseStampedConstPtr& msg)
+    void Localizer::publishPoseStamped(const geometry_msgs::PoseStamped& msg)
 	{
 		pose_pub_.publish(msg);
 		publishTransform(msg);
@@ -46,29 +47,53 @@ namespace localizer
 	{
         if(localization_mode_ == LocalizerMode::NDT)
         {
-            publishPoseStamped(msg);
-        } else if(localization_mode_ == LocalizerMode::AUTO &&
-					counter.getNDTReliabilityCounter() <= unreliable_message_upper_limit_)
+            publishPoseStamped(*msg);
+        } else if(localization_mode_ == LocalizerMode::AUTO)
         {
-			publishPoseStamped(msg);
+			arbitrator_->addNDTPose(*msg);
         }
 	}
     
     void Localizer::ndtScoreCallback(const autoware_msgs::NDTStatConstPtr& msg)
 	{
 		counter.onNDTScore(msg->score);
+		if(localization_mode_ == LocalizerMode::AUTO)
+		{
+			arbitrator_->addNDTScore(msg->header.stamp, msg->score);
+		}
 	}
 
 	void Localizer::gnssPoseCallback(const geometry_msgs::PoseStampedConstPtr& msg)
 	{
 		if(localization_mode_ == LocalizerMode::GNSS)
 		{
-			publishPoseStamped(msg);
-		} else if(localization_mode_ == LocalizerMode::AUTO &&
-					counter.getNDTReliabilityCounter() > unreliable_message_upper_limit_)
+			publishPoseStamped(*msg);
+		} else if(localization_mode_ == LocalizerMode::AUTO)
+		{
+			arbitrator_->addGNSSPose(*msg);
+		}
+	}
+
+	void Localizer::outputTimerCallback(const ros::TimerEvent& event)
+	{
+		geometry_msgs::PoseStamped pose;
+		if(arbitrator_->getPose(ros::Time::now(), pose))
+		{
+			publishPoseStamped(pose);
+		}
+	}
+
+	void Localizer::statsTimerCallback(const ros::TimerEvent& event)
+	{
+		const PoseArbitratorStats& stats = arbitrator_->getStats();
+		if(stats.outputs == 0)
 		{
-			publishPoseStamped(msg);
+			return;
 		}
+		ROS_INFO_STREAM("Pose arbitration outputs: " << stats.outputs << " ndt: " << stats.ndt_outputs
+						<< " gnss: " << stats.gnss_outputs << " source switches: " << stats.source_switches
+						<< " unmatched scores: " << stats.unmatched_scores
+						<< " mean latency: " << stats.total_latency / stats.outputs << " s max latency: " << stats.max_latency << " s");
 	}
 
 	void Localizer::run()
@@ -83,6 +108,30 @@ namespace localizer
 		pnh_->param<int>("localization_mode", localization_mode_, 0);
 		// initialize counter
 		counter = NDTReliabilityCounter(score_upper_limit_, unreliable_message_upper_limit_);
+		// initialize time synchronized arbitration for auto mode
+		PoseArbitratorConfig config;
+		config.score_upper_limit = score_upper_limit_;
+		config.unreliable_message_upper_limit = unreliable_message_upper_limit_;
+		int buffer_size = static_cast<int>(config.buffer_size);
+		pnh_->param<int>("pose_buffer_size", buffer_size, buffer_size);
+		config.buffer_size = static_cast<size_t>(std::max(buffer_size, 2));
+		pnh_->param<double>("score_match_tolerance", config.score_match_tolerance, config.score_match_tolerance);
+		pnh_->param<double>("max_interpolation_gap", config.max_interpolation_gap, config.max_interpolation_gap);
+		pnh_->param<double>("output_delay", config.output_delay, config.output_delay);
+		pnh_->param<double>("blend_duration", config.blend_duration, config.blend_duration);
+		double output_rate = 20.0;
+		pnh_->param<double>("output_rate", output_rate, output_rate);
+		double stats_period = 30.0;
+		pnh_->param<double>("stats_log_period", stats_period, stats_period);
+		arbitrator_.reset(new PoseArbitrator(config));
+		if(localization_mode_ == LocalizerMode::AUTO)
+		{
+			output_timer_ = nh_->createTimer(ros::Duration(1.0 / output_rate), &Localizer::outputTimerCallback, this);
+			if(stats_period > 0)
+			{
+				stats_timer_ = nh_->createTimer(ros::Duration(stats_period), &Localizer::statsTimerCallback, this);
+			}
+		}
 		// initialize subscribers
 		ndt_pose_sub_ = nh_->subscribe("ndt_pose", 5, &Localizer::ndtPoseCallback, this);
 		ndt_score_sub_ = nh_->subscribe("ndt_stat", 5, &Localizer::ndtScoreCallback, this);
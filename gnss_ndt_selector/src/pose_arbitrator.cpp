@@ -0,0 +1,298 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "pose_arbitrator.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <tf2/LinearMath/Quaternion.h>
+#include <tf2_geometry_msgs/tf2_geometry_msgs.h>
+
+namespace localizer
+{
+    namespace
+    {
+        const geometry_msgs::PoseStamped& poseOf(const geometry_msgs::PoseStamped& sample)
+        {
+            return sample;
+        }
+
+        template <class Sample>
+        const geometry_msgs::PoseStamped& poseOf(const Sample& sample)
+        {
+            return sample.pose;
+        }
+
+        // first sample with a stamp not before time
+        template <class Buffer>
+        typename Buffer::const_iterator lowerBound(const Buffer& buffer, const ros::Time& time)
+        {
+            return std::lower_bound(buffer.begin(), buffer.end(), time,
+                [](const typename Buffer::value_type& sample, const ros::Time& t) { return poseOf(sample).header.stamp < t; });
+        }
+
+        // inserts a sample keeping the buffer ordered by stamp and bounded in size
+        template <class Buffer>
+        void insertSample(Buffer& buffer, const typename Buffer::value_type& sample, size_t max_size)
+        {
+            const ros::Time& stamp = poseOf(sample).header.stamp;
+            if (buffer.empty() || poseOf(buffer.back()).header.stamp < stamp)
+            {
+                buffer.push_back(sample); // common case of in order arrival
+            } else
+            {
+                buffer.insert(lowerBound(buffer, stamp), sample);
+            }
+            while (buffer.size() > max_size)
+            {
+                buffer.pop_front();
+            }
+        }
+
+        // pose at time from the surrounding samples. Past the newest sample that sample is held for up to max_gap with
+        // its own stamp, it is not extrapolated and not restamped with the requested time
+        template <class Buffer>
+        bool interpolateBuffer(const Buffer& buffer, const ros::Time& time, double max_gap, geometry_msgs::PoseStamped& pose)
+        {
+            if (buffer.empty() || time < poseOf(buffer.front()).header.stamp)
+            {
+                return false;
+            }
+
+            auto after = lowerBound(buffer, time);
+            if (after == buffer.end())
+            {
+                const geometry_msgs::PoseStamped& newest = poseOf(buffer.back());
+                if ((time - newest.header.stamp).toSec() > max_gap)
+                {
+                    return false;
+                }
+                pose = newest;
+                return true;
+            } else if (poseOf(*after).header.stamp == time)
+            {
+                pose = poseOf(*after);
+            } else
+            {
+                const geometry_msgs::PoseStamped& a = poseOf(*std::prev(after));
+                const geometry_msgs::PoseStamped& b = poseOf(*after);
+                double gap = (b.header.stamp - a.header.stamp).toSec();
+                if (gap > max_gap)
+                {
+                    return false;
+                }
+                pose.header = a.header;
+                pose.pose = interpolatePose(a.pose, b.pose, (time - a.header.stamp).toSec() / gap);
+            }
+            pose.header.stamp = time;
+            return true;
+        }
+    }
+
+    geometry_msgs::Pose interpolatePose(const geometry_msgs::Pose& a, const geometry_msgs::Pose& b, double ratio)
+    {
+        geometry_msgs::Pose pose;
+        pose.position.x = a.position.x + (b.position.x - a.position.x) * ratio;
+        pose.position.y = a.position.y + (b.position.y - a.position.y) * ratio;
+        pose.position.z = a.position.z + (b.position.z - a.position.z) * ratio;
+
+        tf2::Quaternion qa, qb;
+        tf2::fromMsg(a.orientation, qa);
+        tf2::fromMsg(b.orientation, qb);
+        pose.orientation = tf2::toMsg(qa.slerp(qb, ratio));
+        return pose;
+    }
+
+    PoseArbitrator::PoseArbitrator(const PoseArbitratorConfig& config) :
+                                   config_(config),
+                                   counter_(config.score_upper_limit, config.unreliable_message_upper_limit) {}
+
+    void PoseArbitrator::addNDTPose(const geometry_msgs::PoseStamped& pose)
+    {
+        NDTSample sample;
+        sample.pose = pose;
+
+        // a score may have arrived before its pose
+        for (auto it = pending_scores_.begin(); it != pending_scores_.end(); ++it)
+        {
+            if (std::fabs((it->stamp - pose.header.stamp).toSec()) <= config_.score_match_tolerance)
+            {
+                applyScore(sample, it->score);
+                pending_scores_.erase(it);
+                break;
+            }
+        }
+
+        insertSample(ndt_poses_, sample, config_.buffer_size);
+    }
+
+    void PoseArbitrator::addNDTScore(const ros::Time& stamp, double score)
+    {
+        // match to the unscored pose closest in time
+        NDTSample* match = nullptr;
+        double best = config_.score_match_tolerance;
+        for (auto& sample : ndt_poses_)
+        {
+            double diff = std::fabs((sample.pose.header.stamp - stamp).toSec());
+            if (!sample.scored && diff <= best)
+            {
+                match = &sample;
+                best = diff;
+            }
+        }
+
+        if (match)
+        {
+            applyScore(*match, score);
+            return;
+        }
+
+        pending_scores_.push_back({ stamp, score });
+        while (pending_scores_.size() > config_.buffer_size)
+        {
+            pending_scores_.pop_front();
+            stats_.unmatched_scores++;
+        }
+    }
+
+    void PoseArbitrator::addGNSSPose(const geometry_msgs::PoseStamped& pose)
+    {
+        insertSample(gnss_poses_, pose, config_.buffer_size);
+    }
+
+    void PoseArbitrator::applyScore(NDTSample& sample, double score)
+    {
+        counter_.onNDTScore(score);
+        sample.scored = true;
+        sample.reliable = counter_.getNDTReliabilityCounter() <= config_.unreliable_message_upper_limit;
+    }
+
+    const PoseArbitrator::NDTSample* PoseArbitrator::newestScoredNDT(const ros::Time& time) const
+    {
+        auto it = lowerBound(ndt_poses_, time);
+        if (it != ndt_poses_.end() && it->pose.header.stamp == time)
+        {
+            ++it;
+        }
+        while (it != ndt_poses_.begin())
+        {
+            --it;
+            if (it->scored)
+            {
+                return &(*it);
+            }
+        }
+        return nullptr;
+    }
+
+    PoseSource PoseArbitrator::selectSource(const ros::Time& time) const
+    {
+        if (ndt_poses_.empty())
+        {
+            return PoseSource::GNSS;
+        }
+
+        // the newest scored ndt pose at or before the time decides. Poses which are not scored yet keep the current
+        // selection so a late score cannot switch the source in the middle of a cycle
+        const NDTSample* scored = newestScoredNDT(time);
+        if (scored)
+        {
+            return scored->reliable ? PoseSource::NDT : PoseSource::GNSS;
+        }
+        return source_ == PoseSource::NONE ? PoseSource::NDT : source_;
+    }
+
+    bool PoseArbitrator::sourcePose(PoseSource source, const ros::Time& time, geometry_msgs::PoseStamped& pose) const
+    {
+        if (source == PoseSource::NDT)
+        {
+            return interpolateBuffer(ndt_poses_, time, config_.max_interpolation_gap, pose);
+        } else if (source == PoseSource::GNSS)
+        {
+            return interpolateBuffer(gnss_poses_, time, config_.max_interpolation_gap, pose);
+        }
+        return false;
+    }
+
+    bool PoseArbitrator::getPose(const ros::Time& now, geometry_msgs::PoseStamped& pose)
+    {
+        ros::Time time = now - ros::Duration(config_.output_delay);
+
+        PoseSource selected = selectSource(time);
+        const NDTSample* scored_ndt = newestScoredNDT(time);
+        bool ndt_reliable = scored_ndt && scored_ndt->reliable;
+        bool ndt_unreliable = scored_ndt && !scored_ndt->reliable;
+
+        geometry_msgs::PoseStamped selected_pose;
+        if (!sourcePose(selected, time, selected_pose))
+        {
+            // fall back to the other source while the selected one has no data. Ndt is only used in place of gnss
+            // while it is known to be reliable, otherwise no pose is better than an unreliable one
+            if (selected == PoseSource::GNSS && !ndt_reliable)
+            {
+                return false;
+            }
+            selected = selected == PoseSource::NDT ? PoseSource::GNSS : PoseSource::NDT;
+            if (!sourcePose(selected, time, selected_pose))
+            {
+                return false;
+            }
+        }
+
+        if (selected != source_)
+        {
+            if (source_ != PoseSource::NONE)
+            {
+                stats_.source_switches++;
+                blend_from_ = source_;
+                blend_start_ = time;
+            }
+            source_ = selected;
+        }
+
+        pose = selected_pose;
+
+        // an ndt source which was dropped as unreliable is not blended from, the output jumps to the new source
+        double blend_elapsed = (time - blend_start_).toSec();
+        geometry_msgs::PoseStamped previous_pose;
+        if (blend_from_ != PoseSource::NONE && blend_elapsed < config_.blend_duration &&
+            !(blend_from_ == PoseSource::NDT && ndt_unreliable) && sourcePose(blend_from_, time, previous_pose))
+        {
+            pose.pose = interpolatePose(previous_pose.pose, selected_pose.pose, blend_elapsed / config_.blend_duration);
+        } else
+        {
+            blend_from_ = PoseSource::NONE;
+        }
+
+        const ros::Time& newest = source_ == PoseSource::NDT ? ndt_poses_.back().pose.header.stamp : gnss_poses_.back().header.stamp;
+        double latency = std::max(0.0, (now - newest).toSec());
+        stats_.outputs++;
+        (source_ == PoseSource::NDT ? stats_.ndt_outputs : stats_.gnss_outputs)++;
+        stats_.total_latency += latency;
+        stats_.max_latency = std::max(stats_.max_latency, latency);
+        return true;
+    }
+
+    PoseSource PoseArbitrator::getSource() const
+    {
+        return source_;
+    }
+
+    const PoseArbitratorStats& PoseArbitrator::getStats() const
+    {
+        return stats_;
+    }
+}
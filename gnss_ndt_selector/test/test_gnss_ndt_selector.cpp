@@ -15,6 +15,7 @@
  */
 
 #include "ndt_reliability_counter.h"
+#include "pose_arbitrator.h"
 #include <gtest/gtest.h>
 #include <ros/ros.h>
 
@@ -70,6 +71,197 @@ TEST(GnssNdtSelectorTest, testReliabilityCounter)
     EXPECT_EQ(0, counter.getNDTReliabilityCounter());
 }
 
+namespace
+{
+    geometry_msgs::PoseStamped getPose(double stamp, double x)
+    {
+        geometry_msgs::PoseStamped pose;
+        pose.header.stamp = ros::Time(stamp);
+        pose.header.frame_id = "map";
+        pose.pose.position.x = x;
+        pose.pose.orientation.w = 1.0;
+        return pose;
+    }
+}
+
+TEST(GnssNdtSelectorTest, testArbitratorInterpolation)
+{
+    localizer::PoseArbitratorConfig config;
+    config.output_delay = 0.1;
+    localizer::PoseArbitrator arbitrator(config);
+
+    geometry_msgs::PoseStamped out;
+    EXPECT_FALSE(arbitrator.getPose(ros::Time(10.0), out));
+
+    arbitrator.addNDTPose(getPose(10.0, 0.0));
+    arbitrator.addNDTPose(getPose(10.2, 2.0));
+    arbitrator.addNDTScore(ros::Time(10.0), 0.5);
+    arbitrator.addNDTScore(ros::Time(10.2), 0.5);
+
+    // output is delayed and interpolated between the buffered poses
+    ASSERT_TRUE(arbitrator.getPose(ros::Time(10.2), out));
+    EXPECT_EQ(localizer::PoseSource::NDT, arbitrator.getSource());
+    EXPECT_EQ(ros::Time(10.1), out.header.stamp);
+    EXPECT_NEAR(1.0, out.pose.position.x, 0.0001);
+    EXPECT_EQ("map", out.header.frame_id);
+
+    // poses arriving out of order are kept sorted
+    arbitrator.addNDTPose(getPose(10.1, 5.0));
+    ASSERT_TRUE(arbitrator.getPose(ros::Time(10.2), out));
+    EXPECT_NEAR(5.0, out.pose.position.x, 0.0001);
+
+    // the newest pose is held for at most max_interpolation_gap and keeps its own stamp
+    ASSERT_TRUE(arbitrator.getPose(ros::Time(10.6), out));
+    EXPECT_NEAR(2.0, out.pose.position.x, 0.0001);
+    EXPECT_EQ(ros::Time(10.2), out.header.stamp);
+    EXPECT_FALSE(arbitrator.getPose(ros::Time(11.0), out));
+}
+
+TEST(GnssNdtSelectorTest, testArbitratorScoreMatching)
+{
+    localizer::PoseArbitratorConfig config;
+    config.unreliable_message_upper_limit = 0;
+    config.blend_duration = 0.0;
+    localizer::PoseArbitrator arbitrator(config);
+
+    for (int i = 0; i <= 10; i++)
+    {
+        arbitrator.addNDTPose(getPose(10.0 + i * 0.1, 0.0));
+        arbitrator.addGNSSPose(getPose(10.0 + i * 0.1, 100.0));
+    }
+    for (int i = 0; i <= 5; i++)
+    {
+        arbitrator.addNDTScore(ros::Time(10.0 + i * 0.1), 0.5);
+    }
+
+    geometry_msgs::PoseStamped out;
+    ASSERT_TRUE(arbitrator.getPose(ros::Time(10.4), out));
+    EXPECT_EQ(localizer::PoseSource::NDT, arbitrator.getSource());
+
+    // a bad score for a later pose does not affect the output for earlier times
+    arbitrator.addNDTScore(ros::Time(10.8), 50.0);
+    ASSERT_TRUE(arbitrator.getPose(ros::Time(10.6), out));
+    EXPECT_EQ(localizer::PoseSource::NDT, arbitrator.getSource());
+    EXPECT_NEAR(0.0, out.pose.position.x, 0.0001);
+
+    // once the output reaches the unreliable pose the source switches
+    ASSERT_TRUE(arbitrator.getPose(ros::Time(10.9), out));
+    EXPECT_EQ(localizer::PoseSource::GNSS, arbitrator.getSource());
+    EXPECT_NEAR(100.0, out.pose.position.x, 0.0001);
+    EXPECT_EQ(1u, arbitrator.getStats().source_switches);
+
+    // a score received before its pose is matched when the pose arrives
+    arbitrator.addNDTScore(ros::Time(11.1), 0.5);
+    arbitrator.addNDTPose(getPose(11.1, 0.0));
+    arbitrator.addGNSSPose(getPose(11.1, 100.0));
+    ASSERT_TRUE(arbitrator.getPose(ros::Time(11.2), out));
+    EXPECT_EQ(localizer::PoseSource::NDT, arbitrator.getSource());
+    EXPECT_EQ(2u, arbitrator.getStats().source_switches);
+    EXPECT_EQ(0u, arbitrator.getStats().unmatched_scores);
+}
+
+TEST(GnssNdtSelectorTest, testArbitratorBlending)
+{
+    localizer::PoseArbitratorConfig config;
+    config.unreliable_message_upper_limit = 0;
+    config.blend_duration = 0.4;
+    config.output_delay = 0.0;
+    localizer::PoseArbitrator arbitrator(config);
+
+    for (int i = 0; i <= 10; i++)
+    {
+        arbitrator.addNDTPose(getPose(10.0 + i * 0.1, 0.0));
+        arbitrator.addGNSSPose(getPose(10.0 + i * 0.1, 10.0));
+        arbitrator.addNDTScore(ros::Time(10.0 + i * 0.1), i < 3 ? 50.0 : 0.5);
+    }
+
+    geometry_msgs::PoseStamped out;
+    ASSERT_TRUE(arbitrator.getPose(ros::Time(10.2), out));
+    EXPECT_EQ(localizer::PoseSource::GNSS, arbitrator.getSource());
+    EXPECT_NEAR(10.0, out.pose.position.x, 0.0001);
+
+    // the output moves from gnss to ndt over the blend duration instead of jumping
+    ASSERT_TRUE(arbitrator.getPose(ros::Time(10.3), out));
+    EXPECT_EQ(localizer::PoseSource::NDT, arbitrator.getSource());
+    EXPECT_NEAR(10.0, out.pose.position.x, 0.0001);
+    ASSERT_TRUE(arbitrator.getPose(ros::Time(10.5), out));
+    EXPECT_NEAR(5.0, out.pose.position.x, 0.0001);
+    ASSERT_TRUE(arbitrator.getPose(ros::Time(10.7), out));
+    EXPECT_NEAR(0.0, out.pose.position.x, 0.0001);
+    EXPECT_EQ(4u, arbitrator.getStats().outputs);
+    EXPECT_EQ(3u, arbitrator.getStats().ndt_outputs);
+}
+
+TEST(GnssNdtSelectorTest, testArbitratorNoBlendFromUnreliable)
+{
+    localizer::PoseArbitratorConfig config;
+    config.unreliable_message_upper_limit = 0;
+    config.blend_duration = 0.4;
+    config.output_delay = 0.0;
+    localizer::PoseArbitrator arbitrator(config);
+
+    for (int i = 0; i <= 10; i++)
+    {
+        arbitrator.addNDTPose(getPose(10.0 + i * 0.1, 0.0));
+        arbitrator.addGNSSPose(getPose(10.0 + i * 0.1, 10.0));
+        arbitrator.addNDTScore(ros::Time(10.0 + i * 0.1), i < 5 ? 0.5 : 50.0);
+    }
+
+    geometry_msgs::PoseStamped out;
+    ASSERT_TRUE(arbitrator.getPose(ros::Time(10.4), out));
+    EXPECT_NEAR(0.0, out.pose.position.x, 0.0001);
+
+    // ndt was dropped as unreliable so the output jumps to gnss
+    ASSERT_TRUE(arbitrator.getPose(ros::Time(10.5), out));
+    EXPECT_EQ(localizer::PoseSource::GNSS, arbitrator.getSource());
+    EXPECT_NEAR(10.0, out.pose.position.x, 0.0001);
+    ASSERT_TRUE(arbitrator.getPose(ros::Time(10.7), out));
+    EXPECT_NEAR(10.0, out.pose.position.x, 0.0001);
+    EXPECT_EQ(1u, arbitrator.getStats().source_switches);
+}
+
+TEST(GnssNdtSelectorTest, testArbitratorNoFallbackToUnreliable)
+{
+    localizer::PoseArbitratorConfig config;
+    config.unreliable_message_upper_limit = 0;
+    config.blend_duration = 0.0;
+    config.output_delay = 0.0;
+    config.max_interpolation_gap = 0.5;
+    localizer::PoseArbitrator arbitrator(config);
+
+    for (int i = 0; i <= 10; i++)
+    {
+        arbitrator.addNDTPose(getPose(10.0 + i * 0.1, 0.0));
+        arbitrator.addNDTScore(ros::Time(10.0 + i * 0.1), i < 5 ? 0.5 : 50.0);
+    }
+    for (int i = 0; i <= 2; i++)
+    {
+        arbitrator.addGNSSPose(getPose(10.0 + i * 0.1, 10.0));
+    }
+
+    geometry_msgs::PoseStamped out;
+    ASSERT_TRUE(arbitrator.getPose(ros::Time(10.4), out));
+    EXPECT_EQ(localizer::PoseSource::NDT, arbitrator.getSource());
+
+    // gnss is selected and its newest pose is still within max_interpolation_gap
+    ASSERT_TRUE(arbitrator.getPose(ros::Time(10.6), out));
+    EXPECT_EQ(localizer::PoseSource::GNSS, arbitrator.getSource());
+    EXPECT_NEAR(10.0, out.pose.position.x, 0.0001);
+    EXPECT_EQ(ros::Time(10.2), out.header.stamp);
+
+    // gnss has no pose within max_interpolation_gap and ndt is unreliable, so there is no output
+    EXPECT_FALSE(arbitrator.getPose(ros::Time(10.8), out));
+    EXPECT_EQ(2u, arbitrator.getStats().outputs);
+
+    // while ndt is selected and has no data gnss is still used in its place
+    arbitrator.addNDTScore(ros::Time(11.1), 0.5);
+    arbitrator.addNDTPose(getPose(11.1, 0.0));
+    arbitrator.addGNSSPose(getPose(11.8, 10.0));
+    ASSERT_TRUE(arbitrator.getPose(ros::Time(11.8), out));
+    EXPECT_EQ(localizer::PoseSource::GNSS, arbitrator.getSource());
+    EXPECT_NEAR(10.0, out.pose.position.x, 0.0001);
+}
+
 // Run all the tests
 int main(int argc, char **argv)
 {
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2018-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <gnss_to_map_convertor/GNSSToMapConvertor.h>
+#include <vector>
+
+namespace gnss_to_map_convertor
+{
+namespace
+{
+std::vector<gps_common::GPSFix> buildFixes(size_t count)
+{
+  std::vector<gps_common::GPSFix> fixes(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    fixes[i].latitude = 38.95 + i * 1e-6;
+    fixes[i].longitude = -77.14 - i * 1e-6;
+    fixes[i].altitude = 70.0;
+    fixes[i].track = static_cast<double>(i % 360);
+  }
+  return fixes;
+}
+
+tf2::Transform sensorInNedHeading()
+{
+  tf2::Quaternion rotation;
+  rotation.setRPY(wgs84_utils::pi, 0, 0);
+  return tf2::Transform(rotation, tf2::Vector3(0, 0, 0));
+}
+
+const tf2::Transform BASELINK_IN_SENSOR(tf2::Quaternion::getIdentity(), tf2::Vector3(-1.5, 0.2, -1.0));
+const tf2::Transform MAP_IN_EARTH(tf2::Quaternion(0, 0, 0.7071068, 0.7071068), tf2::Vector3(1106000.0, -4844000.0, 3987000.0));
+
+/*!
+ * \brief Conversion of a single fix as previously done by GNSSToMapNode, with the NED frame built by wgs84_utils and the
+ *        map transform inverted for every message
+ */
+geometry_msgs::Pose legacyConversion(const tf2::Transform& baselink_in_sensor, const tf2::Transform& sensor_in_ned_heading,
+                                     const gps_common::GPSFix& fix, const tf2::Transform& map_in_earth)
+{
+  const struct wgs84_utils::wgs84_coordinate geo_point = { fix.latitude * wgs84_utils::DEG2RAD,
+                                                           fix.longitude * wgs84_utils::DEG2RAD, 0, fix.altitude };
+  const tf2::Transform T_e_n = wgs84_utils::ecef_to_ned_from_loc(geo_point);
+  tf2::Quaternion heading_in_ned_quat;
+  heading_in_ned_quat.setRPY(0, 0, fix.track * wgs84_utils::DEG2RAD);
+  const tf2::Transform T_e_b =
+      T_e_n * tf2::Transform(heading_in_ned_quat, tf2::Vector3(0, 0, 0)) * sensor_in_ned_heading * baselink_in_sensor;
+  return ecefTFToMapPose(T_e_b, map_in_earth);
+}
+}  // namespace
+
+static void BM_GnssToMapLegacy(benchmark::State& state)
+{
+  auto fixes = buildFixes(state.range(0));
+  const tf2::Transform sensor_in_ned_heading = sensorInNedHeading();
+  for (auto _ : state)
+  {
+    for (const auto& fix : fixes)
+    {
+      benchmark::DoNotOptimize(legacyConversion(BASELINK_IN_SENSOR, sensor_in_ned_heading, fix, MAP_IN_EARTH));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * fixes.size());
+}
+BENCHMARK(BM_GnssToMapLegacy)->Arg(1000);
+
+static void BM_GnssToMapSingle(benchmark::State& state)
+{
+  auto fixes = buildFixes(state.range(0));
+  std::vector<gps_common::GPSFixConstPtr> fix_ptrs;
+  for (const auto& fix : fixes)
+  {
+    fix_ptrs.emplace_back(new gps_common::GPSFix(fix));
+  }
+  const tf2::Transform sensor_in_ned_heading = sensorInNedHeading();
+  const tf2::Transform earth_in_map = MAP_IN_EARTH.inverse();  // Cached by the node
+  for (auto _ : state)
+  {
+    for (const auto& fix : fix_ptrs)
+    {
+      auto ecef_pose = poseFromGnss(BASELINK_IN_SENSOR, sensor_in_ned_heading, fix);
+      tf2::Transform base_link_in_earth(
+          tf2::Quaternion(ecef_pose.pose.pose.orientation.x, ecef_pose.pose.pose.orientation.y,
+                          ecef_pose.pose.pose.orientation.z, ecef_pose.pose.pose.orientation.w),
+          tf2::Vector3(ecef_pose.pose.pose.position.x, ecef_pose.pose.pose.position.y, ecef_pose.pose.pose.position.z));
+      benchmark::DoNotOptimize(ecefTFToMapPoseFromInverse(base_link_in_earth, earth_in_map));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * fixes.size());
+}
+BENCHMARK(BM_GnssToMapSingle)->Arg(1000);
+
+static void BM_GnssToMapBatch(benchmark::State& state)
+{
+  auto fixes = buildFixes(state.range(0));
+  const tf2::Transform sensor_in_ned_heading = sensorInNedHeading();
+  const tf2::Transform earth_in_map = MAP_IN_EARTH.inverse();
+  std::vector<geometry_msgs::Pose> ecef_poses;
+  std::vector<geometry_msgs::Pose> map_poses;
+  for (auto _ : state)
+  {
+    posesFromGnss(BASELINK_IN_SENSOR, sensor_in_ned_heading, fixes, ecef_poses);
+    ecefPosesToMapPoses(ecef_poses, earth_in_map, map_poses);
+    benchmark::DoNotOptimize(map_poses.data());
+  }
+  state.SetItemsProcessed(state.iterations() * fixes.size());
+}
+BENCHMARK(BM_GnssToMapBatch)->Arg(1000);
+
+}  // namespace gnss_to_map_convertor
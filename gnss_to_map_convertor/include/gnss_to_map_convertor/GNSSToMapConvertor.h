@@ -24,6 +24,7 @@
 #include <geometry_msgs/PoseWithCovarianceStamped.h>
 #include <geometry_msgs/Pose.h>
 #include <gps_common/GPSFix.h>
+#include <vector>
 
 /**
  * \class GNSSToMapNode
@@ -59,4 +60,76 @@ namespace gnss_to_map_convertor
    */ 
   geometry_msgs::Pose ecefTFToMapPose(const tf2::Transform& baselink_in_earth, const tf2::Transform& map_in_earth);
 
+  /**
+   * \brief Same as ecefTFToMapPose but takes the already inverted map_in_earth transform so callers which convert
+   *        many poses against the same map only invert it once
+   * 
+   * \param baselink_in_earth Transform describing location of base_link frame in the earth frame
+   * \param earth_in_map Transform describing location of earth frame in the map frame
+   * 
+   * \return geometry_msgs::Pose containing the pose of the vehicle in the map frame
+   */ 
+  geometry_msgs::Pose ecefTFToMapPoseFromInverse(const tf2::Transform& baselink_in_earth, const tf2::Transform& earth_in_map);
+
+  /**
+   * \brief Sines and cosines of a geodetic location. Computing them once allows the NED frame and ECEF position of the
+   *        location to be built without further trigonometric calls
+   */ 
+  struct GeodeticTrig
+  {
+    double sin_lat;
+    double cos_lat;
+    double sin_lon;
+    double cos_lon;
+    double alt; // Height above the WGS84 ellipsoid in meters
+  };
+
+  /**
+   * \brief Computes the trigonometric terms of a geodetic location
+   * 
+   * \param lat Latitude in radians
+   * \param lon Longitude in radians
+   * \param alt Height above the WGS84 ellipsoid in meters
+   */ 
+  GeodeticTrig geodeticTrig(double lat, double lon, double alt);
+
+  /**
+   * \brief Fast path equivalent of wgs84_utils::ecef_to_ned_from_loc using precomputed trigonometric terms
+   * 
+   * \param trig The trigonometric terms of the location of the NED frame origin
+   * 
+   * \return Transform describing the location of the NED frame in the ECEF frame
+   */ 
+  tf2::Transform nedInEcef(const GeodeticTrig& trig);
+
+  /**
+   * \brief Batch version of poseFromGnss for replay and offline tooling. The trigonometric terms of all fixes are computed
+   *        in one pass over contiguous arrays before the poses are composed, and the transforms shared by all fixes are
+   *        combined once.
+   * 
+   * \param baselink_in_sensor Transform describing the location of the base_link frame in the gnss sensor frame
+   * \param sensor_in_ned_heading Transform describing the location of the sensor frame in the frame in which that sensor reports its heading
+   * \param fixes The fixes to convert
+   * \param[out] ecef_poses The pose of base_link in the earth frame for each fix. Resized to match fixes
+   */ 
+  void posesFromGnss(
+    const tf2::Transform& baselink_in_sensor,
+    const tf2::Transform& sensor_in_ned_heading,
+    const std::vector<gps_common::GPSFix>& fixes,
+    std::vector<geometry_msgs::Pose>& ecef_poses
+  );
+
+  /**
+   * \brief Batch version of ecefTFToMapPoseFromInverse
+   * 
+   * \param ecef_poses Poses of base_link in the earth frame
+   * \param earth_in_map Transform describing location of earth frame in the map frame
+   * \param[out] map_poses The pose of base_link in the map frame for each input pose. Resized to match ecef_poses
+   */ 
+  void ecefPosesToMapPoses(
+    const std::vector<geometry_msgs::Pose>& ecef_poses,
+    const tf2::Transform& earth_in_map,
+    std::vector<geometry_msgs::Pose>& map_poses
+  );
+
 };
\ No newline at end of file
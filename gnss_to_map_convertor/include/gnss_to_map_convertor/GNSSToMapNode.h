@@ -29,6 +29,7 @@
 #include <novatel_gps_msgs/NovatelXYZ.h>
 #include <gnss_to_map_convertor/GNSSToMapConvertor.h>
 #include <carma_utils/CARMAUtils.h>
+#include <tf2_msgs/TFMessage.h>
 
 namespace gnss_to_map_convertor {
   /**
@@ -54,6 +55,7 @@ namespace gnss_to_map_convertor {
       ros::Publisher map_pose_pub_;
 
       ros::Subscriber fix_sub_;
+      ros::Subscriber tf_static_sub_;
 
       tf2::Transform baselink_in_sensor_; 
       tf2::Transform sensor_in_ned_; 
@@ -63,6 +65,26 @@ namespace gnss_to_map_convertor {
       std::string map_frame_ = "map";
       std::string ned_heading_frame_ = "ned_heading";
 
+      // Cached location of the map in the earth frame and its inverse. Refreshed when /tf_static changes or the
+      // refresh period elapses
+      tf2::Transform map_in_earth_;
+      tf2::Transform earth_in_map_;
+      bool map_in_earth_set_ = false;
+      ros::Time map_in_earth_lookup_time_;
+      ros::Duration map_transform_refresh_period_ = ros::Duration(1.0);
+
+      /**
+       * @brief Updates the cached map in earth transform if it is missing or out of date
+       * 
+       * @return True if a map in earth transform is available
+       */ 
+      bool updateMapInEarth();
+
+      /**
+       * @brief /tf_static callback which invalidates the cached map in earth transform
+       */ 
+      void tfStaticCb(const tf2_msgs::TFMessageConstPtr& msg);
+
       /**
        * @brief GPSFix callback which publishes the updated ecef and map poses
        * 
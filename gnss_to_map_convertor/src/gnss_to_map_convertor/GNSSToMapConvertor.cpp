@@ -15,26 +15,71 @@
  */
 
 #include <gnss_to_map_convertor/GNSSToMapConvertor.h>
+#include <cmath>
 
 namespace gnss_to_map_convertor {
 
+  namespace {
+    // WGS84 ellipsoid
+    const double WGS84_SEMI_MAJOR_AXIS = 6378137.0; // meters
+    const double WGS84_ECCENTRICITY_SQR = 6.69437999014e-3;
+
+    void transformToPose(const tf2::Transform& tf, geometry_msgs::Pose& pose) {
+      pose.position.x = tf.getOrigin().getX();
+      pose.position.y = tf.getOrigin().getY();
+      pose.position.z = tf.getOrigin().getZ();
+
+      const tf2::Quaternion rotation = tf.getRotation();
+      pose.orientation.x = rotation.getX();
+      pose.orientation.y = rotation.getY();
+      pose.orientation.z = rotation.getZ();
+      pose.orientation.w = rotation.getW();
+    }
+
+    // Rotation about the NED down axis. Equivalent to setRPY(0, 0, yaw) given the sine and cosine of yaw / 2
+    tf2::Transform headingInNed(double sin_half_yaw, double cos_half_yaw) {
+      return tf2::Transform(tf2::Quaternion(0, 0, sin_half_yaw, cos_half_yaw), tf2::Vector3(0, 0, 0));
+    }
+  }
+
   geometry_msgs::Pose ecefTFToMapPose(const tf2::Transform& baselink_in_earth, const tf2::Transform& map_in_earth){
 
     const tf2::Transform T_m_e = map_in_earth.inverse(); // T_e_m^-1 = T_m_e
 
-    const tf2::Transform T_m_b = T_m_e * baselink_in_earth; // T_m_b = T_m_e * T_e_b
+    return ecefTFToMapPoseFromInverse(baselink_in_earth, T_m_e);
+  }
+
+  geometry_msgs::Pose ecefTFToMapPoseFromInverse(const tf2::Transform& baselink_in_earth, const tf2::Transform& earth_in_map){
+
+    const tf2::Transform T_m_b = earth_in_map * baselink_in_earth; // T_m_b = T_m_e * T_e_b
   
     geometry_msgs::Pose pose;
-    pose.position.x = T_m_b.getOrigin().getX();
-    pose.position.y = T_m_b.getOrigin().getY();
-    pose.position.z = T_m_b.getOrigin().getZ();
+    transformToPose(T_m_b, pose);
+    return pose;
+  }
 
-    pose.orientation.x = T_m_b.getRotation().getX();
-    pose.orientation.y = T_m_b.getRotation().getY();
-    pose.orientation.z = T_m_b.getRotation().getZ();
-    pose.orientation.w = T_m_b.getRotation().getW();
+  GeodeticTrig geodeticTrig(double lat, double lon, double alt) {
+    return { std::sin(lat), std::cos(lat), std::sin(lon), std::cos(lon), alt };
+  }
 
-    return pose;
+  tf2::Transform nedInEcef(const GeodeticTrig& trig) {
+    // Prime vertical radius of curvature
+    const double Rn = WGS84_SEMI_MAJOR_AXIS / std::sqrt(1.0 - WGS84_ECCENTRICITY_SQR * trig.sin_lat * trig.sin_lat);
+
+    const tf2::Vector3 origin(
+      (Rn + trig.alt) * trig.cos_lat * trig.cos_lon,
+      (Rn + trig.alt) * trig.cos_lat * trig.sin_lon,
+      (Rn * (1.0 - WGS84_ECCENTRICITY_SQR) + trig.alt) * trig.sin_lat
+    );
+
+    // Columns are the north, east and down axes expressed in ECEF
+    const tf2::Matrix3x3 rotation(
+      -trig.sin_lat * trig.cos_lon, -trig.sin_lon, -trig.cos_lat * trig.cos_lon,
+      -trig.sin_lat * trig.sin_lon,  trig.cos_lon, -trig.cos_lat * trig.sin_lon,
+       trig.cos_lat,                 0.0,          -trig.sin_lat
+    );
+
+    return tf2::Transform(rotation, origin);
   }
 
   geometry_msgs::PoseWithCovarianceStamped poseFromGnss(
@@ -46,16 +91,10 @@ namespace gnss_to_map_convertor {
     const double lon = fix_msg->longitude * wgs84_utils::DEG2RAD;
     const double alt = fix_msg->altitude;
 
-    const struct wgs84_utils::wgs84_coordinate geo_point = {lat, lon, 0, alt};
+    const tf2::Transform T_e_n = nedInEcef(geodeticTrig(lat, lon, alt));
 
-    const tf2::Transform T_e_n = wgs84_utils::ecef_to_ned_from_loc(geo_point);
-
-    const tf2::Vector3 identity_trans(0,0,0);
-    tf2::Quaternion heading_in_ned_quat;
-    
-    heading_in_ned_quat.setRPY(0, 0, fix_msg->track * wgs84_utils::DEG2RAD);
-
-    const tf2::Transform T_n_h(heading_in_ned_quat, identity_trans);
+    const double half_yaw = fix_msg->track * wgs84_utils::DEG2RAD * 0.5;
+    const tf2::Transform T_n_h = headingInNed(std::sin(half_yaw), std::cos(half_yaw));
 
     const tf2::Transform T_h_s(sensor_in_ned_heading);
 
@@ -72,15 +111,60 @@ namespace gnss_to_map_convertor {
     geometry_msgs::PoseWithCovarianceStamped pose;
     pose.header = fix_msg->header;
 
-    pose.pose.pose.position.x = T_e_b.getOrigin().getX();
-    pose.pose.pose.position.y = T_e_b.getOrigin().getY();
-    pose.pose.pose.position.z = T_e_b.getOrigin().getZ();
-
-    pose.pose.pose.orientation.x = T_e_b.getRotation().getX();
-    pose.pose.pose.orientation.y = T_e_b.getRotation().getY();
-    pose.pose.pose.orientation.z = T_e_b.getRotation().getZ();
-    pose.pose.pose.orientation.w = T_e_b.getRotation().getW();
+    transformToPose(T_e_b, pose.pose.pose);
 
     return pose;
   }
+
+  void posesFromGnss(
+    const tf2::Transform& baselink_in_sensor,
+    const tf2::Transform& sensor_in_ned_heading,
+    const std::vector<gps_common::GPSFix>& fixes,
+    std::vector<geometry_msgs::Pose>& ecef_poses
+  ) {
+    const size_t count = fixes.size();
+
+    // Gather the angles into contiguous arrays so the trigonometry below runs as simple loops over doubles
+    std::vector<double> lat(count), lon(count), half_yaw(count);
+    for (size_t i = 0; i < count; i++) {
+      lat[i] = fixes[i].latitude * wgs84_utils::DEG2RAD;
+      lon[i] = fixes[i].longitude * wgs84_utils::DEG2RAD;
+      half_yaw[i] = fixes[i].track * wgs84_utils::DEG2RAD * 0.5;
+    }
+
+    std::vector<double> sin_lat(count), cos_lat(count), sin_lon(count), cos_lon(count), sin_yaw(count), cos_yaw(count);
+    for (size_t i = 0; i < count; i++) {
+      sin_lat[i] = std::sin(lat[i]);
+      cos_lat[i] = std::cos(lat[i]);
+      sin_lon[i] = std::sin(lon[i]);
+      cos_lon[i] = std::cos(lon[i]);
+      sin_yaw[i] = std::sin(half_yaw[i]);
+      cos_yaw[i] = std::cos(half_yaw[i]);
+    }
+
+    // The sensor mounting is shared by all fixes
+    const tf2::Transform T_h_b = sensor_in_ned_heading * baselink_in_sensor;
+
+    ecef_poses.resize(count);
+    for (size_t i = 0; i < count; i++) {
+      const GeodeticTrig trig = { sin_lat[i], cos_lat[i], sin_lon[i], cos_lon[i], fixes[i].altitude };
+      const tf2::Transform T_e_b = nedInEcef(trig) * headingInNed(sin_yaw[i], cos_yaw[i]) * T_h_b;
+      transformToPose(T_e_b, ecef_poses[i]);
+    }
+  }
+
+  void ecefPosesToMapPoses(
+    const std::vector<geometry_msgs::Pose>& ecef_poses,
+    const tf2::Transform& earth_in_map,
+    std::vector<geometry_msgs::Pose>& map_poses
+  ) {
+    map_poses.resize(ecef_poses.size());
+    for (size_t i = 0; i < ecef_poses.size(); i++) {
+      const tf2::Transform T_e_b(
+        tf2::Quaternion(ecef_poses[i].orientation.x, ecef_poses[i].orientation.y, ecef_poses[i].orientation.z, ecef_poses[i].orientation.w),
+        tf2::Vector3(ecef_poses[i].position.x, ecef_poses[i].position.y, ecef_poses[i].position.z)
+      );
+      transformToPose(earth_in_map * T_e_b, map_poses[i]);
+    }
+  }
 }
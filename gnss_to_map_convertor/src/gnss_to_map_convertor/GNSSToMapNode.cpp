@@ -19,6 +19,7 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 #include <tf2/LinearMath/Quaternion.h>
 #include <tf2/LinearMath/Matrix3x3.h>
+#include <algorithm>
 
 namespace gnss_to_map_convertor {
 
@@ -42,12 +43,7 @@ namespace gnss_to_map_convertor {
     ); 
     ecef_pose.header.frame_id = earth_frame_; // Set correct frame id
 
-    tf2::Transform map_in_earth;
-    try {
-      // The map_in_earth transform should only change occasionally so no need to lookup a specific time
-      tf2::convert(tfBuffer_.lookupTransform(earth_frame_, map_frame_, ros::Time(0)).transform, map_in_earth);
-    } catch (tf2::TransformException &ex) {
-      ROS_ERROR_STREAM("Ignoring re-initialization request: Could not lookup transform with exception " << ex.what());
+    if (!updateMapInEarth()) {
       ecef_pose_pub_.publish(ecef_pose); // Still publish valid ecef_pose even if the map lookup fails
       return;
     }
@@ -58,7 +54,7 @@ namespace gnss_to_map_convertor {
 
     // Compute pose in map frame
     geometry_msgs::PoseStamped map_pose;
-    map_pose.pose = gnss_to_map_convertor::ecefTFToMapPose(base_link_in_earth, map_in_earth);
+    map_pose.pose = gnss_to_map_convertor::ecefTFToMapPoseFromInverse(base_link_in_earth, earth_in_map_);
     map_pose.header = fix_msg->header;
     map_pose.header.frame_id = map_frame_;
 
@@ -67,18 +63,49 @@ namespace gnss_to_map_convertor {
     ecef_pose_pub_.publish(ecef_pose);
   }
 
+  bool GNSSToMapNode::updateMapInEarth() {
+    ros::Time now = ros::Time::now();
+    bool expired = !map_transform_refresh_period_.isZero() && now - map_in_earth_lookup_time_ > map_transform_refresh_period_;
+    if (map_in_earth_set_ && !expired) {
+      return true;
+    }
+
+    try {
+      // The map_in_earth transform should only change occasionally so no need to lookup a specific time
+      tf2::convert(tfBuffer_.lookupTransform(earth_frame_, map_frame_, ros::Time(0)).transform, map_in_earth_);
+    } catch (tf2::TransformException &ex) {
+      ROS_ERROR_STREAM("Ignoring re-initialization request: Could not lookup transform with exception " << ex.what());
+      map_in_earth_set_ = false;
+      return false;
+    }
+
+    earth_in_map_ = map_in_earth_.inverse();
+    map_in_earth_lookup_time_ = now;
+    map_in_earth_set_ = true;
+    return true;
+  }
+
+  void GNSSToMapNode::tfStaticCb(const tf2_msgs::TFMessageConstPtr& msg) {
+    // A new static transform may move the map within the earth frame
+    map_in_earth_set_ = false;
+  }
+
   int GNSSToMapNode::run() {
     // Load parameters
     base_link_frame_ = p_cnh_.param("base_link_frame_id", base_link_frame_);
     earth_frame_ = p_cnh_.param("earth_frame_id", earth_frame_);
     map_frame_ = p_cnh_.param("map_frame_id", map_frame_);
     ned_heading_frame_ = p_cnh_.param("ned_heading_frame_id", ned_heading_frame_);
+    double refresh_period = p_cnh_.param("map_transform_refresh_period", map_transform_refresh_period_.toSec());
+    map_transform_refresh_period_ = ros::Duration(std::max(refresh_period, 0.0));
     // ECEF Pose publisher
     ecef_pose_pub_ = cnh_.advertise<geometry_msgs::PoseWithCovarianceStamped>("ecef_pose_with_cov", 10);
     // Map pose publisher
     map_pose_pub_ = cnh_.advertise<geometry_msgs::PoseStamped>("gnss_pose", 10, true);
     // Fix Subscriber
     fix_sub_ = cnh_.subscribe("gnss_fix_fused", 2, &GNSSToMapNode::fixCb, this);
+    // Static transform subscriber used to invalidate the cached map transform
+    tf_static_sub_ = cnh_.subscribe("/tf_static", 10, &GNSSToMapNode::tfStaticCb, this);
 
     // Spin
     cnh_.setSpinRate(20);
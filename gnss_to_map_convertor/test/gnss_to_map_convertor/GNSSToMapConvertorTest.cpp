@@ -148,6 +148,77 @@ TEST(GNSSToMapConvertor, poseFromGnss)
   /////////
 }
 
+TEST(GNSSToMapConvertor, nedInEcef)
+{
+  const double points[][3] = { { 0, 0, 0 }, { 38.9549716, -77.1493928, 72.0 }, { -33.8688, 151.2093, 10.0 }, { 89.5, 45.0, -20.0 } };
+  for (const auto& point : points)
+  {
+    const double lat = point[0] * wgs84_utils::DEG2RAD;
+    const double lon = point[1] * wgs84_utils::DEG2RAD;
+    const struct wgs84_utils::wgs84_coordinate geo_point = {lat, lon, 0, point[2]};
+
+    tf2::Transform expected = wgs84_utils::ecef_to_ned_from_loc(geo_point);
+    tf2::Transform result = gnss_to_map_convertor::nedInEcef(gnss_to_map_convertor::geodeticTrig(lat, lon, point[2]));
+
+    geometry_msgs::Pose result_pose;
+    result_pose.position.x = result.getOrigin().getX();
+    result_pose.position.y = result.getOrigin().getY();
+    result_pose.position.z = result.getOrigin().getZ();
+    result_pose.orientation.x = result.getRotation().getX();
+    result_pose.orientation.y = result.getRotation().getY();
+    result_pose.orientation.z = result.getRotation().getZ();
+    result_pose.orientation.w = result.getRotation().getW();
+
+    assertNear(expected, result_pose, 0.01, 0.000001);
+  }
+}
+
+TEST(GNSSToMapConvertor, posesFromGnss)
+{
+  tf2::Transform baselink_in_sensor(tf2::Quaternion::getIdentity(), tf2::Vector3(-1.5, 0.2, -1.0));
+  tf2::Quaternion sensor_in_ned_heading_quat;
+  sensor_in_ned_heading_quat.setRPY(wgs84_utils::pi, 0, 0);
+  tf2::Transform sensor_in_ned_heading(sensor_in_ned_heading_quat, tf2::Vector3(0, 0, 0));
+
+  std::vector<gps_common::GPSFix> fixes;
+  for (int i = 0; i < 20; i++)
+  {
+    gps_common::GPSFix fix;
+    fix.latitude = 38.95 + i * 0.001;
+    fix.longitude = -77.14 - i * 0.002;
+    fix.altitude = 70.0 + i;
+    fix.track = i * 17.0;
+    fixes.push_back(fix);
+  }
+
+  std::vector<geometry_msgs::Pose> ecef_poses;
+  gnss_to_map_convertor::posesFromGnss(baselink_in_sensor, sensor_in_ned_heading, fixes, ecef_poses);
+  ASSERT_EQ(fixes.size(), ecef_poses.size());
+
+  tf2::Transform map_in_earth(tf2::Quaternion(0, 0, 0.7071068, 0.7071068), tf2::Vector3(1106000.0, -4844000.0, 3987000.0));
+  std::vector<geometry_msgs::Pose> map_poses;
+  gnss_to_map_convertor::ecefPosesToMapPoses(ecef_poses, map_in_earth.inverse(), map_poses);
+  ASSERT_EQ(fixes.size(), map_poses.size());
+
+  // The batch conversion matches converting each fix on its own
+  for (size_t i = 0; i < fixes.size(); i++)
+  {
+    gps_common::GPSFixConstPtr fix_ptr(new gps_common::GPSFix(fixes[i]));
+    geometry_msgs::PoseWithCovarianceStamped single = gnss_to_map_convertor::poseFromGnss(baselink_in_sensor, sensor_in_ned_heading, fix_ptr);
+
+    tf2::Transform single_tf;
+    tf2::Quaternion single_rot(single.pose.pose.orientation.x, single.pose.pose.orientation.y, single.pose.pose.orientation.z, single.pose.pose.orientation.w);
+    single_tf.setRotation(single_rot);
+    single_tf.setOrigin(tf2::Vector3(single.pose.pose.position.x, single.pose.pose.position.y, single.pose.pose.position.z));
+    assertNear(single_tf, ecef_poses[i], 0.0001, 0.000001);
+
+    geometry_msgs::Pose map_pose = gnss_to_map_convertor::ecefTFToMapPose(single_tf, map_in_earth);
+    tf2::Transform map_tf(tf2::Quaternion(map_pose.orientation.x, map_pose.orientation.y, map_pose.orientation.z, map_pose.orientation.w),
+                          tf2::Vector3(map_pose.position.x, map_pose.position.y, map_pose.position.z));
+    assertNear(map_tf, map_poses[i], 0.0001, 0.000001);
+  }
+}
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc, argv);
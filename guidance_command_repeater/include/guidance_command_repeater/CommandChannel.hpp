@@ -0,0 +1,173 @@
+#pragma once
+
+/*
+ * Copyright (C) 2018-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <ros/ros.h>
+#include "guidance_command_repeater/LatencyHistogram.hpp"
+
+namespace guidance_command_repeater {
+
+/*!
+ * Latest-value slot holding the most recent command of one channel and the time it was received.
+ *
+ * The received message and its time are published together as one immutable sample whose pointer is swapped
+ * atomically, so the subscriber never waits on the publish loop and the publish loop never observes a message paired
+ * with the time of another. Designed for a single writer and a single reader.
+ */
+template <typename MsgT>
+class CommandSlot {
+    public:
+        using MsgConstPtr = typename MsgT::ConstPtr;
+
+        struct Sample {
+            MsgConstPtr msg;
+            ros::Time received;
+            uint64_t sequence = 0; // Number of commands stored in the slot up to and including this one
+        };
+
+        using SampleConstPtr = std::shared_ptr<const Sample>;
+
+        //! Publishes a new command. Must only be called by the writer.
+        void store(const MsgConstPtr& msg, const ros::Time& received)
+        {
+            auto sample = std::make_shared<Sample>();
+            sample->msg = msg;
+            sample->received = received;
+            sample->sequence = ++writes_;
+            std::atomic_store(&sample_, SampleConstPtr(std::move(sample)));
+        }
+
+        //! Returns the latest sample or nullptr if no command has been received.
+        SampleConstPtr load() const
+        {
+            return std::atomic_load(&sample_);
+        }
+
+    private:
+        SampleConstPtr sample_;
+        uint64_t writes_ = 0; // Only accessed by the writer
+};
+
+/*!
+ * One repeated command stream: its latest-value slot, staleness tracking and command age histogram.
+ *
+ * The subscriber callback calls receive and the publish loop calls poll. A command stops being repeated once it is
+ * older than the timeout. The transition to stale is reported once per age-out so a lost upstream controller is
+ * visible in the logs without flooding them at the publish rate.
+ */
+template <typename MsgT>
+class CommandChannel {
+    public:
+        using MsgConstPtr = typename MsgT::ConstPtr;
+
+        explicit CommandChannel(std::string name) : name_(std::move(name)) {}
+
+        //! Records a newly received command.
+        void receive(const MsgConstPtr& msg, const ros::Time& now)
+        {
+            slot_.store(msg, now);
+        }
+
+        /*!
+        * Returns the command to publish or nullptr if there is none or it is older than timeout.
+        * @param now the current time.
+        * @param timeout the maximum age of a repeated command.
+        */
+        MsgConstPtr poll(const ros::Time& now, const ros::Duration& timeout)
+        {
+            auto sample = slot_.load();
+            if (!sample || !sample->msg)
+            {
+                return nullptr;
+            }
+
+            ros::Duration age = now - sample->received;
+            if (age >= timeout)
+            {
+                if (!stale_)
+                {
+                    stale_ = true;
+                    age_outs_++;
+                    ROS_WARN_STREAM(name_ << " command aged out after " << age.toSec() << " s, no longer repeating it");
+                }
+                return nullptr;
+            }
+
+            if (stale_ && age_outs_ > 0)
+            {
+                ROS_INFO_STREAM(name_ << " commands resumed");
+            }
+            stale_ = false;
+            published_++;
+            age_histogram_.add(age.toSec());
+            return sample->msg;
+        }
+
+        //! True if no fresh command is available, including before the first command.
+        bool isStale() const
+        {
+            return stale_;
+        }
+
+        uint64_t getAgeOutCount() const
+        {
+            return age_outs_;
+        }
+
+        uint64_t getPublishedCount() const
+        {
+            return published_;
+        }
+
+        uint64_t getReceivedCount() const
+        {
+            auto sample = slot_.load();
+            return sample ? sample->sequence : 0;
+        }
+
+        //! Age of the commands at the time they were published.
+        const LatencyHistogram& getAgeHistogram() const
+        {
+            return age_histogram_;
+        }
+
+        void resetStats()
+        {
+            age_histogram_.reset();
+        }
+
+        const std::string& getName() const
+        {
+            return name_;
+        }
+
+    private:
+        std::string name_;
+        CommandSlot<MsgT> slot_;
+
+        // Publish loop state
+        bool stale_ = true;
+        uint64_t age_outs_ = 0;
+        uint64_t published_ = 0;
+        LatencyHistogram age_histogram_;
+};
+
+}  // namespace guidance_command_repeater
@@ -14,7 +14,7 @@
  * the License.
  */
 
-#include <mutex>
+#include <chrono>
 // ROS
 #include <ros/ros.h>
 #include <sstream>
@@ -24,6 +24,8 @@
 #include <cav_msgs/SpeedAccel.h>
 #include <cav_msgs/LateralControl.h>
 #include <cav_msgs/RobotEnabled.h>
+#include "guidance_command_repeater/CommandChannel.hpp"
+#include "guidance_command_repeater/LatencyHistogram.hpp"
 
 namespace guidance_command_repeater {
 
@@ -123,26 +125,29 @@ class GuidanceCommandRepeater {
         void LateralControlPublisher();
 
 
-        // Messages used to transfer data from subscribers to publishers
-        cav_msgs::SpeedAccel::ConstPtr SpeedAccelMsg;
-        std_msgs::Float32::ConstPtr WrenchEffortMsg;
-        cav_msgs::LateralControl::ConstPtr LateralControlMsg;
-
-        // Locks used to make the data transfer from subscribers to publishers thread safe
-        std::mutex SpeedAccelMsgMutex;
-        std::mutex WrenchEffortMsgMutex;
-        std::mutex LateralControlMsgMutex;
-
-        // Time used to check the timestamp for the last time subscribers reciaved message
-        double SpeedAccelTimeTracker;
-        double WrenchEffortTimeTracker;
-        double LateralControlTimeTracker;
+        // Latest-value slots used to transfer data from subscribers to publishers without locks
+        CommandChannel<cav_msgs::SpeedAccel> SpeedAccelChannel{"SpeedAccel"};
+        CommandChannel<std_msgs::Float32> WrenchEffortChannel{"WrenchEffort"};
+        CommandChannel<cav_msgs::LateralControl> LateralControlChannel{"LateralControl"};
 
         ros::Duration TimeoutThresh;
         double timeout;
 
         void InitTimeTracker();
 
+        // Deviation of the publish loop period from 1 / rate
+        LatencyHistogram PublishJitter;
+        std::chrono::steady_clock::time_point LastPublishTime;
+        bool PublishedOnce = false;
+
+        // Seconds between reports of the latency histograms, 0 disables them
+        double statsReportPeriod;
+        std::chrono::steady_clock::time_point LastStatsReport;
+
+        void recordPublishJitter(std::chrono::steady_clock::time_point now);
+
+        void reportStats(std::chrono::steady_clock::time_point now);
+
 };
 
 }  // namespace guidance_command_repeater
\ No newline at end of file
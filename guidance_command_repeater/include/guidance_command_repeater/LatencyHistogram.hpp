@@ -0,0 +1,75 @@
+#pragma once
+
+/*
+ * Copyright (C) 2018-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace guidance_command_repeater {
+
+/*!
+ * Fixed bucket histogram of durations in seconds.
+ *
+ * Samples are counted in the first bucket whose upper bound is not below them. Samples above the last bound are
+ * counted in an overflow bucket. Recording does not allocate. Not thread safe, it is only used by the publish loop.
+ */
+class LatencyHistogram {
+    public:
+        /*!
+        * Constructor.
+        * @param bucket_bounds ascending upper bounds of the buckets in seconds.
+        */
+        explicit LatencyHistogram(std::vector<double> bucket_bounds = defaultBounds());
+
+        //! Upper bounds from 1 ms to 1 s covering the expected command ages and loop jitter.
+        static std::vector<double> defaultBounds();
+
+        void add(double seconds);
+
+        void reset();
+
+        uint64_t count() const;
+
+        double mean() const;
+
+        double max() const;
+
+        /*!
+        * Returns the upper bound of the bucket holding the requested quantile. The largest sample is returned if the
+        * quantile falls in the overflow bucket.
+        * @param q the quantile in [0, 1].
+        */
+        double quantile(double q) const;
+
+        const std::vector<double>& bounds() const;
+
+        //! Bucket counts, with the overflow bucket last.
+        const std::vector<uint64_t>& counts() const;
+
+        //! Single line summary such as "n=10 mean=2.1ms p50<=5ms p99<=10ms max=7.3ms [<=1ms:2 <=5ms:8]".
+        std::string toString() const;
+
+    private:
+        std::vector<double> bounds_;
+        std::vector<uint64_t> counts_;
+        uint64_t count_ = 0;
+        double sum_ = 0;
+        double max_ = 0;
+};
+
+}  // namespace guidance_command_repeater
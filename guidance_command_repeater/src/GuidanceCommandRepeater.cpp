@@ -15,6 +15,7 @@
  */
 
 #include "guidance_command_repeater/GuidanceCommandRepeater.hpp"
+#include <cmath>
 
 namespace guidance_command_repeater {
 
@@ -48,11 +49,44 @@ GuidanceCommandRepeater::~GuidanceCommandRepeater()
 
 void GuidanceCommandRepeater::publisher(){
   ROS_DEBUG("Calling publisher functions");
+  auto now = std::chrono::steady_clock::now();
+  recordPublishJitter(now);
   SpeedAccelPublisher();
   WrenchEffortPublisher();
   LateralControlPublisher();
+  reportStats(now);
 } 
 
+void GuidanceCommandRepeater::recordPublishJitter(std::chrono::steady_clock::time_point now){
+  if (PublishedOnce && rate > 0) {
+    double period = std::chrono::duration<double>(now - LastPublishTime).count();
+    PublishJitter.add(std::abs(period - 1.0 / rate));
+  }
+  LastPublishTime = now;
+  PublishedOnce = true;
+}
+
+void GuidanceCommandRepeater::reportStats(std::chrono::steady_clock::time_point now){
+  if (statsReportPeriod <= 0 || std::chrono::duration<double>(now - LastStatsReport).count() < statsReportPeriod) {
+    return;
+  }
+  LastStatsReport = now;
+
+  ROS_INFO_STREAM("Publish loop jitter: " << PublishJitter.toString());
+  ROS_INFO_STREAM("SpeedAccel command age: " << SpeedAccelChannel.getAgeHistogram().toString()
+                  << " received=" << SpeedAccelChannel.getReceivedCount() << " age_outs=" << SpeedAccelChannel.getAgeOutCount());
+  ROS_INFO_STREAM("WrenchEffort command age: " << WrenchEffortChannel.getAgeHistogram().toString()
+                  << " received=" << WrenchEffortChannel.getReceivedCount() << " age_outs=" << WrenchEffortChannel.getAgeOutCount());
+  ROS_INFO_STREAM("LateralControl command age: " << LateralControlChannel.getAgeHistogram().toString()
+                  << " received=" << LateralControlChannel.getReceivedCount() << " age_outs=" << LateralControlChannel.getAgeOutCount());
+
+  // Each report covers the period since the previous one
+  PublishJitter.reset();
+  SpeedAccelChannel.resetStats();
+  WrenchEffortChannel.resetStats();
+  LateralControlChannel.resetStats();
+}
+
 bool GuidanceCommandRepeater::readParameters()
 {
   nodeHandle_.param<std::string>("SpeedAccelPublisher_topic", SpeedAccelPublisherTopic_, "/republish/cmd_speed");
@@ -60,61 +94,54 @@ bool GuidanceCommandRepeater::readParameters()
   nodeHandle_.param<std::string>("LateralControlPublisher_topic", LateralControlPublisherTopic_, "/republish/cmd_lateral");
   nodeHandle_.param("publish_rate", rate, 10);
   nodeHandle_.param("timeout_thresh", timeout, 0.5);
+  nodeHandle_.param("stats_report_period", statsReportPeriod, 10.0);
 
   return true;
 }
 
 
 void GuidanceCommandRepeater::SpeedAccelSubscriberCallback(const cav_msgs::SpeedAccel::ConstPtr& msg){
-    std::lock_guard<std::mutex> lock(SpeedAccelMsgMutex);
-    SpeedAccelTimeTracker = ros::Time::now().toSec();
-    SpeedAccelMsg = msg;
+    SpeedAccelChannel.receive(msg, ros::Time::now());
     ROS_DEBUG("I heard SpeedAccel");
 };
 
 void GuidanceCommandRepeater::WrenchEffortSubscriberCallback(const std_msgs::Float32::ConstPtr& msg){
-    std::lock_guard<std::mutex> lock(WrenchEffortMsgMutex);
-    WrenchEffortTimeTracker = ros::Time::now().toSec();
-    WrenchEffortMsg = msg;
+    WrenchEffortChannel.receive(msg, ros::Time::now());
     ROS_DEBUG("I heard wrenchEffort");
 };
 
 void GuidanceCommandRepeater::LateralControlSubscriberCallback(const cav_msgs::LateralControl::ConstPtr& msg){
-    std::lock_guard<std::mutex> lock(LateralControlMsgMutex);
-    LateralControlTimeTracker = ros::Time::now().toSec();
-    LateralControlMsg = msg;
+    LateralControlChannel.receive(msg, ros::Time::now());
     ROS_DEBUG("I heard lateralControl");
 };
 
 void GuidanceCommandRepeater::SpeedAccelPublisher(){
-    std::lock_guard<std::mutex> lock(SpeedAccelMsgMutex);
-    if(SpeedAccelMsg != nullptr && (ros::Time::now().toSec() - SpeedAccelTimeTracker) < TimeoutThresh.toSec()) {
-      SpeedAccelPublisher_.publish(SpeedAccelMsg);
+    auto msg = SpeedAccelChannel.poll(ros::Time::now(), TimeoutThresh);
+    if(msg != nullptr) {
+      SpeedAccelPublisher_.publish(msg);
       ROS_DEBUG("I publish SpeedAccel");
     }
 };
 
 void GuidanceCommandRepeater::WrenchEffortPublisher(){
-    std::lock_guard<std::mutex> lock(WrenchEffortMsgMutex);
-    if(WrenchEffortMsg != nullptr && (ros::Time::now().toSec() - WrenchEffortTimeTracker) < TimeoutThresh.toSec()) {
-      WrenchEffortPublisher_.publish(WrenchEffortMsg);
+    auto msg = WrenchEffortChannel.poll(ros::Time::now(), TimeoutThresh);
+    if(msg != nullptr) {
+      WrenchEffortPublisher_.publish(msg);
       ROS_DEBUG("I publish wrenchEffort");
     }
 };
 
 void GuidanceCommandRepeater::LateralControlPublisher(){
-    std::lock_guard<std::mutex> lock(LateralControlMsgMutex);
-    if(LateralControlMsg != nullptr && (ros::Time::now().toSec() - LateralControlTimeTracker) < TimeoutThresh.toSec()) {
-      LateralControlPublisher_.publish(LateralControlMsg);
+    auto msg = LateralControlChannel.poll(ros::Time::now(), TimeoutThresh);
+    if(msg != nullptr) {
+      LateralControlPublisher_.publish(msg);
       ROS_DEBUG("I publish lateralControl");
     }
 };
 
 void GuidanceCommandRepeater::InitTimeTracker(){
-  SpeedAccelTimeTracker = 0;
-  WrenchEffortTimeTracker = 0;
-  LateralControlTimeTracker = 0;
   TimeoutThresh = ros::Duration(timeout);
+  LastStatsReport = std::chrono::steady_clock::now();
 }
 
 } // namespace guidance_command_repeater
\ No newline at end of file
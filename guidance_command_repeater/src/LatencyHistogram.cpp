@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2018-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "guidance_command_repeater/LatencyHistogram.hpp"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace guidance_command_repeater {
+
+LatencyHistogram::LatencyHistogram(std::vector<double> bucket_bounds)
+    : bounds_(std::move(bucket_bounds)), counts_(bounds_.size() + 1, 0)
+{
+  std::sort(bounds_.begin(), bounds_.end());
+}
+
+std::vector<double> LatencyHistogram::defaultBounds()
+{
+  return { 0.001, 0.002, 0.005, 0.01, 0.02, 0.05, 0.1, 0.2, 0.5, 1.0 };
+}
+
+void LatencyHistogram::add(double seconds)
+{
+  size_t bucket = std::lower_bound(bounds_.begin(), bounds_.end(), seconds) - bounds_.begin();
+  counts_[bucket]++;
+  count_++;
+  sum_ += seconds;
+  max_ = std::max(max_, seconds);
+}
+
+void LatencyHistogram::reset()
+{
+  std::fill(counts_.begin(), counts_.end(), 0);
+  count_ = 0;
+  sum_ = 0;
+  max_ = 0;
+}
+
+uint64_t LatencyHistogram::count() const
+{
+  return count_;
+}
+
+double LatencyHistogram::mean() const
+{
+  return count_ == 0 ? 0 : sum_ / count_;
+}
+
+double LatencyHistogram::max() const
+{
+  return max_;
+}
+
+double LatencyHistogram::quantile(double q) const
+{
+  if (count_ == 0)
+  {
+    return 0;
+  }
+
+  uint64_t rank = static_cast<uint64_t>(std::ceil(std::min(std::max(q, 0.0), 1.0) * count_));
+  rank = std::max<uint64_t>(rank, 1);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < bounds_.size(); i++)
+  {
+    seen += counts_[i];
+    if (seen >= rank)
+    {
+      return bounds_[i];
+    }
+  }
+  return max_;
+}
+
+const std::vector<double>& LatencyHistogram::bounds() const
+{
+  return bounds_;
+}
+
+const std::vector<uint64_t>& LatencyHistogram::counts() const
+{
+  return counts_;
+}
+
+std::string LatencyHistogram::toString() const
+{
+  std::ostringstream out;
+  out << "n=" << count_ << " mean=" << mean() * 1000.0 << "ms p50<=" << quantile(0.5) * 1000.0 << "ms p99<="
+      << quantile(0.99) * 1000.0 << "ms max=" << max_ * 1000.0 << "ms [";
+
+  bool first = true;
+  for (size_t i = 0; i < counts_.size(); i++)
+  {
+    if (counts_[i] == 0)
+    {
+      continue;
+    }
+    if (!first)
+    {
+      out << " ";
+    }
+    first = false;
+    if (i < bounds_.size())
+    {
+      out << "<=" << bounds_[i] * 1000.0 << "ms:" << counts_[i];
+    }
+    else
+    {
+      out << ">" << (bounds_.empty() ? 0.0 : bounds_.back()) * 1000.0 << "ms:" << counts_[i];
+    }
+  }
+  out << "]";
+  return out.str();
+}
+
+}  // namespace guidance_command_repeater
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2018-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <std_msgs/Float32.h>
+#include "guidance_command_repeater/CommandChannel.hpp"
+
+namespace guidance_command_repeater {
+
+namespace {
+std_msgs::Float32::ConstPtr makeCommand(float value)
+{
+  std_msgs::Float32::Ptr msg(new std_msgs::Float32);
+  msg->data = value;
+  return msg;
+}
+}  // namespace
+
+TEST(CommandChannelTest, ageOut)
+{
+  CommandChannel<std_msgs::Float32> channel("WrenchEffort");
+  ros::Duration timeout(0.5);
+
+  // Nothing is published before the first command
+  ASSERT_EQ(nullptr, channel.poll(ros::Time(1.0), timeout));
+  ASSERT_TRUE(channel.isStale());
+
+  channel.receive(makeCommand(1.0), ros::Time(1.0));
+  auto msg = channel.poll(ros::Time(1.1), timeout);
+  ASSERT_NE(nullptr, msg);
+  ASSERT_FLOAT_EQ(1.0, msg->data);
+  ASSERT_FALSE(channel.isStale());
+
+  // The same command is repeated until it ages out, which is counted once
+  ASSERT_NE(nullptr, channel.poll(ros::Time(1.4), timeout));
+  ASSERT_EQ(nullptr, channel.poll(ros::Time(1.5), timeout));
+  ASSERT_EQ(nullptr, channel.poll(ros::Time(1.6), timeout));
+  ASSERT_TRUE(channel.isStale());
+  ASSERT_EQ(1u, channel.getAgeOutCount());
+
+  // A new command resumes publishing
+  channel.receive(makeCommand(2.0), ros::Time(2.0));
+  msg = channel.poll(ros::Time(2.05), timeout);
+  ASSERT_NE(nullptr, msg);
+  ASSERT_FLOAT_EQ(2.0, msg->data);
+  ASSERT_FALSE(channel.isStale());
+
+  ASSERT_EQ(2u, channel.getReceivedCount());
+  ASSERT_EQ(3u, channel.getPublishedCount());
+  ASSERT_EQ(3u, channel.getAgeHistogram().count());
+  ASSERT_NEAR(0.4, channel.getAgeHistogram().max(), 1e-6);
+}
+
+TEST(CommandSlotTest, concurrentStore)
+{
+  CommandSlot<std_msgs::Float32> slot;
+  const uint64_t commands = 5000;
+
+  // Each command carries the time it is stored with so a message paired with another time can be detected
+  std::thread writer([&slot, commands]() {
+    for (uint64_t i = 1; i <= commands; i++)
+    {
+      slot.store(makeCommand(i), ros::Time(i));
+    }
+  });
+
+  // Failures are recorded rather than asserted so the writer is always joined
+  bool mismatch = false;
+  bool went_backwards = false;
+  uint64_t last_sequence = 0;
+  while (last_sequence < commands)
+  {
+    auto sample = slot.load();
+    if (!sample)
+    {
+      continue;
+    }
+    mismatch |= sample->msg->data != sample->received.toSec() || sample->sequence != sample->received.sec;
+    went_backwards |= sample->sequence < last_sequence;
+    last_sequence = sample->sequence;
+  }
+  writer.join();
+
+  ASSERT_FALSE(mismatch);
+  ASSERT_FALSE(went_backwards);
+}
+
+TEST(LatencyHistogramTest, buckets)
+{
+  LatencyHistogram hist({ 0.001, 0.01, 0.1 });
+  ASSERT_EQ(0u, hist.count());
+  ASSERT_EQ(0.0, hist.quantile(0.5));
+
+  hist.add(0.0005);
+  hist.add(0.001);
+  hist.add(0.005);
+  hist.add(0.05);
+  hist.add(0.5);
+
+  ASSERT_EQ(5u, hist.count());
+  ASSERT_EQ((std::vector<uint64_t>{ 2, 1, 1, 1 }), hist.counts());
+  ASSERT_NEAR(0.1113, hist.mean(), 1e-6);
+  ASSERT_DOUBLE_EQ(0.5, hist.max());
+  ASSERT_DOUBLE_EQ(0.001, hist.quantile(0.2));
+  ASSERT_DOUBLE_EQ(0.01, hist.quantile(0.5));
+  ASSERT_DOUBLE_EQ(0.5, hist.quantile(1.0)); // Overflow bucket reports the largest sample
+
+  hist.reset();
+  ASSERT_EQ(0u, hist.count());
+  ASSERT_EQ((std::vector<uint64_t>{ 0, 0, 0, 0 }), hist.counts());
+}
+
+}  // namespace guidance_command_repeater
+
+// Run all the tests
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
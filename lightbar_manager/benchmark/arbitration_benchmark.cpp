@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2018-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include "lightbar_manager/lightbar_manager_worker.hpp"
+
+namespace lightbar_manager
+{
+namespace
+{
+// Indicators requested by the competing plugins, cycling through single, grouped and mutually inexclusive requests
+const std::vector<std::vector<LightBarIndicator>> REQUESTS = {
+    {YELLOW_DIM},
+    {YELLOW_ARROW_LEFT},
+    {YELLOW_ARROW_RIGHT, YELLOW_SIDES},
+    {YELLOW_FLASH},
+    {YELLOW_ARROW_OUT, YELLOW_DIM},
+    {GREEN_SOLID}};
+
+std::vector<std::string> pluginNames(int plugins)
+{
+    std::vector<std::string> names;
+    for (int i = 0; i < plugins; i++)
+    {
+        names.push_back("plugin_" + std::to_string(i));
+    }
+    return names;
+}
+
+LightBarManagerWorker buildWorker(const std::vector<std::string>& names)
+{
+    LightBarManagerWorker worker("lightbar_manager");
+    std::vector<std::string> priorities = {"lightbar_manager"};
+    priorities.insert(priorities.end(), names.begin(), names.end());
+    worker.setControlPriorities(priorities);
+    worker.setIndicatorControllers();
+    worker.requestControl(std::vector<LightBarIndicator>{GREEN_SOLID, GREEN_FLASH}, "lightbar_manager");
+    return worker;
+}
+}  // namespace
+
+// Request and release through the service facing interface, as done for every service call
+static void BM_RequestReleaseByName(benchmark::State& state)
+{
+    auto names = pluginNames(state.range(0));
+    auto worker = buildWorker(names);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        const std::string& plugin = names[i % names.size()];
+        const auto& request = REQUESTS[i % REQUESTS.size()];
+        auto denied = worker.requestControl(request, plugin);
+        benchmark::DoNotOptimize(denied.data());
+        worker.releaseControl(request, plugin);
+        i++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RequestReleaseByName)->Arg(4)->Arg(16)->Arg(64);
+
+// Request and release with interned ids and indicator sets, which allocates nothing
+static void BM_RequestReleaseById(benchmark::State& state)
+{
+    auto names = pluginNames(state.range(0));
+    auto worker = buildWorker(names);
+    std::vector<RequesterId> ids;
+    for (const auto& name : names)
+    {
+        ids.push_back(worker.internRequester(name));
+    }
+    std::vector<IndicatorSet> requests;
+    for (const auto& request : REQUESTS)
+    {
+        requests.push_back(LightBarManagerWorker::toIndicatorSet(request));
+    }
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        RequesterId plugin = ids[i % ids.size()];
+        IndicatorSet request = requests[i % requests.size()];
+        IndicatorSet denied = worker.requestControl(request, plugin);
+        benchmark::DoNotOptimize(denied);
+        worker.releaseControl(request, plugin);
+        i++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RequestReleaseById)->Arg(4)->Arg(16)->Arg(64);
+
+// Proposing a new indicator status and building the driver message for it
+static void BM_SetIndicatorStatusMsg(benchmark::State& state)
+{
+    auto worker = buildWorker(pluginNames(1));
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        LightBarIndicator indicator = static_cast<LightBarIndicator>(i % INDICATOR_COUNT);
+        worker.light_status = worker.setIndicator(indicator, i % 3 == 0 ? OFF : ON, "plugin_0");
+        cav_msgs::LightBarStatus msg = worker.getLightBarStatusMsg(worker.light_status);
+        benchmark::DoNotOptimize(msg);
+        i++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SetIndicatorStatusMsg);
+
+}  // namespace lightbar_manager
@@ -22,6 +22,10 @@
 #include <carma_utils/CARMAUtils.h>
 #include <vector>
 #include <map>
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <unordered_map>
 
 #include <cav_msgs/LightBarCDAType.h>
 #include <cav_msgs/LightBarIndicator.h>
@@ -44,6 +48,12 @@ namespace lightbar_manager
 // forward declaration
 class LightBarManagerStateMachine;
 
+// Set of indicators, or the ON/OFF status of every indicator, indexed by LightBarIndicator
+using IndicatorSet = std::bitset<INDICATOR_COUNT>;
+
+// Interned name of a component requesting indicator control. Id 0 is reserved for no owner.
+using RequesterId = uint16_t;
+
 class LightBarManagerWorker
 {
     public:
@@ -75,20 +85,52 @@ class LightBarManagerWorker
         * \brief Releases the specified owner plugin or component's control of the given indicator list.
         * This function handles successful transitioning of next ownership when that happens.
         */
-        void releaseControl(std::vector<LightBarIndicator> ind_list, std::string owner_name);
+        void releaseControl(const std::vector<LightBarIndicator>& ind_list, const std::string& owner_name);
+
+        /*!
+        * \brief Releases the owner's control of the given indicators without allocating.
+        */
+        void releaseControl(IndicatorSet indicators, RequesterId owner);
 
         /*!
         * \brief Requests the control of the given list of indicators to the requester.
         * This function handles successful transitioning of next ownership and illogical requests such as mutually exclusive indicators
         * \return Returns the list of the indicators that were denied for the requester
         */
-        std::vector<LightBarIndicator> requestControl(std::vector<LightBarIndicator> ind_list, std::string requester_name);
+        std::vector<LightBarIndicator> requestControl(const std::vector<LightBarIndicator>& ind_list, const std::string& requester_name);
+
+        /*!
+        * \brief Requests the control of the given indicators to the requester without allocating.
+        * \return Returns the set of the indicators that were denied for the requester
+        */
+        IndicatorSet requestControl(IndicatorSet indicators, RequesterId requester);
         
         /*!
         * \brief Try to turn the given indicator ON or OFF (locally) upon the given component's request
-        * \return Returns the changed vector of indicator status to be set by the driver client
+        * \return Returns the changed indicator status to be set by the driver client
+        */
+        IndicatorSet setIndicator(LightBarIndicator ind, IndicatorStatus ind_status, const std::string& requester_name) const;
+
+        /*!
+        * \brief Returns the id of the given component, assigning one the first time it is seen.
+        * Ids stay valid for the lifetime of the worker, so callers may keep them to skip the lookup.
+        */
+        RequesterId internRequester(const std::string& name);
+
+        /*!
+        * \brief Returns the name of an interned component, or an empty string for no owner
+        */
+        const std::string& getRequesterName(RequesterId id) const;
+
+        /*!
+        * \brief Sets the priorities of components, highest first, and precomputes them for every known component
+        */
+        void setControlPriorities(const std::vector<std::string>& priorities);
+
+        /*!
+        * \brief Returns the priorities of components, highest first
         */
-        std::vector<IndicatorStatus> setIndicator(LightBarIndicator ind, IndicatorStatus ind_status, std::string requester_name);
+        const std::vector<std::string>& getControlPriorities() const;
 
         /*!
         * \brief Helper functions that translates an indicator to its corresponding CDA msg type  
@@ -114,7 +156,17 @@ class LightBarManagerWorker
         * \brief Helper function that gets all current owners of the indicator.
         * \return return the mapping of indicators to their owners
         */
-        std::map<LightBarIndicator,std::string> getIndicatorControllers();
+        std::map<LightBarIndicator,std::string> getIndicatorControllers() const;
+
+        /*!
+        * \brief Returns the name of the current owner of the indicator, or an empty string if it has none
+        */
+        const std::string& getIndicatorController(LightBarIndicator indicator) const;
+
+        /*!
+        * \brief Returns the current owners of the indicators as a message without building an intermediate map
+        */
+        cav_msgs::LightBarIndicatorControllers getIndicatorControllersMsg() const;
        
         /*!
         * \brief Helper function that initializes supporting Indicators and their owner mapping as empty strings
@@ -125,20 +177,44 @@ class LightBarManagerWorker
         * \brief Helper function that checks if the first input component has higher priority than the second.
         * \return true if the requester has higher priority than the controller
         */
-        bool hasHigherPriority(std::string requester, std::string controller);
+        bool hasHigherPriority(const std::string& requester, const std::string& controller);
+
+        /*!
+        * \brief Compares the precomputed priorities of two interned components.
+        * Components not in the priority list, including no owner, have the lowest priority.
+        * A requester not in the list never has higher priority.
+        * \return true if the requester has higher priority than the controller
+        */
+        bool hasHigherPriority(RequesterId requester, RequesterId controller) const;
 
         /*!
         * \brief Helper function that handles control lost/gained event of a component. 
         * This function registers/removes controller's name to all mutually inexclusive indicators.
         * e.g. If registering a component as controller of YELLOW_ARROW_OUT, it will be registered for YELLOW_ARROW_LEFT/RIGHT/FLASH too. 
         */
-        void handleControlChange(LightBarIndicator indicator, std::string controller, IndicatorControlEvent event);
+        void handleControlChange(LightBarIndicator indicator, const std::string& controller, IndicatorControlEvent event);
 
         /*!
         * \brief Helper function that translates IndicatorStatus vector into LightBarStatus.msg, a lightbar driver compatible msg.
         * \return light bar status
         */
-        cav_msgs::LightBarStatus getLightBarStatusMsg(std::vector<IndicatorStatus> indicators);
+        cav_msgs::LightBarStatus getLightBarStatusMsg(const std::vector<IndicatorStatus>& indicators) const;
+
+        /*!
+        * \brief Helper function that translates the indicator status set into LightBarStatus.msg without allocating.
+        * \return light bar status
+        */
+        cav_msgs::LightBarStatus getLightBarStatusMsg(const IndicatorSet& indicators) const;
+
+        /*!
+        * \brief Helper function that converts a list of indicators into a set. Invalid indicators are skipped.
+        */
+        static IndicatorSet toIndicatorSet(const std::vector<LightBarIndicator>& indicators);
+
+        /*!
+        * \brief Helper function that converts the status of every indicator, in LightBarIndicator order, into a set of ON indicators.
+        */
+        static IndicatorSet toIndicatorSet(const std::vector<IndicatorStatus>& indicator_status);
 
         /*!
         * \brief Helper function that translates LightBarIndicator vector into LightBarIndicator.msg vector.
@@ -158,13 +234,15 @@ class LightBarManagerWorker
         */
         cav_msgs::LightBarIndicatorControllers getMsg(std::map<LightBarIndicator, std::string> ind_ctrl_map);
 
-        // Priorities of components/plugins read from ROSParamter
-        std::vector<std::string> control_priorities;
-
-        // LightBarStatus local copy in LightBarIndicator representation
-        std::vector<IndicatorStatus> light_status;
+        // LightBarStatus local copy in LightBarIndicator representation, a set bit is an indicator which is ON
+        IndicatorSet light_status;
 
     private:
+
+        void handleControlChange(LightBarIndicator indicator, RequesterId controller, IndicatorControlEvent event);
+
+        // Priorities of components/plugins read from ROSParamter
+        std::vector<std::string> control_priorities_;
         
         // Node data
         std::string node_name_;
@@ -172,8 +250,18 @@ class LightBarManagerWorker
         // LightBarManager state machine
         LightBarManagerStateMachine lbsm_;
 
-        // Indicators and their owners' mapping
-        std::map<LightBarIndicator, std::string> ind_ctrl_map_;
+        // Owner of each indicator, indexed by LightBarIndicator
+        std::array<RequesterId, INDICATOR_COUNT> ind_owners_ {};
+
+        // Interned component names. Index is the RequesterId, index 0 is the empty name of no owner
+        std::vector<std::string> requester_names_ {""};
+        std::unordered_map<std::string, RequesterId> requester_ids_ {{"", 0}};
+
+        // Position of each interned component in control_priorities_, lower is higher priority. Indexed by RequesterId
+        std::vector<int> requester_priorities_ {UNLISTED_PRIORITY};
+        static constexpr int UNLISTED_PRIORITY = INT32_MAX;
+
+        int priorityOf(const std::string& name) const;
 
         // Indicators and their corresponding CDA msg type mapping
         std::map<LightBarCDAType, LightBarIndicator> cda_ind_map_;
@@ -135,7 +135,7 @@ bool LightBarManager::releaseControlCallBack(cav_srvs::ReleaseIndicatorControlRe
 
 bool LightBarManager::spinCallBack()
 {
-    indicator_control_publisher_.publish(lbm_.getMsg(lbm_.getIndicatorControllers()));
+    indicator_control_publisher_.publish(lbm_.getIndicatorControllersMsg());
     return true;
 }
 
@@ -183,7 +183,7 @@ int LightBarManager::setIndicator(LightBarIndicator ind, IndicatorStatus ind_sta
     }
 
     // Check if the requester has control of this light
-    std::string current_controller = lbm_.getIndicatorControllers()[ind];
+    const std::string& current_controller = lbm_.getIndicatorController(ind);
     if (requester_name == "" || current_controller != requester_name) 
     {
         ROS_WARN_STREAM(requester_name << " failed to set the LightBarIndicator ID" << ind 
@@ -192,7 +192,7 @@ int LightBarManager::setIndicator(LightBarIndicator ind, IndicatorStatus ind_sta
         return response_code;
     }
 
-    std::vector<IndicatorStatus> light_status_proposed = lbm_.setIndicator(ind, ind_status, requester_name);
+    IndicatorSet light_status_proposed = lbm_.setIndicator(ind, ind_status, requester_name);
     cav_msgs::LightBarStatus msg = lbm_.getLightBarStatusMsg(light_status_proposed);
     cav_srvs::SetLights srv;
     srv.request.set_state = msg;
@@ -256,11 +256,12 @@ void LightBarManager::init(std::string mode)
     lbm_.setIndicatorControllers();
 
     // Initialize indicator representation of lightbar status to all OFF
-    for (int i =0; i < INDICATOR_COUNT; i++)
-        lbm_.light_status.push_back(OFF);
+    lbm_.light_status.reset();
 
     // Load lightbar priorities. 
-    pnh_.getParam("lightbar_priorities", lbm_.control_priorities);
+    std::vector<std::string> control_priorities;
+    pnh_.getParam("lightbar_priorities", control_priorities);
+    lbm_.setControlPriorities(control_priorities);
 
     // Setup priorities for unit test 
     if (mode == "test")
@@ -291,12 +292,7 @@ void LightBarManager::init(std::string mode)
 void LightBarManager::setupUnitTest()
 {
     // Add mock components for unit test
-    while (lbm_.control_priorities.size() != 0)
-        lbm_.control_priorities.pop_back();
-    lbm_.control_priorities.push_back("lightbar_manager");
-    lbm_.control_priorities.push_back("tester1");
-    lbm_.control_priorities.push_back("tester2");
-    lbm_.control_priorities.push_back("tester3");
+    lbm_.setControlPriorities({"lightbar_manager", "tester1", "tester2", "tester3"});
     return;
 }
 
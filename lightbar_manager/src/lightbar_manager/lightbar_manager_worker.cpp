@@ -19,6 +19,8 @@
 #include <ros/console.h>
 namespace lightbar_manager
 {
+    constexpr int LightBarManagerWorker::UNLISTED_PRIORITY;
+
     LightBarManagerWorker::LightBarManagerWorker(std::string node_name) : node_name_(node_name){};
 
     void LightBarManagerWorker::next(const LightBarEvent& event)
@@ -77,9 +79,85 @@ namespace lightbar_manager
 
 
 
-    std::map<LightBarIndicator, std::string> LightBarManagerWorker::getIndicatorControllers()
+    std::map<LightBarIndicator, std::string> LightBarManagerWorker::getIndicatorControllers() const
+    {
+        std::map<LightBarIndicator, std::string> ind_ctrl_map;
+        for (int i = 0; i < INDICATOR_COUNT; i++)
+        {
+            ind_ctrl_map[static_cast<LightBarIndicator>(i)] = requester_names_[ind_owners_[i]];
+        }
+        return ind_ctrl_map;
+    }
+
+    const std::string& LightBarManagerWorker::getIndicatorController(LightBarIndicator indicator) const
+    {
+        return requester_names_[ind_owners_[indicator]];
+    }
+
+    cav_msgs::LightBarIndicatorControllers LightBarManagerWorker::getIndicatorControllersMsg() const
+    {
+        cav_msgs::LightBarIndicatorControllers curr;
+        curr.green_solid_owner = getIndicatorController(GREEN_SOLID);
+        curr.green_flash_owner = getIndicatorController(GREEN_FLASH);
+        curr.yellow_sides_owner= getIndicatorController(YELLOW_SIDES);
+        curr.yellow_dim_owner = getIndicatorController(YELLOW_DIM);
+        curr.yellow_flash_owner = getIndicatorController(YELLOW_FLASH);
+        curr.yellow_arrow_left_owner = getIndicatorController(YELLOW_ARROW_LEFT);
+        curr.yellow_arrow_right_owner = getIndicatorController(YELLOW_ARROW_RIGHT);
+        curr.yellow_arrow_out_owner = getIndicatorController(YELLOW_ARROW_OUT);
+
+        return curr;
+    }
+
+    RequesterId LightBarManagerWorker::internRequester(const std::string& name)
+    {
+        auto it = requester_ids_.find(name);
+        if (it != requester_ids_.end())
+        {
+            return it->second;
+        }
+
+        RequesterId id = static_cast<RequesterId>(requester_names_.size());
+        requester_names_.push_back(name);
+        requester_ids_.emplace(name, id);
+        requester_priorities_.push_back(priorityOf(name));
+
+        // Warned once here rather than on every comparison
+        if (requester_priorities_[id] == UNLISTED_PRIORITY)
+        {
+            ROS_WARN_STREAM(name << " is referenced in lightbar_manager, but is not in the priority list");
+        }
+        return id;
+    }
+
+    const std::string& LightBarManagerWorker::getRequesterName(RequesterId id) const
+    {
+        return requester_names_[id];
+    }
+
+    void LightBarManagerWorker::setControlPriorities(const std::vector<std::string>& priorities)
+    {
+        control_priorities_ = priorities;
+        for (size_t id = 1; id < requester_names_.size(); id++)
+        {
+            requester_priorities_[id] = priorityOf(requester_names_[id]);
+        }
+    }
+
+    const std::vector<std::string>& LightBarManagerWorker::getControlPriorities() const
     {
-        return ind_ctrl_map_;
+        return control_priorities_;
+    }
+
+    int LightBarManagerWorker::priorityOf(const std::string& name) const
+    {
+        auto it = std::find(control_priorities_.begin(), control_priorities_.end(), name);
+        // No owner is never in the priority list
+        if (name.empty() || it == control_priorities_.end())
+        {
+            return UNLISTED_PRIORITY;
+        }
+        return static_cast<int>(it - control_priorities_.begin());
     }
 
     std::map<LightBarCDAType, LightBarIndicator> LightBarManagerWorker::setIndicatorCDAMap(std::map<std::string, std::string> raw_map)
@@ -131,109 +209,130 @@ namespace lightbar_manager
         return cda_ind_map_;
     }
 
-    bool LightBarManagerWorker::hasHigherPriority (std::string requester, std::string controller)
+    bool LightBarManagerWorker::hasHigherPriority (const std::string& requester, const std::string& controller)
     {
-        auto start = control_priorities.begin();
-        auto end = control_priorities.end();
-        
-        auto requesterPriority = std::find(start, end, requester);
-        auto controllerPriority = std::find(start, end, controller);
+        return hasHigherPriority(internRequester(requester), internRequester(controller));
+    }
+
+    bool LightBarManagerWorker::hasHigherPriority (RequesterId requester, RequesterId controller) const
+    {
+        int requester_priority = requester_priorities_[requester];
+        int controller_priority = requester_priorities_[controller];
 
         // Components not in the priority list are assumed to have the lowest priority
-        if (requesterPriority == end)
+        if (requester_priority == UNLISTED_PRIORITY)
         {
-            ROS_WARN_STREAM(requester << " is referenced in lightbar_manager, but is not in the priority list");
             return false;
-        }  
-        else if (controllerPriority == end)
+        }
+        return requester_priority <= controller_priority;
+    }
+
+    IndicatorSet LightBarManagerWorker::toIndicatorSet(const std::vector<LightBarIndicator>& indicators)
+    {
+        IndicatorSet set;
+        for (LightBarIndicator indicator : indicators)
         {
-            ROS_WARN_STREAM(controller << " is referenced in lightbar_manager and is controlling an indicator, but is not in the priority list");
-            return true;
+            if (indicator < 0 || indicator >= INDICATOR_COUNT)
+            {
+                ROS_WARN_STREAM("In function: " << __FUNCTION__ << ", skipping invalid indicator " << indicator);
+                continue;
+            }
+            set.set(indicator);
+        }
+        return set;
+    }
+
+    IndicatorSet LightBarManagerWorker::toIndicatorSet(const std::vector<IndicatorStatus>& indicator_status)
+    {
+        IndicatorSet set;
+        for (size_t i = 0; i < indicator_status.size() && i < INDICATOR_COUNT; i++)
+        {
+            set[i] = indicator_status[i] == ON;
         }
-        return (requesterPriority - end) <= (controllerPriority - end);
+        return set;
     }
 
-    std::vector<LightBarIndicator> LightBarManagerWorker::requestControl(std::vector<LightBarIndicator> ind_list, std::string requester_name)
+    std::vector<LightBarIndicator> LightBarManagerWorker::requestControl(const std::vector<LightBarIndicator>& ind_list, const std::string& requester_name)
     {
+        IndicatorSet denied = requestControl(toIndicatorSet(ind_list), internRequester(requester_name));
+
+        // Report denied indicators in the order they were requested
         std::vector<LightBarIndicator> denied_list;
-        std::string indicator_owner;
-        // Attempt to acquire control of every indicators
-        for (LightBarIndicator indicator: ind_list) 
+        for (LightBarIndicator indicator : ind_list)
         {
-            // Attempt control
-            try
+            if (indicator >= 0 && indicator < INDICATOR_COUNT && denied[indicator])
             {
-                indicator_owner = ind_ctrl_map_.at(indicator);
+                denied_list.push_back(indicator);
             }
-            catch(const std::exception& e)
+        }
+        return denied_list;
+    }
+
+    IndicatorSet LightBarManagerWorker::requestControl(IndicatorSet indicators, RequesterId requester)
+    {
+        IndicatorSet denied;
+        // Attempt to acquire control of every indicators
+        for (int i = 0; i < INDICATOR_COUNT; i++) 
+        {
+            if (!indicators[i])
             {
-                ROS_WARN_STREAM("In function: " << __FUNCTION__ << ", the component, " << requester_name 
-                    << ", requested a control of invalid indicator. Skipping with WARNING:" << e.what() << "\n");
                 continue;
             }
+            LightBarIndicator indicator = static_cast<LightBarIndicator>(i);
+            RequesterId indicator_owner = ind_owners_[i];
         
-            if (indicator_owner == "") 
+            if (indicator_owner == 0) 
             {   
                 // Add new controller If no other component has claimed this indicator
-                handleControlChange(indicator, requester_name, CONTROL_GAINED);
+                handleControlChange(indicator, requester, CONTROL_GAINED);
             } 
-            else if (indicator_owner != requester_name) 
+            else if (indicator_owner != requester) 
             {   
                 // If this indicator is already controlled
                 // If the requesting component has higher priority it may take control of this indicator
-                if (hasHigherPriority(requester_name, indicator_owner)) 
+                if (hasHigherPriority(requester, indicator_owner)) 
                 {
                     // Handle previous controller
                     handleControlChange(indicator, indicator_owner, CONTROL_LOST);
                     // Add new controller
-                    handleControlChange(indicator, requester_name, CONTROL_GAINED);
+                    handleControlChange(indicator, requester, CONTROL_GAINED);
                 } 
                 else 
                 {
-                    denied_list.push_back(indicator); // Notify caller of failure to take control of component
+                    denied.set(i); // Notify caller of failure to take control of component
                 }
             }
         }
-        return denied_list;
+        return denied;
     }   
 
-    void LightBarManagerWorker::releaseControl(std::vector<LightBarIndicator> ind_list, std::string owner_name)
+    void LightBarManagerWorker::releaseControl(const std::vector<LightBarIndicator>& ind_list, const std::string& owner_name)
+    {
+        releaseControl(toIndicatorSet(ind_list), internRequester(owner_name));
+    }
+
+    void LightBarManagerWorker::releaseControl(IndicatorSet indicators, RequesterId owner)
     {
-        std::string current_owner;
-        
         // Attempt to release control of all indicators
-        for (LightBarIndicator indicator: ind_list) 
+        for (int i = 0; i < INDICATOR_COUNT; i++) 
         {
-            // Attempt release control
-            try
-            {
-                current_owner = ind_ctrl_map_.at(indicator);
-            }
-            catch(const std::exception& e)
-            {
-                ROS_WARN_STREAM("In function: " << __FUNCTION__ << ", the component, " << owner_name 
-                    << ", requested a release of an invalid indicator. Skipping with WARNING:" << e.what() << "\n");
-                continue;
-            }
-
             // Lose control only if the requester is currently controlling it
-            if (current_owner == owner_name) 
+            if (indicators[i] && ind_owners_[i] == owner) 
             {   
-                handleControlChange(indicator,owner_name, CONTROL_LOST);
+                handleControlChange(static_cast<LightBarIndicator>(i), owner, CONTROL_LOST);
             }
         }
+    }
 
-        return;
+    void LightBarManagerWorker::handleControlChange(LightBarIndicator indicator, const std::string& controller, IndicatorControlEvent event)
+    {
+        handleControlChange(indicator, internRequester(controller), event);
     }
     
-    void LightBarManagerWorker::handleControlChange(LightBarIndicator indicator, std::string controller, IndicatorControlEvent event)
+    void LightBarManagerWorker::handleControlChange(LightBarIndicator indicator, RequesterId controller, IndicatorControlEvent event)
     {
-        // Pick new owner name depending on losing or gaining control
-        std::string new_owner;
-        if (event == CONTROL_GAINED)
-            new_owner = controller;
-        else
-            new_owner = "";
+        // Pick new owner depending on losing or gaining control
+        RequesterId new_owner = event == CONTROL_GAINED ? controller : 0;
         
         // Handle mutually in-exclusive indicators
         // These are indicators that are controlled indirectly due to change in one indicator
@@ -244,63 +343,61 @@ namespace lightbar_manager
         {
             case YELLOW_ARROW_LEFT:
             case YELLOW_ARROW_RIGHT:
-                ind_ctrl_map_[YELLOW_ARROW_OUT] = 
-                    hasHigherPriority(controller, ind_ctrl_map_[YELLOW_ARROW_OUT]) ? new_owner :ind_ctrl_map_[YELLOW_ARROW_OUT];
-                ind_ctrl_map_[YELLOW_FLASH] = ind_ctrl_map_[YELLOW_ARROW_OUT]; //they always have same owner
-                ind_ctrl_map_[indicator] = new_owner;
+                ind_owners_[YELLOW_ARROW_OUT] = 
+                    hasHigherPriority(controller, ind_owners_[YELLOW_ARROW_OUT]) ? new_owner : ind_owners_[YELLOW_ARROW_OUT];
+                ind_owners_[YELLOW_FLASH] = ind_owners_[YELLOW_ARROW_OUT]; //they always have same owner
+                ind_owners_[indicator] = new_owner;
                 break;
             case YELLOW_ARROW_OUT:
             case YELLOW_FLASH:
-                ind_ctrl_map_[YELLOW_ARROW_LEFT] = 
-                    hasHigherPriority(controller, ind_ctrl_map_[YELLOW_ARROW_LEFT]) ? new_owner :ind_ctrl_map_[YELLOW_ARROW_LEFT];
-                ind_ctrl_map_[YELLOW_ARROW_RIGHT] = 
-                    hasHigherPriority(controller, ind_ctrl_map_[YELLOW_ARROW_RIGHT]) ? new_owner :ind_ctrl_map_[YELLOW_ARROW_RIGHT];
-                ind_ctrl_map_[YELLOW_ARROW_OUT] = 
-                    hasHigherPriority(controller, ind_ctrl_map_[YELLOW_ARROW_OUT]) ? new_owner :ind_ctrl_map_[YELLOW_ARROW_OUT];
-                ind_ctrl_map_[YELLOW_FLASH] = ind_ctrl_map_[YELLOW_ARROW_OUT]; //they always have same owner
+                ind_owners_[YELLOW_ARROW_LEFT] = 
+                    hasHigherPriority(controller, ind_owners_[YELLOW_ARROW_LEFT]) ? new_owner : ind_owners_[YELLOW_ARROW_LEFT];
+                ind_owners_[YELLOW_ARROW_RIGHT] = 
+                    hasHigherPriority(controller, ind_owners_[YELLOW_ARROW_RIGHT]) ? new_owner : ind_owners_[YELLOW_ARROW_RIGHT];
+                ind_owners_[YELLOW_ARROW_OUT] = 
+                    hasHigherPriority(controller, ind_owners_[YELLOW_ARROW_OUT]) ? new_owner : ind_owners_[YELLOW_ARROW_OUT];
+                ind_owners_[YELLOW_FLASH] = ind_owners_[YELLOW_ARROW_OUT]; //they always have same owner
                 break;
             case GREEN_FLASH:
             case GREEN_SOLID:
-                ind_ctrl_map_[GREEN_FLASH] = 
-                    hasHigherPriority(controller, ind_ctrl_map_[GREEN_FLASH]) ? new_owner :ind_ctrl_map_[GREEN_FLASH];
-                ind_ctrl_map_[GREEN_SOLID] = ind_ctrl_map_[GREEN_FLASH]; //they always have same owner
+                ind_owners_[GREEN_FLASH] = 
+                    hasHigherPriority(controller, ind_owners_[GREEN_FLASH]) ? new_owner : ind_owners_[GREEN_FLASH];
+                ind_owners_[GREEN_SOLID] = ind_owners_[GREEN_FLASH]; //they always have same owner
                 break;
             default:
-                ind_ctrl_map_[indicator] = new_owner;
+                ind_owners_[indicator] = new_owner;
                 break;
         }
         return;
     }
 
-    std::vector<IndicatorStatus> LightBarManagerWorker::setIndicator(LightBarIndicator ind, IndicatorStatus ind_status, std::string requester_name)
+    IndicatorSet LightBarManagerWorker::setIndicator(LightBarIndicator ind, IndicatorStatus ind_status, const std::string& requester_name) const
     {
-        std::string current_controller = ind_ctrl_map_[ind];
-
         // Use a local copy in case manager fails to set the light
-        std::vector<IndicatorStatus> light_status_copy = light_status;
+        IndicatorSet light_status_copy = light_status;
 
         // Handle mutually non-exclusive cases
         // If desired indicator is already at the status do not change any indicators 
-        if (ind_status != light_status_copy[ind])
+        if ((ind_status == ON) != light_status_copy[ind])
         {
             switch(ind)
             {
                 case YELLOW_ARROW_LEFT:
                 case YELLOW_ARROW_RIGHT:
-                    light_status_copy[YELLOW_ARROW_OUT] = OFF;
-                    light_status_copy[YELLOW_FLASH] = OFF;
+                    light_status_copy.reset(YELLOW_ARROW_OUT);
+                    light_status_copy.reset(YELLOW_FLASH);
                     break;
                 case YELLOW_ARROW_OUT:
                 case YELLOW_FLASH:
-                    light_status_copy[YELLOW_ARROW_OUT] = OFF;
-                    light_status_copy[YELLOW_FLASH] = OFF;
-                    light_status_copy[YELLOW_ARROW_LEFT] = OFF;
-                    light_status_copy[YELLOW_ARROW_RIGHT] = OFF;
+                    light_status_copy.reset(YELLOW_ARROW_OUT);
+                    light_status_copy.reset(YELLOW_FLASH);
+                    light_status_copy.reset(YELLOW_ARROW_LEFT);
+                    light_status_copy.reset(YELLOW_ARROW_RIGHT);
                     break;
                 case GREEN_FLASH:
                 case GREEN_SOLID:
-                    light_status_copy[GREEN_FLASH] = OFF;
-                    light_status_copy[GREEN_SOLID] = OFF;
+                    light_status_copy.reset(GREEN_FLASH);
+                    light_status_copy.reset(GREEN_SOLID);
                     break;
                 default:
                     break;
@@ -308,40 +405,36 @@ namespace lightbar_manager
         }
         
         // Set the desired indicator now that there is no conflict.
-        light_status_copy[ind] = ind_status;
+        light_status_copy[ind] = ind_status == ON;
         return light_status_copy;
 
     }
 
-    cav_msgs::LightBarStatus LightBarManagerWorker::getLightBarStatusMsg(std::vector<IndicatorStatus> indicators)
+    cav_msgs::LightBarStatus LightBarManagerWorker::getLightBarStatusMsg(const std::vector<IndicatorStatus>& indicators) const
+    {
+        return getLightBarStatusMsg(toIndicatorSet(indicators));
+    }
+
+    cav_msgs::LightBarStatus LightBarManagerWorker::getLightBarStatusMsg(const IndicatorSet& indicators) const
     {
         // it is assumed that mutually exclusive cases are handled properly.
         cav_msgs::LightBarStatus msg;
-        msg.green_solid = indicators[GREEN_SOLID] == ON ? cav_msgs::LightBarStatus::ON : cav_msgs::LightBarStatus::OFF;
-        msg.green_flash = indicators[GREEN_FLASH]== ON ? cav_msgs::LightBarStatus::ON : cav_msgs::LightBarStatus::OFF;
-        msg.sides_solid = indicators[YELLOW_SIDES]== ON ? cav_msgs::LightBarStatus::ON : cav_msgs::LightBarStatus::OFF;
-        msg.yellow_solid = indicators[YELLOW_DIM]== ON ? cav_msgs::LightBarStatus::ON : cav_msgs::LightBarStatus::OFF;
-        msg.flash = indicators[YELLOW_FLASH]== ON ? cav_msgs::LightBarStatus::ON : cav_msgs::LightBarStatus::OFF;
-
-        msg.left_arrow = indicators[YELLOW_ARROW_LEFT]== ON ? cav_msgs::LightBarStatus::ON : cav_msgs::LightBarStatus::OFF;
-        msg.right_arrow = indicators[YELLOW_ARROW_RIGHT]== ON ? cav_msgs::LightBarStatus::ON : cav_msgs::LightBarStatus::OFF;
+        msg.green_solid = indicators[GREEN_SOLID] ? cav_msgs::LightBarStatus::ON : cav_msgs::LightBarStatus::OFF;
+        msg.green_flash = indicators[GREEN_FLASH] ? cav_msgs::LightBarStatus::ON : cav_msgs::LightBarStatus::OFF;
+        msg.sides_solid = indicators[YELLOW_SIDES] ? cav_msgs::LightBarStatus::ON : cav_msgs::LightBarStatus::OFF;
+        msg.yellow_solid = indicators[YELLOW_DIM] ? cav_msgs::LightBarStatus::ON : cav_msgs::LightBarStatus::OFF;
+        msg.flash = indicators[YELLOW_FLASH] ? cav_msgs::LightBarStatus::ON : cav_msgs::LightBarStatus::OFF;
+
         // for YELLOW_ARROW_OUT set left and right
-        if (indicators[YELLOW_ARROW_OUT] == ON)
-        {
-            msg.left_arrow = cav_msgs::LightBarStatus::ON;
-            msg.right_arrow = cav_msgs::LightBarStatus::ON;
-        }
+        msg.left_arrow = indicators[YELLOW_ARROW_LEFT] || indicators[YELLOW_ARROW_OUT] ? cav_msgs::LightBarStatus::ON : cav_msgs::LightBarStatus::OFF;
+        msg.right_arrow = indicators[YELLOW_ARROW_RIGHT] || indicators[YELLOW_ARROW_OUT] ? cav_msgs::LightBarStatus::ON : cav_msgs::LightBarStatus::OFF;
         return msg;
     }
 
     void LightBarManagerWorker::setIndicatorControllers()
     {
-        for (int i = 0; i <= INDICATOR_COUNT; i++ )
-        {
-            LightBarIndicator indicator = static_cast<LightBarIndicator>(i);
-            // initialize the owner as empty string
-            ind_ctrl_map_[indicator] = "";
-        }
+        // initialize the owner as no owner
+        ind_owners_.fill(0);
         return;
     }
 
@@ -202,7 +202,7 @@ TEST(LightBarManagerWorkerTest, testSetIndicator)
     // initialize worker that is unit testable
     node.init("test");
     LightBarManagerWorker worker = node.getWorker();
-    std::vector<IndicatorStatus> correct_light_status;
+    IndicatorSet correct_light_status;
     std::vector<LightBarIndicator> target_indicators;
     // Lightbar_manager should be able to set the green indicators right away
     //target_indicators = {GREEN_SOLID};
@@ -210,7 +210,7 @@ TEST(LightBarManagerWorkerTest, testSetIndicator)
     std::map<LightBarIndicator, std::string> curr_owners = worker.getIndicatorControllers();
     EXPECT_EQ("lightbar_manager", curr_owners[GREEN_SOLID]);
     worker.light_status = worker.setIndicator(GREEN_SOLID, ON, "lightbar_manager");
-    correct_light_status = {ON, OFF, OFF, OFF, OFF, OFF, OFF, OFF};
+    correct_light_status = LightBarManagerWorker::toIndicatorSet(std::vector<IndicatorStatus>{ON, OFF, OFF, OFF, OFF, OFF, OFF, OFF});
     EXPECT_EQ(correct_light_status, worker.light_status);
     
     /*
@@ -218,17 +218,17 @@ TEST(LightBarManagerWorkerTest, testSetIndicator)
     */
     // LightbarManager changing one green indicator should change the other too
     worker.light_status = worker.setIndicator(GREEN_FLASH, ON, "lightbar_manager");
-    correct_light_status = {OFF, ON, OFF, OFF, OFF, OFF, OFF, OFF};
+    correct_light_status = LightBarManagerWorker::toIndicatorSet(std::vector<IndicatorStatus>{OFF, ON, OFF, OFF, OFF, OFF, OFF, OFF});
     EXPECT_EQ(correct_light_status, worker.light_status);
     // However changing the same indicator to same status should not change anything
     worker.light_status = worker.setIndicator(GREEN_FLASH, ON, "lightbar_manager");
-    correct_light_status = {OFF, ON, OFF, OFF, OFF, OFF, OFF, OFF};
+    correct_light_status = LightBarManagerWorker::toIndicatorSet(std::vector<IndicatorStatus>{OFF, ON, OFF, OFF, OFF, OFF, OFF, OFF});
     EXPECT_EQ(correct_light_status, worker.light_status);
     // Unlike request/release control func, this should only turn ON what is requested
     target_indicators = {YELLOW_ARROW_LEFT};
     worker.requestControl(target_indicators, "tester3");
     worker.light_status = worker.setIndicator(YELLOW_ARROW_LEFT, ON, "tester3");
-    correct_light_status = {OFF, ON, OFF, OFF, OFF, ON, OFF, OFF};
+    correct_light_status = LightBarManagerWorker::toIndicatorSet(std::vector<IndicatorStatus>{OFF, ON, OFF, OFF, OFF, ON, OFF, OFF});
     EXPECT_EQ(correct_light_status, worker.light_status);
 
 }
@@ -268,6 +268,60 @@ TEST(LightBarManagerWorkerTest, testGetLightBarStatusMsg)
     EXPECT_EQ(cav_msgs::LightBarStatus::OFF, msg.flash);
     EXPECT_EQ(cav_msgs::LightBarStatus::ON, msg.left_arrow);
     EXPECT_EQ(cav_msgs::LightBarStatus::ON, msg.right_arrow);
+
+    // The indicator set produces the same message
+    IndicatorSet right_arrow;
+    right_arrow.set(YELLOW_ARROW_RIGHT);
+    msg = worker.getLightBarStatusMsg(right_arrow);
+    EXPECT_EQ(cav_msgs::LightBarStatus::OFF, msg.green_solid);
+    EXPECT_EQ(cav_msgs::LightBarStatus::OFF, msg.left_arrow);
+    EXPECT_EQ(cav_msgs::LightBarStatus::ON, msg.right_arrow);
+}
+
+TEST(LightBarManagerWorkerTest, testInternedRequesters) 
+{
+    LightBarManager node("lightbar_manager");
+    // initialize worker that is unit testable
+    node.init("test");
+    LightBarManagerWorker worker = node.getWorker();
+
+    // No owner is always id 0 and ids are stable
+    EXPECT_EQ(0, worker.internRequester(""));
+    RequesterId tester1 = worker.internRequester("tester1");
+    RequesterId tester3 = worker.internRequester("tester3");
+    EXPECT_EQ(tester1, worker.internRequester("tester1"));
+    EXPECT_NE(tester1, tester3);
+    EXPECT_EQ("tester3", worker.getRequesterName(tester3));
+
+    // The id interface matches the name interface
+    IndicatorSet arrows;
+    arrows.set(YELLOW_ARROW_LEFT);
+    arrows.set(YELLOW_ARROW_RIGHT);
+    EXPECT_TRUE(worker.requestControl(arrows, tester3).none());
+    EXPECT_EQ("tester3", worker.getIndicatorController(YELLOW_ARROW_LEFT));
+    EXPECT_EQ("tester3", worker.getIndicatorController(YELLOW_FLASH));
+    EXPECT_TRUE(worker.requestControl(arrows, tester1).none());
+    EXPECT_EQ("tester1", worker.getIndicatorController(YELLOW_ARROW_RIGHT));
+    EXPECT_EQ(arrows, worker.requestControl(arrows, tester3));
+
+    worker.releaseControl(arrows, tester1);
+    EXPECT_EQ("", worker.getIndicatorController(YELLOW_ARROW_LEFT));
+    EXPECT_EQ("", worker.getIndicatorController(YELLOW_ARROW_RIGHT));
+    EXPECT_EQ("", worker.getIndicatorController(YELLOW_ARROW_OUT));
+    EXPECT_EQ("", worker.getIndicatorController(YELLOW_FLASH));
+
+    // Changing priorities applies to components which were already interned
+    worker.setControlPriorities({"tester3", "tester1"});
+    EXPECT_TRUE(worker.hasHigherPriority(tester3, tester1));
+    EXPECT_FALSE(worker.hasHigherPriority(tester1, tester3));
+
+    // The controllers message is built from the owners
+    worker.requestControl(arrows, tester1);
+    cav_msgs::LightBarIndicatorControllers controllers = worker.getIndicatorControllersMsg();
+    EXPECT_EQ("lightbar_manager", controllers.green_solid_owner);
+    EXPECT_EQ("tester1", controllers.yellow_arrow_left_owner);
+    EXPECT_EQ("tester1", controllers.yellow_arrow_out_owner);
+    EXPECT_EQ("", controllers.yellow_dim_owner);
 }
 
 
@@ -20,6 +20,8 @@
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <tf2_ros/transform_listener.h>
+#include <tf2/LinearMath/Transform.h>
+#include <tf2_msgs/TFMessage.h>
 #include <boost/shared_ptr.hpp>
 #include <carma_utils/CARMAUtils.h>
 #include <cav_msgs/TrajectoryPlan.h>
@@ -44,6 +46,22 @@ namespace mobilitypath_publisher
         boost::shared_ptr<geometry_msgs::PoseStamped const> current_pose_;
 
         cav_msgs::MobilityPath mobilityPathMessageGenerator(const cav_msgs::TrajectoryPlan& trajectory_plan, const geometry_msgs::TransformStamped& tf);
+
+        cav_msgs::MobilityPath mobilityPathMessageGenerator(const cav_msgs::TrajectoryPlan& trajectory_plan, const tf2::Transform& map_in_earth);
+
+        /**
+         * \brief Converts the trajectory into the path to publish unless the current path was already built from a
+         * trajectory with the same id and the same map in earth transform, in which case only its timestamp is updated
+         *
+         * \param trajectory_plan The trajectory to publish
+         * \param map_in_earth Location of the map frame in the earth frame
+         * \param map_in_earth_version Incremented by the caller whenever map_in_earth changes
+         *
+         * \return True if the trajectory was converted, false if the previous path was reused
+         */
+        bool updateMobilityPath(const cav_msgs::TrajectoryPlan& trajectory_plan, const tf2::Transform& map_in_earth, size_t map_in_earth_version);
+
+        const cav_msgs::MobilityPath& getLatestMobilityPath() const;
         
 
     private:
@@ -66,16 +84,30 @@ namespace mobilitypath_publisher
 
         // ROS publishers
         ros::Publisher mob_path_pub_;
+        ros::Publisher conversion_latency_pub_;
+
+        ros::Subscriber tf_static_sub_;
 
-        cav_msgs::TrajectoryPlan latest_trajectory_;
         cav_msgs::MobilityPath latest_mobility_path_;
 
+        // Trajectory id and transform version the latest path was built from
+        std::string latest_trajectory_id_;
+        size_t latest_path_map_in_earth_version_ = 0;
+        bool latest_path_set_ = false;
+
         // TF listenser
         tf2_ros::Buffer tf2_buffer_;
         std::unique_ptr<tf2_ros::TransformListener> tf2_listener_;
 
-        // BSM Message
-        cav_msgs::BSMCoreData bsm_core_;
+        // Cached location of the map in the earth frame. Refreshed when /tf_static changes or the refresh period elapses
+        tf2::Transform map_in_earth_;
+        bool map_in_earth_set_ = false;
+        size_t map_in_earth_version_ = 0;
+        ros::Time map_in_earth_lookup_time_;
+        ros::Duration map_transform_refresh_period_ = ros::Duration(1.0);
+
+        // Only seeded once since seeding reads from the system entropy source
+        boost::uuids::random_generator plan_id_generator_;
 
         
         // initialize this node
@@ -85,16 +117,22 @@ namespace mobilitypath_publisher
         void currentpose_cb(const geometry_msgs::PoseStampedConstPtr& msg);
         void trajectory_cb(const cav_msgs::TrajectoryPlanConstPtr& msg);
         void bsm_cb(const cav_msgs::BSMConstPtr& msg);
+        void tf_static_cb(const tf2_msgs::TFMessageConstPtr& msg);
+
+        /**
+         * \brief Updates the cached map in earth transform if it is missing or out of date
+         *
+         * \return True if a map in earth transform is available
+         */
+        bool updateMapInEarth();
 
         // Compose Mobility Header
         cav_msgs::MobilityHeader composeMobilityHeader(uint64_t time);
 
         // Convert Trajectory Plan to (Mobility) Trajectory
-        cav_msgs::Trajectory TrajectoryPlantoTrajectory(const std::vector<cav_msgs::TrajectoryPlanPoint>& traj_points, const geometry_msgs::TransformStamped& tf) const;
-
-    
-        // Convert Trajectory Point to ECEF Transform
-        cav_msgs::LocationECEF TrajectoryPointtoECEF(const cav_msgs::TrajectoryPlanPoint& traj_point, const geometry_msgs::TransformStamped& tf) const;
+        // The first point is the starting location and each offset is from the previous point, all in centimeters.
+        // Offsets are taken between rounded locations so rounding errors do not build up along the path
+        cav_msgs::Trajectory TrajectoryPlantoTrajectory(const std::vector<cav_msgs::TrajectoryPlanPoint>& traj_points, const tf2::Transform& map_in_earth) const;
 
         // sender's static ID which is its license plate
         std::string sender_id = "USDOT-49096";
@@ -16,9 +16,35 @@
 
 
 #include "mobilitypath_publisher.h"
+#include <tf2_geometry_msgs/tf2_geometry_msgs.h>
+#include <std_msgs/Float64.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <type_traits>
 
 namespace mobilitypath_publisher
 {
+namespace
+{
+    // Rounds a location in meters to the nearest centimeter
+    int64_t toCentimeters(double meters)
+    {
+        return std::llround(meters * 100.0);
+    }
+
+    // Clamps a centimeter offset to the range of the message field it is written to
+    template <typename T>
+    T toOffsetField(int64_t offset_cm)
+    {
+        static_assert(std::is_integral<T>::value, "ECEF offsets are expected to be fixed point");
+        offset_cm = std::max<int64_t>(offset_cm, std::numeric_limits<T>::min());
+        offset_cm = std::min<int64_t>(offset_cm, std::numeric_limits<T>::max());
+        return static_cast<T>(offset_cm);
+    }
+}  // namespace
+
 // @SONAR_STOP@
     MobilityPathPublication::MobilityPathPublication():
                             spin_rate_(10.0) {}
@@ -29,10 +55,16 @@ namespace mobilitypath_publisher
         pnh_.reset(new ros::CARMANodeHandle("~"));
         pnh_->param<double>("spin_rate", spin_rate_, 10.0);
         pnh_->getParam("vehicle_id", sender_id);
+        double refresh_period = map_transform_refresh_period_.toSec();
+        pnh_->param<double>("map_transform_refresh_period", refresh_period, refresh_period);
+        map_transform_refresh_period_ = ros::Duration(std::max(refresh_period, 0.0));
         mob_path_pub_ = nh_->advertise<cav_msgs::MobilityPath>("mobility_path_msg", 5);
+        conversion_latency_pub_ = pnh_->advertise<std_msgs::Float64>("conversion_latency", 5);
         traj_sub_ = nh_->subscribe("plan_trajectory", 5, &MobilityPathPublication::trajectory_cb, this);
         pose_sub_ = nh_->subscribe("current_pose", 5, &MobilityPathPublication::currentpose_cb, this);
         bsm_sub_ = nh_->subscribe("bsm_outbound", 1, &MobilityPathPublication::bsm_cb, this);
+        // Static transform subscriber used to invalidate the cached map transform
+        tf_static_sub_ = nh_->subscribe("/tf_static", 10, &MobilityPathPublication::tf_static_cb, this);
         tf2_listener_.reset(new tf2_ros::TransformListener(tf2_buffer_));
         ros::CARMANodeHandle::setSpinCallback(std::bind(&MobilityPathPublication::spinCallback, this));
         ros::CARMANodeHandle::setSpinRate(spin_rate_);
@@ -54,18 +86,58 @@ namespace mobilitypath_publisher
 
     void MobilityPathPublication::trajectory_cb(const cav_msgs::TrajectoryPlanConstPtr& msg)
     {
-        latest_trajectory_ = *msg;
+        if (!updateMapInEarth())
+        {
+            return;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        if (updateMobilityPath(*msg, map_in_earth_, map_in_earth_version_))
+        {
+            std_msgs::Float64 latency_msg;
+            latency_msg.data = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            conversion_latency_pub_.publish(latency_msg);
+            ROS_DEBUG_STREAM("Converted trajectory " << msg->trajectory_id << " with " << msg->trajectory_points.size() << " points in " << latency_msg.data << " ms");
+        }
+    }
 
+    bool MobilityPathPublication::updateMapInEarth()
+    {
+        ros::Time now = ros::Time::now();
+        bool expired = !map_transform_refresh_period_.isZero() && now - map_in_earth_lookup_time_ > map_transform_refresh_period_;
+        if (map_in_earth_set_ && !expired)
+        {
+            return true;
+        }
+
+        tf2::Transform map_in_earth;
         try
         {
-            geometry_msgs::TransformStamped tf = tf2_buffer_.lookupTransform("earth", "map", ros::Time(0));
-            latest_mobility_path_ = mobilityPathMessageGenerator(latest_trajectory_, tf);
+            // The map_in_earth transform should only change occasionally so no need to lookup a specific time
+            tf2::fromMsg(tf2_buffer_.lookupTransform("earth", "map", ros::Time(0)).transform, map_in_earth);
         }
         catch (tf2::TransformException &ex)
         {
             ROS_WARN("%s", ex.what());
+            map_in_earth_set_ = false;
+            return false;
+        }
+
+        // Only a changed transform invalidates the published path
+        if (!map_in_earth_set_ || !(map_in_earth == map_in_earth_))
+        {
+            map_in_earth_ = map_in_earth;
+            map_in_earth_version_++;
         }
+        map_in_earth_lookup_time_ = now;
+        map_in_earth_set_ = true;
+        return true;
+    }
 
+    void MobilityPathPublication::tf_static_cb(const tf2_msgs::TFMessageConstPtr& msg)
+    {
+        // A new static transform may move the map within the earth frame
+        map_in_earth_set_ = false;
     }
 
     void MobilityPathPublication::currentpose_cb(const geometry_msgs::PoseStampedConstPtr& msg)
@@ -75,19 +147,44 @@ namespace mobilitypath_publisher
 
     void MobilityPathPublication::bsm_cb(const cav_msgs::BSMConstPtr& msg)
     {
-        bsm_core_ = msg->core_data;
-        
+        sender_bsm_id = bsmIDtoString(msg->core_data);
     }
     
 // @SONAR_START@
+    bool MobilityPathPublication::updateMobilityPath(const cav_msgs::TrajectoryPlan& trajectory_plan, const tf2::Transform& map_in_earth, size_t map_in_earth_version)
+    {
+        if (latest_path_set_ && trajectory_plan.trajectory_id == latest_trajectory_id_ && map_in_earth_version == latest_path_map_in_earth_version_)
+        {
+            latest_mobility_path_.header.timestamp = trajectory_plan.header.stamp.toNSec()/1000000;
+            return false;
+        }
+
+        latest_mobility_path_ = mobilityPathMessageGenerator(trajectory_plan, map_in_earth);
+        latest_trajectory_id_ = trajectory_plan.trajectory_id;
+        latest_path_map_in_earth_version_ = map_in_earth_version;
+        latest_path_set_ = true;
+        return true;
+    }
+
+    const cav_msgs::MobilityPath& MobilityPathPublication::getLatestMobilityPath() const
+    {
+        return latest_mobility_path_;
+    }
+
     cav_msgs::MobilityPath MobilityPathPublication::mobilityPathMessageGenerator(const cav_msgs::TrajectoryPlan& trajectory_plan, const geometry_msgs::TransformStamped& tf)
+    {
+        tf2::Transform map_in_earth;
+        tf2::fromMsg(tf.transform, map_in_earth);
+        return mobilityPathMessageGenerator(trajectory_plan, map_in_earth);
+    }
+
+    cav_msgs::MobilityPath MobilityPathPublication::mobilityPathMessageGenerator(const cav_msgs::TrajectoryPlan& trajectory_plan, const tf2::Transform& map_in_earth)
     {
         cav_msgs::MobilityPath mobility_path_msg;
         uint64_t millisecs =trajectory_plan.header.stamp.toNSec()/1000000;
         mobility_path_msg.header = composeMobilityHeader(millisecs);
         
-        cav_msgs::Trajectory mob_path_traj = TrajectoryPlantoTrajectory(trajectory_plan.trajectory_points, tf);
-        mobility_path_msg.trajectory = mob_path_traj;
+        mobility_path_msg.trajectory = TrajectoryPlantoTrajectory(trajectory_plan.trajectory_points, map_in_earth);
 
         return mobility_path_msg;
     }
@@ -96,50 +193,63 @@ namespace mobilitypath_publisher
         cav_msgs::MobilityHeader header;
         header.sender_id = sender_id;
         header.recipient_id = recipient_id;
-        header.sender_bsm_id = bsmIDtoString(bsm_core_);
+        header.sender_bsm_id = sender_bsm_id;
         // random GUID that identifies this particular plan for future reference
-        header.plan_id = boost::uuids::to_string(boost::uuids::random_generator()());
+        header.plan_id = boost::uuids::to_string(plan_id_generator_());
         header.timestamp = time; //time in millisecond
         
         return header;
     }
 
-    cav_msgs::Trajectory MobilityPathPublication::TrajectoryPlantoTrajectory(const std::vector<cav_msgs::TrajectoryPlanPoint>& traj_points, const geometry_msgs::TransformStamped& tf) const{
+    cav_msgs::Trajectory MobilityPathPublication::TrajectoryPlantoTrajectory(const std::vector<cav_msgs::TrajectoryPlanPoint>& traj_points, const tf2::Transform& map_in_earth) const{
         cav_msgs::Trajectory traj;
-        cav_msgs::LocationECEF ecef_location = TrajectoryPointtoECEF(traj_points[0], tf);
+
+        if (traj_points.empty()){
+            ROS_WARN("Received Trajectory Plan is empty");
+            return traj;
+        }
 
         if (traj_points.size()<2){
             ROS_WARN("Received Trajectory Plan is too small");
-            traj.offsets = {};
-        }
-        else{
-            for (size_t i=1; i<traj_points.size(); i++){
-                
-                    cav_msgs::LocationOffsetECEF offset;
-                    cav_msgs::LocationECEF new_point = TrajectoryPointtoECEF(traj_points[i], tf);
-                    offset.offset_x = new_point.ecef_x - ecef_location.ecef_x;
-                    offset.offset_y = new_point.ecef_y - ecef_location.ecef_y;
-                    offset.offset_z = new_point.ecef_z - ecef_location.ecef_z;
-                    traj.offsets.push_back(offset);
-                
-            }
         }
-        
-        
-        traj.location = ecef_location;
-        return traj;
-    }
 
+        // Trajectory points lie in the map plane so only the first two columns of the rotation are needed
+        const tf2::Matrix3x3& rot = map_in_earth.getBasis();
+        const tf2::Vector3& origin = map_in_earth.getOrigin();
+        const tf2::Vector3 x_axis = rot.getColumn(0);
+        const tf2::Vector3 y_axis = rot.getColumn(1);
+
+        traj.offsets.reserve(traj_points.size() - 1);
+        int64_t prev_x = 0, prev_y = 0, prev_z = 0;
+        for (size_t i=0; i<traj_points.size(); i++){
+            const tf2::Vector3 ecef = origin + x_axis * traj_points[i].x + y_axis * traj_points[i].y;
+            const int64_t x = toCentimeters(ecef.x());
+            const int64_t y = toCentimeters(ecef.y());
+            const int64_t z = toCentimeters(ecef.z());
+
+            if (i == 0){
+                traj.location.ecef_x = x;
+                traj.location.ecef_y = y;
+                traj.location.ecef_z = z;
+                prev_x = x;
+                prev_y = y;
+                prev_z = z;
+                continue;
+            }
 
+            cav_msgs::LocationOffsetECEF offset;
+            offset.offset_x = toOffsetField<decltype(offset.offset_x)>(x - prev_x);
+            offset.offset_y = toOffsetField<decltype(offset.offset_y)>(y - prev_y);
+            offset.offset_z = toOffsetField<decltype(offset.offset_z)>(z - prev_z);
+            traj.offsets.push_back(offset);
 
-    cav_msgs::LocationECEF MobilityPathPublication::TrajectoryPointtoECEF(const cav_msgs::TrajectoryPlanPoint& traj_point, const geometry_msgs::TransformStamped& tf) const{
-        cav_msgs::LocationECEF ecef_point;    
+            // Continue from the location a receiver will reconstruct in case an offset was clamped
+            prev_x += offset.offset_x;
+            prev_y += offset.offset_y;
+            prev_z += offset.offset_z;
+        }
 
-        ecef_point.ecef_x = traj_point.x * tf.transform.translation.x;
-        ecef_point.ecef_y = traj_point.y * tf.transform.translation.y;
-        ecef_point.ecef_z = 0.0 * tf.transform.translation.z;
-       
-        return ecef_point;
-    } 
+        return traj;
+    }
     
 }
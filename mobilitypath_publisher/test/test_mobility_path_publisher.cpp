@@ -37,14 +37,19 @@ TEST(MobilityPathPublicationTest, test1)
     tf.transform.translation.x = 1;
     tf.transform.translation.y = 2;
     tf.transform.translation.z = 3;
+    tf.transform.rotation.w = 1;
     auto res = worker.mobilityPathMessageGenerator(plan, tf);
+    // Locations and offsets are in cm and each offset is from the previous point
     EXPECT_EQ(3, res.trajectory.offsets.size());
-    EXPECT_EQ(1, res.trajectory.location.ecef_x);
-    EXPECT_EQ(1, res.trajectory.offsets[0].offset_x);
-    EXPECT_EQ(2, res.trajectory.location.ecef_y);
-    EXPECT_EQ(4, res.trajectory.offsets[1].offset_y);
-    EXPECT_EQ(0, res.trajectory.location.ecef_z);
-    EXPECT_EQ(0, res.trajectory.offsets[2].offset_z);
+    EXPECT_EQ(200, res.trajectory.location.ecef_x);
+    EXPECT_EQ(300, res.trajectory.location.ecef_y);
+    EXPECT_EQ(300, res.trajectory.location.ecef_z);
+    for (const auto& offset : res.trajectory.offsets)
+    {
+        EXPECT_EQ(100, offset.offset_x);
+        EXPECT_EQ(100, offset.offset_y);
+        EXPECT_EQ(0, offset.offset_z);
+    }
 }
 
 TEST(MobilityPathPublicationTest, test2)
@@ -63,12 +68,104 @@ TEST(MobilityPathPublicationTest, test2)
     geometry_msgs::TransformStamped tf;
     tf.transform.translation.x = 1;
     tf.transform.translation.y = 2;
+    tf.transform.rotation.w = 1;
 
     auto res = worker.mobilityPathMessageGenerator(plan, tf);
     EXPECT_EQ(0, res.trajectory.offsets.size());
-    EXPECT_EQ(1, res.trajectory.location.ecef_x);
-    EXPECT_EQ(2, res.trajectory.location.ecef_y);
-    
+    EXPECT_EQ(200, res.trajectory.location.ecef_x);
+    EXPECT_EQ(300, res.trajectory.location.ecef_y);
+
+    // An empty plan results in an empty trajectory
+    plan.trajectory_points.clear();
+    res = worker.mobilityPathMessageGenerator(plan, tf);
+    EXPECT_EQ(0, res.trajectory.offsets.size());
+    EXPECT_EQ(0, res.trajectory.location.ecef_x);
+}
+
+TEST(MobilityPathPublicationTest, rotatedMap)
+{
+    ros::Time::init();
+    cav_msgs::TrajectoryPlan plan;
+    cav_msgs::TrajectoryPlanPoint point;
+    point.x = 1.0;
+    point.y = 0.5;
+    plan.trajectory_points.push_back(point);
+    point.x = 2.0;
+    plan.trajectory_points.push_back(point);
+
+    // Map x axis along earth y and map y axis along earth z
+    tf2::Matrix3x3 rot(0, 0, 1,
+                       1, 0, 0,
+                       0, 1, 0);
+    tf2::Transform map_in_earth(rot, tf2::Vector3(6378137.0, 10.0, -20.0));
+
+    mobilitypath_publisher::MobilityPathPublication worker;
+    auto res = worker.mobilityPathMessageGenerator(plan, map_in_earth);
+    EXPECT_EQ(637813700, res.trajectory.location.ecef_x);
+    EXPECT_EQ(1100, res.trajectory.location.ecef_y);
+    EXPECT_EQ(-1950, res.trajectory.location.ecef_z);
+    ASSERT_EQ(1, res.trajectory.offsets.size());
+    EXPECT_EQ(0, res.trajectory.offsets[0].offset_x);
+    EXPECT_EQ(100, res.trajectory.offsets[0].offset_y);
+    EXPECT_EQ(0, res.trajectory.offsets[0].offset_z);
+}
+
+TEST(MobilityPathPublicationTest, roundingDoesNotAccumulate)
+{
+    ros::Time::init();
+    cav_msgs::TrajectoryPlan plan;
+    for (int i=0; i<100; i++){
+        cav_msgs::TrajectoryPlanPoint point;
+        point.x = i * 0.014; // 1.4 cm steps are encoded as a mix of 1 and 2 cm offsets
+        plan.trajectory_points.push_back(point);
+    }
+
+    mobilitypath_publisher::MobilityPathPublication worker;
+    auto res = worker.mobilityPathMessageGenerator(plan, tf2::Transform::getIdentity());
+    ASSERT_EQ(99, res.trajectory.offsets.size());
+
+    int64_t x = res.trajectory.location.ecef_x;
+    for (const auto& offset : res.trajectory.offsets)
+    {
+        x += offset.offset_x;
+    }
+    EXPECT_EQ(139, x); // 99 * 1.4 cm rounded
+}
+
+TEST(MobilityPathPublicationTest, reusePath)
+{
+    ros::Time::init();
+    cav_msgs::TrajectoryPlan plan;
+    plan.trajectory_id = "plan_1";
+    plan.header.stamp = ros::Time(1.0);
+    for (int i=0; i<3; i++){
+        cav_msgs::TrajectoryPlanPoint point;
+        point.x = i;
+        plan.trajectory_points.push_back(point);
+    }
+
+    mobilitypath_publisher::MobilityPathPublication worker;
+    tf2::Transform map_in_earth = tf2::Transform::getIdentity();
+    ASSERT_TRUE(worker.updateMobilityPath(plan, map_in_earth, 1));
+    std::string plan_id = worker.getLatestMobilityPath().header.plan_id;
+    EXPECT_EQ(1000u, worker.getLatestMobilityPath().header.timestamp);
+
+    // The same trajectory only refreshes the timestamp
+    plan.header.stamp = ros::Time(2.0);
+    ASSERT_FALSE(worker.updateMobilityPath(plan, map_in_earth, 1));
+    EXPECT_EQ(plan_id, worker.getLatestMobilityPath().header.plan_id);
+    EXPECT_EQ(2000u, worker.getLatestMobilityPath().header.timestamp);
+
+    // A new transform or a new trajectory are converted again
+    map_in_earth.setOrigin(tf2::Vector3(1, 0, 0));
+    ASSERT_TRUE(worker.updateMobilityPath(plan, map_in_earth, 2));
+    EXPECT_NE(plan_id, worker.getLatestMobilityPath().header.plan_id);
+    EXPECT_EQ(100, worker.getLatestMobilityPath().trajectory.location.ecef_x);
+
+    plan_id = worker.getLatestMobilityPath().header.plan_id;
+    plan.trajectory_id = "plan_2";
+    ASSERT_TRUE(worker.updateMobilityPath(plan, map_in_earth, 2));
+    EXPECT_NE(plan_id, worker.getLatestMobilityPath().header.plan_id);
 }
 
 
@@ -34,7 +34,7 @@
 
 #include <carma_utils/CARMAUtils.h>
 
-#include "mpc_follower_wrapper_worker.hpp"
+#include <trajectory_utils/trajectory_to_waypoints.h>
 
 namespace mpc_follower_wrapper {
 
@@ -74,7 +74,9 @@ class MPCFollowerWrapper {
         ros::Publisher way_points_pub_;
 
 
-        MPCFollowerWrapperWorker mpcww;
+        // @brief Batch trajectory converter and the lane message it reuses between trajectories
+        trajectory_utils::TrajectoryToWaypoints trajectory_converter_;
+        autoware_msgs::Lane lane_;
 
 
         // @brief ROS pusblishers.
@@ -44,19 +44,8 @@ void MPCFollowerWrapper::Initialize() {
 void MPCFollowerWrapper::TrajectoryPlanPoseHandler(const cav_msgs::TrajectoryPlan::ConstPtr& tp){
   ROS_DEBUG_STREAM("Received TrajectoryPlanCurrentPosecallback message");
     try {
-      autoware_msgs::Lane lane;
-      lane.header = tp->header;
-      std::vector <autoware_msgs::Waypoint> waypoints;
-      for(int i = 0; i < tp->trajectory_points.size() - 1; i++ ) {
-
-        cav_msgs::TrajectoryPlanPoint t1 = tp->trajectory_points[i];
-        cav_msgs::TrajectoryPlanPoint t2 = tp->trajectory_points[i + 1];
-        autoware_msgs::Waypoint waypoint = mpcww.TrajectoryPlanPointToWaypointConverter(t1, t2);
-        waypoints.push_back(waypoint);
-      }
-
-      lane.waypoints = waypoints;
-      PublisherForWayPoints(lane);
+      trajectory_converter_.convert(*tp, lane_);
+      PublisherForWayPoints(lane_);
     }
     catch(const std::exception& e) {
       ros::CARMANodeHandle::handleException(e);
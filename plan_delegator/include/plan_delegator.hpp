@@ -17,7 +17,11 @@
 #ifndef PLAN_DELEGATOR_INCLUDE_PLAN_DELEGATOR_HPP_
 #define PLAN_DELEGATOR_INCLUDE_PLAN_DELEGATOR_HPP_
 
+#include <functional>
+#include <memory>
 #include <unordered_map>
+#include <vector>
+#include <string>
 #include <math.h>
 #include <ros/ros.h>
 #include <cav_msgs/ManeuverPlan.h>
@@ -43,6 +47,33 @@
 
 namespace plan_delegator
 {
+    /**
+     * \brief Trajectory segment produced by a single tactical plugin for a single maneuver
+     */
+    struct TrajectorySegment
+    {
+        cav_msgs::TrajectoryPlan trajectory;
+        // wall time at which the plugin returned this segment
+        ros::Time planned_at;
+    };
+
+    /**
+     * \brief Running latency statistics of the PlanTrajectory service call for one tactical plugin
+     */
+    struct PlannerLatencyStats
+    {
+        uint64_t calls = 0;
+        uint64_t failures = 0;
+        double last_ms = 0.0;
+        double mean_ms = 0.0;
+        double max_ms = 0.0;
+
+        /**
+         * \brief Add one service call sample to the statistics
+         */
+        void update(double latency_ms, bool success);
+    };
+
     class PlanDelegator
     {
         public:
@@ -50,10 +81,17 @@ namespace plan_delegator
             // constants definition
             static const constexpr double MILLISECOND_TO_SECOND = 0.001;
 
+            /**
+             * \brief Plans a trajectory segment on behalf of the named tactical plugin
+             * \return false if no trajectory could be planned, as for a failed service call
+             */
+            using PlanTrajectoryCallback = std::function<bool(const std::string& planner_name, cav_srvs::PlanTrajectory& plan_req)>;
+
             PlanDelegator();
 
             /**
-             * \brief Initialize the plan delegator
+             * \brief Initialize the plan delegator. Creates the node handles, so it is not called when the plan
+             * delegator is run in process through setPlanTrajectoryCallback
              */
             void init();
 
@@ -67,9 +105,28 @@ namespace plan_delegator
              */
             void maneuverPlanCallback(const cav_msgs::ManeuverPlanConstPtr& plan);
 
+            /**
+             * \brief Callback function of current pose subscriber
+             */
+            void poseCallback(const geometry_msgs::PoseStampedConstPtr& pose);
+
+            /**
+             * \brief Callback function of current velocity subscriber
+             */
+            void twistCallback(const geometry_msgs::TwistStampedConstPtr& twist);
+
+            /**
+             * \brief Send PlanTrajectory requests to the given callback instead of the tactical plugin services.
+             * Used to run the plan delegator in process without node handles, see the planning_replay package.
+             * The callback is invoked concurrently for different segments so it has to be thread safe.
+             * \param callback The planner to use, an empty callback restores the service calls
+             */
+            void setPlanTrajectoryCallback(PlanTrajectoryCallback callback);
+
             /**
              * \brief Get PlanTrajectory service client by plugin name and
-             * create new PlanTrajectory service client if specified name does not exist
+             * create new PlanTrajectory service client if specified name does not exist.
+             * Creates the node handle if init has not been called
              * \return a ServiceClient object which corresponse to the target planner
              */
             ros::ServiceClient& getPlannerClientByName(const std::string& planner_name);
@@ -86,15 +143,61 @@ namespace plan_delegator
              */
             cav_srvs::PlanTrajectory composePlanTrajectoryRequest(const cav_msgs::TrajectoryPlan& latest_trajectory_plan) const;
 
+            /**
+             * \brief Build the trajectory segment cache key of a maneuver
+             * \param plan_id ID of the maneuver plan which contains the maneuver
+             * \param maneuver_index Index of the maneuver in the maneuver plan
+             * \return a key which is unique for every maneuver of every plan
+             */
+            static std::string segmentKey(const std::string& plan_id, size_t maneuver_index);
+
+            /**
+             * \brief Example if a cached trajectory segment has to be replanned
+             * \param segment The cached segment
+             * \param maneuver The maneuver the segment was planned for
+             * \param current_time Time used to compute the age of the segment
+             * \return true if the maneuver is expired or the segment is older than the configured refresh period
+             */
+            bool isSegmentStale(const TrajectorySegment& segment, const cav_msgs::Maneuver& maneuver, ros::Time current_time = ros::Time::now()) const;
+
+            /**
+             * \brief Example if a trajectory segment starts where the already planned trajectory ends
+             * \param trajectory The trajectory planned so far
+             * \param segment The segment to be appended
+             * \return true if the gap between the two is within the configured continuity threshold
+             */
+            bool isSegmentContinuous(const cav_msgs::TrajectoryPlan& trajectory, const cav_msgs::TrajectoryPlan& segment) const noexcept;
+
+            /**
+             * \brief Get the latency statistics collected so far, keyed by tactical plugin name
+             */
+            const std::unordered_map<std::string, PlannerLatencyStats>& getPlannerLatencyStats() const;
+
+            /**
+             * \brief Plan trajectory based on latest maneuver plan via ROS service call to plugins.
+             * The segment of the current maneuver is always replanned from the current vehicle state. Cached segments
+             * of the following maneuvers are reused while they are fresh, and segments which have to be replanned
+             * are requested concurrently when the end state of their predecessor can be predicted from the cache.
+             * \return a TrajectoryPlan object which contains PlanTrajectory response from plugins
+             */
+            cav_msgs::TrajectoryPlan planTrajectory();
+
         protected:
             
             // ROS params
             std::string planning_topic_prefix_;
             std::string planning_topic_suffix_;
             double spin_rate_, max_trajectory_duration_;
+            double segment_refresh_period_, segment_continuity_threshold_;
 
             // map to store service clients
             std::unordered_map<std::string, ros::ServiceClient> trajectory_planners_;
+            // trajectory segments of the current maneuver plan keyed by segmentKey
+            std::unordered_map<std::string, TrajectorySegment> segment_cache_;
+            // PlanTrajectory service latency keyed by tactical plugin name
+            std::unordered_map<std::string, PlannerLatencyStats> planner_latency_;
+            // replaces the PlanTrajectory service calls when set
+            PlanTrajectoryCallback plan_trajectory_cb_;
             // local storage of incoming messages
             cav_msgs::ManeuverPlan latest_maneuver_plan_;
             geometry_msgs::PoseStamped latest_pose_;
@@ -102,9 +205,9 @@ namespace plan_delegator
 
         private:
 
-            // nodehandle and private nodehandle
-            ros::NodeHandle nh_;
-            ros::NodeHandle pnh_;
+            // nodehandle and private nodehandle, only created when needed since creating one starts the ROS node
+            std::unique_ptr<ros::CARMANodeHandle> nh_;
+            std::unique_ptr<ros::CARMANodeHandle> pnh_;
 
             // ROS subscribers and publishers
             ros::Publisher traj_pub_;
@@ -137,10 +240,48 @@ namespace plan_delegator
             bool isTrajectoryLongEnough(const cav_msgs::TrajectoryPlan& plan) const noexcept;
 
             /**
-             * \brief Plan trajectory based on latest maneuver plan via ROS service call to plugins
-             * \return a TrajectoryPlan object which contains PlanTrajectory response from plugins
+             * \brief Result of a single PlanTrajectory service call
              */
-            cav_msgs::TrajectoryPlan planTrajectory();
+            struct SegmentRequestResult
+            {
+                bool success = false;
+                cav_srvs::PlanTrajectory request;
+                double latency_ms = 0.0;
+            };
+
+            /**
+             * \brief Function calling a single tactical plugin with a PlanTrajectory request
+             */
+            using PlannerCall = std::function<bool(cav_srvs::PlanTrajectory&)>;
+
+            /**
+             * \brief Get the function calling the named tactical plugin, either its PlanTrajectory service
+             * or the configured PlanTrajectoryCallback
+             */
+            PlannerCall getPlannerCall(const std::string& planner_name);
+
+            /**
+             * \brief Call a tactical plugin and measure the service call latency.
+             * Does not touch any member state, so it is safe to run concurrently for different segments.
+             */
+            static SegmentRequestResult requestSegment(const PlannerCall& call, cav_srvs::PlanTrajectory plan_req);
+
+            /**
+             * \brief Record a service call result in the latency statistics of a plugin
+             */
+            void recordLatency(const std::string& planner_name, const SegmentRequestResult& result);
+
+            /**
+             * \brief Record a service call result and store the returned segment in the cache if it is usable
+             * \return false if the service call failed or returned an invalid trajectory,
+             * in which case there is no point to keep planning the rest of the maneuver plan
+             */
+            bool acceptSegment(const std::string& planner_name, const std::string& key, const SegmentRequestResult& result);
+
+            /**
+             * \brief Summarize the latency statistics of all known plugins in one line
+             */
+            std::string latencyReport() const;
 
     };
 }
@@ -15,29 +15,49 @@
  */
 
 #include <stdexcept>
+#include <chrono>
+#include <future>
+#include <sstream>
+#include <algorithm>
 #include "plan_delegator.hpp"
 
 namespace plan_delegator
 {
+    void PlannerLatencyStats::update(double latency_ms, bool success)
+    {
+        ++calls;
+        if(!success)
+        {
+            ++failures;
+        }
+        last_ms = latency_ms;
+        mean_ms += (latency_ms - mean_ms) / calls;
+        max_ms = std::max(max_ms, latency_ms);
+    }
+
     PlanDelegator::PlanDelegator() : 
-        planning_topic_prefix_(""), planning_topic_suffix_(""), spin_rate_(10.0), max_trajectory_duration_(6.0) { }
+        planning_topic_prefix_(""), planning_topic_suffix_(""), spin_rate_(10.0), max_trajectory_duration_(6.0),
+        segment_refresh_period_(1.0), segment_continuity_threshold_(0.5) { }
     
     void PlanDelegator::init()
     {
-        nh_ = ros::CARMANodeHandle();
-        pnh_ = ros::CARMANodeHandle("~");
+        if(!nh_)
+        {
+            nh_.reset(new ros::CARMANodeHandle());
+        }
+        pnh_.reset(new ros::CARMANodeHandle("~"));
 
-        pnh_.param<std::string>("planning_topic_prefix", planning_topic_prefix_, "/plugins/");        
-        pnh_.param<std::string>("planning_topic_suffix", planning_topic_suffix_, "/plan_trajectory");
-        pnh_.param<double>("spin_rate", spin_rate_, 10.0);
-        pnh_.param<double>("trajectory_duration_threshold", max_trajectory_duration_, 6.0);
+        pnh_->param<std::string>("planning_topic_prefix", planning_topic_prefix_, "/plugins/");        
+        pnh_->param<std::string>("planning_topic_suffix", planning_topic_suffix_, "/plan_trajectory");
+        pnh_->param<double>("spin_rate", spin_rate_, 10.0);
+        pnh_->param<double>("trajectory_duration_threshold", max_trajectory_duration_, 6.0);
+        pnh_->param<double>("segment_refresh_period", segment_refresh_period_, 1.0);
+        pnh_->param<double>("segment_continuity_threshold", segment_continuity_threshold_, 0.5);
 
-        traj_pub_ = nh_.advertise<cav_msgs::TrajectoryPlan>("plan_trajectory", 5);
-        plan_sub_ = nh_.subscribe("final_maneuver_plan", 5, &PlanDelegator::maneuverPlanCallback, this);
-        twist_sub_ = nh_.subscribe<geometry_msgs::TwistStamped>("current_velocity", 5,
-            [this](const geometry_msgs::TwistStampedConstPtr& twist) {this->latest_twist_ = *twist;});
-        pose_sub_ = nh_.subscribe<geometry_msgs::PoseStamped>("current_pose", 5,
-            [this](const geometry_msgs::PoseStampedConstPtr& pose) {this->latest_pose_ = *pose;});
+        traj_pub_ = nh_->advertise<cav_msgs::TrajectoryPlan>("plan_trajectory", 5);
+        plan_sub_ = nh_->subscribe("final_maneuver_plan", 5, &PlanDelegator::maneuverPlanCallback, this);
+        twist_sub_ = nh_->subscribe("current_velocity", 5, &PlanDelegator::twistCallback, this);
+        pose_sub_ = nh_->subscribe("current_pose", 5, &PlanDelegator::poseCallback, this);
 
         ros::CARMANodeHandle::setSpinCallback(std::bind(&PlanDelegator::spinCallback, this));
         ros::CARMANodeHandle::setSpinRate(spin_rate_);
@@ -54,6 +74,11 @@ namespace plan_delegator
         // do basic check to see if the input is valid
         if (isManeuverPlanValid(plan))
         {
+            // segments of a previous plan can never be reused because cache keys are only unique within one plan
+            if(plan->maneuver_plan_id != latest_maneuver_plan_.maneuver_plan_id)
+            {
+                segment_cache_.clear();
+            }
             latest_maneuver_plan_ = *plan;
         }
         else {
@@ -61,6 +86,21 @@ namespace plan_delegator
         }
     }
 
+    void PlanDelegator::poseCallback(const geometry_msgs::PoseStampedConstPtr& pose)
+    {
+        latest_pose_ = *pose;
+    }
+
+    void PlanDelegator::twistCallback(const geometry_msgs::TwistStampedConstPtr& twist)
+    {
+        latest_twist_ = *twist;
+    }
+
+    void PlanDelegator::setPlanTrajectoryCallback(PlanTrajectoryCallback callback)
+    {
+        plan_trajectory_cb_ = std::move(callback);
+    }
+
     ros::ServiceClient& PlanDelegator::getPlannerClientByName(const std::string& planner_name)
     {
         if(planner_name.size() == 0)
@@ -69,9 +109,13 @@ namespace plan_delegator
         }
         if(trajectory_planners_.find(planner_name) == trajectory_planners_.end())
         {
+            if(!nh_)
+            {
+                nh_.reset(new ros::CARMANodeHandle());
+            }
             ROS_INFO_STREAM("Discovered new trajectory planner: " << planner_name);
             trajectory_planners_.emplace(
-                planner_name, nh_.serviceClient<cav_srvs::PlanTrajectory>(planning_topic_prefix_ + planner_name + planning_topic_suffix_));
+                planner_name, nh_->serviceClient<cav_srvs::PlanTrajectory>(planning_topic_prefix_ + planner_name + planning_topic_suffix_));
         }
         return trajectory_planners_[planner_name];
     }
@@ -124,44 +168,164 @@ namespace plan_delegator
         return (plan.trajectory_points.back().target_time - plan.trajectory_points.front().target_time) * MILLISECOND_TO_SECOND >= max_trajectory_duration_;
     }
 
+    std::string PlanDelegator::segmentKey(const std::string& plan_id, size_t maneuver_index)
+    {
+        return plan_id + "#" + std::to_string(maneuver_index);
+    }
+
+    bool PlanDelegator::isSegmentStale(const TrajectorySegment& segment, const cav_msgs::Maneuver& maneuver, ros::Time current_time) const
+    {
+        return isManeuverExpired(maneuver, current_time) || (current_time - segment.planned_at).toSec() >= segment_refresh_period_;
+    }
+
+    bool PlanDelegator::isSegmentContinuous(const cav_msgs::TrajectoryPlan& trajectory, const cav_msgs::TrajectoryPlan& segment) const noexcept
+    {
+        if(trajectory.trajectory_points.empty() || segment.trajectory_points.empty())
+        {
+            return true;
+        }
+        const auto& last_point = trajectory.trajectory_points.back();
+        const auto& first_point = segment.trajectory_points.front();
+        return std::hypot(first_point.x - last_point.x, first_point.y - last_point.y) <= segment_continuity_threshold_;
+    }
+
+    const std::unordered_map<std::string, PlannerLatencyStats>& PlanDelegator::getPlannerLatencyStats() const
+    {
+        return planner_latency_;
+    }
+
+    PlanDelegator::PlannerCall PlanDelegator::getPlannerCall(const std::string& planner_name)
+    {
+        if(plan_trajectory_cb_)
+        {
+            if(planner_name.size() == 0)
+            {
+                throw std::invalid_argument("Invalid trajectory planner name because it has zero length!");
+            }
+            const PlanTrajectoryCallback& callback = plan_trajectory_cb_;
+            return [&callback, planner_name](cav_srvs::PlanTrajectory& plan_req) { return callback(planner_name, plan_req); };
+        }
+        // service clients are never removed from the map so the reference stays valid
+        ros::ServiceClient& client = getPlannerClientByName(planner_name);
+        return [&client](cav_srvs::PlanTrajectory& plan_req) { return client.call(plan_req); };
+    }
+
+    PlanDelegator::SegmentRequestResult PlanDelegator::requestSegment(const PlannerCall& call, cav_srvs::PlanTrajectory plan_req)
+    {
+        SegmentRequestResult result;
+        auto start = std::chrono::steady_clock::now();
+        result.success = call(plan_req);
+        result.latency_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        result.request = std::move(plan_req);
+        return result;
+    }
+
+    void PlanDelegator::recordLatency(const std::string& planner_name, const SegmentRequestResult& result)
+    {
+        planner_latency_[planner_name].update(result.latency_ms, result.success);
+        ROS_DEBUG_STREAM("Trajectory planner " << planner_name << " responded in " << result.latency_ms << " ms");
+    }
+
+    bool PlanDelegator::acceptSegment(const std::string& planner_name, const std::string& key, const SegmentRequestResult& result)
+    {
+        recordLatency(planner_name, result);
+        if(!result.success)
+        {
+            ROS_WARN_STREAM("Unsuccessful service call to trajectory planner:" << planner_name << " for plan ID " << latest_maneuver_plan_.maneuver_plan_id);
+            segment_cache_.erase(key);
+            return false;
+        }
+        // validate trajectory before add to the plan
+        if(!isTrajectoryValid(result.request.response.trajectory_plan))
+        {
+            ROS_WARN_STREAM("Found invalid trajectory with less than 2 trajectory points for " << latest_maneuver_plan_.maneuver_plan_id);
+            segment_cache_.erase(key);
+            return false;
+        }
+        segment_cache_[key] = TrajectorySegment{result.request.response.trajectory_plan, ros::Time::now()};
+        return true;
+    }
+
+    std::string PlanDelegator::latencyReport() const
+    {
+        std::ostringstream report;
+        report << "Trajectory planner latency:";
+        for(const auto& entry : planner_latency_)
+        {
+            report << " [" << entry.first << " calls: " << entry.second.calls << " failures: " << entry.second.failures
+                   << " last: " << entry.second.last_ms << " ms mean: " << entry.second.mean_ms << " ms max: " << entry.second.max_ms << " ms]";
+        }
+        return report.str();
+    }
+
     cav_msgs::TrajectoryPlan PlanDelegator::planTrajectory()
     {
         cav_msgs::TrajectoryPlan latest_trajectory_plan;
-        // iterate through maneuver list to make service call
-    
-        for(const auto& maneuver : latest_maneuver_plan_.maneuvers)
+        const auto& maneuvers = latest_maneuver_plan_.maneuvers;
+        const std::string& plan_id = latest_maneuver_plan_.maneuver_plan_id;
+        ros::Time current_time = ros::Time::now();
+
+        // first pass: find segments which have to be replanned and dispatch the ones whose start state is already known,
+        // either the current vehicle state or the predicted end state of the cached previous segment
+        std::vector<bool> needs_replan(maneuvers.size(), false);
+        std::vector<std::future<SegmentRequestResult>> pending(maneuvers.size());
+        const cav_msgs::TrajectoryPlan* predecessor = nullptr;
+        bool first_active = true;
+        for(size_t i = 0; i < maneuvers.size(); ++i)
         {
             // ignore expired maneuvers
-            if(isManeuverExpired(maneuver))
+            if(isManeuverExpired(maneuvers[i], current_time))
+            {
+                continue;
+            }
+            auto cached = segment_cache_.find(segmentKey(plan_id, i));
+            bool has_cached = cached != segment_cache_.end();
+            // the segment the vehicle is currently on is always replanned from the current vehicle state
+            // so the published trajectory never starts with points the vehicle has already passed
+            needs_replan[i] = first_active || !has_cached || isSegmentStale(cached->second, maneuvers[i], current_time);
+            if(needs_replan[i] && (first_active || predecessor))
+            {
+                auto maneuver_planner = GET_MANEUVER_PROPERTY(maneuvers[i], parameters.planning_strategic_plugin);
+                auto plan_req = composePlanTrajectoryRequest(first_active ? cav_msgs::TrajectoryPlan() : *predecessor);
+                pending[i] = std::async(std::launch::async, &PlanDelegator::requestSegment, getPlannerCall(maneuver_planner), plan_req);
+            }
+            predecessor = has_cached ? &cached->second.trajectory : nullptr;
+            first_active = false;
+        }
+
+        // second pass: stitch segments in order, replanning serially any segment which could not be predicted
+        // or which does not line up with the actual end of the trajectory planned so far
+        for(size_t i = 0; i < maneuvers.size(); ++i)
+        {
+            if(isManeuverExpired(maneuvers[i], current_time))
             {
                 continue;
             }
-            // get corresponding ros service client for plan trajectory
-            auto maneuver_planner = GET_MANEUVER_PROPERTY(maneuver, parameters.planning_strategic_plugin);
-            auto client = getPlannerClientByName(maneuver_planner);
-            // compose service request
-            auto plan_req = composePlanTrajectoryRequest(latest_trajectory_plan);
-            if(client.call(plan_req))
+            auto maneuver_planner = GET_MANEUVER_PROPERTY(maneuvers[i], parameters.planning_strategic_plugin);
+            const std::string key = segmentKey(plan_id, i);
+            bool have_segment = !needs_replan[i];
+            if(pending[i].valid())
             {
-                // validate trajectory before add to the plan
-                if(!isTrajectoryValid(plan_req.response.trajectory_plan))
+                if(!acceptSegment(maneuver_planner, key, pending[i].get()))
                 {
-                    ROS_WARN_STREAM("Found invalid trajectory with less than 2 trajectory points for " << latest_maneuver_plan_.maneuver_plan_id);
                     break;
                 }
-                latest_trajectory_plan.trajectory_points.insert(latest_trajectory_plan.trajectory_points.end(),
-                                                                plan_req.response.trajectory_plan.trajectory_points.begin(),
-                                                                plan_req.response.trajectory_plan.trajectory_points.end());
-                if(isTrajectoryLongEnough(latest_trajectory_plan))
+                have_segment = true;
+            }
+            if(!have_segment || !isSegmentContinuous(latest_trajectory_plan, segment_cache_[key].trajectory))
+            {
+                // get corresponding ros service client for plan trajectory
+                if(!acceptSegment(maneuver_planner, key, requestSegment(getPlannerCall(maneuver_planner), composePlanTrajectoryRequest(latest_trajectory_plan))))
                 {
-                    ROS_INFO_STREAM("Plan Trajectory completed for " << latest_maneuver_plan_.maneuver_plan_id);
                     break;
                 }
             }
-            else
+            const auto& segment_points = segment_cache_[key].trajectory.trajectory_points;
+            latest_trajectory_plan.trajectory_points.insert(latest_trajectory_plan.trajectory_points.end(),
+                                                            segment_points.begin(), segment_points.end());
+            if(isTrajectoryLongEnough(latest_trajectory_plan))
             {
-                ROS_WARN_STREAM("Unsuccessful service call to trajectory planner:" << maneuver_planner << " for plan ID " << latest_maneuver_plan_.maneuver_plan_id);
-                // if one service call fails, it should end plan immediately because it is there is no point to generate plan with empty space
+                ROS_INFO_STREAM("Plan Trajectory completed for " << plan_id);
                 break;
             }
         }
@@ -181,6 +345,7 @@ namespace plan_delegator
         {
             ROS_WARN_STREAM("Planned trajectory is empty. It will not be published!");
         }
+        ROS_INFO_STREAM_THROTTLE(10.0, latencyReport());
         return true;
     }
 }
@@ -16,6 +16,8 @@
 
 #include <thread>
 #include <chrono>
+#include <map>
+#include <mutex>
 #include <cav_msgs/ManeuverPlan.h>
 #include <cav_srvs/PlanTrajectory.h>
 #include <gtest/gtest.h>
@@ -66,6 +68,17 @@
             {
                 return this->trajectory_planners_;
             }
+
+            std::unordered_map<std::string, plan_delegator::TrajectorySegment>& getSegmentCache()
+            {
+                return this->segment_cache_;
+            }
+
+            void setPose(double x, double y)
+            {
+                this->latest_pose_.pose.position.x = x;
+                this->latest_pose_.pose.position.y = y;
+            }
     };
 
     TEST(TestPlanDelegator, UnitTestPlanDelegator) {
@@ -122,6 +135,102 @@
         EXPECT_NEAR(1.0, req.request.vehicle_state.longitudinal_vel, 0.1);
     }
 
+    TEST(TestPlanDelegator, TestSegmentCache) {
+        PlanDelegatorTest pd;
+        EXPECT_EQ("plan_1#0", PlanDelegatorTest::segmentKey("plan_1", 0));
+        EXPECT_NE(PlanDelegatorTest::segmentKey("plan_1", 1), PlanDelegatorTest::segmentKey("plan_11", 0));
+        // test segment staleness
+        cav_msgs::Maneuver maneuver;
+        maneuver.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        maneuver.lane_following_maneuver.end_time = ros::Time(100, 0);
+        plan_delegator::TrajectorySegment segment;
+        segment.planned_at = ros::Time(10, 0);
+        EXPECT_FALSE(pd.isSegmentStale(segment, maneuver, ros::Time(10, 500000000)));
+        EXPECT_TRUE(pd.isSegmentStale(segment, maneuver, ros::Time(11, 0)));
+        EXPECT_TRUE(pd.isSegmentStale(segment, maneuver, ros::Time(100, 0)));
+        // test segment continuity
+        cav_msgs::TrajectoryPlanPoint point_1;
+        point_1.x = 0.0;
+        point_1.y = 0.0;
+        cav_msgs::TrajectoryPlanPoint point_2;
+        point_2.x = 10.0;
+        point_2.y = 0.0;
+        segment.trajectory.trajectory_points = {point_1, point_2};
+        cav_msgs::TrajectoryPlan next;
+        EXPECT_TRUE(pd.isSegmentContinuous(cav_msgs::TrajectoryPlan(), segment.trajectory));
+        next.trajectory_points = {point_2};
+        EXPECT_TRUE(pd.isSegmentContinuous(segment.trajectory, next));
+        next.trajectory_points = {point_1};
+        EXPECT_FALSE(pd.isSegmentContinuous(segment.trajectory, next));
+        // cache is only dropped when a plan with a new ID arrives
+        cav_msgs::ManeuverPlan plan;
+        plan.maneuver_plan_id = "plan_1";
+        plan.maneuvers.push_back(maneuver);
+        pd.maneuverPlanCallback(cav_msgs::ManeuverPlanConstPtr(new cav_msgs::ManeuverPlan(plan)));
+        pd.getSegmentCache()[PlanDelegatorTest::segmentKey("plan_1", 0)] = segment;
+        pd.maneuverPlanCallback(cav_msgs::ManeuverPlanConstPtr(new cav_msgs::ManeuverPlan(plan)));
+        EXPECT_EQ(1, pd.getSegmentCache().size());
+        plan.maneuver_plan_id = "plan_2";
+        pd.maneuverPlanCallback(cav_msgs::ManeuverPlanConstPtr(new cav_msgs::ManeuverPlan(plan)));
+        EXPECT_TRUE(pd.getSegmentCache().empty());
+        // test latency statistics
+        plan_delegator::PlannerLatencyStats stats;
+        stats.update(10.0, true);
+        stats.update(20.0, false);
+        EXPECT_EQ(2, stats.calls);
+        EXPECT_EQ(1, stats.failures);
+        EXPECT_NEAR(15.0, stats.mean_ms, 0.0001);
+        EXPECT_NEAR(20.0, stats.max_ms, 0.0001);
+        EXPECT_NEAR(20.0, stats.last_ms, 0.0001);
+    }
+
+    TEST(TestPlanDelegator, TestCurrentSegmentReplanned) {
+        PlanDelegatorTest pd;
+        std::mutex calls_mutex;
+        std::map<std::string, int> calls;
+        // like a maneuver which ends at a fixed distance, each segment drives from the requested start state
+        // to x = 10 for plugin_A and x = 20 for plugin_B within one second
+        pd.setPlanTrajectoryCallback([&](const std::string& planner, cav_srvs::PlanTrajectory& req) {
+            {
+                std::lock_guard<std::mutex> lock(calls_mutex);
+                ++calls[planner];
+            }
+            cav_msgs::TrajectoryPlanPoint start;
+            start.x = req.request.vehicle_state.X_pos_global;
+            start.y = req.request.vehicle_state.Y_pos_global;
+            start.target_time = 0;
+            cav_msgs::TrajectoryPlanPoint end = start;
+            end.x = planner == "plugin_A" ? 10.0 : 20.0;
+            end.target_time = 1000;
+            req.response.trajectory_plan.trajectory_points = {start, end};
+            return true;
+        });
+        cav_msgs::ManeuverPlan plan;
+        plan.maneuver_plan_id = "plan_1";
+        cav_msgs::Maneuver maneuver;
+        maneuver.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        maneuver.lane_following_maneuver.end_time = ros::Time::now() + ros::Duration(100.0);
+        maneuver.lane_following_maneuver.parameters.planning_strategic_plugin = "plugin_A";
+        plan.maneuvers.push_back(maneuver);
+        maneuver.lane_following_maneuver.parameters.planning_strategic_plugin = "plugin_B";
+        plan.maneuvers.push_back(maneuver);
+        pd.maneuverPlanCallback(cav_msgs::ManeuverPlanConstPtr(new cav_msgs::ManeuverPlan(plan)));
+
+        pd.setPose(0.0, 0.0);
+        cav_msgs::TrajectoryPlan trajectory = pd.planTrajectory();
+        ASSERT_EQ(4, trajectory.trajectory_points.size());
+        EXPECT_EQ(1, calls["plugin_A"]);
+        EXPECT_EQ(1, calls["plugin_B"]);
+
+        // the vehicle moved along the current segment, only that segment is replanned and it starts at the vehicle
+        pd.setPose(5.0, 0.0);
+        trajectory = pd.planTrajectory();
+        ASSERT_EQ(4, trajectory.trajectory_points.size());
+        EXPECT_EQ(2, calls["plugin_A"]);
+        EXPECT_EQ(1, calls["plugin_B"]);
+        EXPECT_NEAR(5.0, trajectory.trajectory_points.front().x, 0.0001);
+    }
+
     TEST(TestPlanDelegator, TestPlanDelegator) {
         ros::NodeHandle nh = ros::NodeHandle();
         cav_msgs::TrajectoryPlan res_plan;
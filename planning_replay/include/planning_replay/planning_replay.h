@@ -0,0 +1,184 @@
+#pragma once
+
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <array>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <ros/time.h>
+#include <autoware_lanelet2_msgs/MapBin.h>
+#include <cav_msgs/ExternalObjectList.h>
+#include <cav_msgs/RoadwayObstacleList.h>
+#include <geometry_msgs/PoseStamped.h>
+#include <geometry_msgs/TwistStamped.h>
+#include <beam_search_strategy.hpp>
+#include <fixed_priority_cost_function.hpp>
+#include <tree_planner.hpp>
+#include <plan_delegator.hpp>
+#include <motion_computation_worker.h>
+#include <roadway_objects/RoadwayObjectsWorker.h>
+#include <carma_wm/WMListenerWorker.h>
+#include "planning_replay/stage_stats.h"
+#include "planning_replay/stub_planners.h"
+
+namespace planning_replay
+{
+/**
+ * \brief Topics and planning settings of a replay
+ */
+struct ReplayConfig
+{
+  // Recorded inputs of the planning stack
+  std::string external_objects_topic = "/environment/external_objects";
+  std::string semantic_map_topic = "/environment/semantic_map";
+  std::string map_update_topic = "/environment/map_update";
+  std::string pose_topic = "/localization/current_pose";
+  std::string twist_topic = "/hardware/interface/vehicle/twist";
+
+  double planning_frequency = 1.0;     // Hz, maneuver plans generated by the TreePlanner
+  double trajectory_frequency = 10.0;  // Hz, trajectories generated by the PlanDelegator
+  double target_plan_duration = 15.0;  // s
+  int beam_width = 3;
+  int stub_plugins = 2;               // Number of simulated strategic plugins
+  double maneuver_duration = 5.0;     // s, see StubNeighborGenerator
+  double segment_duration = 3.0;      // s, see StubTacticalPlanner
+};
+
+/**
+ * \brief Replays recorded topics through the worker classes of the planning stack in process
+ *
+ * Messages are handed to the same worker classes the nodes use, in the order they were recorded and as fast as they
+ * can be processed:
+ *
+ *   external objects -> MotionComputationWorker -> RoadwayObjectsWorker -> WMListenerWorker
+ *   semantic map, map updates -> WMListenerWorker
+ *   simulated planning ticks -> TreePlanner -> PlanDelegator
+ *
+ * ROS time is simulated from the recorded message times with ros::Time::setNow, and the TreePlanner and PlanDelegator
+ * are run whenever the simulated clock passes their next period, so a bag always produces the same sequence of calls.
+ * The strategic and tactical plugins are replaced by StubNeighborGenerator and StubTacticalPlanner. The wall time of
+ * every call is recorded per stage.
+ *
+ * ros::init must be called before construction for ros::Time. No node handle is created, the PlanDelegator only
+ * creates its node handles in init() which is not called here, so no ROS master is contacted.
+ */
+class PlanningReplay
+{
+public:
+  /**
+   * \brief Stages of the planning pipeline whose latency is recorded
+   */
+  enum Stage
+  {
+    MOTION_COMPUTATION,
+    ROADWAY_OBJECTS,
+    WM_ROADWAY_OBJECTS,
+    WM_MAP,
+    WM_MAP_UPDATE,
+    TREE_PLANNER,
+    PLAN_DELEGATOR,
+    STAGE_COUNT
+  };
+
+  static const char* stageName(Stage stage);
+
+  explicit PlanningReplay(const ReplayConfig& config);
+
+  /**
+   * \brief The recorded topics used by the replay
+   */
+  std::vector<std::string> topics() const;
+
+  /**
+   * \brief Replays every message of the bags on topics(), merged in recorded time order
+   *
+   * \throws rosbag::BagException if a bag cannot be read
+   */
+  void replay(const std::vector<std::string>& bag_files);
+
+  /**
+   * \brief Moves the simulated clock forward to time, running the planning ticks which fall before it
+   */
+  void advanceTo(const ros::Time& time);
+
+  // Handlers of the recorded messages, called at the current simulated time
+  void externalObjectsCallback(const cav_msgs::ExternalObjectListPtr& msg);
+  void mapCallback(const autoware_lanelet2_msgs::MapBinConstPtr& msg);
+  void mapUpdateCallback(const autoware_lanelet2_msgs::MapBinConstPtr& msg);
+  void poseCallback(const geometry_msgs::PoseStampedConstPtr& msg);
+  void twistCallback(const geometry_msgs::TwistStampedConstPtr& msg);
+
+  const StageStats& stats(Stage stage) const;
+
+  /**
+   * \brief Number of non empty trajectories produced by the PlanDelegator
+   */
+  size_t trajectoryCount() const;
+
+  /**
+   * \brief Prints the throughput of the replay and the latency percentiles of every stage
+   */
+  void printReport(std::ostream& out) const;
+
+  /**
+   * \brief Writes the same figures as printReport as JSON, for comparing replays between commits
+   */
+  void writeJson(std::ostream& out) const;
+
+private:
+  void planningTick();
+  void trajectoryTick();
+
+  ReplayConfig config_;
+
+  object::MotionComputationWorker motion_worker_;
+  carma_wm::WMListenerWorker wm_worker_;
+  objects::RoadwayObjectsWorker roadway_objects_worker_;
+
+  StubNeighborGenerator neighbor_generator_;
+  arbitrator::FixedPriorityCostFunction cost_function_;
+  arbitrator::BeamSearchStrategy search_strategy_;
+  arbitrator::TreePlanner tree_planner_;
+
+  StubTacticalPlanner tactical_planner_;
+  plan_delegator::PlanDelegator plan_delegator_;
+
+  // Outputs of the object pipeline handed to the next stage once the previous one returns
+  cav_msgs::ExternalObjectListPtr predictions_;
+  cav_msgs::RoadwayObstacleListPtr roadway_obstacles_;
+
+  geometry_msgs::PoseStamped latest_pose_;
+  double latest_speed_ = 0;
+  bool has_pose_ = false;
+
+  // Simulated clock
+  bool clock_started_ = false;
+  ros::Time start_time_;
+  ros::Time current_time_;
+  ros::Time next_planning_tick_;
+  ros::Time next_trajectory_tick_;
+
+  std::array<StageStats, STAGE_COUNT> stats_;
+  size_t messages_ = 0;
+  size_t maneuver_plans_ = 0;
+  size_t trajectories_ = 0;
+  double wall_seconds_ = 0;
+};
+
+}  // namespace planning_replay
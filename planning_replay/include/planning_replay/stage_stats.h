@@ -0,0 +1,92 @@
+#pragma once
+
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace planning_replay
+{
+/**
+ * \brief Latency samples of one pipeline stage
+ *
+ * Every sample is kept so percentiles are exact. A replay records at most a few samples per message, which is small
+ * compared to the messages themselves.
+ */
+class StageStats
+{
+public:
+  /**
+   * \brief Records one call of the stage
+   *
+   * \param seconds Wall time spent in the call
+   */
+  void add(double seconds);
+
+  /**
+   * \brief Runs fn and records its wall time
+   *
+   * \return The result of fn
+   */
+  template <class F>
+  auto time(F&& fn) -> decltype(fn())
+  {
+    struct Recorder
+    {
+      StageStats& stats;
+      std::chrono::steady_clock::time_point start;
+      ~Recorder()
+      {
+        stats.add(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+      }
+    } recorder{ *this, std::chrono::steady_clock::now() };
+    return fn();
+  }
+
+  size_t count() const;
+
+  /**
+   * \brief Total wall time spent in the stage in seconds
+   */
+  double total() const;
+
+  double mean() const;
+
+  double max() const;
+
+  /**
+   * \brief Nearest rank percentile of the samples in seconds, or 0 if there are none
+   *
+   * \param p The percentile in [0, 100]
+   */
+  double percentile(double p) const;
+
+  /**
+   * \brief Calls per second the stage sustains on its own, the inverse of its mean latency
+   */
+  double throughput() const;
+
+private:
+  // Sorted lazily by percentile()
+  mutable std::vector<double> samples_;
+  mutable bool sorted_ = true;
+  double total_ = 0;
+  double max_ = 0;
+};
+
+}  // namespace planning_replay
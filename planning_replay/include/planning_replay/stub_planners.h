@@ -0,0 +1,98 @@
+#pragma once
+
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <string>
+#include <vector>
+#include <ros/time.h>
+#include <cav_msgs/ManeuverPlan.h>
+#include <cav_srvs/PlanTrajectory.h>
+#include <geometry_msgs/Pose.h>
+#include <neighbor_generator.hpp>
+
+namespace planning_replay
+{
+/**
+ * \brief NeighborGenerator standing in for the strategic plugins during a replay
+ *
+ * Every plugin appends one lane following maneuver to the plan, which plugin i plans for (1 + 0.5 * i) times the base
+ * maneuver duration at the current speed. The children only depend on the plan and the state set by setVehicleState
+ * so a replay always searches the same tree.
+ */
+class StubNeighborGenerator : public arbitrator::NeighborGenerator
+{
+public:
+  /**
+   * \param plugins Names of the simulated strategic plugins
+   * \param maneuver_duration Duration in seconds of the maneuvers planned by the first plugin
+   */
+  StubNeighborGenerator(std::vector<std::string> plugins, double maneuver_duration);
+
+  /**
+   * \brief Sets the state plans start from. Must not be called during a search.
+   *
+   * \param now Start time of the plan
+   * \param speed Current speed in m/s. Maneuvers are planned at 1 m/s or more so they always cover some distance.
+   */
+  void setVehicleState(const ros::Time& now, double speed);
+
+  std::vector<cav_msgs::ManeuverPlan> generate_neighbors(cav_msgs::ManeuverPlan plan) const override;
+
+private:
+  std::vector<std::string> plugins_;
+  double maneuver_duration_;
+  ros::Time now_;
+  double speed_ = 1.0;
+};
+
+/**
+ * \brief Tactical plugin standing in for every plugin called by the PlanDelegator during a replay
+ *
+ * Answers each PlanTrajectory request with a straight trajectory starting at the requested vehicle state and heading
+ * in the direction of the current pose, with points every point_spacing seconds over segment_duration seconds. The
+ * first point is timed as if the vehicle drove from the current pose to the start at the requested speed, so stitched
+ * segments have increasing target times.
+ */
+class StubTacticalPlanner
+{
+public:
+  /**
+   * \param segment_duration Duration in seconds of the returned trajectories
+   * \param point_spacing Time in seconds between trajectory points
+   */
+  explicit StubTacticalPlanner(double segment_duration = 3.0, double point_spacing = 0.1);
+
+  /**
+   * \brief Sets the current pose of the vehicle. Must not be called while the PlanDelegator is planning.
+   */
+  void setVehicleState(const geometry_msgs::Pose& pose, const ros::Time& now);
+
+  /**
+   * \brief Plans a trajectory segment, see plan_delegator::PlanDelegator::PlanTrajectoryCallback. Thread safe.
+   */
+  bool operator()(const std::string& planner_name, cav_srvs::PlanTrajectory& plan_req) const;
+
+private:
+  double segment_duration_;
+  double point_spacing_;
+  double x_ = 0;
+  double y_ = 0;
+  double yaw_ = 0;
+  ros::Time now_;
+};
+
+}  // namespace planning_replay
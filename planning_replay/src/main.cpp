@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <ros/ros.h>
+#include <rosbag/exceptions.h>
+#include "planning_replay/planning_replay.h"
+
+namespace
+{
+void printUsage(const char* name)
+{
+  std::cerr << "Usage: " << name << " [options] BAG [BAG...]\n"
+            << "Replays recorded topics through the planning stack in process and reports per stage latency.\n\n"
+            << "Options:\n"
+            << "  --external-objects TOPIC    ExternalObjectList input of motion computation\n"
+            << "  --semantic-map TOPIC        MapBin semantic map\n"
+            << "  --map-update TOPIC          MapBin geofence map updates\n"
+            << "  --pose TOPIC                PoseStamped current pose\n"
+            << "  --twist TOPIC               TwistStamped current velocity\n"
+            << "  --planning-frequency HZ     Maneuver planning frequency (default 1)\n"
+            << "  --trajectory-frequency HZ   Trajectory planning frequency (default 10)\n"
+            << "  --target-plan-duration S    Duration of the maneuver plans (default 15)\n"
+            << "  --beam-width N              Width of the maneuver plan search (default 3)\n"
+            << "  --plugins N                 Number of simulated strategic plugins (default 2)\n"
+            << "  --json FILE                 Also write the report as JSON to FILE\n"
+            << "  --verbose                   Keep the INFO logs of the replayed components\n";
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  // Only initializes ros::Time, no node handle is created so no ROS master is contacted
+  ros::init(argc, argv, "planning_replay",
+            ros::init_options::AnonymousName | ros::init_options::NoRosout | ros::init_options::NoSigintHandler);
+
+  planning_replay::ReplayConfig config;
+  std::vector<std::string> bags;
+  std::string json_file;
+  bool verbose = false;
+  for (int i = 1; i < argc; i++)
+  {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    try
+    {
+      if (arg == "--help" || arg == "-h")
+      {
+        printUsage(argv[0]);
+        return 0;
+      }
+      else if (arg == "--verbose")
+        verbose = true;
+      else if (arg.compare(0, 2, "--") != 0)
+        bags.push_back(arg);
+      else if (!has_value)
+        throw std::invalid_argument("missing value");
+      else if (arg == "--external-objects")
+        config.external_objects_topic = argv[++i];
+      else if (arg == "--semantic-map")
+        config.semantic_map_topic = argv[++i];
+      else if (arg == "--map-update")
+        config.map_update_topic = argv[++i];
+      else if (arg == "--pose")
+        config.pose_topic = argv[++i];
+      else if (arg == "--twist")
+        config.twist_topic = argv[++i];
+      else if (arg == "--planning-frequency")
+        config.planning_frequency = std::stod(argv[++i]);
+      else if (arg == "--trajectory-frequency")
+        config.trajectory_frequency = std::stod(argv[++i]);
+      else if (arg == "--target-plan-duration")
+        config.target_plan_duration = std::stod(argv[++i]);
+      else if (arg == "--beam-width")
+        config.beam_width = std::stoi(argv[++i]);
+      else if (arg == "--plugins")
+        config.stub_plugins = std::stoi(argv[++i]);
+      else if (arg == "--json")
+        json_file = argv[++i];
+      else
+        throw std::invalid_argument("unknown option");
+    }
+    catch (const std::exception& e)
+    {
+      std::cerr << "Invalid argument " << arg << ": " << e.what() << "\n\n";
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (bags.empty() || config.planning_frequency <= 0 || config.trajectory_frequency <= 0 || config.beam_width < 1 ||
+      config.stub_plugins < 1)
+  {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  if (!verbose && ros::console::set_logger_level(ROSCONSOLE_DEFAULT_NAME, ros::console::levels::Warn))
+  {
+    ros::console::notifyLoggerLevelsChanged();
+  }
+
+  planning_replay::PlanningReplay replay(config);
+  try
+  {
+    replay.replay(bags);
+  }
+  catch (const rosbag::BagException& e)
+  {
+    std::cerr << "Failed to read bag: " << e.what() << "\n";
+    return 1;
+  }
+
+  replay.printReport(std::cout);
+  if (!json_file.empty())
+  {
+    std::ofstream json(json_file);
+    replay.writeJson(json);
+  }
+  return 0;
+}
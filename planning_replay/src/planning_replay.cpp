@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <boost/make_shared.hpp>
+#include <rosbag/bag.h>
+#include <rosbag/view.h>
+#include "planning_replay/planning_replay.h"
+
+namespace planning_replay
+{
+namespace
+{
+std::vector<std::string> stubPluginNames(int count)
+{
+  std::vector<std::string> names;
+  for (int i = 0; i < count; i++)
+  {
+    names.push_back("replay_plugin_" + std::to_string(i));
+  }
+  return names;
+}
+
+// Earlier plugins are preferred so the search behaves the same on every replay
+std::map<std::string, double> stubPluginPriorities(int count)
+{
+  std::map<std::string, double> priorities;
+  auto names = stubPluginNames(count);
+  for (int i = 0; i < count; i++)
+  {
+    priorities[names[i]] = count - i;
+  }
+  return priorities;
+}
+}  // namespace
+
+const char* PlanningReplay::stageName(Stage stage)
+{
+  switch (stage)
+  {
+    case MOTION_COMPUTATION:
+      return "motion_computation";
+    case ROADWAY_OBJECTS:
+      return "roadway_objects";
+    case WM_ROADWAY_OBJECTS:
+      return "wm_roadway_objects";
+    case WM_MAP:
+      return "wm_map";
+    case WM_MAP_UPDATE:
+      return "wm_map_update";
+    case TREE_PLANNER:
+      return "tree_planner";
+    case PLAN_DELEGATOR:
+      return "plan_delegator";
+    default:
+      return "unknown";
+  }
+}
+
+PlanningReplay::PlanningReplay(const ReplayConfig& config)
+  : config_(config)
+  , motion_worker_([this](const cav_msgs::ExternalObjectList& msg) {
+    predictions_ = boost::make_shared<cav_msgs::ExternalObjectList>(msg);
+  })
+  , roadway_objects_worker_(wm_worker_.getWorldModel(),
+                            [this](const cav_msgs::RoadwayObstacleList& msg) {
+                              roadway_obstacles_ = boost::make_shared<cav_msgs::RoadwayObstacleList>(msg);
+                            })
+  , neighbor_generator_(stubPluginNames(config.stub_plugins), config.maneuver_duration)
+  , cost_function_(stubPluginPriorities(config.stub_plugins))
+  , search_strategy_(config.beam_width)
+  // No wall clock budget as it would make the plans depend on the speed of the machine
+  , tree_planner_(cost_function_, neighbor_generator_, search_strategy_, ros::Duration(config.target_plan_duration))
+  , tactical_planner_(config.segment_duration)
+{
+  plan_delegator_.setPlanTrajectoryCallback(std::cref(tactical_planner_));
+}
+
+std::vector<std::string> PlanningReplay::topics() const
+{
+  return { config_.external_objects_topic, config_.semantic_map_topic, config_.map_update_topic, config_.pose_topic,
+           config_.twist_topic };
+}
+
+void PlanningReplay::replay(const std::vector<std::string>& bag_files)
+{
+  std::vector<std::unique_ptr<rosbag::Bag>> bags;
+  rosbag::View view;
+  for (const auto& file : bag_files)
+  {
+    bags.emplace_back(new rosbag::Bag(file, rosbag::bagmode::Read));
+    view.addQuery(*bags.back(), rosbag::TopicQuery(topics()));
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (const rosbag::MessageInstance& m : view)
+  {
+    advanceTo(m.getTime());
+    const std::string& topic = m.getTopic();
+    if (topic == config_.external_objects_topic)
+    {
+      if (auto msg = m.instantiate<cav_msgs::ExternalObjectList>())
+        externalObjectsCallback(msg);
+    }
+    else if (topic == config_.semantic_map_topic)
+    {
+      if (auto msg = m.instantiate<autoware_lanelet2_msgs::MapBin>())
+        mapCallback(msg);
+    }
+    else if (topic == config_.map_update_topic)
+    {
+      if (auto msg = m.instantiate<autoware_lanelet2_msgs::MapBin>())
+        mapUpdateCallback(msg);
+    }
+    else if (topic == config_.pose_topic)
+    {
+      if (auto msg = m.instantiate<geometry_msgs::PoseStamped>())
+        poseCallback(msg);
+    }
+    else if (topic == config_.twist_topic)
+    {
+      if (auto msg = m.instantiate<geometry_msgs::TwistStamped>())
+        twistCallback(msg);
+    }
+    messages_++;
+  }
+  wall_seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void PlanningReplay::advanceTo(const ros::Time& time)
+{
+  if (!clock_started_)
+  {
+    clock_started_ = true;
+    start_time_ = time;
+    next_planning_tick_ = time;
+    next_trajectory_tick_ = time;
+  }
+
+  const ros::Duration planning_period(1.0 / config_.planning_frequency);
+  const ros::Duration trajectory_period(1.0 / config_.trajectory_frequency);
+  while (next_planning_tick_ <= time || next_trajectory_tick_ <= time)
+  {
+    // A maneuver plan due at the same time as a trajectory is generated first so the trajectory uses it
+    if (next_planning_tick_ <= next_trajectory_tick_)
+    {
+      ros::Time::setNow(next_planning_tick_);
+      planningTick();
+      next_planning_tick_ += planning_period;
+    }
+    else
+    {
+      ros::Time::setNow(next_trajectory_tick_);
+      trajectoryTick();
+      next_trajectory_tick_ += trajectory_period;
+    }
+  }
+
+  if (time > current_time_)
+  {
+    current_time_ = time;
+  }
+  ros::Time::setNow(time);
+}
+
+void PlanningReplay::externalObjectsCallback(const cav_msgs::ExternalObjectListPtr& msg)
+{
+  predictions_.reset();
+  stats_[MOTION_COMPUTATION].time([&] { motion_worker_.predictionLogic(msg); });
+  if (!predictions_)
+  {
+    return;
+  }
+
+  roadway_obstacles_.reset();
+  stats_[ROADWAY_OBJECTS].time([&] { roadway_objects_worker_.externalObjectsCallback(predictions_); });
+  if (!roadway_obstacles_)
+  {
+    return;
+  }
+
+  stats_[WM_ROADWAY_OBJECTS].time([&] { wm_worker_.roadwayObjectListCallback(roadway_obstacles_); });
+}
+
+void PlanningReplay::mapCallback(const autoware_lanelet2_msgs::MapBinConstPtr& msg)
+{
+  stats_[WM_MAP].time([&] { wm_worker_.mapCallback(msg); });
+}
+
+void PlanningReplay::mapUpdateCallback(const autoware_lanelet2_msgs::MapBinConstPtr& msg)
+{
+  stats_[WM_MAP_UPDATE].time([&] { wm_worker_.mapUpdateCallback(msg); });
+}
+
+void PlanningReplay::poseCallback(const geometry_msgs::PoseStampedConstPtr& msg)
+{
+  latest_pose_ = *msg;
+  has_pose_ = true;
+  plan_delegator_.poseCallback(msg);
+}
+
+void PlanningReplay::twistCallback(const geometry_msgs::TwistStampedConstPtr& msg)
+{
+  latest_speed_ = msg->twist.linear.x;
+  plan_delegator_.twistCallback(msg);
+}
+
+void PlanningReplay::planningTick()
+{
+  ros::Time now = ros::Time::now();
+  neighbor_generator_.setVehicleState(now, latest_speed_);
+  auto plan = boost::make_shared<cav_msgs::ManeuverPlan>(
+      stats_[TREE_PLANNER].time([&] { return tree_planner_.generate_plan(); }));
+  if (plan->maneuvers.empty())
+  {
+    return;
+  }
+  plan->header.stamp = now;
+  plan->maneuver_plan_id = "replay_plan_" + std::to_string(++maneuver_plans_);
+  plan_delegator_.maneuverPlanCallback(plan);
+}
+
+void PlanningReplay::trajectoryTick()
+{
+  // The stub tactical plugin plans from the current pose
+  if (!has_pose_ || maneuver_plans_ == 0)
+  {
+    return;
+  }
+  tactical_planner_.setVehicleState(latest_pose_.pose, ros::Time::now());
+  auto trajectory = stats_[PLAN_DELEGATOR].time([&] { return plan_delegator_.planTrajectory(); });
+  if (!trajectory.trajectory_points.empty())
+  {
+    trajectories_++;
+  }
+}
+
+const StageStats& PlanningReplay::stats(Stage stage) const
+{
+  return stats_[stage];
+}
+
+size_t PlanningReplay::trajectoryCount() const
+{
+  return trajectories_;
+}
+
+void PlanningReplay::printReport(std::ostream& out) const
+{
+  const double recorded = clock_started_ ? (current_time_ - start_time_).toSec() : 0.0;
+  out << std::fixed << std::setprecision(3);
+  out << "Replayed " << messages_ << " messages covering " << recorded << " s of recorded time in " << wall_seconds_
+      << " s";
+  if (wall_seconds_ > 0)
+  {
+    out << " (" << recorded / wall_seconds_ << "x real time, " << messages_ / wall_seconds_ << " msg/s)";
+  }
+  out << "\n";
+  out << "Generated " << maneuver_plans_ << " maneuver plans and " << trajectories_ << " trajectories\n\n";
+
+  out << std::left << std::setw(20) << "stage" << std::right << std::setw(9) << "calls" << std::setw(11) << "mean ms"
+      << std::setw(11) << "p50 ms" << std::setw(11) << "p90 ms" << std::setw(11) << "p99 ms" << std::setw(11) << "max ms"
+      << std::setw(13) << "calls/s" << "\n";
+  for (int i = 0; i < STAGE_COUNT; i++)
+  {
+    const StageStats& s = stats_[i];
+    out << std::left << std::setw(20) << stageName(static_cast<Stage>(i)) << std::right << std::setw(9) << s.count()
+        << std::setw(11) << s.mean() * 1e3 << std::setw(11) << s.percentile(50) * 1e3 << std::setw(11)
+        << s.percentile(90) * 1e3 << std::setw(11) << s.percentile(99) * 1e3 << std::setw(11) << s.max() * 1e3
+        << std::setw(13) << std::setprecision(1) << s.throughput() << std::setprecision(3) << "\n";
+  }
+}
+
+void PlanningReplay::writeJson(std::ostream& out) const
+{
+  const double recorded = clock_started_ ? (current_time_ - start_time_).toSec() : 0.0;
+  out << std::setprecision(9);
+  out << "{\n";
+  out << "  \"messages\": " << messages_ << ",\n";
+  out << "  \"recorded_seconds\": " << recorded << ",\n";
+  out << "  \"wall_seconds\": " << wall_seconds_ << ",\n";
+  out << "  \"maneuver_plans\": " << maneuver_plans_ << ",\n";
+  out << "  \"trajectories\": " << trajectories_ << ",\n";
+  out << "  \"stages\": [\n";
+  for (int i = 0; i < STAGE_COUNT; i++)
+  {
+    const StageStats& s = stats_[i];
+    out << "    {\"name\": \"" << stageName(static_cast<Stage>(i)) << "\", \"calls\": " << s.count()
+        << ", \"mean_ms\": " << s.mean() * 1e3 << ", \"p50_ms\": " << s.percentile(50) * 1e3
+        << ", \"p90_ms\": " << s.percentile(90) * 1e3 << ", \"p99_ms\": " << s.percentile(99) * 1e3
+        << ", \"max_ms\": " << s.max() * 1e3 << ", \"calls_per_second\": " << s.throughput() << "}"
+        << (i + 1 < STAGE_COUNT ? ",\n" : "\n");
+  }
+  out << "  ]\n";
+  out << "}\n";
+}
+
+}  // namespace planning_replay
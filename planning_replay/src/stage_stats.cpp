@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "planning_replay/stage_stats.h"
+
+namespace planning_replay
+{
+void StageStats::add(double seconds)
+{
+  if (!samples_.empty() && seconds < samples_.back())
+  {
+    sorted_ = false;
+  }
+  samples_.push_back(seconds);
+  total_ += seconds;
+  max_ = std::max(max_, seconds);
+}
+
+size_t StageStats::count() const
+{
+  return samples_.size();
+}
+
+double StageStats::total() const
+{
+  return total_;
+}
+
+double StageStats::mean() const
+{
+  return samples_.empty() ? 0.0 : total_ / samples_.size();
+}
+
+double StageStats::max() const
+{
+  return max_;
+}
+
+double StageStats::percentile(double p) const
+{
+  if (samples_.empty())
+  {
+    return 0.0;
+  }
+  if (!sorted_)
+  {
+    std::sort(samples_.begin(), samples_.end());
+    sorted_ = true;
+  }
+  // Smallest sample such that p percent of the samples are less than or equal to it
+  double rank = std::ceil(std::min(std::max(p, 0.0), 100.0) / 100.0 * samples_.size());
+  size_t index = rank < 1.0 ? 0 : static_cast<size_t>(rank) - 1;
+  return samples_[index];
+}
+
+double StageStats::throughput() const
+{
+  return total_ > 0 ? samples_.size() / total_ : 0.0;
+}
+
+}  // namespace planning_replay
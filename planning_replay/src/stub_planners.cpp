@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <arbitrator_utils.hpp>
+#include "planning_replay/stub_planners.h"
+
+namespace planning_replay
+{
+namespace
+{
+constexpr double MIN_SPEED = 1.0;  // m/s
+}  // namespace
+
+StubNeighborGenerator::StubNeighborGenerator(std::vector<std::string> plugins, double maneuver_duration)
+  : plugins_(std::move(plugins)), maneuver_duration_(maneuver_duration)
+{
+}
+
+void StubNeighborGenerator::setVehicleState(const ros::Time& now, double speed)
+{
+  now_ = now;
+  speed_ = std::max(speed, MIN_SPEED);
+}
+
+std::vector<cav_msgs::ManeuverPlan> StubNeighborGenerator::generate_neighbors(cav_msgs::ManeuverPlan plan) const
+{
+  double start_dist = plan.maneuvers.empty() ? 0.0 : arbitrator::arbitrator_utils::get_plan_end_distance(plan);
+  ros::Time start_time = plan.maneuvers.empty() ? now_ : arbitrator::arbitrator_utils::get_plan_end_time(plan);
+
+  std::vector<cav_msgs::ManeuverPlan> children;
+  children.reserve(plugins_.size());
+  for (size_t i = 0; i < plugins_.size(); i++)
+  {
+    double duration = maneuver_duration_ * (1.0 + 0.5 * i);
+    cav_msgs::Maneuver mvr;
+    mvr.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+    mvr.lane_following_maneuver.parameters.planning_strategic_plugin = plugins_[i];
+    mvr.lane_following_maneuver.start_dist = start_dist;
+    mvr.lane_following_maneuver.end_dist = start_dist + speed_ * duration;
+    mvr.lane_following_maneuver.start_speed = speed_;
+    mvr.lane_following_maneuver.end_speed = speed_;
+    mvr.lane_following_maneuver.start_time = start_time;
+    mvr.lane_following_maneuver.end_time = start_time + ros::Duration(duration);
+    children.push_back(plan);
+    children.back().maneuvers.push_back(mvr);
+  }
+  return children;
+}
+
+StubTacticalPlanner::StubTacticalPlanner(double segment_duration, double point_spacing)
+  : segment_duration_(segment_duration), point_spacing_(point_spacing)
+{
+}
+
+void StubTacticalPlanner::setVehicleState(const geometry_msgs::Pose& pose, const ros::Time& now)
+{
+  x_ = pose.position.x;
+  y_ = pose.position.y;
+  const auto& q = pose.orientation;
+  yaw_ = std::atan2(2.0 * (q.w * q.z + q.x * q.y), 1.0 - 2.0 * (q.y * q.y + q.z * q.z));
+  now_ = now;
+}
+
+bool StubTacticalPlanner::operator()(const std::string&, cav_srvs::PlanTrajectory& plan_req) const
+{
+  const auto& state = plan_req.request.vehicle_state;
+  double speed = std::isfinite(state.longitudinal_vel) ? std::max(state.longitudinal_vel, MIN_SPEED) : MIN_SPEED;
+  double offset = std::hypot(state.X_pos_global - x_, state.Y_pos_global - y_);
+  double start_ms = now_.toNSec() / 1000000.0 + 1000.0 * offset / speed;
+
+  int points = static_cast<int>(std::round(segment_duration_ / point_spacing_)) + 1;
+  auto& trajectory = plan_req.response.trajectory_plan;
+  trajectory.trajectory_points.resize(points);
+  for (int i = 0; i < points; i++)
+  {
+    double t = i * point_spacing_;
+    auto& point = trajectory.trajectory_points[i];
+    point.x = state.X_pos_global + std::cos(yaw_) * speed * t;
+    point.y = state.Y_pos_global + std::sin(yaw_) * speed * t;
+    point.target_time = static_cast<uint64_t>(std::llround(start_ms + 1000.0 * t));
+  }
+  return true;
+}
+
+}  // namespace planning_replay
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <boost/make_shared.hpp>
+#include <ros/ros.h>
+#include <arbitrator_utils.hpp>
+#include "planning_replay/planning_replay.h"
+
+namespace planning_replay
+{
+TEST(PlanningReplayTest, stageStats)
+{
+  StageStats stats;
+  ASSERT_EQ(0.0, stats.percentile(50));
+  for (int i = 100; i >= 1; i--)
+  {
+    stats.add(i * 0.001);
+  }
+  ASSERT_EQ(100u, stats.count());
+  ASSERT_NEAR(0.050, stats.percentile(50), 1e-12);
+  ASSERT_NEAR(0.090, stats.percentile(90), 1e-12);
+  ASSERT_NEAR(0.099, stats.percentile(99), 1e-12);
+  ASSERT_NEAR(0.100, stats.percentile(100), 1e-12);
+  ASSERT_NEAR(0.001, stats.percentile(0), 1e-12);
+  ASSERT_NEAR(0.0505, stats.mean(), 1e-12);
+  ASSERT_NEAR(0.100, stats.max(), 1e-12);
+  ASSERT_NEAR(100 / 5.05, stats.throughput(), 1e-9);
+
+  ASSERT_EQ(4, stats.time([] { return 4; }));
+  ASSERT_EQ(101u, stats.count());
+}
+
+TEST(PlanningReplayTest, stubNeighborGenerator)
+{
+  StubNeighborGenerator generator({ "a", "b" }, 2.0);
+  generator.setVehicleState(ros::Time(100), 0.0);
+
+  auto children = generator.generate_neighbors(cav_msgs::ManeuverPlan());
+  ASSERT_EQ(2u, children.size());
+  const auto& mvr = children[1].maneuvers[0].lane_following_maneuver;
+  ASSERT_EQ("b", mvr.parameters.planning_strategic_plugin);
+  ASSERT_EQ(ros::Time(100), mvr.start_time);
+  ASSERT_EQ(ros::Time(103), mvr.end_time);
+  ASSERT_NEAR(3.0, mvr.end_dist - mvr.start_dist, 1e-9);  // Planned at the minimum speed
+
+  auto grandchildren = generator.generate_neighbors(children[1]);
+  ASSERT_EQ(2u, grandchildren[0].maneuvers.size());
+  ASSERT_EQ(ros::Time(105), arbitrator::arbitrator_utils::get_plan_end_time(grandchildren[0]));
+  ASSERT_NEAR(5.0, arbitrator::arbitrator_utils::get_plan_end_distance(grandchildren[0]), 1e-9);
+}
+
+TEST(PlanningReplayTest, stubTacticalPlanner)
+{
+  StubTacticalPlanner planner(1.0, 0.1);
+  geometry_msgs::Pose pose;
+  pose.position.x = 10;
+  pose.position.y = 5;
+  pose.orientation.z = std::sin(M_PI / 4);  // Heading along +y
+  pose.orientation.w = std::cos(M_PI / 4);
+  planner.setVehicleState(pose, ros::Time(100));
+
+  cav_srvs::PlanTrajectory req;
+  req.request.vehicle_state.X_pos_global = 10;
+  req.request.vehicle_state.Y_pos_global = 25;
+  req.request.vehicle_state.longitudinal_vel = 10;
+  ASSERT_TRUE(planner("plugin", req));
+
+  const auto& points = req.response.trajectory_plan.trajectory_points;
+  ASSERT_EQ(11u, points.size());
+  ASSERT_NEAR(10.0, points.front().x, 1e-9);
+  ASSERT_NEAR(25.0, points.front().y, 1e-9);
+  ASSERT_NEAR(35.0, points.back().y, 1e-9);
+  // The start is 20m ahead of the vehicle, reached in 2s
+  ASSERT_EQ(102000u, points.front().target_time);
+  ASSERT_EQ(103000u, points.back().target_time);
+}
+
+TEST(PlanningReplayTest, replayWithoutBag)
+{
+  ReplayConfig config;
+  PlanningReplay replay(config);
+
+  auto twist = boost::make_shared<geometry_msgs::TwistStamped>();
+  twist->twist.linear.x = 10;
+  auto pose = boost::make_shared<geometry_msgs::PoseStamped>();
+  pose->pose.orientation.w = 1;
+
+  // Drive along x for 5s with a pose and twist every 100ms
+  for (int i = 0; i <= 50; i++)
+  {
+    replay.advanceTo(ros::Time(1000) + ros::Duration(0.1 * i));
+    pose->pose.position.x = i;
+    replay.poseCallback(pose);
+    replay.twistCallback(twist);
+  }
+
+  // Objects are dropped by roadway_objects as no map was received
+  auto objects = boost::make_shared<cav_msgs::ExternalObjectList>();
+  objects->objects.resize(3);
+  replay.externalObjectsCallback(objects);
+
+  ASSERT_EQ(6u, replay.stats(PlanningReplay::TREE_PLANNER).count());
+  // Trajectories are only planned once a pose was received after the first maneuver plan
+  ASSERT_EQ(50u, replay.stats(PlanningReplay::PLAN_DELEGATOR).count());
+  ASSERT_EQ(50u, replay.trajectoryCount());
+  ASSERT_EQ(1u, replay.stats(PlanningReplay::MOTION_COMPUTATION).count());
+  ASSERT_EQ(1u, replay.stats(PlanningReplay::ROADWAY_OBJECTS).count());
+  ASSERT_EQ(0u, replay.stats(PlanningReplay::WM_ROADWAY_OBJECTS).count());
+
+  std::ostringstream report;
+  replay.printReport(report);
+  ASSERT_NE(std::string::npos, report.str().find("plan_delegator"));
+  std::ostringstream json;
+  replay.writeJson(json);
+  ASSERT_NE(std::string::npos, json.str().find("\"name\": \"tree_planner\", \"calls\": 6"));
+}
+
+}  // namespace planning_replay
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  // Needed for ros::Time, the replay creates no node handle so no ROS master is contacted
+  ros::init(argc, argv, "test_planning_replay", ros::init_options::AnonymousName | ros::init_options::NoRosout);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace platoon_control
+{
+
+    // Timing statistics of the fixed-rate control loop. All durations are in seconds.
+    struct ControlLoopStats
+    {
+        uint64_t cycles = 0;
+        // Cycles which finished after the start of the next scheduled cycle
+        uint64_t overruns = 0;
+        // Measured interval between the last two cycles
+        double last_dt = 0.0;
+        // Wake-up latency relative to the schedule
+        double last_jitter = 0.0;
+        double mean_jitter = 0.0;
+        double max_jitter = 0.0;
+        // Time spent computing a command
+        double last_compute_time = 0.0;
+        double max_compute_time = 0.0;
+    };
+
+    /**
+     * \brief Schedules the cycles of a fixed-rate loop on an absolute time grid and tracks its timing.
+     *
+     * Usage:
+     *   wake = timer.start(Clock::now());
+     *   loop { sleep_until(wake); dt = timer.beginCycle(Clock::now()); ...; wake = timer.endCycle(Clock::now()); }
+     *
+     * When a cycle overruns its period the missed deadlines are dropped and the schedule is
+     * re-anchored at the end of the late cycle, so commands are never produced in a burst.
+     */
+    class ControlLoopTimer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * \brief Constructor
+         *
+         * \param period The nominal loop period in seconds
+         */
+        explicit ControlLoopTimer(double period);
+
+        /**
+         * \brief Change the nominal loop period. Takes effect from the next call to start.
+         */
+        void setPeriod(double period);
+
+        /**
+         * \brief Reset the schedule and statistics
+         *
+         * \param now The current time
+         *
+         * \return The time at which the first cycle should start
+         */
+        Clock::time_point start(Clock::time_point now);
+
+        /**
+         * \brief Mark the start of a cycle
+         *
+         * \param now The current time
+         *
+         * \return The measured time since the start of the previous cycle in seconds.
+         *         The nominal period is returned for the first cycle.
+         */
+        double beginCycle(Clock::time_point now);
+
+        /**
+         * \brief Mark the end of a cycle
+         *
+         * \param now The current time
+         *
+         * \return The time at which the next cycle should start
+         */
+        Clock::time_point endCycle(Clock::time_point now);
+
+        ControlLoopStats getStats() const;
+
+        double getPeriod() const;
+
+    private:
+        Clock::duration period_;
+        Clock::duration next_period_;
+        Clock::time_point scheduled_;
+        Clock::time_point cycle_start_;
+        bool first_cycle_ = true;
+
+        mutable std::mutex stats_mutex_;
+        ControlLoopStats stats_;
+    };
+}
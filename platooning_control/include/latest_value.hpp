@@ -0,0 +1,94 @@
+#pragma once
+
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace platoon_control
+{
+
+    /**
+     * \brief Single writer / multiple reader latest-value slot implemented as a seqlock.
+     *
+     * The writer never blocks and readers retry only if they raced a write, so the
+     * control thread can sample the most recent value without locks or allocation.
+     * T must be trivially copyable as it is copied with memcpy.
+     */
+    template <typename T>
+    class LatestValue
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "LatestValue requires a trivially copyable type");
+
+    public:
+
+        /**
+         * \brief Publish a new value. Must only be called from a single writer thread.
+         */
+        void store(const T& value)
+        {
+            uint64_t seq = seq_.load(std::memory_order_relaxed);
+            seq_.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(&value_, &value, sizeof(T));
+            seq_.store(seq + 2, std::memory_order_release);
+        }
+
+        /**
+         * \brief Copy the latest value into out
+         *
+         * \return False if no value has been stored yet, in which case out is unchanged
+         */
+        bool load(T& out) const
+        {
+            for (;;)
+            {
+                uint64_t before = seq_.load(std::memory_order_acquire);
+                if (before == 0)
+                {
+                    return false;
+                }
+                if (before & 1)
+                {
+                    continue; // Write in progress
+                }
+                T copy;
+                std::memcpy(&copy, &value_, sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (seq_.load(std::memory_order_relaxed) == before)
+                {
+                    out = copy;
+                    return true;
+                }
+            }
+        }
+
+        /**
+         * \brief Number of completed writes, usable to detect new data
+         */
+        uint64_t version() const
+        {
+            return seq_.load(std::memory_order_acquire) / 2;
+        }
+
+    private:
+        std::atomic<uint64_t> seq_ {0};
+        T value_;
+    };
+}
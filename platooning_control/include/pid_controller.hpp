@@ -28,6 +28,10 @@ namespace platoon_control
 
         // Returns the manipulated variable given a setpoint and current process value
         double calculate( double setpoint, double pv );
+
+        // Same as above using the measured interval dt (s) since the previous call.
+        // Non-positive dt falls back to the nominal loop interval.
+        double calculate( double setpoint, double pv, double dt );
         // ~PID();
 
         void reset();
@@ -23,17 +23,39 @@
 #include <geometry_msgs/PoseStamped.h>
 #include <cav_msgs/TrajectoryPlan.h>
 #include <cav_msgs/Plugin.h>
+#include <boost/make_shared.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <math.h>
 #include <carma_utils/CARMAUtils.h>
+#include <std_msgs/Float64.h>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
 #include "platoon_control_worker.hpp"
+#include "latest_value.hpp"
+#include "control_loop_timer.hpp"
 
 
 
 
 namespace platoon_control
 {
+    // Plain copy of the vehicle pose which can be handed to the control thread through a LatestValue slot
+    struct PoseSample
+    {
+        double x = 0.0, y = 0.0, z = 0.0;
+        double qx = 0.0, qy = 0.0, qz = 0.0, qw = 1.0;
+    };
+
+    // Trajectory handed to the control thread together with the time it was received
+    struct TrajectorySample
+    {
+        cav_msgs::TrajectoryPlan::ConstPtr plan;
+        ros::Time received;
+    };
+
     class PlatoonControlPlugin
     {
         public:
@@ -41,12 +63,27 @@ namespace platoon_control
             // Default constructor for PlatoonControlPlugin class
             PlatoonControlPlugin();
 
+            // Stops the control thread
+            ~PlatoonControlPlugin();
+
             void initialize();
 
             // general starting point of this node
             void run();
 			// Compose twist message by calculating speed and steering commands.
 			geometry_msgs::TwistStamped composeTwist(const cav_msgs::TrajectoryPlanPoint& point);
+
+			// Index of the trajectory point the controller should track at time now_ns (ns since epoch).
+			// This is the first point whose target time is in the future, the last point of the plan is never used.
+			static size_t selectTrajectoryPoint(const cav_msgs::TrajectoryPlan& tp, uint64_t now_ns);
+
+			// True if a trajectory received at received must no longer be tracked at time now, either because no newer
+			// trajectory arrived within timeout or because now is past the target time of its last point.
+			static bool isTrajectoryStale(const cav_msgs::TrajectoryPlan& tp, const ros::Time& received, const ros::Time& now,
+										  const ros::Duration& timeout);
+
+			// Timing statistics of the control loop
+			ControlLoopStats getControlLoopStats() const;
 			
 			// local copy of pose
         	boost::shared_ptr<geometry_msgs::PoseStamped const> pose_msg_;
@@ -59,9 +96,41 @@ namespace platoon_control
         	std::shared_ptr<ros::CARMANodeHandle> nh_, pnh_;
 
         	PlatoonControlWorker pcw_;
+			// Guards pcw_ which is used by both the control thread and composeTwist
+			std::mutex pcw_mutex_;
 
 			double current_speed_ = 0.0;
 
+			// Latest values written by the ROS callbacks and read by the control thread
+			LatestValue<PoseSample> pose_slot_;
+			LatestValue<double> speed_slot_;
+			// The trajectory sample is immutable so only its pointer is swapped, using boost atomic shared_ptr access
+			boost::shared_ptr<const TrajectorySample> trajectory_slot_;
+
+			// Commands stop once the latest trajectory is older than this, in seconds
+			double trajectory_timeout_ = 0.5;
+
+			// Control loop rate in Hz
+			double control_rate_ = 30.0;
+			ControlLoopTimer loop_timer_ {1.0 / 30.0};
+			std::thread control_thread_;
+			std::atomic<bool> running_ {false};
+
+			// Reused command message. Publishing still serializes it every cycle.
+			geometry_msgs::TwistStamped twist_cmd_;
+
+			// Fixed-rate control thread body
+			void controlLoop();
+
+			// Compute and publish one command using the latest pose, speed and trajectory
+			void controlStep(double dt);
+
+			// Compute a command for point from the given state into twist
+			void computeCommand(const cav_msgs::TrajectoryPlanPoint& point, const geometry_msgs::Pose& pose,
+								double speed, double dt, geometry_msgs::TwistStamped& twist);
+
+			void publishLoopStats();
+
 			// callback function for pose
 			void pose_cb(const geometry_msgs::PoseStampedConstPtr& msg);
 
@@ -85,6 +154,8 @@ namespace platoon_control
         	ros::Publisher twist_pub_;
         	
         	ros::Publisher plugin_discovery_pub_;
+			ros::Publisher jitter_pub_;
+			ros::Publisher overrun_pub_;
 
 			// TODO: add communication to receive leader
 			PlatoonLeaderInfo leader;
@@ -83,6 +83,14 @@ namespace platoon_control
 			current_pose = msg->pose;
 		}
 
+        void setCurrentPose(const geometry_msgs::Pose& pose)
+		{
+			current_pose = pose;
+		}
+
+        // set the measured interval (s) since the previous command, used by the pid controller and accel filter
+        void setControlPeriod(double dt);
+
 		// geometry pose
 		geometry_msgs::Pose current_pose;
 
@@ -103,7 +111,8 @@ namespace platoon_control
         double desiredGap_ = 0.0;
 
 
-        long CMD_TIMESTEP = 100;
+        // interval between commands in seconds
+        double dt_ = 0.1;
 
 
         double getCurrentDowntrackDistance(const cav_msgs::TrajectoryPlanPoint& point);
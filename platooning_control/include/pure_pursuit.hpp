@@ -40,11 +40,11 @@ namespace platoon_control
 		// calculate yaw angle of the vehicle
 		double getYaw() const;
 
-		// calculate alpha angle
-		double getAlpha(double lookahead, std::vector<double> v1, std::vector<double> v2) const;
+		// calculate alpha angle between vector v1 (to the target point) and v2 (vehicle heading)
+		double getAlpha(double lookahead, double v1_x, double v1_y, double v2_x, double v2_y) const;
 
 		// calculate steering direction
-		int getSteeringDirection(std::vector<double> v1, std::vector<double> v2) const;
+		int getSteeringDirection(double v1_x, double v1_y, double v2_x, double v2_y) const;
 
 		// calculate command velocity from trajecoty point
 		double getVelocity(const cav_msgs::TrajectoryPlanPoint& tp, double delta_pos) const;
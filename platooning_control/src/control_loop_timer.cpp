@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "control_loop_timer.hpp"
+#include <algorithm>
+
+namespace platoon_control
+{
+    namespace
+    {
+        double toSec(ControlLoopTimer::Clock::duration d)
+        {
+            return std::chrono::duration<double>(d).count();
+        }
+    }
+
+    ControlLoopTimer::ControlLoopTimer(double period)
+        : period_(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(period))),
+          next_period_(period_) {}
+
+    void ControlLoopTimer::setPeriod(double period)
+    {
+        next_period_ = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(period));
+    }
+
+    ControlLoopTimer::Clock::time_point ControlLoopTimer::start(Clock::time_point now)
+    {
+        period_ = next_period_;
+        scheduled_ = now;
+        cycle_start_ = now;
+        first_cycle_ = true;
+
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_ = ControlLoopStats();
+        return scheduled_;
+    }
+
+    double ControlLoopTimer::beginCycle(Clock::time_point now)
+    {
+        double dt = first_cycle_ ? toSec(period_) : toSec(now - cycle_start_);
+        double jitter = std::max(0.0, toSec(now - scheduled_));
+        cycle_start_ = now;
+        first_cycle_ = false;
+
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.cycles++;
+        stats_.last_dt = dt;
+        stats_.last_jitter = jitter;
+        stats_.mean_jitter += (jitter - stats_.mean_jitter) / stats_.cycles;
+        stats_.max_jitter = std::max(stats_.max_jitter, jitter);
+        return dt;
+    }
+
+    ControlLoopTimer::Clock::time_point ControlLoopTimer::endCycle(Clock::time_point now)
+    {
+        double compute_time = toSec(now - cycle_start_);
+        scheduled_ += period_;
+
+        bool overrun = now > scheduled_;
+        if (overrun)
+        {
+            scheduled_ = now;
+        }
+
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.last_compute_time = compute_time;
+        stats_.max_compute_time = std::max(stats_.max_compute_time, compute_time);
+        if (overrun)
+        {
+            stats_.overruns++;
+        }
+        return scheduled_;
+    }
+
+    ControlLoopStats ControlLoopTimer::getStats() const
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        return stats_;
+    }
+
+    double ControlLoopTimer::getPeriod() const
+    {
+        return toSec(period_);
+    }
+}
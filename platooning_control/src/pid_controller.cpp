@@ -7,6 +7,14 @@ namespace platoon_control
 	PIDController::PIDController(){}
 	
 	double PIDController::calculate( double setpoint, double pv ){
+		return calculate(setpoint, pv, _dt);
+	}
+
+	double PIDController::calculate( double setpoint, double pv, double dt ){
+
+		if (dt <= 0.0){
+			dt = _dt;
+		}
 
 		// Calculate error
 	    double error = setpoint - pv;
@@ -15,7 +23,7 @@ namespace platoon_control
 	    double Pout = _Kp * error;
 
 	    // Integral term
-	    _integral += error * _dt;
+	    _integral += error * dt;
 		if (_integral > integratorMax){
 			 _integral = integratorMax;
 		}
@@ -25,7 +33,7 @@ namespace platoon_control
 	    double Iout = _Ki * _integral;
 
 	    // Derivative term
-	    double derivative = (error - _pre_error) / _dt;
+	    double derivative = (error - _pre_error) / dt;
 	    double Dout = _Kd * derivative;
 
 	    // Calculate total output
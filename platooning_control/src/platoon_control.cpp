@@ -21,6 +21,15 @@ namespace platoon_control
 {
 // @SONAR_STOP@
     PlatoonControlPlugin::PlatoonControlPlugin(){}
+
+    PlatoonControlPlugin::~PlatoonControlPlugin()
+    {
+        running_ = false;
+        if (control_thread_.joinable())
+        {
+            control_thread_.join();
+        }
+    }
     
 
     void PlatoonControlPlugin::initialize(){
@@ -28,6 +37,14 @@ namespace platoon_control
     	nh_.reset(new ros::CARMANodeHandle());
         pnh_.reset(new ros::CARMANodeHandle("~"));
 
+        pnh_->param<double>("control_rate", control_rate_, control_rate_);
+        if (control_rate_ <= 0.0)
+        {
+            throw std::invalid_argument("control_rate must be positive");
+        }
+        loop_timer_.setPeriod(1.0 / control_rate_);
+        pnh_->param<double>("trajectory_timeout", trajectory_timeout_, trajectory_timeout_);
+
 	  	// Trajectory Plan Subscriber
 		trajectory_plan_sub = nh_->subscribe<cav_msgs::TrajectoryPlan>("trajectory_plan", 1, &PlatoonControlPlugin::TrajectoryPlan_cb, this);
         
@@ -48,11 +65,18 @@ namespace platoon_control
         plugin_discovery_msg_.type = cav_msgs::Plugin::CONTROL;
         plugin_discovery_msg_.capability = "control/trajectory_control";
 
+        jitter_pub_ = pnh_->advertise<std_msgs::Float64>("control_loop_jitter", 1);
+        overrun_pub_ = pnh_->advertise<std_msgs::Float64>("control_loop_overruns", 1);
+
         ros::CARMANodeHandle::setSpinCallback([this]()
         {
             plugin_discovery_pub_.publish(plugin_discovery_msg_);
+            publishLoopStats();
             return true;
         });
+
+        running_ = true;
+        control_thread_ = std::thread(&PlatoonControlPlugin::controlLoop, this);
     }
 
                                     
@@ -62,26 +86,135 @@ namespace platoon_control
     }
 
 
-    void  PlatoonControlPlugin::TrajectoryPlan_cb(const cav_msgs::TrajectoryPlan::ConstPtr& tp){
-    	for(int i = 0; i < tp->trajectory_points.size() - 1; i++ ) {
-    		
-    		cav_msgs::TrajectoryPlanPoint t1 = tp->trajectory_points[i];
+    void PlatoonControlPlugin::controlLoop()
+    {
+        ControlLoopTimer::Clock::time_point wake = loop_timer_.start(ControlLoopTimer::Clock::now());
+        while (running_ && ros::ok())
+        {
+            std::this_thread::sleep_until(wake);
+            double dt = loop_timer_.beginCycle(ControlLoopTimer::Clock::now());
+            controlStep(dt);
+            wake = loop_timer_.endCycle(ControlLoopTimer::Clock::now());
+        }
+    }
 
-    		geometry_msgs::TwistStamped twist_msg = composeTwist(t1);
+    void PlatoonControlPlugin::controlStep(double dt)
+    {
+        PoseSample sample;
+        if (!pose_slot_.load(sample))
+        {
+            return; // No pose yet
+        }
 
-    		publishTwist(twist_msg);
-    	}
+        boost::shared_ptr<const TrajectorySample> trajectory = boost::atomic_load(&trajectory_slot_);
+        if (!trajectory || trajectory->plan->trajectory_points.size() < 2)
+        {
+            return;
+        }
+        const cav_msgs::TrajectoryPlan::ConstPtr& tp = trajectory->plan;
 
+        // Without a fresh trajectory no command is sent, as before the control thread was introduced
+        ros::Time now = ros::Time::now();
+        if (isTrajectoryStale(*tp, trajectory->received, now, ros::Duration(trajectory_timeout_)))
+        {
+            ROS_WARN_STREAM_THROTTLE(1, "Trajectory received at " << trajectory->received << " is stale, not commanding");
+            return;
+        }
+
+        double speed = 0.0;
+        speed_slot_.load(speed);
+
+        geometry_msgs::Pose pose;
+        pose.position.x = sample.x;
+        pose.position.y = sample.y;
+        pose.position.z = sample.z;
+        pose.orientation.x = sample.qx;
+        pose.orientation.y = sample.qy;
+        pose.orientation.z = sample.qz;
+        pose.orientation.w = sample.qw;
+
+        size_t idx = selectTrajectoryPoint(*tp, now.toNSec());
+        computeCommand(tp->trajectory_points[idx], pose, speed, dt, twist_cmd_);
+        publishTwist(twist_cmd_);
+    }
+
+    size_t PlatoonControlPlugin::selectTrajectoryPoint(const cav_msgs::TrajectoryPlan& tp, uint64_t now_ns)
+    {
+        if (tp.trajectory_points.size() < 2)
+        {
+            return 0;
+        }
+        size_t last = tp.trajectory_points.size() - 2;
+        for (size_t i = 0; i < last; i++)
+        {
+            if (tp.trajectory_points[i].target_time > now_ns)
+            {
+                return i;
+            }
+        }
+        return last;
+    }
+
+    bool PlatoonControlPlugin::isTrajectoryStale(const cav_msgs::TrajectoryPlan& tp, const ros::Time& received,
+                                                 const ros::Time& now, const ros::Duration& timeout)
+    {
+        if (now - received > timeout)
+        {
+            return true;
+        }
+        return tp.trajectory_points.empty() || now.toNSec() > tp.trajectory_points.back().target_time;
+    }
+
+    ControlLoopStats PlatoonControlPlugin::getControlLoopStats() const
+    {
+        return loop_timer_.getStats();
+    }
+
+    void PlatoonControlPlugin::publishLoopStats()
+    {
+        ControlLoopStats stats = loop_timer_.getStats();
+
+        std_msgs::Float64 jitter_msg;
+        jitter_msg.data = stats.last_jitter;
+        jitter_pub_.publish(jitter_msg);
+
+        std_msgs::Float64 overrun_msg;
+        overrun_msg.data = static_cast<double>(stats.overruns);
+        overrun_pub_.publish(overrun_msg);
+
+        ROS_INFO_STREAM_THROTTLE(10, "Control loop: cycles " << stats.cycles << " overruns " << stats.overruns
+                                 << " dt " << stats.last_dt << "s mean jitter " << stats.mean_jitter * 1000.0
+                                 << "ms max jitter " << stats.max_jitter * 1000.0 << "ms max compute "
+                                 << stats.max_compute_time * 1000.0 << "ms");
+    }
+
+    void  PlatoonControlPlugin::TrajectoryPlan_cb(const cav_msgs::TrajectoryPlan::ConstPtr& tp){
+        // Commands are generated by the control thread from the latest plan
+        auto sample = boost::make_shared<TrajectorySample>();
+        sample->plan = tp;
+        sample->received = ros::Time::now();
+        boost::atomic_store(&trajectory_slot_, boost::shared_ptr<const TrajectorySample>(sample));
     }
 
     void PlatoonControlPlugin::pose_cb(const geometry_msgs::PoseStampedConstPtr& msg)
     {
         pose_msg_ = msg;
+
+        PoseSample sample;
+        sample.x = msg->pose.position.x;
+        sample.y = msg->pose.position.y;
+        sample.z = msg->pose.position.z;
+        sample.qx = msg->pose.orientation.x;
+        sample.qy = msg->pose.orientation.y;
+        sample.qz = msg->pose.orientation.z;
+        sample.qw = msg->pose.orientation.w;
+        pose_slot_.store(sample);
     }
 
 
     void PlatoonControlPlugin::currentTwist_cb(const geometry_msgs::TwistStamped::ConstPtr& twist){
         current_speed_ = twist->twist.linear.x;
+        speed_slot_.store(current_speed_);
     }
 
     void PlatoonControlPlugin::publishTwist(const geometry_msgs::TwistStamped& twist) const {
@@ -91,15 +224,22 @@ namespace platoon_control
 // @SONAR_START@
     geometry_msgs::TwistStamped PlatoonControlPlugin::composeTwist(const cav_msgs::TrajectoryPlanPoint& point){
     	geometry_msgs::TwistStamped current_twist;
-        pcw_.setCurrentSpeed(current_speed_);
+        computeCommand(point, pose_msg_->pose, current_speed_, loop_timer_.getPeriod(), current_twist);
+    	return current_twist;
+    }
+
+    void PlatoonControlPlugin::computeCommand(const cav_msgs::TrajectoryPlanPoint& point, const geometry_msgs::Pose& pose,
+                                              double speed, double dt, geometry_msgs::TwistStamped& twist){
+        std::lock_guard<std::mutex> lock(pcw_mutex_);
+        pcw_.setCurrentSpeed(speed);
         pcw_.setLeader(leader);
-        pcw_.setCurrentPose(pose_msg_);
+        pcw_.setCurrentPose(pose);
+        pcw_.setControlPeriod(dt);
     	pcw_.generateSpeed(point);
     	pcw_.generateSteer(point);
-    	current_twist.twist.linear.x = pcw_.speedCmd_;
-    	current_twist.twist.angular.z = pcw_.steerCmd_;
-        current_twist.header.stamp = ros::Time::now();
-    	return current_twist;
+    	twist.twist.linear.x = pcw_.speedCmd_;
+    	twist.twist.angular.z = pcw_.steerCmd_;
+        twist.header.stamp = ros::Time::now();
     }
 
 }
@@ -39,7 +39,7 @@ namespace platoon_control
 	        // The summation of the leader vehicle command speed and the output of PD controller will be used as speed commands
 	        // The command speed of leader vehicle will act as the baseline for our speed control
 	        
-	        controllerOutput = pid_ctrl_.calculate(desiredHostPosition, hostVehiclePosition);//; = speedController_.apply(signal).get().getData();
+	        controllerOutput = pid_ctrl_.calculate(desiredHostPosition, hostVehiclePosition, dt_);//; = speedController_.apply(signal).get().getData();
 
 		    double adjSpeedCmd = controllerOutput + leader.commandSpeed;
 	        ROS_DEBUG("Adjusted Speed Cmd = " , adjSpeedCmd , "; Controller Output = " , controllerOutput
@@ -58,8 +58,8 @@ namespace platoon_control
             // Third: we allow do not a large gap between two consecutive speed commands
             if(enableMaxAccelFilter) {
                 
-                double max = lastCmdSpeed + (maxAccel * (CMD_TIMESTEP / 1000.0));
-                double min = lastCmdSpeed - (maxAccel * (CMD_TIMESTEP / 1000.0));
+                double max = lastCmdSpeed + (maxAccel * dt_);
+                double min = lastCmdSpeed - (maxAccel * dt_);
                 if(adjSpeedCmd > max) {
                     adjSpeedCmd = max; 
                 } else if (adjSpeedCmd < min) {
@@ -98,6 +98,12 @@ namespace platoon_control
     	currentSpeed = speed;
     }
 
+    void PlatoonControlWorker::setControlPeriod(double dt){
+        if (dt > 0.0) {
+            dt_ = dt;
+        }
+    }
+
     double PlatoonControlWorker::getCurrentDowntrackDistance(const cav_msgs::TrajectoryPlanPoint& point) {
         
         double x_diff = (point.x-current_pose.position.x);
@@ -15,7 +15,8 @@ namespace platoon_control
 
 	double PurePursuit::getVelocity(const cav_msgs::TrajectoryPlanPoint& tp, double delta_pos) const {
 		
-		double delta_t_second = (double)abs(tp.target_time - tp0.target_time) / 1e9;
+		// target_time is unsigned so take the difference as a signed value before the abs
+		double delta_t_second = fabs(static_cast<double>(static_cast<int64_t>(tp.target_time - tp0.target_time))) / 1e9;
 
 		if(delta_t_second != 0) {
 			return delta_pos / delta_t_second;
@@ -29,9 +30,9 @@ namespace platoon_control
 		return yaw;
 	}
 
-	double PurePursuit::getAlpha(double lookahead, std::vector<double> v1, std::vector<double> v2) const {
+	double PurePursuit::getAlpha(double lookahead, double v1_x, double v1_y, double v2_x, double v2_y) const {
 		
-		double inner_prod = v1[0]*v2[0] + v1[1]*v2[1];
+		double inner_prod = v1_x*v2_x + v1_y*v2_y;
 		double value = inner_prod/lookahead;
 		if (value > 1) value = 1;
 		else if (value < -1) value = -1;
@@ -39,8 +40,8 @@ namespace platoon_control
         return alpha;
 	}
 
-	int PurePursuit::getSteeringDirection(std::vector<double> v1, std::vector<double> v2) const{
-		double corss_prod = v1[0]*v2[1] - v1[1]*v2[0];
+	int PurePursuit::getSteeringDirection(double v1_x, double v1_y, double v2_x, double v2_y) const{
+		double corss_prod = v1_x*v2_y - v1_y*v2_x;
         if (corss_prod >= 0.0){
 			 return -1;
 		}
@@ -56,10 +57,12 @@ namespace platoon_control
 		double lookahead = getLookaheadDist(tp);
 		double v = getVelocity(tp, lookahead);
 		double yaw = getYaw();
-		std::vector<double> v1 = {tp.x - current_pose_.position.x , tp.y - current_pose_.position.y};
-		std::vector<double> v2 = {cos(yaw), sin(yaw)};
-		double alpha = getAlpha(lookahead, v1, v2);
-		int direction = getSteeringDirection(v1, v2);
+		double v1_x = tp.x - current_pose_.position.x;
+		double v1_y = tp.y - current_pose_.position.y;
+		double v2_x = cos(yaw);
+		double v2_y = sin(yaw);
+		double alpha = getAlpha(lookahead, v1_x, v1_y, v2_x, v2_y);
+		int direction = getSteeringDirection(v1_x, v1_y, v2_x, v2_y);
 		double steering = direction* atan((2 * wheelbase_ * sin(alpha))/(lookahead));// change (lookahead) to (Kdd_*v) if steering is bad
 		tp0 = tp;
 		if (std::isnan(steering)) return prev_steering;
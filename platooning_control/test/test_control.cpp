@@ -26,3 +26,44 @@ TEST(PlatoonControlPluginTest, test1)
 
 
 
+
+TEST(PlatoonControlPluginTest, testSelectTrajectoryPoint)
+{
+    cav_msgs::TrajectoryPlan tp;
+    for (int i = 0; i < 4; i++)
+    {
+        cav_msgs::TrajectoryPlanPoint point;
+        point.x = i;
+        point.target_time = (i + 1) * 1e9;
+        tp.trajectory_points.push_back(point);
+    }
+
+    EXPECT_EQ(0u, platoon_control::PlatoonControlPlugin::selectTrajectoryPoint(tp, 0));
+    EXPECT_EQ(1u, platoon_control::PlatoonControlPlugin::selectTrajectoryPoint(tp, 1.5e9));
+    // The last point is never tracked
+    EXPECT_EQ(2u, platoon_control::PlatoonControlPlugin::selectTrajectoryPoint(tp, 10e9));
+
+    tp.trajectory_points.resize(1);
+    EXPECT_EQ(0u, platoon_control::PlatoonControlPlugin::selectTrajectoryPoint(tp, 0));
+}
+
+TEST(PlatoonControlPluginTest, testIsTrajectoryStale)
+{
+    cav_msgs::TrajectoryPlan tp;
+    for (int i = 0; i < 4; i++)
+    {
+        cav_msgs::TrajectoryPlanPoint point;
+        point.target_time = (i + 1) * 1e9;
+        tp.trajectory_points.push_back(point);
+    }
+    ros::Duration timeout(0.5);
+
+    EXPECT_FALSE(platoon_control::PlatoonControlPlugin::isTrajectoryStale(tp, ros::Time(1), ros::Time(1.2), timeout));
+    // No new trajectory within the timeout
+    EXPECT_TRUE(platoon_control::PlatoonControlPlugin::isTrajectoryStale(tp, ros::Time(1), ros::Time(1.6), timeout));
+    // Past the last point of the trajectory
+    EXPECT_TRUE(platoon_control::PlatoonControlPlugin::isTrajectoryStale(tp, ros::Time(4), ros::Time(4.1), timeout));
+
+    tp.trajectory_points.clear();
+    EXPECT_TRUE(platoon_control::PlatoonControlPlugin::isTrajectoryStale(tp, ros::Time(1), ros::Time(1), timeout));
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2019-2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "latest_value.hpp"
+#include "control_loop_timer.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+
+
+TEST(LatestValueTest, test1)
+{
+    platoon_control::LatestValue<double> slot;
+    double value = -1.0;
+    EXPECT_FALSE(slot.load(value));
+    EXPECT_EQ(-1.0, value);
+    EXPECT_EQ(0u, slot.version());
+
+    slot.store(2.5);
+    EXPECT_TRUE(slot.load(value));
+    EXPECT_EQ(2.5, value);
+    slot.store(3.5);
+    EXPECT_TRUE(slot.load(value));
+    EXPECT_EQ(3.5, value);
+    EXPECT_EQ(2u, slot.version());
+}
+
+namespace
+{
+    struct Pair
+    {
+        double a;
+        double b;
+    };
+}
+
+TEST(LatestValueTest, testConcurrentReadsAreConsistent)
+{
+    platoon_control::LatestValue<Pair> slot;
+    std::atomic<bool> done {false};
+
+    std::thread writer([&]() {
+        for (int i = 0; i < 100000; i++)
+        {
+            slot.store(Pair{(double)i, (double)-i});
+        }
+        done = true;
+    });
+
+    Pair p;
+    while (!done)
+    {
+        if (slot.load(p))
+        {
+            ASSERT_EQ(p.a, -p.b); // Never observe a torn write
+        }
+    }
+    writer.join();
+    ASSERT_TRUE(slot.load(p));
+    EXPECT_EQ(99999.0, p.a);
+}
+
+TEST(ControlLoopTimerTest, test1)
+{
+    using Clock = platoon_control::ControlLoopTimer::Clock;
+    platoon_control::ControlLoopTimer timer(0.1);
+    EXPECT_NEAR(0.1, timer.getPeriod(), 1e-9);
+
+    Clock::time_point t0;
+    Clock::time_point wake = timer.start(t0);
+    EXPECT_TRUE(wake == t0);
+
+    // First cycle reports the nominal period
+    EXPECT_NEAR(0.1, timer.beginCycle(t0), 1e-9);
+    wake = timer.endCycle(t0 + std::chrono::milliseconds(10));
+    EXPECT_TRUE(wake == t0 + std::chrono::milliseconds(100));
+
+    // Woke up 5 ms late, dt is measured
+    EXPECT_NEAR(0.105, timer.beginCycle(t0 + std::chrono::milliseconds(105)), 1e-9);
+    wake = timer.endCycle(t0 + std::chrono::milliseconds(120));
+    EXPECT_TRUE(wake == t0 + std::chrono::milliseconds(200)); // Stays on the fixed grid
+
+    platoon_control::ControlLoopStats stats = timer.getStats();
+    EXPECT_EQ(2u, stats.cycles);
+    EXPECT_EQ(0u, stats.overruns);
+    EXPECT_NEAR(0.005, stats.last_jitter, 1e-9);
+    EXPECT_NEAR(0.0025, stats.mean_jitter, 1e-9);
+    EXPECT_NEAR(0.005, stats.max_jitter, 1e-9);
+    EXPECT_NEAR(0.015, stats.max_compute_time, 1e-9);
+}
+
+TEST(ControlLoopTimerTest, testOverrun)
+{
+    using Clock = platoon_control::ControlLoopTimer::Clock;
+    platoon_control::ControlLoopTimer timer(0.1);
+
+    Clock::time_point t0;
+    timer.start(t0);
+    timer.beginCycle(t0);
+    // Cycle took 250 ms, the missed deadlines are dropped and the next cycle runs immediately
+    Clock::time_point wake = timer.endCycle(t0 + std::chrono::milliseconds(250));
+    EXPECT_TRUE(wake == t0 + std::chrono::milliseconds(250));
+
+    EXPECT_NEAR(0.25, timer.beginCycle(wake), 1e-9);
+    wake = timer.endCycle(t0 + std::chrono::milliseconds(260));
+    EXPECT_TRUE(wake == t0 + std::chrono::milliseconds(350));
+
+    platoon_control::ControlLoopStats stats = timer.getStats();
+    EXPECT_EQ(1u, stats.overruns);
+    EXPECT_NEAR(0.25, stats.max_compute_time, 1e-9);
+
+    // Restarting with a new period resets the statistics
+    timer.setPeriod(0.05);
+    timer.start(t0);
+    EXPECT_NEAR(0.05, timer.getPeriod(), 1e-9);
+    EXPECT_EQ(0u, timer.getStats().cycles);
+}
@@ -35,3 +35,13 @@ TEST(PIDControllerTest, test4)
     double res3 = pid.calculate(25,500);
     EXPECT_EQ(100, res3);
 }
+
+TEST(PIDControllerTest, testMeasuredDt)
+{
+    platoon_control::PIDController pid;
+    double res = pid.calculate(40, 38, 0.2);
+    EXPECT_EQ(-3, res); // 2 + (-0.5 * 2 / 0.2)
+
+    platoon_control::PIDController pid2;
+    EXPECT_EQ(pid2.calculate(40, 38, 0.0), -8); // Falls back to the nominal dt
+}
@@ -11,6 +11,7 @@
 #include <carma_wm/WorldModel.h>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <boost/utility/string_view.hpp>
 #include <autoware_msgs/ControlCommandStamped.h>
 
 
@@ -60,7 +61,7 @@ namespace platoon_strategic
 
 
 
-        void memberUpdates(const std::string& senderId,const std::string& platoonId,const std::string& senderBsmId,const std::string& params);
+        void memberUpdates(const std::string& senderId,const std::string& platoonId,const std::string& senderBsmId,boost::string_view params);
 
         /**
          * Given any valid platooning mobility STATUS operation parameters and sender staticId,
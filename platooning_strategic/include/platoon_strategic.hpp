@@ -34,6 +34,7 @@
 #include <cav_msgs/MobilityResponse.h>
 #include <cav_msgs/PlanType.h>
 #include <state_machine.hpp>
+#include <strategy_params_codec/message_schemas.h>
 
 // #include <leader_state.hpp>
 
@@ -134,11 +135,15 @@ namespace platoon_strategic
             cav_msgs::MobilityOperation mobility_op_msg_;
 
 
-            void composeMobilityOperationLeader(cav_msgs::MobilityOperation &msg, const std::string& type);
+            void composeMobilityOperationLeaderInfo(cav_msgs::MobilityOperation &msg);
+            void composeMobilityOperationLeaderStatus(cav_msgs::MobilityOperation &msg) const;
             void composeMobilityOperationFollower(cav_msgs::MobilityOperation &msg) const;
             void composeMobilityOperationLeaderWaiting(cav_msgs::MobilityOperation &msg) const;
             void composeMobilityOperationCandidateFollower(cav_msgs::MobilityOperation &msg);
 
+            // Encodes the STATUS params of the host vehicle sent in every state
+            void composeStatusParams(std::string& params) const;
+
 
             double maxAllowedJoinTimeGap = 15.0;
             double maxAllowedJoinGap = 90;
@@ -157,9 +162,6 @@ namespace platoon_strategic
 
 
             const std::string MOBILITY_STRATEGY = "Carma/Platooning";
-            const std::string OPERATION_INFO_TYPE = "INFO";
-            const std::string OPERATION_STATUS_TYPE = "STATUS";
-            const std::string OPERATION_STATUS_PARAMS = "STATUS|CMDSPEED:%1%,DTD:%2%,SPEED:%3%";
 
 
             // Check these values
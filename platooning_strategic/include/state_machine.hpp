@@ -13,6 +13,7 @@
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <platoon_manager.hpp>
+#include <strategy_params_codec/message_schemas.h>
 
 namespace platoon_strategic
 {
@@ -129,9 +130,6 @@ namespace platoon_strategic
         double vehicleLength = 5.0;
         int infoMessageInterval;
         const std::string targetPlatoonId;
-        const std::string OPERATION_INFO_TYPE = "INFO";
-        const std::string OPERATION_STATUS_TYPE = "STATUS";
-        const std::string JOIN_AT_REAR_PARAMS = "SIZE:%1%,SPEED:%2%,DTD:%3%";
         const std::string  MOBILITY_STRATEGY = "Carma/Platooning";
     };
 }
@@ -14,7 +14,7 @@
  */
 
 #include "platoon_manager.hpp"
-#include <boost/algorithm/string.hpp>
+#include <strategy_params_codec/message_schemas.h>
 #include <ros/ros.h>
 #include <array>
 
@@ -29,24 +29,16 @@ namespace platoon_strategic
                 pose_sub_ = nh_->subscribe("current_pose", 1, &PlatoonManager::pose_cb, this);
         };
 
-    void PlatoonManager::memberUpdates(const std::string& senderId,const std::string& platoonId,const std::string& senderBsmId,const std::string& params){
+    void PlatoonManager::memberUpdates(const std::string& senderId,const std::string& platoonId,const std::string& senderBsmId,boost::string_view params){
 
-        std::vector<std::string> inputsParams;
-        boost::algorithm::split(inputsParams, params, boost::is_any_of(","));
-
-        std::vector<std::string> cmd_parsed;
-        boost::algorithm::split(cmd_parsed, inputsParams[0], boost::is_any_of(":"));
-        double cmdSpeed = std::stod(cmd_parsed[1]);
-
-
-        std::vector<std::string> dtd_parsed;
-        boost::algorithm::split(dtd_parsed, inputsParams[1], boost::is_any_of(":"));
-        double dtDistance = std::stod(dtd_parsed[1]);
-
-
-        std::vector<std::string> cur_parsed;
-        boost::algorithm::split(cur_parsed, inputsParams[2], boost::is_any_of(":"));
-        double curSpeed = std::stod(cur_parsed[1]);
+        strategy_params_codec::PlatoonStatusParams status;
+        if (!strategy_params_codec::decodeBody(params, status)) {
+            ROS_WARN_STREAM("Ignoring STATUS message from " << senderId << " with invalid params: " << params);
+            return;
+        }
+        double cmdSpeed = status.command_speed;
+        double dtDistance = status.downtrack;
+        double curSpeed = status.speed;
 
 
         // If we are currently in a follower state:
@@ -140,7 +140,7 @@ namespace platoon_strategic
             bool isTimeForHeartBeat = tsStart - lastHeartBeatTime >= infoMessageInterval;
             if(isTimeForHeartBeat) {
                     cav_msgs::MobilityOperation infoOperation;
-                    composeMobilityOperationLeader(infoOperation, "INFO");
+                    composeMobilityOperationLeaderInfo(infoOperation);
                     mob_op_pub_.publish(infoOperation);
                     lastHeartBeatTime = ros::Time::now().toSec()*1000.0;
                     ROS_DEBUG("Published heart beat platoon INFO mobility operatrion message");
@@ -165,7 +165,7 @@ namespace platoon_strategic
             bool hasFollower = (psm_.pm_.getTotalPlatooningSize() > 1);
             if(hasFollower) {
                 cav_msgs::MobilityOperation statusOperation;
-                composeMobilityOperationLeader(statusOperation, "STATUS");
+                composeMobilityOperationLeaderStatus(statusOperation);
                 mob_op_pub_.publish(statusOperation);
                 ROS_DEBUG("Published platoon STATUS operation message");
             }
@@ -294,7 +294,7 @@ namespace platoon_strategic
     }
 
 
-    void PlatoonStrategicPlugin::composeMobilityOperationLeader(cav_msgs::MobilityOperation &msg, const std::string& type){
+    void PlatoonStrategicPlugin::composeMobilityOperationLeaderInfo(cav_msgs::MobilityOperation &msg){
         msg.header.plan_id = psm_.pm_.currentPlatoonID;
         msg.header.recipient_id = "";
         msg.header.sender_bsm_id = BSMID;
@@ -303,41 +303,27 @@ namespace platoon_strategic
         msg.header.timestamp = ros::Time::now().toSec()*1000.0;
         msg.strategy = MOBILITY_STRATEGY;
 
-        if (type == OPERATION_INFO_TYPE){
-            // For INFO params, the string format is INFO|REAR:%s,LENGTH:%.2f,SPEED:%.2f,SIZE:%d
-
-            std::string PlatoonRearBsmId = BSMID;
-            int CurrentPlatoonLength = psm_.pm_.getCurrentPlatoonLength();
-            double current_speed = psm_.pm_.getCurrentSpeed();
-            int PlatoonSize = psm_.pm_.getTotalPlatooningSize();
-            double PlatoonRearDowntrackDistance = psm_.pm_.getPlatoonRearDowntrackDistance();
+        strategy_params_codec::PlatoonInfoParams info;
+        info.rear_bsm_id = BSMID;
+        info.length = psm_.pm_.getCurrentPlatoonLength();
+        info.speed = psm_.pm_.getCurrentSpeed();
+        info.size = psm_.pm_.getTotalPlatooningSize();
+        info.rear_downtrack = psm_.pm_.getPlatoonRearDowntrackDistance();
+        strategy_params_codec::encode(info, msg.strategy_params);
+        ROS_DEBUG("Composed a mobility operation message with params " , msg.strategy_params);
+    }
 
-            boost::format fmter(OPERATION_INFO_TYPE);
-            fmter %PlatoonRearBsmId;
-            fmter %CurrentPlatoonLength;
-            fmter %current_speed;
-            fmter %PlatoonSize;
-            fmter %PlatoonRearDowntrackDistance;
+    void PlatoonStrategicPlugin::composeMobilityOperationLeaderStatus(cav_msgs::MobilityOperation &msg) const{
+        msg.header.plan_id = psm_.pm_.currentPlatoonID;
+        msg.header.recipient_id = "";
+        msg.header.sender_bsm_id = BSMID;
+        std::string hostStaticId = HostMobilityId;
+        msg.header.sender_id = hostStaticId;
+        msg.header.timestamp = ros::Time::now().toSec()*1000.0;
+        msg.strategy = MOBILITY_STRATEGY;
 
-            std::string infoParams = fmter.str();
-            msg.strategy_params = infoParams;
-        }
-        else if (type == OPERATION_STATUS_TYPE){
-            // For STATUS params, the string format is "STATUS|CMDSPEED:xx,DTD:xx,SPEED:xx"
-            double cmdSpeed, current_speed, current_downtrack;
-            boost::format fmter(OPERATION_STATUS_PARAMS);
-            fmter %cmdSpeed;
-            fmter %current_downtrack;
-            fmter %current_speed;
-                    
-            std::string statusParams = fmter.str();
-            msg.strategy_params = statusParams;
-        } else {
-            ROS_ERROR("UNKNOW strategy param string!!!");
-            msg.strategy_params = "";
-        }
+        composeStatusParams(msg.strategy_params);
         ROS_DEBUG("Composed a mobility operation message with params " , msg.strategy_params);
-    
     }
 
     void PlatoonStrategicPlugin::composeMobilityOperationFollower(cav_msgs::MobilityOperation &msg) const{
@@ -349,16 +335,7 @@ namespace platoon_strategic
         msg.header.sender_id = hostStaticId;
         msg.header.timestamp = ros::Time::now().toSec()*1000.0;
         msg.strategy = MOBILITY_STRATEGY;
-        
-        double cmdSpeed, current_speed, current_downtrack;
-
-        boost::format fmter(OPERATION_STATUS_PARAMS);
-        fmter %cmdSpeed;
-        fmter %current_downtrack;
-        fmter %current_speed;
-                    
-        std::string statusParams = fmter.str();
-        msg.strategy_params = statusParams;
+        composeStatusParams(msg.strategy_params);
         ROS_DEBUG("Composed a mobility operation message with params " , msg.strategy_params);
     }
 
@@ -373,15 +350,7 @@ namespace platoon_strategic
         msg.header.sender_id = hostStaticId;
         msg.header.timestamp = ros::Time::now().toSec()*1000;
         msg.strategy = MOBILITY_STRATEGY;
-        // For STATUS params, the string format is "STATUS|CMDSPEED:5.0,DOWNTRACK:100.0,SPEED:5.0"
-        double cmdSpeed, current_speed, current_downtrack;
-        boost::format fmter(OPERATION_STATUS_PARAMS);
-        fmter %cmdSpeed;
-        fmter %current_downtrack;
-        fmter %current_speed;
-                    
-        std::string statusParams = fmter.str();
-        msg.strategy_params = statusParams;
+        composeStatusParams(msg.strategy_params);
         
     }
 
@@ -396,19 +365,17 @@ namespace platoon_strategic
         msg.header.sender_id = hostStaticId;
         msg.header.timestamp = ros::Time::now().toSec()*1000.0; 
         msg.strategy = MOBILITY_STRATEGY;
-        
-        // // For STATUS params, the string format is "STATUS|CMDSPEED:xx,DTD:xx,SPEED:xx"
-        
-        double cmdSpeed, current_speed, current_downtrack;
-        boost::format fmter(OPERATION_STATUS_PARAMS);
-        fmter %cmdSpeed;
-        fmter %current_downtrack;
-        fmter %current_speed;
-                    
-        std::string statusParams = fmter.str();
-        msg.strategy_params = statusParams;
+        composeStatusParams(msg.strategy_params);
         ROS_DEBUG("Composed a mobility operation message with params " , msg.strategy_params);
     }
 
+    void PlatoonStrategicPlugin::composeStatusParams(std::string& params) const
+    {
+        strategy_params_codec::PlatoonStatusParams status;
+        status.command_speed = psm_.pm_.command_speed_;
+        status.downtrack = psm_.pm_.getCurrentDowntrackDistance();
+        status.speed = psm_.pm_.getCurrentSpeed();
+        strategy_params_codec::encode(status, params);
+    }
 
 }
@@ -154,29 +154,21 @@ namespace platoon_strategic
 
     void PlatooningStateMachine::onMobilityOperationMessageFollower(cav_msgs::MobilityOperation &msg)
     {
-        std::string strategyParams = msg.strategy_params;
+        const std::string& strategyParams = msg.strategy_params;
         // In the current state, we care about the STATUS message
-        bool isPlatoonStatusMsg = (strategyParams.find(OPERATION_STATUS_TYPE) == 0);
-        bool isPlatoonInfoMsg = (strategyParams.find(OPERATION_INFO_TYPE) == 0);
-        // If it is platoon status message, the params string is in format:
-        // STATUS|CMDSPEED:xx,DTD:xx,SPEED:xx
+        bool isPlatoonStatusMsg = strategy_params_codec::hasPrefix<strategy_params_codec::PlatoonStatusParams>(strategyParams);
+        bool isPlatoonInfoMsg = strategy_params_codec::hasPrefix<strategy_params_codec::PlatoonInfoParams>(strategyParams);
         if(isPlatoonStatusMsg) {
             std::string vehicleID = msg.header.sender_id;
             std::string platoonID = msg.header.plan_id;
-            std::string statusParams = strategyParams.substr(OPERATION_STATUS_TYPE.size()+1);
             ROS_DEBUG("Receive operation message from vehicle: " , vehicleID);
             std::string SenderBsmId = msg.header.sender_bsm_id;
-            pm_.memberUpdates(vehicleID, platoonID, SenderBsmId, statusParams);
+            pm_.memberUpdates(vehicleID, platoonID, SenderBsmId,
+                              strategy_params_codec::paramsBody<strategy_params_codec::PlatoonStatusParams>(strategyParams));
         } else if(isPlatoonInfoMsg) {
-                if(msg.header.sender_id == pm_.leaderID) {
-                    std::string infoParams = strategyParams.substr(OPERATION_INFO_TYPE.size()+1);
-
-                    std::vector<std::string> parsed_params;
-                    boost::algorithm::split(parsed_params, infoParams, boost::is_any_of(","));
-                    std::vector<std::string> parsed_size;
-                    boost::algorithm::split(parsed_size, parsed_params[3], boost::is_any_of(":"));
-
-                    pm_.platoonSize = std::stoi(parsed_size[1]);
+                strategy_params_codec::PlatoonInfoParams info;
+                if(msg.header.sender_id == pm_.leaderID && strategy_params_codec::decode(strategyParams, info)) {
+                    pm_.platoonSize = info.size;
 
                     ROS_DEBUG("Update from the lead: the current platoon size is " , pm_.getTotalPlatooningSize());
                 }
@@ -198,23 +190,15 @@ namespace platoon_strategic
             std::string applicantId = msg.header.sender_id;
             ROS_DEBUG("Receive mobility JOIN request from " , applicantId, " and PlanId = " , msg.header.plan_id);
             ROS_DEBUG("The strategy parameters are " , params);
-            // For JOIN_PLATOON_AT_REAR message, the strategy params is defined as "SIZE:xx,SPEED:xx,DTD:xx"
             // TODO In future, we should remove down track distance from this string and use location field in request message
-            
-            std::vector<std::string> parsed_params;
-            boost::algorithm::split(parsed_params, params, boost::is_any_of(","));
-
-            std::vector<std::string> parsed_size;
-            boost::algorithm::split(parsed_size, parsed_params[0], boost::is_any_of(":"));
-            int applicantSize = std::stoi(parsed_size[1]);
-
-            std::vector<std::string> parsed_speed;
-            boost::algorithm::split(parsed_speed, parsed_params[1], boost::is_any_of(":"));
-            double applicantCurrentSpeed = std::stod(parsed_size[1]);
-
-            std::vector<std::string> parsed_dtd;
-            boost::algorithm::split(parsed_dtd, parsed_params[1], boost::is_any_of(":"));
-            double applicantCurrentDtd = std::stod(parsed_size[1]);
+            strategy_params_codec::JoinPlatoonAtRearParams join;
+            if(!strategy_params_codec::decodeBody(params, join)) {
+                ROS_WARN_STREAM("Received JOIN request from " << applicantId << " with invalid params: " << params << ". NACK it.");
+                return MobilityRequestResponse::NACK;
+            }
+            int applicantSize = join.size;
+            double applicantCurrentSpeed = join.speed;
+            double applicantCurrentDtd = join.downtrack;
 
             // Check if we have enough room for that applicant
             int currentPlatoonSize = pm_.getTotalPlatooningSize();
@@ -288,31 +272,27 @@ namespace platoon_strategic
 
     void PlatooningStateMachine::onMobilityOperationMessageLeader(cav_msgs::MobilityOperation &msg)
     {
-        std::string strategyParams = msg.strategy_params;
+        const std::string& strategyParams = msg.strategy_params;
         std::string senderId = msg.header.sender_id;
         std::string platoonId = msg.header.plan_id;
         // In the current state, we care about the INFO heart-beat operation message if we are not currently in
         // a negotiation, and also we need to care about operation from members in our current platoon
 
-        bool isPlatoonInfoMsg = (strategyParams.find(OPERATION_INFO_TYPE) == 0);// = strategyParams.startsWith(PlatooningPlugin.OPERATION_INFO_TYPE);
-        bool isPlatoonStatusMsg = (strategyParams.find(OPERATION_STATUS_TYPE) == 0);;// = strategyParams.startsWith(PlatooningPlugin.OPERATION_STATUS_TYPE);
+        bool isPlatoonInfoMsg = strategy_params_codec::hasPrefix<strategy_params_codec::PlatoonInfoParams>(strategyParams);
+        bool isPlatoonStatusMsg = strategy_params_codec::hasPrefix<strategy_params_codec::PlatoonStatusParams>(strategyParams);
         {
             std::lock_guard<std::mutex> lock(plan_mutex_);
 
             bool isNotInNegotiation = (!current_plan.valid);
             if(isPlatoonInfoMsg && isNotInNegotiation) {
-                // For INFO params, the string format is INFO|REAR:%s,LENGTH:%.2f,SPEED:%.2f,SIZE:%d
                 // TODO In future, we should remove downtrack distance from this string and send XYZ location in ECEF
-                std::vector<std::string> parsed_strategy_params;
-                boost::algorithm::split(parsed_strategy_params, strategyParams, boost::is_any_of(","));
-
-                std::vector<std::string> parsed_BsmId;
-                boost::algorithm::split(parsed_BsmId, parsed_strategy_params[0], boost::is_any_of(":"));
-                std::string rearVehicleBsmId = parsed_BsmId[1];
-
-                std::vector<std::string> parsed_dtd;
-                boost::algorithm::split(parsed_dtd, parsed_strategy_params[4], boost::is_any_of(":"));
-                double rearVehicleDtd = std::stod(parsed_dtd[1]);
+                strategy_params_codec::PlatoonInfoParams info;
+                if(!strategy_params_codec::decode(strategyParams, info)) {
+                    ROS_WARN_STREAM("Ignoring INFO message from " << senderId << " with invalid params: " << strategyParams);
+                    return;
+                }
+                std::string rearVehicleBsmId = info.rear_bsm_id;
+                double rearVehicleDtd = info.rear_downtrack;
                 // We are trying to validate is the platoon rear is right in front of the host vehicle
                 if(isVehicleRightInFront(rearVehicleBsmId, rearVehicleDtd)) {
                     ROS_DEBUG("Found a platoon with id = " , platoonId , " in front of us.");
@@ -327,17 +307,11 @@ namespace platoon_strategic
                     request.strategy = MOBILITY_STRATEGY;
 
 
-                    double total_platoon_size = pm_.getTotalPlatooningSize();
-                    double current_speed = pm_.current_speed_;
-                    double current_downtrack = pm_.getCurrentDowntrackDistance();
-
-                    boost::format fmter(JOIN_AT_REAR_PARAMS);
-                    fmter %total_platoon_size;
-                    fmter %current_speed;
-                    fmter %current_downtrack;
- 
-                    std::string strategyParamsString = fmter.str(); 
-                    request.strategy_params = strategyParamsString;
+                    strategy_params_codec::JoinPlatoonAtRearParams join;
+                    join.size = pm_.getTotalPlatooningSize();
+                    join.speed = pm_.current_speed_;
+                    join.downtrack = pm_.getCurrentDowntrackDistance();
+                    strategy_params_codec::encode(join, request.strategy_params);
                     request.urgency = 50;
                     mob_req_pub_.publish(request);
                     PlatoonPlan* new_plan = new PlatoonPlan(true, currentTime, planId, senderId);
@@ -351,11 +325,10 @@ namespace platoon_strategic
                 }
             }
             else if(isPlatoonStatusMsg) {
-                // If it is platoon status message, the params string is in format: STATUS|CMDSPEED:xx,DTD:xx,SPEED:xx
-                std::string statusParams = strategyParams.substr(OPERATION_STATUS_TYPE.size()+1);// = strategyParams.substring(PlatooningPlugin.OPERATION_STATUS_TYPE.length() + 1);
-                ROS_DEBUG("Receive operation status message from vehicle: " , senderId , " with params: " , statusParams);
+                ROS_DEBUG("Receive operation status message from vehicle: " , senderId , " with params: " , strategyParams);
                 std::string SenderBsmId = msg.header.sender_bsm_id;
-                pm_.memberUpdates(senderId, platoonId, SenderBsmId, statusParams);
+                pm_.memberUpdates(senderId, platoonId, SenderBsmId,
+                                  strategy_params_codec::paramsBody<strategy_params_codec::PlatoonStatusParams>(strategyParams));
             }
             else {
                 ROS_DEBUG("Receive operation message but ignore it because isPlatoonInfoMsg = " , isPlatoonInfoMsg 
@@ -390,15 +363,14 @@ namespace platoon_strategic
     void PlatooningStateMachine::onMobilityOperationMessageLeaderWaiting(cav_msgs::MobilityOperation &msg)
     {
         // We still need to handle STATUS operation message from our platoon
-        std::string strategyParams = msg.strategy_params;
-        std::string OPERATION_STATUS_TYPE;
-        bool isPlatoonStatusMsg = (strategyParams.find(OPERATION_STATUS_TYPE) == 0); 
+        const std::string& strategyParams = msg.strategy_params;
+        bool isPlatoonStatusMsg = strategy_params_codec::hasPrefix<strategy_params_codec::PlatoonStatusParams>(strategyParams);
         if (isPlatoonStatusMsg){
             std::string vehicleID = msg.header.sender_id;
             std::string platoonID = msg.header.plan_id;
-            std::string statusParams = strategyParams.substr(OPERATION_STATUS_TYPE.size()+1); 
             std::string SenderBsmId = msg.header.sender_bsm_id;
-            pm_.memberUpdates(vehicleID, platoonID, SenderBsmId, statusParams);
+            pm_.memberUpdates(vehicleID, platoonID, SenderBsmId,
+                              strategy_params_codec::paramsBody<strategy_params_codec::PlatoonStatusParams>(strategyParams));
             ROS_DEBUG("Received platoon status message from " , msg.header.sender_id);
         }
         else
@@ -449,15 +421,14 @@ namespace platoon_strategic
     void PlatooningStateMachine::onMobilityOperationMessageCandidateFollower(cav_msgs::MobilityOperation &msg)
     {
         // We still need to handle STATUS operAtion message from our platoon
-        std::string strategyParams = msg.strategy_params;
-        std::string OPERATION_STATUS_TYPE;
-        bool isPlatoonStatusMsg = (strategyParams.find(OPERATION_STATUS_TYPE) == 0);
+        const std::string& strategyParams = msg.strategy_params;
+        bool isPlatoonStatusMsg = strategy_params_codec::hasPrefix<strategy_params_codec::PlatoonStatusParams>(strategyParams);
         if (isPlatoonStatusMsg){
             std::string vehicleId = msg.header.sender_id;
             std::string platoonId = msg.header.plan_id;
-            std::string statusParams = strategyParams.substr(OPERATION_STATUS_TYPE.size()+1);
             std::string SenderBsmId = msg.header.sender_bsm_id;
-            pm_.memberUpdates(vehicleId, platoonId, SenderBsmId, statusParams);
+            pm_.memberUpdates(vehicleId, platoonId, SenderBsmId,
+                              strategy_params_codec::paramsBody<strategy_params_codec::PlatoonStatusParams>(strategyParams));
             ROS_DEBUG("Received platoon status message from " , vehicleId);
         }
         else {
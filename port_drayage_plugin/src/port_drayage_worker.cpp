@@ -16,8 +16,7 @@
 
 #include "port_drayage_plugin/port_drayage_worker.h"
 #include "ros/ros.h"
-#include <boost/property_tree/ptree.hpp>
-#include <boost/property_tree/json_parser.hpp>
+#include <strategy_params_codec/message_schemas.h>
 
 namespace port_drayage_plugin
 {
@@ -78,15 +77,11 @@ namespace port_drayage_plugin
 
         msg.strategy = PORT_DRAYAGE_STRATEGY_ID;
 
-        // Encode JSON with Boost Property Tree
-        using boost::property_tree::ptree;
-        ptree pt;
-        pt.put("cmv_id", _cmv_id);
-        pt.put("cargo_id", _cargo_id);
-        pt.put("operation", PORT_DRAYAGE_ARRIVAL_OPERATION_ID);
-        std::stringstream body_stream;
-        boost::property_tree::json_parser::write_json(body_stream, pt);
-        msg.strategy_params = body_stream.str();
+        strategy_params_codec::PortDrayageArrivalParams params;
+        params.cmv_id = _cmv_id;
+        params.cargo_id = _cargo_id;
+        params.operation = PORT_DRAYAGE_ARRIVAL_OPERATION_ID;
+        strategy_params_codec::encode(params, msg.strategy_params);
 
         return msg;
     }
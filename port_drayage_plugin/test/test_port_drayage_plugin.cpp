@@ -20,6 +20,7 @@
 #include <ros/ros.h>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
+#include <strategy_params_codec/message_schemas.h>
 #include <sstream>
 
 TEST(PortDrayageTest, testComposeArrivalMessage)
@@ -50,6 +51,16 @@ TEST(PortDrayageTest, testComposeArrivalMessage)
     ASSERT_EQ("TEST_ID", cmv_id);
     ASSERT_EQ("TEST_CARGO_ID", cargo_id);
     ASSERT_EQ("ARRIVED_AT_DESTINATION", operation);
+
+    // the shared codec writes compact JSON
+    ASSERT_EQ("{\"cmv_id\":\"TEST_ID\",\"cargo_id\":\"TEST_CARGO_ID\",\"operation\":\"ARRIVED_AT_DESTINATION\"}",
+              msg.strategy_params);
+
+    strategy_params_codec::PortDrayageArrivalParams params;
+    ASSERT_TRUE(strategy_params_codec::decode(msg.strategy_params, params));
+    ASSERT_EQ("TEST_ID", params.cmv_id);
+    ASSERT_EQ("TEST_CARGO_ID", params.cargo_id);
+    ASSERT_EQ("ARRIVED_AT_DESTINATION", params.operation);
 }
 
 TEST(PortDrayageTest, testCheckStop1)
@@ -33,7 +33,7 @@
 #include "autoware_config_msgs/ConfigWaypointFollower.h"
 #include "autoware_msgs/ControlCommandStamped.h"
 
-#include "pure_pursuit_wrapper_worker.hpp"
+#include <trajectory_utils/trajectory_to_waypoints.h>
 
 namespace pure_pursuit_wrapper {
 
@@ -85,7 +85,9 @@ class PurePursuitWrapper {
         ros::Publisher way_points_pub_;
         ros::Publisher system_alert_pub_;
 
-        PurePursuitWrapperWorker ppww;
+        // @brief Batch trajectory converter and the lane message it reuses between trajectories
+        trajectory_utils::TrajectoryToWaypoints trajectory_converter_;
+        autoware_msgs::Lane lane_;
 
         /*!
         * Reads and verifies the ROS parameters.
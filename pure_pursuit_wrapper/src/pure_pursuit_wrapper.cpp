@@ -55,20 +55,8 @@ bool PurePursuitWrapper::ReadParameters() {
 void PurePursuitWrapper::TrajectoryPlanPoseHandler(const geometry_msgs::PoseStamped::ConstPtr& pose, const cav_msgs::TrajectoryPlan::ConstPtr& tp){
   ROS_DEBUG_STREAM("Received TrajectoryPlanCurrentPosecallback message");
     try {
-      autoware_msgs::Lane lane;
-      lane.header = tp->header;
-      std::vector <autoware_msgs::Waypoint> waypoints;
-      double current_time = ros::Time::now().toSec();
-      for(int i = 0; i < tp->trajectory_points.size() - 1; i++ ) {
-
-        cav_msgs::TrajectoryPlanPoint t1 = tp->trajectory_points[i];
-        cav_msgs::TrajectoryPlanPoint t2 = tp->trajectory_points[i + 1];
-        autoware_msgs::Waypoint waypoint = ppww.TrajectoryPlanPointToWaypointConverter(current_time, *pose,t1, t2);
-        waypoints.push_back(waypoint);
-      }
-
-      lane.waypoints = waypoints;
-      PublisherForWayPoints(lane);
+      trajectory_converter_.convert(*tp, lane_);
+      PublisherForWayPoints(lane_);
     }
     catch(const std::exception& e) {
       HandleException(e);
@@ -26,7 +26,9 @@
 #include <cav_srvs/StartActiveRoute.h>
 #include <cav_srvs/AbortActiveRoute.h>
 #include <carma_utils/CARMAUtils.h>
+#include <autoware_msgs/Lane.h>
 #include "boost/filesystem.hpp"
+#include "route_library.h"
 
 class RouteGenerator
 {
@@ -42,6 +44,9 @@ public:
     // read file names in the given route path
     static std::vector<std::string> read_route_names(const std::string& route_path);
 
+    // convert a parsed route to the waypoint message consumed by the planning stack
+    static autoware_msgs::Lane route_to_lane(const ParsedRoute& route);
+
     // check the status of the selected route file
     bool is_route_active ();
 
@@ -58,6 +63,21 @@ private:
 
     // publisher for waypoint loader full file path
     ros::Publisher  route_file_path_pub_;
+
+    // publisher for the parsed waypoints of the selected route
+    ros::Publisher  route_waypoints_pub_;
+
+    // publisher for the path of the binary form of the selected route
+    ros::Publisher  route_binary_path_pub_;
+
+    // routes parsed at startup and refreshed when the route directory changes
+    std::unique_ptr<RouteLibrary> route_library_;
+
+    // directory the binary routes are written to, empty if disabled. Created if missing
+    std::string route_binary_path_;
+
+    // timer which checks the route directory for changes
+    ros::Timer route_scan_timer_;
     
     // route service servers
     ros::ServiceServer get_available_route_srv_;
@@ -71,6 +91,15 @@ private:
     bool start_active_route_cb(cav_srvs::StartActiveRouteRequest &req, cav_srvs::StartActiveRouteResponse &resp);
     bool abort_active_route_cb(cav_srvs::AbortActiveRouteRequest &req, cav_srvs::AbortActiveRouteResponse &resp);
 
+    // reload changed route files, write the binary form of changed routes and delete those of removed routes
+    void refresh_routes();
+
+    // create the binary route folder and delete the binary routes left in it by a previous run
+    void prepare_route_binary_folder();
+
+    // path of the binary form of a route
+    std::string route_binary_file(const std::string& route_id) const;
+
     // initialize this node
     void initialize();
 
@@ -0,0 +1,109 @@
+#pragma once
+
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Parsed contents of a route csv file. Each column is held in its own contiguous array
+struct ParsedRoute
+{
+    std::string route_id;
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+    std::vector<double> yaw;
+    std::vector<double> velocity;
+    std::vector<int32_t> change_flag;
+
+    size_t size() const;
+};
+
+enum class RouteParseResult
+{
+    // the waypoints were parsed into the route
+    PARSED,
+    // the file does not start with a header naming the x,y,z,yaw and velocity columns, such as the headerless
+    // ver1 and ver2 waypoint_loader layouts. It is left to waypoint_loader as before
+    UNRECOGNIZED,
+    // the file cannot be read or is malformed
+    INVALID,
+};
+
+// parse and validate a route csv file whose header names its columns. The x,y,z,yaw and velocity columns are
+// required, change_flag defaults to 0 and other columns are ignored. Sets error unless the route was parsed
+RouteParseResult parse_route_csv(const std::string& file_path, ParsedRoute& route, std::string& error);
+
+// write the route to a binary file which can be read without parsing. The file is written next to the target and
+// renamed into place so readers never observe a partially written route. Placing it under /dev/shm keeps it in shared memory
+bool write_route_binary(const ParsedRoute& route, const std::string& file_path);
+
+// read a route written by write_route_binary
+bool read_route_binary(const std::string& file_path, ParsedRoute& route);
+
+// Routes of a directory parsed once and kept in memory. The directory is only re-read for files which were
+// added, removed or modified since the last refresh
+class RouteLibrary
+{
+
+public:
+
+    explicit RouteLibrary(const std::string& route_path);
+
+    // check the directory for changes and parse new or modified route files
+    // returns true if the set of routes changed
+    bool refresh();
+
+    // ids of all route files in the directory, valid or not, in alphabetical order
+    std::vector<std::string> get_route_ids() const;
+
+    // ids of the routes added or modified by the last refresh
+    const std::vector<std::string>& get_changed_route_ids() const;
+
+    // ids of the routes whose file was removed by the last refresh
+    const std::vector<std::string>& get_removed_route_ids() const;
+
+    // the parsed route or nullptr if the route does not exist, failed validation or is in an unrecognized format
+    std::shared_ptr<const ParsedRoute> get_route(const std::string& route_id) const;
+
+    // true if the route exists and did not fail validation. Routes in an unrecognized format are valid but not parsed
+    bool is_route_valid(const std::string& route_id) const;
+
+    // validation error of the route or an empty string if it is valid
+    std::string get_route_error(const std::string& route_id) const;
+
+private:
+
+    struct RouteEntry
+    {
+        std::time_t last_write_time {0};
+        uintmax_t file_size {0};
+        std::shared_ptr<const ParsedRoute> route;
+        // empty unless the route failed validation
+        std::string error;
+    };
+
+    std::string route_path_;
+    std::map<std::string, RouteEntry> routes_;
+    std::vector<std::string> changed_route_ids_;
+    std::vector<std::string> removed_route_ids_;
+
+};
@@ -17,6 +17,7 @@
 #include <ros/ros.h>
 
 #include "route_generator.h"
+#include <cmath>
 
 RouteGenerator::RouteGenerator(){}
 
@@ -27,7 +28,23 @@ void RouteGenerator::initialize()
     nh_.reset(new ros::CARMANodeHandle());
     pnh_.reset(new ros::CARMANodeHandle("~"));
     pnh_->getParam("route_file_path", route_file_path_);
+    pnh_->param<std::string>("route_binary_path", route_binary_path_, "");
+    if(!route_binary_path_.empty())
+    {
+        prepare_route_binary_folder();
+    }
+    double route_scan_period = 2.0;
+    pnh_->param<double>("route_scan_period", route_scan_period, route_scan_period);
     route_file_path_pub_ = nh_->advertise<std_msgs::String>("selected_route_path", 1);
+    route_waypoints_pub_ = nh_->advertise<autoware_msgs::Lane>("selected_route_waypoints", 1, true);
+    route_binary_path_pub_ = nh_->advertise<std_msgs::String>("selected_route_binary_path", 1, true);
+    // parse all routes once at startup
+    route_library_.reset(new RouteLibrary(route_file_path_));
+    refresh_routes();
+    if(route_scan_period > 0)
+    {
+        route_scan_timer_ = nh_->createTimer(ros::Duration(route_scan_period), [this](const ros::TimerEvent&) { refresh_routes(); });
+    }
     get_available_route_srv_ = nh_->advertiseService("get_available_routes", &RouteGenerator::get_available_route_cb, this);
     set_active_route_srv_ = nh_->advertiseService("set_active_route", &RouteGenerator::set_active_route_cb, this);
     start_active_route_srv_ = nh_->advertiseService("start_active_route", &RouteGenerator::start_active_route_cb, this);
@@ -40,16 +57,82 @@ void RouteGenerator::run()
     ros::CARMANodeHandle::spin();
 }
 
+void RouteGenerator::prepare_route_binary_folder()
+{
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(route_binary_path_, ec);
+    if(ec)
+    {
+        ROS_WARN_STREAM("Failed to create binary route folder " << route_binary_path_ << ": " << ec.message() << ". Binary routes are disabled");
+        route_binary_path_.clear();
+        return;
+    }
+
+    // routes of a previous run may have been removed since, every current route is written again by the first refresh
+    boost::filesystem::directory_iterator end_point;
+    for(boost::filesystem::directory_iterator itr(route_binary_path_, ec); !ec && itr != end_point; itr.increment(ec))
+    {
+        if(itr->path().extension() == ".bin")
+        {
+            boost::system::error_code remove_ec;
+            boost::filesystem::remove(itr->path(), remove_ec);
+        }
+    }
+}
+
+std::string RouteGenerator::route_binary_file(const std::string& route_id) const
+{
+    return (boost::filesystem::path(route_binary_path_) / (route_id + ".bin")).generic_string();
+}
+
+void RouteGenerator::refresh_routes()
+{
+    if(!route_library_->refresh())
+    {
+        return;
+    }
+
+    boost::system::error_code ec;
+    for(const auto& route_id : route_library_->get_removed_route_ids())
+    {
+        if(!route_binary_path_.empty())
+        {
+            boost::filesystem::remove(route_binary_file(route_id), ec);
+        }
+    }
+
+    // only routes which were added or modified need their binary form written
+    for(const auto& route_id : route_library_->get_changed_route_ids())
+    {
+        if(!route_library_->is_route_valid(route_id))
+        {
+            ROS_WARN_STREAM("Route " << route_id << " is invalid: " << route_library_->get_route_error(route_id));
+        }
+        auto route = route_library_->get_route(route_id);
+        if(route_binary_path_.empty())
+        {
+            continue;
+        }
+        if(!route)
+        {
+            // the previous version of the route may have been parsed
+            boost::filesystem::remove(route_binary_file(route_id), ec);
+        }
+        else if(!write_route_binary(*route, route_binary_file(route_id)))
+        {
+            ROS_WARN_STREAM("Failed to write binary route " << route_binary_file(route_id));
+        }
+    }
+}
+
 bool RouteGenerator::get_available_route_cb(cav_srvs::GetAvailableRoutesRequest &req, cav_srvs::GetAvailableRoutesResponse &resp)
 {
-    std::vector<std::string> route_ids = RouteGenerator::read_route_names(route_file_path_);
-    for(int i = 0; i < route_ids.size(); ++i)
+    for(const auto& route_name : route_library_->get_route_ids())
     {
-        std::string route_name = route_ids[i].substr(0, route_ids[i].find(".csv"));
         cav_msgs::Route route_msg;
         route_msg.routeID = route_name;
         route_msg.routeName = route_name;
-        route_msg.valid = true;
+        route_msg.valid = route_library_->is_route_valid(route_name);
         resp.availableRoutes.push_back(route_msg);
     }
     return true;
@@ -69,11 +152,26 @@ bool RouteGenerator::set_active_route_cb(cav_srvs::SetActiveRouteRequest &req, c
             return true;
         }
 
-        route_file_name = route_file_name + ".csv";
+        if (!route_library_->is_route_valid(route_file_name)) {
+            ROS_WARN_STREAM("Route " << route_file_name << " is not available: " << route_library_->get_route_error(route_file_name));
+            resp.errorStatus = cav_srvs::SetActiveRouteResponse::NO_ROUTE;
+            return true;
+        }
 
         std_msgs::String selected_route_file_path;
-        selected_route_file_path.data = route_file_path_ + route_file_name;
+        selected_route_file_path.data = route_file_path_ + route_file_name + ".csv";
         route_file_path_pub_.publish(selected_route_file_path);
+
+        // serve the already parsed route so consumers do not need to parse the file again. Routes in a format which
+        // is only understood by waypoint_loader publish empty waypoints and binary path so no stale route stays latched
+        auto route = route_library_->get_route(route_file_name);
+        route_waypoints_pub_.publish(route ? route_to_lane(*route) : autoware_msgs::Lane());
+        if(!route_binary_path_.empty())
+        {
+            std_msgs::String binary_path;
+            binary_path.data = route ? route_binary_file(route_file_name) : "";
+            route_binary_path_pub_.publish(binary_path);
+        }
         resp.errorStatus = cav_srvs::SetActiveRouteResponse::NO_ERROR;
     }
     else
@@ -134,6 +232,28 @@ std::vector<std::string> RouteGenerator::read_route_names(const std::string& rou
     return route_names;
 }
 
+autoware_msgs::Lane RouteGenerator::route_to_lane(const ParsedRoute& route)
+{
+    autoware_msgs::Lane lane;
+    lane.header.frame_id = "map";
+    lane.waypoints.resize(route.size());
+    for(size_t i = 0; i < route.size(); ++i)
+    {
+        autoware_msgs::Waypoint& wp = lane.waypoints[i];
+        wp.gid = i;
+        wp.lid = i;
+        wp.pose.pose.position.x = route.x[i];
+        wp.pose.pose.position.y = route.y[i];
+        wp.pose.pose.position.z = route.z[i];
+        wp.pose.pose.orientation.z = std::sin(route.yaw[i] / 2.0);
+        wp.pose.pose.orientation.w = std::cos(route.yaw[i] / 2.0);
+        // route files hold velocities in km/h as read by waypoint_loader
+        wp.twist.twist.linear.x = route.velocity[i] / 3.6;
+        wp.change_flag = route.change_flag[i];
+    }
+    return lane;
+}
+
 bool RouteGenerator::is_route_active ()
 {
     return route_is_active_;
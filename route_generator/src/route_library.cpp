@@ -0,0 +1,341 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "route_library.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include "boost/filesystem.hpp"
+
+namespace
+{
+    // columns every parsed route needs, in the order of the values they are read into
+    const char* const REQUIRED_COLUMNS[] = { "x", "y", "z", "yaw", "velocity" };
+    const size_t REQUIRED_COLUMN_COUNT = sizeof(REQUIRED_COLUMNS) / sizeof(REQUIRED_COLUMNS[0]);
+    const char CHANGE_FLAG_COLUMN[] = "change_flag";
+    const char ROUTE_BINARY_MAGIC[8] = { 'C', 'A', 'R', 'M', 'A', 'R', 'T', 'E' };
+    const uint32_t ROUTE_BINARY_VERSION = 1;
+
+    struct RouteBinaryHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t id_length;
+        uint64_t point_count;
+    };
+
+    void strip_line_ending(std::string& line)
+    {
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' '))
+        {
+            line.pop_back();
+        }
+    }
+
+    // split a csv line into its fields with surrounding spaces removed
+    std::vector<std::string> split_fields(const std::string& line)
+    {
+        std::vector<std::string> fields;
+        std::stringstream stream(line);
+        std::string field;
+        while (std::getline(stream, field, ','))
+        {
+            size_t first = field.find_first_not_of(' ');
+            size_t last = field.find_last_not_of(' ');
+            fields.push_back(first == std::string::npos ? "" : field.substr(first, last - first + 1));
+        }
+        if (!line.empty() && line.back() == ',')
+        {
+            fields.push_back("");
+        }
+        return fields;
+    }
+
+    bool parse_double(const std::string& field, double& value)
+    {
+        char* end = nullptr;
+        value = std::strtod(field.c_str(), &end);
+        return !field.empty() && end == field.c_str() + field.size();
+    }
+
+    bool parse_int(const std::string& field, int32_t& value)
+    {
+        char* end = nullptr;
+        value = static_cast<int32_t>(std::strtol(field.c_str(), &end, 10));
+        return !field.empty() && end == field.c_str() + field.size();
+    }
+
+    template <class T>
+    void write_array(std::ofstream& out, const std::vector<T>& values)
+    {
+        out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+
+    template <class T>
+    bool read_array(std::ifstream& in, std::vector<T>& values, size_t count)
+    {
+        values.resize(count);
+        in.read(reinterpret_cast<char*>(values.data()), count * sizeof(T));
+        return static_cast<bool>(in);
+    }
+}
+
+size_t ParsedRoute::size() const
+{
+    return x.size();
+}
+
+RouteParseResult parse_route_csv(const std::string& file_path, ParsedRoute& route, std::string& error)
+{
+    std::ifstream in(file_path);
+    if (!in)
+    {
+        error = "could not open file";
+        return RouteParseResult::INVALID;
+    }
+
+    std::string line;
+    if (!std::getline(in, line))
+    {
+        error = "file is empty";
+        return RouteParseResult::INVALID;
+    }
+    strip_line_ending(line);
+
+    // like waypoint_loader, a first column containing a digit means the file has no header
+    std::vector<std::string> header = split_fields(line);
+    if (header.empty() || std::any_of(header[0].begin(), header[0].end(), [](unsigned char c) { return std::isdigit(c); }))
+    {
+        error = "no header naming the columns";
+        return RouteParseResult::UNRECOGNIZED;
+    }
+
+    size_t required_index[REQUIRED_COLUMN_COUNT];
+    for (size_t i = 0; i < REQUIRED_COLUMN_COUNT; i++)
+    {
+        auto column = std::find(header.begin(), header.end(), REQUIRED_COLUMNS[i]);
+        if (column == header.end())
+        {
+            error = "header has no " + std::string(REQUIRED_COLUMNS[i]) + " column";
+            return RouteParseResult::UNRECOGNIZED;
+        }
+        required_index[i] = column - header.begin();
+    }
+    auto change_flag_column = std::find(header.begin(), header.end(), CHANGE_FLAG_COLUMN);
+    bool has_change_flag = change_flag_column != header.end();
+    size_t change_flag_index = change_flag_column - header.begin();
+
+    size_t line_number = 1;
+    while (std::getline(in, line))
+    {
+        line_number++;
+        strip_line_ending(line);
+        if (line.empty())
+        {
+            continue;
+        }
+
+        std::vector<std::string> fields = split_fields(line);
+        double values[REQUIRED_COLUMN_COUNT];
+        int32_t change_flag = 0;
+        bool valid = fields.size() == header.size() && (!has_change_flag || parse_int(fields[change_flag_index], change_flag));
+        for (size_t i = 0; valid && i < REQUIRED_COLUMN_COUNT; i++)
+        {
+            valid = parse_double(fields[required_index[i]], values[i]);
+        }
+        if (!valid)
+        {
+            error = "malformed waypoint on line " + std::to_string(line_number);
+            return RouteParseResult::INVALID;
+        }
+
+        route.x.push_back(values[0]);
+        route.y.push_back(values[1]);
+        route.z.push_back(values[2]);
+        route.yaw.push_back(values[3]);
+        route.velocity.push_back(values[4]);
+        route.change_flag.push_back(change_flag);
+    }
+
+    if (route.size() == 0)
+    {
+        error = "route has no waypoints";
+        return RouteParseResult::INVALID;
+    }
+    error.clear();
+    return RouteParseResult::PARSED;
+}
+
+bool write_route_binary(const ParsedRoute& route, const std::string& file_path)
+{
+    RouteBinaryHeader header;
+    std::memcpy(header.magic, ROUTE_BINARY_MAGIC, sizeof(header.magic));
+    header.version = ROUTE_BINARY_VERSION;
+    header.id_length = route.route_id.size();
+    header.point_count = route.size();
+
+    std::string tmp_path = file_path + ".tmp." + std::to_string(getpid());
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(route.route_id.data(), route.route_id.size());
+        write_array(out, route.x);
+        write_array(out, route.y);
+        write_array(out, route.z);
+        write_array(out, route.yaw);
+        write_array(out, route.velocity);
+        write_array(out, route.change_flag);
+        if (!out)
+        {
+            std::remove(tmp_path.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(tmp_path.c_str(), file_path.c_str()) != 0)
+    {
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool read_route_binary(const std::string& file_path, ParsedRoute& route)
+{
+    std::ifstream in(file_path, std::ios::binary);
+    RouteBinaryHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, ROUTE_BINARY_MAGIC, sizeof(header.magic)) != 0 || header.version != ROUTE_BINARY_VERSION)
+    {
+        return false;
+    }
+
+    route.route_id.resize(header.id_length);
+    if (!in.read(&route.route_id[0], header.id_length))
+    {
+        return false;
+    }
+
+    size_t count = header.point_count;
+    return read_array(in, route.x, count) && read_array(in, route.y, count) && read_array(in, route.z, count) &&
+           read_array(in, route.yaw, count) && read_array(in, route.velocity, count) &&
+           read_array(in, route.change_flag, count);
+}
+
+RouteLibrary::RouteLibrary(const std::string& route_path) : route_path_(route_path) {}
+
+bool RouteLibrary::refresh()
+{
+    changed_route_ids_.clear();
+    removed_route_ids_.clear();
+    std::map<std::string, RouteEntry> current;
+
+    boost::filesystem::path route_path_object(route_path_);
+    boost::system::error_code ec;
+    if (boost::filesystem::is_directory(route_path_object, ec))
+    {
+        boost::filesystem::directory_iterator end_point;
+        for (boost::filesystem::directory_iterator itr(route_path_object, ec); !ec && itr != end_point; itr.increment(ec))
+        {
+            const boost::filesystem::path& file = itr->path();
+            if (boost::filesystem::is_directory(itr->status()) || file.extension() != ".csv")
+            {
+                continue;
+            }
+
+            std::string route_id = file.stem().generic_string();
+            RouteEntry entry;
+            entry.last_write_time = boost::filesystem::last_write_time(file, ec);
+            entry.file_size = boost::filesystem::file_size(file, ec);
+
+            auto existing = routes_.find(route_id);
+            if (existing != routes_.end() && existing->second.last_write_time == entry.last_write_time &&
+                existing->second.file_size == entry.file_size)
+            {
+                current.emplace(route_id, existing->second); // Unchanged, keep the parsed route
+                continue;
+            }
+
+            auto route = std::make_shared<ParsedRoute>();
+            route->route_id = route_id;
+            std::string error;
+            RouteParseResult result = parse_route_csv(file.generic_string(), *route, error);
+            if (result == RouteParseResult::PARSED)
+            {
+                entry.route = route;
+            } else if (result == RouteParseResult::INVALID)
+            {
+                entry.error = error;
+            }
+            current.emplace(route_id, entry);
+            changed_route_ids_.push_back(route_id);
+        }
+    }
+
+    for (const auto& entry : routes_)
+    {
+        if (current.find(entry.first) == current.end())
+        {
+            removed_route_ids_.push_back(entry.first);
+        }
+    }
+
+    routes_.swap(current);
+    return !changed_route_ids_.empty() || !removed_route_ids_.empty();
+}
+
+std::vector<std::string> RouteLibrary::get_route_ids() const
+{
+    std::vector<std::string> route_ids;
+    for (const auto& entry : routes_)
+    {
+        route_ids.push_back(entry.first);
+    }
+    return route_ids;
+}
+
+const std::vector<std::string>& RouteLibrary::get_changed_route_ids() const
+{
+    return changed_route_ids_;
+}
+
+const std::vector<std::string>& RouteLibrary::get_removed_route_ids() const
+{
+    return removed_route_ids_;
+}
+
+bool RouteLibrary::is_route_valid(const std::string& route_id) const
+{
+    auto entry = routes_.find(route_id);
+    return entry != routes_.end() && entry->second.error.empty();
+}
+
+std::shared_ptr<const ParsedRoute> RouteLibrary::get_route(const std::string& route_id) const
+{
+    auto entry = routes_.find(route_id);
+    return entry == routes_.end() ? nullptr : entry->second.route;
+}
+
+std::string RouteLibrary::get_route_error(const std::string& route_id) const
+{
+    auto entry = routes_.find(route_id);
+    return entry == routes_.end() ? "route does not exist" : entry->second.error;
+}
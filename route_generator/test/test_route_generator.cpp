@@ -15,8 +15,11 @@
  */
 
 #include "route_generator.h"
+#include "route_library.h"
 #include <gtest/gtest.h>
 #include <ros/ros.h>
+#include <cstdio>
+#include <fstream>
 
 TEST(RouteGeneratorTest, testReadFileFunction)
 {
@@ -34,6 +37,164 @@ TEST(RouteGeneratorTest, testRouteGenerator)
     RouteGenerator rg;
     EXPECT_FALSE(rg.is_route_active());
 }
+TEST(RouteGeneratorTest, testParseRoute)
+{
+    ParsedRoute route;
+    std::string error;
+    ASSERT_EQ(RouteParseResult::PARSED, parse_route_csv("../resource/route3.csv", route, error));
+    ASSERT_EQ(3u, route.size());
+    EXPECT_NEAR(-11.5636, route.x[0], 0.00001);
+    EXPECT_NEAR(7.5534, route.y[1], 0.00001);
+    EXPECT_NEAR(-37.6067, route.z[2], 0.00001);
+    EXPECT_NEAR(-0.4187, route.yaw[1], 0.00001);
+    EXPECT_NEAR(4.0, route.velocity[2], 0.00001);
+    EXPECT_EQ(0, route.change_flag[0]);
+    EXPECT_EQ(1, route.change_flag[2]);
+
+    // empty and missing files are rejected
+    ParsedRoute empty_route;
+    EXPECT_EQ(RouteParseResult::INVALID, parse_route_csv("../resource/route1.csv", empty_route, error));
+    EXPECT_EQ(RouteParseResult::INVALID, parse_route_csv("../resource/missing.csv", empty_route, error));
+
+    // malformed waypoints are rejected
+    {
+        std::ofstream out("malformed_route.csv");
+        out << "x,y,z,yaw,velocity,change_flag\n1,2,3,4,5,0\n1,2,three,4,5,0\n";
+    }
+    ParsedRoute malformed_route;
+    EXPECT_EQ(RouteParseResult::INVALID, parse_route_csv("malformed_route.csv", malformed_route, error));
+    EXPECT_EQ("malformed waypoint on line 3", error);
+    std::remove("malformed_route.csv");
+
+    // columns are found by name, unknown columns are ignored and change_flag is optional
+    {
+        std::ofstream out("named_columns_route.csv");
+        out << "velocity,yaw,steering_flag,z,y,x\n5,0.5,1,3,2,1\n6,0.6,0,3.5,2.5,1.5\n";
+    }
+    ParsedRoute named_route;
+    ASSERT_EQ(RouteParseResult::PARSED, parse_route_csv("named_columns_route.csv", named_route, error));
+    ASSERT_EQ(2u, named_route.size());
+    EXPECT_NEAR(1.5, named_route.x[1], 0.00001);
+    EXPECT_NEAR(2.0, named_route.y[0], 0.00001);
+    EXPECT_NEAR(3.5, named_route.z[1], 0.00001);
+    EXPECT_NEAR(0.5, named_route.yaw[0], 0.00001);
+    EXPECT_NEAR(6.0, named_route.velocity[1], 0.00001);
+    EXPECT_EQ(0, named_route.change_flag[0]);
+    std::remove("named_columns_route.csv");
+
+    // headerless waypoint_loader layouts and headers without the required columns are left to waypoint_loader
+    {
+        std::ofstream out("ver1_route.csv");
+        out << "1,2,3\n4,5,6,10\n";
+    }
+    ParsedRoute ver1_route;
+    EXPECT_EQ(RouteParseResult::UNRECOGNIZED, parse_route_csv("ver1_route.csv", ver1_route, error));
+    std::remove("ver1_route.csv");
+    {
+        std::ofstream out("unknown_header_route.csv");
+        out << "x,y,z,velocity\n1,2,3,4\n";
+    }
+    ParsedRoute unknown_header_route;
+    EXPECT_EQ(RouteParseResult::UNRECOGNIZED, parse_route_csv("unknown_header_route.csv", unknown_header_route, error));
+    std::remove("unknown_header_route.csv");
+
+    // lane conversion
+    autoware_msgs::Lane lane = RouteGenerator::route_to_lane(route);
+    ASSERT_EQ(3u, lane.waypoints.size());
+    EXPECT_NEAR(-10.6099, lane.waypoints[1].pose.pose.position.x, 0.00001);
+    EXPECT_NEAR(3.0 / 3.6, lane.waypoints[1].twist.twist.linear.x, 0.00001);
+    EXPECT_EQ(1, lane.waypoints[2].change_flag);
+}
+
+TEST(RouteGeneratorTest, testRouteBinary)
+{
+    ParsedRoute route;
+    std::string error;
+    ASSERT_EQ(RouteParseResult::PARSED, parse_route_csv("../resource/route3.csv", route, error));
+    route.route_id = "route3";
+
+    ASSERT_TRUE(write_route_binary(route, "route3.bin"));
+    ParsedRoute loaded;
+    ASSERT_TRUE(read_route_binary("route3.bin", loaded));
+    EXPECT_EQ("route3", loaded.route_id);
+    EXPECT_EQ(route.x, loaded.x);
+    EXPECT_EQ(route.y, loaded.y);
+    EXPECT_EQ(route.z, loaded.z);
+    EXPECT_EQ(route.yaw, loaded.yaw);
+    EXPECT_EQ(route.velocity, loaded.velocity);
+    EXPECT_EQ(route.change_flag, loaded.change_flag);
+    std::remove("route3.bin");
+
+    EXPECT_FALSE(read_route_binary("../resource/route3.csv", loaded));
+}
+
+TEST(RouteGeneratorTest, testRouteLibrary)
+{
+    RouteLibrary library("../resource/");
+    ASSERT_TRUE(library.refresh());
+    std::vector<std::string> route_ids = library.get_route_ids();
+    ASSERT_EQ(3u, route_ids.size());
+    EXPECT_EQ("route1", route_ids[0]);
+    EXPECT_EQ("route3", route_ids[2]);
+
+    EXPECT_EQ(3u, library.get_changed_route_ids().size());
+    EXPECT_FALSE(library.get_route("route1"));
+    EXPECT_FALSE(library.is_route_valid("route1"));
+    EXPECT_FALSE(library.get_route_error("route1").empty());
+    EXPECT_TRUE(library.is_route_valid("route3"));
+    ASSERT_TRUE(library.get_route("route3"));
+    EXPECT_EQ(3u, library.get_route("route3")->size());
+    EXPECT_FALSE(library.get_route("missing"));
+
+    // nothing changed so the routes are not parsed again
+    auto route = library.get_route("route3");
+    EXPECT_FALSE(library.refresh());
+    EXPECT_EQ(route, library.get_route("route3"));
+    EXPECT_TRUE(library.get_changed_route_ids().empty());
+}
+
+TEST(RouteGeneratorTest, testRouteLibraryChanges)
+{
+    boost::filesystem::path route_dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    ASSERT_TRUE(boost::filesystem::create_directories(route_dir));
+    {
+        std::ofstream out((route_dir / "route_a.csv").string());
+        out << "x,y,z,yaw,velocity,change_flag\n1,2,3,4,5,0\n";
+    }
+    {
+        std::ofstream out((route_dir / "route_b.csv").string());
+        out << "1,2,3\n4,5,6,10\n";
+    }
+
+    RouteLibrary library(route_dir.string());
+    ASSERT_TRUE(library.refresh());
+    EXPECT_EQ(2u, library.get_changed_route_ids().size());
+    EXPECT_TRUE(library.get_removed_route_ids().empty());
+
+    // routes only waypoint_loader understands are valid but not parsed
+    EXPECT_TRUE(library.is_route_valid("route_b"));
+    EXPECT_FALSE(library.get_route("route_b"));
+    EXPECT_TRUE(library.get_route_error("route_b").empty());
+
+    // only the modified route is reported
+    {
+        std::ofstream out((route_dir / "route_a.csv").string());
+        out << "x,y,z,yaw,velocity,change_flag\n1,2,3,4,5,0\n6,7,8,9,10,0\n";
+    }
+    ASSERT_TRUE(library.refresh());
+    ASSERT_EQ(1u, library.get_changed_route_ids().size());
+    EXPECT_EQ("route_a", library.get_changed_route_ids()[0]);
+    EXPECT_EQ(2u, library.get_route("route_a")->size());
+
+    boost::filesystem::remove(route_dir / "route_b.csv");
+    ASSERT_TRUE(library.refresh());
+    EXPECT_TRUE(library.get_changed_route_ids().empty());
+    ASSERT_EQ(1u, library.get_removed_route_ids().size());
+    EXPECT_EQ("route_b", library.get_removed_route_ids()[0]);
+
+    boost::filesystem::remove_all(route_dir);
+}
+
 // Run all the tests
 int main(int argc, char **argv)
 {
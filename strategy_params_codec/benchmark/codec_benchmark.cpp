@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <sstream>
+#include <boost/algorithm/string.hpp>
+#include <boost/format.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <strategy_params_codec/message_schemas.h>
+
+namespace strategy_params_codec
+{
+namespace
+{
+PortDrayageArrivalParams arrivalParams()
+{
+  PortDrayageArrivalParams params;
+  params.cmv_id = "DOT-80550";
+  params.cargo_id = "SOME_CARGO";
+  params.operation = "ARRIVED_AT_DESTINATION";
+  return params;
+}
+
+TruckInspectionResponseParams inspectionParams()
+{
+  TruckInspectionResponseParams params;
+  params.vin_number = "1FUJGBDV8CLBP8834";
+  params.license_plate = "DOT-10003";
+  params.carrier_name = "FMCSA Tech Division";
+  params.carrier_id = "USDOT 0000001";
+  params.weight = 20000;
+  params.ads_software_version = "System Version Unknown";
+  params.date_of_last_state_inspection = "2020.01.20";
+  params.date_of_last_ads_calibration = "2020.02.20";
+  params.pre_trip_ads_health_check = "Green";
+  params.ads_health_status = "1";
+  params.ads_auto_status = "Engaged";
+  params.iss_score = 90;
+  params.permit_required = false;
+  return params;
+}
+}  // namespace
+
+// Port drayage arrival message as previously built with a property tree
+static void BM_ArrivalEncodePropertyTree(benchmark::State& state)
+{
+  auto params = arrivalParams();
+  std::string out;
+  for (auto _ : state)
+  {
+    boost::property_tree::ptree pt;
+    pt.put("cmv_id", params.cmv_id);
+    pt.put("cargo_id", params.cargo_id);
+    pt.put("operation", params.operation);
+    std::stringstream body_stream;
+    boost::property_tree::json_parser::write_json(body_stream, pt);
+    out = body_stream.str();
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.counters["bytes"] = out.size();
+}
+BENCHMARK(BM_ArrivalEncodePropertyTree);
+
+static void BM_ArrivalEncodeCodec(benchmark::State& state)
+{
+  auto params = arrivalParams();
+  std::string out;
+  for (auto _ : state)
+  {
+    encode(params, out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.counters["bytes"] = out.size();
+}
+BENCHMARK(BM_ArrivalEncodeCodec);
+
+static void BM_ArrivalDecodePropertyTree(benchmark::State& state)
+{
+  std::string encoded = encode(arrivalParams());
+  for (auto _ : state)
+  {
+    std::istringstream stream(encoded);
+    boost::property_tree::ptree pt;
+    boost::property_tree::json_parser::read_json(stream, pt);
+    PortDrayageArrivalParams params;
+    params.cmv_id = pt.get<std::string>("cmv_id");
+    params.cargo_id = pt.get<std::string>("cargo_id");
+    params.operation = pt.get<std::string>("operation");
+    benchmark::DoNotOptimize(params);
+  }
+}
+BENCHMARK(BM_ArrivalDecodePropertyTree);
+
+static void BM_ArrivalDecodeCodec(benchmark::State& state)
+{
+  std::string encoded = encode(arrivalParams());
+  PortDrayageArrivalParams params;
+  for (auto _ : state)
+  {
+    bool decoded = decode(encoded, params);
+    benchmark::DoNotOptimize(decoded);
+  }
+}
+BENCHMARK(BM_ArrivalDecodeCodec);
+
+// Truck inspection response as previously built with boost::format
+static void BM_InspectionEncodeFormat(benchmark::State& state)
+{
+  auto p = inspectionParams();
+  std::string out;
+  for (auto _ : state)
+  {
+    out = boost::str(
+        boost::format("vin_number:%s,license_plate:%s,carrier_name:%s,carrier_id:%s,weight:%d,ads_software_version:%s,"
+                      "date_of_last_state_inspection:%s,date_of_last_ads_calibration:%s,pre_trip_ads_health_check:%s,"
+                      "ads_health_status:%s,ads_auto_status:%s,iss_score:%d,permit_required:%s") %
+        p.vin_number % p.license_plate % p.carrier_name % p.carrier_id % p.weight % p.ads_software_version %
+        p.date_of_last_state_inspection % p.date_of_last_ads_calibration % p.pre_trip_ads_health_check %
+        p.ads_health_status % p.ads_auto_status % p.iss_score % p.permit_required);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.counters["bytes"] = out.size();
+}
+BENCHMARK(BM_InspectionEncodeFormat);
+
+static void BM_InspectionEncodeCodec(benchmark::State& state)
+{
+  auto params = inspectionParams();
+  std::string out;
+  for (auto _ : state)
+  {
+    encode(params, out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.counters["bytes"] = out.size();
+}
+BENCHMARK(BM_InspectionEncodeCodec);
+
+// Platoon STATUS body as previously parsed by PlatoonManager::memberUpdates
+static void BM_StatusDecodeSplit(benchmark::State& state)
+{
+  std::string body = "CMDSPEED:5.25,DTD:1234.567,SPEED:4.9";
+  for (auto _ : state)
+  {
+    std::vector<std::string> params;
+    boost::algorithm::split(params, body, boost::is_any_of(","));
+    std::vector<std::string> cmd_parsed;
+    boost::algorithm::split(cmd_parsed, params[0], boost::is_any_of(":"));
+    std::vector<std::string> dtd_parsed;
+    boost::algorithm::split(dtd_parsed, params[1], boost::is_any_of(":"));
+    std::vector<std::string> cur_parsed;
+    boost::algorithm::split(cur_parsed, params[2], boost::is_any_of(":"));
+    double sum = std::stod(cmd_parsed[1]) + std::stod(dtd_parsed[1]) + std::stod(cur_parsed[1]);
+    benchmark::DoNotOptimize(sum);
+  }
+}
+BENCHMARK(BM_StatusDecodeSplit);
+
+static void BM_StatusDecodeCodec(benchmark::State& state)
+{
+  std::string body = "CMDSPEED:5.25,DTD:1234.567,SPEED:4.9";
+  PlatoonStatusParams params;
+  for (auto _ : state)
+  {
+    bool decoded = decodeBody(body, params);
+    benchmark::DoNotOptimize(decoded);
+    benchmark::DoNotOptimize(params);
+  }
+}
+BENCHMARK(BM_StatusDecodeCodec);
+
+}  // namespace strategy_params_codec
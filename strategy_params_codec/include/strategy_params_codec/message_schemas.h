@@ -0,0 +1,169 @@
+#pragma once
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <string>
+#include <strategy_params_codec/strategy_params_codec.h>
+
+/**
+ * Schemas of the strategy_params sent and received by CARMA plugins. Senders and receivers of a strategy share the same
+ * schema so the field names and types are defined in one place.
+ */
+namespace strategy_params_codec
+{
+/**
+ * \brief MobilityOperation sent by the port drayage plugin when the vehicle stops at its destination
+ */
+struct PortDrayageArrivalParams : JsonSchema
+{
+  std::string cmv_id;
+  std::string cargo_id;
+  std::string operation;
+
+  template <class Self, class Visitor>
+  static void fields(Self& self, Visitor& visit)
+  {
+    visit("cmv_id", self.cmv_id);
+    visit("cargo_id", self.cargo_id);
+    visit("operation", self.operation);
+  }
+};
+
+/**
+ * \brief MobilityOperation periodically broadcast by the truck inspection client to identify the vehicle
+ */
+struct TruckInspectionVinParams : KeyValueSchema
+{
+  std::string vin_number;
+  std::string license_plate;
+  std::string state_short_name;
+
+  template <class Self, class Visitor>
+  static void fields(Self& self, Visitor& visit)
+  {
+    visit("vin_number", self.vin_number);
+    visit("license_plate", self.license_plate);
+    visit("state_short_name", self.state_short_name);
+  }
+};
+
+/**
+ * \brief MobilityOperation sent by the truck inspection client in response to an inspection request
+ */
+struct TruckInspectionResponseParams : KeyValueSchema
+{
+  std::string vin_number;
+  std::string license_plate;
+  std::string carrier_name;
+  std::string carrier_id;
+  int weight = 0;
+  std::string ads_software_version;
+  std::string date_of_last_state_inspection;
+  std::string date_of_last_ads_calibration;
+  std::string pre_trip_ads_health_check;
+  std::string ads_health_status;
+  std::string ads_auto_status;
+  int iss_score = 0;
+  bool permit_required = false;
+
+  template <class Self, class Visitor>
+  static void fields(Self& self, Visitor& visit)
+  {
+    visit("vin_number", self.vin_number);
+    visit("license_plate", self.license_plate);
+    visit("carrier_name", self.carrier_name);
+    visit("carrier_id", self.carrier_id);
+    visit("weight", self.weight);
+    visit("ads_software_version", self.ads_software_version);
+    visit("date_of_last_state_inspection", self.date_of_last_state_inspection);
+    visit("date_of_last_ads_calibration", self.date_of_last_ads_calibration);
+    visit("pre_trip_ads_health_check", self.pre_trip_ads_health_check);
+    visit("ads_health_status", self.ads_health_status);
+    visit("ads_auto_status", self.ads_auto_status);
+    visit("iss_score", self.iss_score);
+    visit("permit_required", self.permit_required);
+  }
+};
+
+/**
+ * \brief Platooning INFO heartbeat broadcast by a platoon leader
+ */
+struct PlatoonInfoParams : KeyValueSchema
+{
+  static constexpr const char* prefix()
+  {
+    return "INFO|";
+  }
+
+  std::string rear_bsm_id;    // BSM id of the last vehicle in the platoon
+  double length = 0;          // Length of the platoon in m
+  double speed = 0;           // Speed of the leader in m/s
+  int size = 0;               // Number of vehicles in the platoon
+  double rear_downtrack = 0;  // Downtrack distance of the platoon rear in m
+
+  template <class Self, class Visitor>
+  static void fields(Self& self, Visitor& visit)
+  {
+    visit("REAR", self.rear_bsm_id);
+    visit("LENGTH", self.length);
+    visit("SPEED", self.speed);
+    visit("SIZE", self.size);
+    visit("DTD", self.rear_downtrack);
+  }
+};
+
+/**
+ * \brief Platooning STATUS broadcast by every platoon member
+ */
+struct PlatoonStatusParams : KeyValueSchema
+{
+  static constexpr const char* prefix()
+  {
+    return "STATUS|";
+  }
+
+  double command_speed = 0;  // Commanded speed in m/s
+  double downtrack = 0;      // Downtrack distance of the sender in m
+  double speed = 0;          // Current speed of the sender in m/s
+
+  template <class Self, class Visitor>
+  static void fields(Self& self, Visitor& visit)
+  {
+    visit("CMDSPEED", self.command_speed);
+    visit("DTD", self.downtrack);
+    visit("SPEED", self.speed);
+  }
+};
+
+/**
+ * \brief Parameters of a JOIN_PLATOON_AT_REAR MobilityRequest
+ */
+struct JoinPlatoonAtRearParams : KeyValueSchema
+{
+  int size = 0;          // Number of vehicles in the applicant platoon
+  double speed = 0;      // Current speed of the applicant in m/s
+  double downtrack = 0;  // Downtrack distance of the applicant in m
+
+  template <class Self, class Visitor>
+  static void fields(Self& self, Visitor& visit)
+  {
+    visit("SIZE", self.size);
+    visit("SPEED", self.speed);
+    visit("DTD", self.downtrack);
+  }
+};
+
+}  // namespace strategy_params_codec
@@ -0,0 +1,356 @@
+#pragma once
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <boost/utility/string_view.hpp>
+
+namespace strategy_params_codec
+{
+/**
+ * \brief Wire formats used in the strategy_params field of Mobility messages
+ */
+enum class ParamsFormat
+{
+  JSON,       // Flat JSON object such as {"cmv_id":"123","cargo_id":"456"}
+  KEY_VALUE   // KEY:value pairs separated by commas such as CMDSPEED:5,DTD:100.5,SPEED:4.9
+};
+
+/**
+ * \brief Base of schemas encoded as a flat JSON object
+ *
+ * A schema is a struct holding one member per parameter which derives from JsonSchema or KeyValueSchema and lists its
+ * members in a static fields function. The list is resolved at compile time into an encoder and decoder for that type.
+ *
+ *   struct ArrivalParams : JsonSchema
+ *   {
+ *     std::string cmv_id;
+ *     int weight = 0;
+ *
+ *     template <class Self, class Visitor>
+ *     static void fields(Self& self, Visitor& visit)
+ *     {
+ *       visit("cmv_id", self.cmv_id);
+ *       visit("weight", self.weight);
+ *     }
+ *   };
+ *
+ * Members may be std::string, bool or any integral or floating point type, with at most 64 members per schema. A
+ * schema may hide prefix() to require a fixed string such as "STATUS|" ahead of the parameters.
+ */
+struct JsonSchema
+{
+  static constexpr ParamsFormat format()
+  {
+    return ParamsFormat::JSON;
+  }
+
+  static constexpr const char* prefix()
+  {
+    return "";
+  }
+};
+
+/**
+ * \brief Base of schemas encoded as KEY:value pairs separated by commas, see JsonSchema
+ *
+ * Values are written without escaping so they must not contain commas. Booleans are written as 1 and 0.
+ */
+struct KeyValueSchema
+{
+  static constexpr ParamsFormat format()
+  {
+    return ParamsFormat::KEY_VALUE;
+  }
+
+  static constexpr const char* prefix()
+  {
+    return "";
+  }
+};
+
+/**
+ * \brief Iterates over the parameters of an encoded body without allocating
+ *
+ * Keys and values are views into the body, which must outlive the reader. JSON string values are returned without
+ * their quotes and with any escape sequences left in place, see isEscaped().
+ */
+class ParamsReader
+{
+public:
+  ParamsReader(ParamsFormat format, boost::string_view body);
+
+  /**
+   * \brief Moves to the next parameter
+   *
+   * \return False once all parameters have been read or the body is malformed, see failed()
+   */
+  bool next();
+
+  boost::string_view key() const;
+
+  boost::string_view value() const;
+
+  /**
+   * \brief True if the current value is a JSON string holding escape sequences which must be decoded
+   */
+  bool isEscaped() const;
+
+  /**
+   * \brief True if the body could not be parsed
+   */
+  bool failed() const;
+
+private:
+  bool nextJson();
+  bool nextKeyValue();
+  bool fail();
+
+  ParamsFormat format_;
+  boost::string_view body_;
+  size_t pos_ = 0;
+  bool started_ = false;
+  bool failed_ = false;
+  bool escaped_ = false;
+  boost::string_view key_;
+  boost::string_view value_;
+};
+
+/**
+ * \brief Returns the value of key in body or an empty view if it is not present
+ */
+boost::string_view findParam(ParamsFormat format, boost::string_view body, boost::string_view key);
+
+// Helpers used by the schema encoders and decoders
+namespace detail
+{
+void appendKey(ParamsFormat format, const char* key, bool first, std::string& out);
+
+void appendValue(ParamsFormat format, const std::string& value, std::string& out);
+void appendValue(ParamsFormat format, bool value, std::string& out);
+void appendValue(ParamsFormat format, long long value, std::string& out);
+void appendValue(ParamsFormat format, unsigned long long value, std::string& out);
+void appendValue(ParamsFormat format, double value, std::string& out);
+
+void appendClose(ParamsFormat format, bool empty, std::string& out);
+
+bool parseValue(boost::string_view text, bool escaped, std::string& value);
+bool parseValue(boost::string_view text, bool escaped, bool& value);
+bool parseValue(boost::string_view text, bool escaped, long long& value);
+bool parseValue(boost::string_view text, bool escaped, unsigned long long& value);
+bool parseValue(boost::string_view text, bool escaped, double& value);
+
+template <class T>
+using EncodedAs = typename std::conditional<
+    std::is_same<T, bool>::value || std::is_same<T, std::string>::value, T,
+    typename std::conditional<std::is_floating_point<T>::value, double,
+                              typename std::conditional<std::is_signed<T>::value, long long,
+                                                        unsigned long long>::type>::type>::type;
+
+template <class T>
+bool parseField(boost::string_view text, bool escaped, T& value)
+{
+  EncodedAs<T> parsed;
+  if (!parseValue(text, escaped, parsed))
+  {
+    return false;
+  }
+  value = static_cast<T>(parsed);
+  return true;
+}
+
+inline bool parseField(boost::string_view text, bool escaped, std::string& value)
+{
+  return parseValue(text, escaped, value);
+}
+
+class FieldWriter
+{
+public:
+  FieldWriter(ParamsFormat format, std::string& out) : format_(format), out_(out)
+  {
+  }
+
+  template <class T>
+  void operator()(const char* key, const T& value)
+  {
+    appendKey(format_, key, first_, out_);
+    appendValue(format_, static_cast<const EncodedAs<T>&>(value), out_);
+    first_ = false;
+  }
+
+  // True if no field has been written
+  bool empty() const
+  {
+    return first_;
+  }
+
+private:
+  ParamsFormat format_;
+  std::string& out_;
+  bool first_ = true;
+};
+
+class FieldCounter
+{
+public:
+  template <class T>
+  void operator()(const char*, const T&)
+  {
+    count++;
+  }
+
+  size_t count = 0;
+};
+
+class FieldReader
+{
+public:
+  explicit FieldReader(const ParamsReader& reader) : reader_(reader)
+  {
+  }
+
+  template <class T>
+  void operator()(const char* key, T& value)
+  {
+    uint64_t bit = uint64_t(1) << index_++;
+    if (matched_ || reader_.key() != key)
+    {
+      return;
+    }
+    matched_ = true;
+    if (parseField(reader_.value(), reader_.isEscaped(), value))
+    {
+      found_ |= bit;
+    }
+    else
+    {
+      invalid_ = true;
+    }
+  }
+
+  // Prepares for matching the current parameter of the reader
+  void reset()
+  {
+    index_ = 0;
+    matched_ = false;
+  }
+
+  // True if each of the first field_count fields was found and no value failed to parse
+  bool complete(size_t field_count) const
+  {
+    uint64_t all = field_count >= 64 ? ~uint64_t(0) : (uint64_t(1) << field_count) - 1;
+    return !invalid_ && found_ == all;
+  }
+
+private:
+  const ParamsReader& reader_;
+  size_t index_ = 0;
+  bool matched_ = false;
+  bool invalid_ = false;
+  uint64_t found_ = 0;
+};
+}  // namespace detail
+
+/**
+ * \brief Returns true if text starts with the prefix of Schema
+ */
+template <class Schema>
+bool hasPrefix(boost::string_view text)
+{
+  return text.starts_with(Schema::prefix());
+}
+
+/**
+ * \brief Returns text without the prefix of Schema. Text must start with the prefix, see hasPrefix
+ */
+template <class Schema>
+boost::string_view paramsBody(boost::string_view text)
+{
+  text.remove_prefix(std::char_traits<char>::length(Schema::prefix()));
+  return text;
+}
+
+/**
+ * \brief Encodes params into out, replacing its contents
+ *
+ * The capacity of out is reused so encoding into the same buffer, such as the strategy_params of a reused message,
+ * only allocates when the encoded size grows.
+ */
+template <class Schema>
+void encode(const Schema& params, std::string& out)
+{
+  out.clear();
+  out.append(Schema::prefix());
+  detail::FieldWriter writer(Schema::format(), out);
+  Schema::fields(params, writer);
+  detail::appendClose(Schema::format(), writer.empty(), out);
+}
+
+/**
+ * \brief Returns params encoded into a new string
+ */
+template <class Schema>
+std::string encode(const Schema& params)
+{
+  std::string out;
+  encode(params, out);
+  return out;
+}
+
+/**
+ * \brief Decodes a body which does not include the schema prefix
+ *
+ * Parameters which are not part of the schema are ignored. Members of params are only updated for parameters present in
+ * the body.
+ *
+ * \return True if every member of the schema was present and parsed
+ */
+template <class Schema>
+bool decodeBody(boost::string_view body, Schema& params)
+{
+  ParamsReader reader(Schema::format(), body);
+  detail::FieldReader field_reader(reader);
+  while (reader.next())
+  {
+    field_reader.reset();
+    Schema::fields(params, field_reader);
+  }
+  if (reader.failed())
+  {
+    return false;
+  }
+  detail::FieldCounter counter;
+  Schema::fields(static_cast<const Schema&>(params), counter);
+  return field_reader.complete(counter.count);
+}
+
+/**
+ * \brief Decodes text which starts with the schema prefix, see decodeBody
+ */
+template <class Schema>
+bool decode(boost::string_view text, Schema& params)
+{
+  if (!hasPrefix<Schema>(text))
+  {
+    return false;
+  }
+  return decodeBody(paramsBody<Schema>(text), params);
+}
+
+}  // namespace strategy_params_codec
@@ -0,0 +1,563 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <strategy_params_codec/strategy_params_codec.h>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace strategy_params_codec
+{
+namespace
+{
+bool isJsonWhitespace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Copies text into buffer as a null terminated string for the C number parsers
+template <size_t N>
+bool toCString(boost::string_view text, char (&buffer)[N])
+{
+  if (text.empty() || text.size() >= N)
+  {
+    return false;
+  }
+  std::memcpy(buffer, text.data(), text.size());
+  buffer[text.size()] = '\0';
+  return true;
+}
+
+int hexDigit(char c)
+{
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  return -1;
+}
+
+bool parseHex4(boost::string_view text, size_t pos, uint32_t& code)
+{
+  if (pos + 4 > text.size())
+  {
+    return false;
+  }
+  code = 0;
+  for (size_t i = pos; i < pos + 4; i++)
+  {
+    int digit = hexDigit(text[i]);
+    if (digit < 0)
+    {
+      return false;
+    }
+    code = (code << 4) | digit;
+  }
+  return true;
+}
+
+void appendUtf8(uint32_t code, std::string& out)
+{
+  if (code < 0x80)
+  {
+    out.push_back(static_cast<char>(code));
+  }
+  else if (code < 0x800)
+  {
+    out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+    out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+  }
+  else if (code < 0x10000)
+  {
+    out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+    out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+  }
+  else
+  {
+    out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+    out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+  }
+}
+
+bool unescapeJson(boost::string_view text, std::string& out)
+{
+  out.clear();
+  out.reserve(text.size());
+  for (size_t i = 0; i < text.size(); i++)
+  {
+    char c = text[i];
+    if (c != '\\')
+    {
+      out.push_back(c);
+      continue;
+    }
+    if (++i >= text.size())
+    {
+      return false;
+    }
+    switch (text[i])
+    {
+      case '"':
+      case '\\':
+      case '/':
+        out.push_back(text[i]);
+        break;
+      case 'b':
+        out.push_back('\b');
+        break;
+      case 'f':
+        out.push_back('\f');
+        break;
+      case 'n':
+        out.push_back('\n');
+        break;
+      case 'r':
+        out.push_back('\r');
+        break;
+      case 't':
+        out.push_back('\t');
+        break;
+      case 'u':
+      {
+        uint32_t code;
+        if (!parseHex4(text, i + 1, code))
+        {
+          return false;
+        }
+        i += 4;
+        // Combine surrogate pairs into a single code point
+        uint32_t low;
+        if (code >= 0xD800 && code < 0xDC00 && i + 2 < text.size() && text[i + 1] == '\\' && text[i + 2] == 'u' &&
+            parseHex4(text, i + 3, low) && low >= 0xDC00 && low < 0xE000)
+        {
+          code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+          i += 6;
+        }
+        appendUtf8(code, out);
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+void appendJsonString(boost::string_view value, std::string& out)
+{
+  static const char HEX[] = "0123456789abcdef";
+  out.push_back('"');
+  for (char c : value)
+  {
+    switch (c)
+    {
+      case '"':
+        out.append("\\\"");
+        break;
+      case '\\':
+        out.append("\\\\");
+        break;
+      case '\n':
+        out.append("\\n");
+        break;
+      case '\r':
+        out.append("\\r");
+        break;
+      case '\t':
+        out.append("\\t");
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          out.append("\\u00");
+          out.push_back(HEX[(c >> 4) & 0xF]);
+          out.push_back(HEX[c & 0xF]);
+        }
+        else
+        {
+          out.push_back(c);
+        }
+    }
+  }
+  out.push_back('"');
+}
+}  // namespace
+
+ParamsReader::ParamsReader(ParamsFormat format, boost::string_view body) : format_(format), body_(body)
+{
+}
+
+bool ParamsReader::next()
+{
+  if (failed_)
+  {
+    return false;
+  }
+  escaped_ = false;
+  return format_ == ParamsFormat::JSON ? nextJson() : nextKeyValue();
+}
+
+boost::string_view ParamsReader::key() const
+{
+  return key_;
+}
+
+boost::string_view ParamsReader::value() const
+{
+  return value_;
+}
+
+bool ParamsReader::isEscaped() const
+{
+  return escaped_;
+}
+
+bool ParamsReader::failed() const
+{
+  return failed_;
+}
+
+bool ParamsReader::fail()
+{
+  failed_ = true;
+  key_.clear();
+  value_.clear();
+  return false;
+}
+
+bool ParamsReader::nextKeyValue()
+{
+  if (pos_ >= body_.size())
+  {
+    // A trailing comma leaves an empty pair
+    if (started_ && !body_.empty() && body_.back() == ',')
+    {
+      return fail();
+    }
+    return false;
+  }
+  started_ = true;
+
+  size_t end = body_.find(',', pos_);
+  if (end == boost::string_view::npos)
+  {
+    end = body_.size();
+  }
+  boost::string_view pair = body_.substr(pos_, end - pos_);
+  pos_ = end + 1;
+
+  size_t separator = pair.find(':');
+  if (separator == boost::string_view::npos || separator == 0)
+  {
+    return fail();
+  }
+  key_ = pair.substr(0, separator);
+  value_ = pair.substr(separator + 1);
+  return true;
+}
+
+bool ParamsReader::nextJson()
+{
+  auto skip_whitespace = [this]() {
+    while (pos_ < body_.size() && isJsonWhitespace(body_[pos_]))
+    {
+      pos_++;
+    }
+  };
+  // Reads a string starting at the opening quote and leaves pos_ after the closing quote
+  auto read_string = [this](boost::string_view& str, bool& escaped) {
+    if (pos_ >= body_.size() || body_[pos_] != '"')
+    {
+      return false;
+    }
+    size_t start = ++pos_;
+    escaped = false;
+    while (pos_ < body_.size() && body_[pos_] != '"')
+    {
+      if (body_[pos_] == '\\')
+      {
+        escaped = true;
+        pos_++;
+      }
+      pos_++;
+    }
+    if (pos_ >= body_.size())
+    {
+      return false;
+    }
+    str = body_.substr(start, pos_ - start);
+    pos_++;
+    return true;
+  };
+
+  skip_whitespace();
+  if (!started_)
+  {
+    started_ = true;
+    if (pos_ >= body_.size() || body_[pos_] != '{')
+    {
+      return fail();
+    }
+    pos_++;
+    skip_whitespace();
+  }
+  else if (pos_ < body_.size() && body_[pos_] == ',')
+  {
+    pos_++;
+    skip_whitespace();
+  }
+  else if (pos_ >= body_.size() || body_[pos_] != '}')
+  {
+    return fail();
+  }
+
+  if (pos_ < body_.size() && body_[pos_] == '}')
+  {
+    pos_++;
+    skip_whitespace();
+    if (pos_ != body_.size())
+    {
+      return fail();
+    }
+    key_.clear();
+    value_.clear();
+    return false;
+  }
+
+  bool key_escaped;
+  if (!read_string(key_, key_escaped))
+  {
+    return fail();
+  }
+  skip_whitespace();
+  if (pos_ >= body_.size() || body_[pos_] != ':')
+  {
+    return fail();
+  }
+  pos_++;
+  skip_whitespace();
+  if (pos_ >= body_.size())
+  {
+    return fail();
+  }
+
+  if (body_[pos_] == '"')
+  {
+    if (!read_string(value_, escaped_))
+    {
+      return fail();
+    }
+  }
+  else if (body_[pos_] == '{' || body_[pos_] == '[')
+  {
+    // Only flat objects are supported
+    return fail();
+  }
+  else
+  {
+    size_t start = pos_;
+    while (pos_ < body_.size() && body_[pos_] != ',' && body_[pos_] != '}' && !isJsonWhitespace(body_[pos_]))
+    {
+      pos_++;
+    }
+    if (pos_ == start)
+    {
+      return fail();
+    }
+    value_ = body_.substr(start, pos_ - start);
+  }
+  skip_whitespace();
+  if (pos_ >= body_.size() || (body_[pos_] != ',' && body_[pos_] != '}'))
+  {
+    return fail();
+  }
+  return true;
+}
+
+boost::string_view findParam(ParamsFormat format, boost::string_view body, boost::string_view key)
+{
+  ParamsReader reader(format, body);
+  while (reader.next())
+  {
+    if (reader.key() == key)
+    {
+      return reader.value();
+    }
+  }
+  return boost::string_view();
+}
+
+namespace detail
+{
+void appendKey(ParamsFormat format, const char* key, bool first, std::string& out)
+{
+  if (format == ParamsFormat::JSON)
+  {
+    out.append(first ? "{\"" : ",\"");
+    out.append(key);
+    out.append("\":");
+  }
+  else
+  {
+    if (!first)
+    {
+      out.push_back(',');
+    }
+    out.append(key);
+    out.push_back(':');
+  }
+}
+
+void appendValue(ParamsFormat format, const std::string& value, std::string& out)
+{
+  if (format == ParamsFormat::JSON)
+  {
+    appendJsonString(value, out);
+  }
+  else
+  {
+    out.append(value);
+  }
+}
+
+void appendValue(ParamsFormat format, bool value, std::string& out)
+{
+  if (format == ParamsFormat::JSON)
+  {
+    out.append(value ? "true" : "false");
+  }
+  else
+  {
+    out.push_back(value ? '1' : '0');
+  }
+}
+
+void appendValue(ParamsFormat format, long long value, std::string& out)
+{
+  char buffer[32];
+  int size = std::snprintf(buffer, sizeof(buffer), "%lld", value);
+  out.append(buffer, size);
+}
+
+void appendValue(ParamsFormat format, unsigned long long value, std::string& out)
+{
+  char buffer[32];
+  int size = std::snprintf(buffer, sizeof(buffer), "%llu", value);
+  out.append(buffer, size);
+}
+
+void appendValue(ParamsFormat format, double value, std::string& out)
+{
+  if (format == ParamsFormat::JSON && !std::isfinite(value))
+  {
+    out.append("null");
+    return;
+  }
+  // 10 significant digits keeps millimeters on downtrack distances while short values stay short
+  char buffer[32];
+  int size = std::snprintf(buffer, sizeof(buffer), "%.10g", value);
+  out.append(buffer, size);
+}
+
+void appendClose(ParamsFormat format, bool empty, std::string& out)
+{
+  if (format != ParamsFormat::JSON)
+  {
+    return;
+  }
+  // A schema without fields is still written as an object
+  out.append(empty ? "{}" : "}");
+}
+
+bool parseValue(boost::string_view text, bool escaped, std::string& value)
+{
+  if (escaped)
+  {
+    return unescapeJson(text, value);
+  }
+  value.assign(text.data(), text.size());
+  return true;
+}
+
+bool parseValue(boost::string_view text, bool escaped, bool& value)
+{
+  if (text == "1" || text == "true")
+  {
+    value = true;
+    return true;
+  }
+  if (text == "0" || text == "false")
+  {
+    value = false;
+    return true;
+  }
+  return false;
+}
+
+bool parseValue(boost::string_view text, bool escaped, long long& value)
+{
+  char buffer[32];
+  if (!toCString(text, buffer))
+  {
+    return false;
+  }
+  char* end;
+  errno = 0;
+  value = std::strtoll(buffer, &end, 10);
+  return errno == 0 && end == buffer + text.size();
+}
+
+bool parseValue(boost::string_view text, bool escaped, unsigned long long& value)
+{
+  char buffer[32];
+  if (!toCString(text, buffer) || buffer[0] == '-')
+  {
+    return false;
+  }
+  char* end;
+  errno = 0;
+  value = std::strtoull(buffer, &end, 10);
+  return errno == 0 && end == buffer + text.size();
+}
+
+bool parseValue(boost::string_view text, bool escaped, double& value)
+{
+  if (text == "null")
+  {
+    value = std::numeric_limits<double>::quiet_NaN();
+    return true;
+  }
+  char buffer[64];
+  if (!toCString(text, buffer))
+  {
+    return false;
+  }
+  char* end;
+  errno = 0;
+  value = std::strtod(buffer, &end);
+  return errno != ERANGE && end == buffer + text.size();
+}
+}  // namespace detail
+
+}  // namespace strategy_params_codec
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <boost/format.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <strategy_params_codec/message_schemas.h>
+
+namespace strategy_params_codec
+{
+TEST(StrategyParamsCodecTest, jsonRoundTrip)
+{
+  PortDrayageArrivalParams params;
+  params.cmv_id = "123";
+  params.cargo_id = "cargo \"A\"\\B\n";
+  params.operation = "ARRIVED_AT_DESTINATION";
+
+  std::string encoded = encode(params);
+  ASSERT_EQ("{\"cmv_id\":\"123\",\"cargo_id\":\"cargo \\\"A\\\"\\\\B\\n\",\"operation\":\"ARRIVED_AT_DESTINATION\"}",
+            encoded);
+
+  PortDrayageArrivalParams decoded;
+  ASSERT_TRUE(decode(encoded, decoded));
+  ASSERT_EQ(params.cmv_id, decoded.cmv_id);
+  ASSERT_EQ(params.cargo_id, decoded.cargo_id);
+  ASSERT_EQ(params.operation, decoded.operation);
+
+  // Messages remain readable by existing property tree consumers
+  std::istringstream stream(encoded);
+  boost::property_tree::ptree pt;
+  boost::property_tree::json_parser::read_json(stream, pt);
+  ASSERT_EQ(params.cmv_id, pt.get<std::string>("cmv_id"));
+  ASSERT_EQ(params.cargo_id, pt.get<std::string>("cargo_id"));
+  ASSERT_EQ(params.operation, pt.get<std::string>("operation"));
+}
+
+TEST(StrategyParamsCodecTest, decodePropertyTreeJson)
+{
+  boost::property_tree::ptree pt;
+  pt.put("operation", "ARRIVED_AT_DESTINATION");
+  pt.put("cmv_id", "123");
+  pt.put("cargo_id", "caf\xC3\xA9");
+  pt.put("unused", "value");
+  std::stringstream stream;
+  boost::property_tree::json_parser::write_json(stream, pt);
+
+  PortDrayageArrivalParams decoded;
+  ASSERT_TRUE(decode(stream.str(), decoded));
+  ASSERT_EQ("123", decoded.cmv_id);
+  ASSERT_EQ("caf\xC3\xA9", decoded.cargo_id);
+  ASSERT_EQ("ARRIVED_AT_DESTINATION", decoded.operation);
+
+  ASSERT_TRUE(decode("{\"cmv_id\":\"\\u0041\\ud83d\\ude00\",\"cargo_id\":\"\",\"operation\":\"\"}", decoded));
+  ASSERT_EQ("A\xF0\x9F\x98\x80", decoded.cmv_id);
+  ASSERT_EQ("", decoded.cargo_id);
+}
+
+TEST(StrategyParamsCodecTest, keyValueRoundTrip)
+{
+  TruckInspectionResponseParams params;
+  params.vin_number = "1FUJGBDV8CLBP8834";
+  params.license_plate = "DOT-10003";
+  params.carrier_name = "FMCSA Tech Division";
+  params.carrier_id = "USDOT 0000001";
+  params.weight = 20000;
+  params.ads_software_version = "System Version Unknown";
+  params.date_of_last_state_inspection = "2020.01.20";
+  params.date_of_last_ads_calibration = "2020.02.20";
+  params.pre_trip_ads_health_check = "Green";
+  params.ads_health_status = "1";
+  params.ads_auto_status = "Not Engaged";
+  params.iss_score = 90;
+  params.permit_required = true;
+
+  // Same text as previously produced with boost::format
+  std::string expected = boost::str(
+      boost::format("vin_number:%s,license_plate:%s,carrier_name:%s,carrier_id:%s,weight:%d,ads_software_version:%s,"
+                    "date_of_last_state_inspection:%s,date_of_last_ads_calibration:%s,pre_trip_ads_health_check:%s,"
+                    "ads_health_status:%s,ads_auto_status:%s,iss_score:%d,permit_required:%s") %
+      params.vin_number % params.license_plate % params.carrier_name % params.carrier_id % params.weight %
+      params.ads_software_version % params.date_of_last_state_inspection % params.date_of_last_ads_calibration %
+      params.pre_trip_ads_health_check % params.ads_health_status % params.ads_auto_status % params.iss_score %
+      params.permit_required);
+  std::string encoded = encode(params);
+  ASSERT_EQ(expected, encoded);
+
+  TruckInspectionResponseParams decoded;
+  ASSERT_TRUE(decode(encoded, decoded));
+  ASSERT_EQ(params.vin_number, decoded.vin_number);
+  ASSERT_EQ(params.carrier_id, decoded.carrier_id);
+  ASSERT_EQ(params.weight, decoded.weight);
+  ASSERT_EQ(params.ads_auto_status, decoded.ads_auto_status);
+  ASSERT_EQ(params.iss_score, decoded.iss_score);
+  ASSERT_TRUE(decoded.permit_required);
+}
+
+TEST(StrategyParamsCodecTest, prefixedRoundTrip)
+{
+  PlatoonInfoParams info;
+  info.rear_bsm_id = "0a1b2c3d";
+  info.length = 15.25;
+  info.speed = 4.9;
+  info.size = 3;
+  info.rear_downtrack = 1234.567;
+
+  std::string encoded = encode(info);
+  ASSERT_EQ("INFO|REAR:0a1b2c3d,LENGTH:15.25,SPEED:4.9,SIZE:3,DTD:1234.567", encoded);
+  ASSERT_TRUE(hasPrefix<PlatoonInfoParams>(encoded));
+  ASSERT_FALSE(hasPrefix<PlatoonStatusParams>(encoded));
+
+  PlatoonInfoParams decoded;
+  ASSERT_TRUE(decode(encoded, decoded));
+  ASSERT_EQ(info.rear_bsm_id, decoded.rear_bsm_id);
+  ASSERT_DOUBLE_EQ(info.length, decoded.length);
+  ASSERT_DOUBLE_EQ(info.speed, decoded.speed);
+  ASSERT_EQ(info.size, decoded.size);
+  ASSERT_DOUBLE_EQ(info.rear_downtrack, decoded.rear_downtrack);
+
+  // Decoding requires the prefix while decodeBody expects it to be removed
+  PlatoonStatusParams status;
+  ASSERT_FALSE(decode("CMDSPEED:5,DTD:100.5,SPEED:4.9", status));
+  ASSERT_TRUE(decodeBody("CMDSPEED:5,DTD:100.5,SPEED:4.9", status));
+  ASSERT_DOUBLE_EQ(5.0, status.command_speed);
+  ASSERT_DOUBLE_EQ(100.5, status.downtrack);
+  ASSERT_DOUBLE_EQ(4.9, status.speed);
+
+  // Order does not matter and unknown keys are ignored
+  ASSERT_TRUE(decode("STATUS|SPEED:1,EXTRA:x,DTD:2,CMDSPEED:3", status));
+  ASSERT_DOUBLE_EQ(3.0, status.command_speed);
+  ASSERT_DOUBLE_EQ(2.0, status.downtrack);
+  ASSERT_DOUBLE_EQ(1.0, status.speed);
+}
+
+TEST(StrategyParamsCodecTest, invalidParams)
+{
+  PlatoonStatusParams status;
+  ASSERT_FALSE(decodeBody("CMDSPEED:5,DOWNTRACK:100.5,SPEED:4.9", status));  // Missing field
+  ASSERT_FALSE(decodeBody("CMDSPEED:fast,DTD:100.5,SPEED:4.9", status));     // Unparsable value
+  ASSERT_FALSE(decodeBody("CMDSPEED:5,DTD:100.5,SPEED:4.9,", status));        // Empty pair
+  ASSERT_FALSE(decodeBody("CMDSPEED 5,DTD:100.5,SPEED:4.9", status));         // Missing separator
+  ASSERT_FALSE(decodeBody("", status));
+
+  JoinPlatoonAtRearParams join;
+  ASSERT_FALSE(decodeBody("SIZE:2.5,SPEED:1,DTD:1", join));
+
+  PortDrayageArrivalParams arrival;
+  ASSERT_FALSE(decode("{\"cmv_id\":\"1\",\"cargo_id\":\"2\"}", arrival));
+  ASSERT_FALSE(decode("{\"cmv_id\":\"1\",\"cargo_id\":\"2\",\"operation\":\"3\"", arrival));
+  ASSERT_FALSE(decode("{\"cmv_id\":{\"a\":1},\"cargo_id\":\"2\",\"operation\":\"3\"}", arrival));
+  ASSERT_FALSE(decode("{\"cmv_id\":\"1\",\"cargo_id\":\"2\",\"operation\":\"3\"} extra", arrival));
+  ASSERT_FALSE(decode("cmv_id:1,cargo_id:2,operation:3", arrival));
+}
+
+TEST(StrategyParamsCodecTest, reader)
+{
+  ParamsReader reader(ParamsFormat::JSON, " { \"a\" : 1.5 , \"b\":\"x\\\"y\", \"c\": true } ");
+  ASSERT_TRUE(reader.next());
+  ASSERT_EQ("a", reader.key());
+  ASSERT_EQ("1.5", reader.value());
+  ASSERT_TRUE(reader.next());
+  ASSERT_EQ("b", reader.key());
+  ASSERT_EQ("x\\\"y", reader.value());
+  ASSERT_TRUE(reader.isEscaped());
+  ASSERT_TRUE(reader.next());
+  ASSERT_EQ("c", reader.key());
+  ASSERT_EQ("true", reader.value());
+  ASSERT_FALSE(reader.next());
+  ASSERT_FALSE(reader.failed());
+
+  ASSERT_EQ("100.5", findParam(ParamsFormat::KEY_VALUE, "CMDSPEED:5,DTD:100.5,SPEED:4.9", "DTD"));
+  ASSERT_TRUE(findParam(ParamsFormat::KEY_VALUE, "CMDSPEED:5,DTD:100.5,SPEED:4.9", "SIZE").empty());
+}
+
+TEST(StrategyParamsCodecTest, reuseBuffer)
+{
+  PlatoonStatusParams status;
+  status.command_speed = 5;
+  status.downtrack = 100.5;
+  status.speed = 4.9;
+
+  std::string buffer;
+  encode(status, buffer);
+  ASSERT_EQ("STATUS|CMDSPEED:5,DTD:100.5,SPEED:4.9", buffer);
+  const char* data = buffer.data();
+
+  status.downtrack = 99;
+  encode(status, buffer);
+  ASSERT_EQ("STATUS|CMDSPEED:5,DTD:99,SPEED:4.9", buffer);
+  ASSERT_EQ(data, buffer.data());
+}
+
+}  // namespace strategy_params_codec
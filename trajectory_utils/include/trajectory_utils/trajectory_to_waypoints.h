@@ -0,0 +1,84 @@
+#pragma once
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <vector>
+#include <cav_msgs/TrajectoryPlan.h>
+#include <autoware_msgs/Lane.h>
+
+namespace trajectory_utils
+{
+/**
+ * \brief Batch converter from a CARMA TrajectoryPlan to the Autoware waypoint lane consumed by the controllers
+ *
+ * The trajectory is first unpacked into contiguous x/y/time arrays. Speed, heading and optionally curvature
+ * are then computed by finite differences in simple loops over those arrays which the compiler can vectorize.
+ * All buffers, including the waypoints of the output lane, are kept between calls so that converting
+ * trajectories of similar length at controller rate does not allocate.
+ *
+ * For a trajectory of N points the lane holds N-1 waypoints. Waypoint i is located at point i and carries the
+ * speed and heading of the segment from point i to point i+1. Segments with zero duration get zero speed.
+ *
+ * This class is not thread safe, each caller should own its converter.
+ */
+class TrajectoryToWaypoints
+{
+public:
+  /**
+   * \brief Constructor
+   * \param compute_curvature If true curvature is computed during each conversion and available from curvatures()
+   */
+  explicit TrajectoryToWaypoints(bool compute_curvature = false);
+
+  /**
+   * \brief Convert a whole trajectory into the waypoints of lane
+   *
+   * \param trajectory The trajectory to convert. Point target_time is in nanoseconds.
+   * \param lane The lane to fill. Its header is copied from the trajectory and its waypoints are resized in place.
+   */
+  void convert(const cav_msgs::TrajectoryPlan& trajectory, autoware_msgs::Lane& lane);
+
+  /**
+   * \brief Speed in m/s of each segment of the last converted trajectory
+   */
+  const std::vector<double>& speeds() const;
+
+  /**
+   * \brief Heading in rad of each segment of the last converted trajectory, measured from the x axis
+   */
+  const std::vector<double>& headings() const;
+
+  /**
+   * \brief Curvature in 1/m at each waypoint of the last converted trajectory.
+   * Empty if curvature computation is disabled. The last waypoint repeats the curvature of the one before it.
+   */
+  const std::vector<double>& curvatures() const;
+
+private:
+  bool compute_curvature_;
+
+  // Structure of arrays view of the trajectory
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<double> dt_;
+
+  // Per segment results
+  std::vector<double> speed_;
+  std::vector<double> heading_;
+  std::vector<double> curvature_;
+};
+
+}  // namespace trajectory_utils
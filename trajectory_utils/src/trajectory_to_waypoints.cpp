@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <trajectory_utils/trajectory_to_waypoints.h>
+#include <cmath>
+#include <cstdint>
+
+namespace trajectory_utils
+{
+TrajectoryToWaypoints::TrajectoryToWaypoints(bool compute_curvature) : compute_curvature_(compute_curvature)
+{
+}
+
+void TrajectoryToWaypoints::convert(const cav_msgs::TrajectoryPlan& trajectory, autoware_msgs::Lane& lane)
+{
+  lane.header = trajectory.header;
+
+  const auto& points = trajectory.trajectory_points;
+  if (points.size() < 2)
+  {
+    lane.waypoints.clear();
+    speed_.clear();
+    heading_.clear();
+    curvature_.clear();
+    return;
+  }
+
+  const size_t num_points = points.size();
+  const size_t num_segments = num_points - 1;
+
+  // Unpack into contiguous arrays. Time deltas are taken as signed integers before conversion
+  // so trajectories with decreasing target times do not wrap around
+  x_.resize(num_points);
+  y_.resize(num_points);
+  dt_.resize(num_segments);
+  for (size_t i = 0; i < num_points; i++)
+  {
+    x_[i] = points[i].x;
+    y_[i] = points[i].y;
+  }
+  for (size_t i = 0; i < num_segments; i++)
+  {
+    int64_t delta_ns = static_cast<int64_t>(points[i + 1].target_time - points[i].target_time);
+    dt_[i] = std::fabs(static_cast<double>(delta_ns)) * 1e-9;
+  }
+
+  // Finite difference speed and heading of each segment
+  speed_.resize(num_segments);
+  heading_.resize(num_segments);
+  for (size_t i = 0; i < num_segments; i++)
+  {
+    double dx = x_[i + 1] - x_[i];
+    double dy = y_[i + 1] - y_[i];
+    double dist = std::sqrt(dx * dx + dy * dy);
+    speed_[i] = dt_[i] != 0.0 ? dist / dt_[i] : 0.0;
+    heading_[i] = std::atan2(dy, dx);
+  }
+
+  if (compute_curvature_)
+  {
+    // Heading change over the mean length of the two segments meeting at each interior point
+    curvature_.resize(num_segments);
+    curvature_[0] = 0.0;
+    for (size_t i = 1; i < num_segments; i++)
+    {
+      double dx0 = x_[i] - x_[i - 1];
+      double dy0 = y_[i] - y_[i - 1];
+      double dx1 = x_[i + 1] - x_[i];
+      double dy1 = y_[i + 1] - y_[i];
+      double arc = 0.5 * (std::sqrt(dx0 * dx0 + dy0 * dy0) + std::sqrt(dx1 * dx1 + dy1 * dy1));
+      double dheading = heading_[i] - heading_[i - 1];
+      dheading -= 2.0 * M_PI * std::nearbyint(dheading / (2.0 * M_PI));
+      curvature_[i] = arc > 0.0 ? dheading / arc : 0.0;
+    }
+    if (num_segments > 1)
+    {
+      curvature_[0] = curvature_[1];
+    }
+  }
+  else
+  {
+    curvature_.clear();
+  }
+
+  // Fill the reused waypoints, resize keeps the capacity of previous conversions
+  lane.waypoints.resize(num_segments);
+  for (size_t i = 0; i < num_segments; i++)
+  {
+    autoware_msgs::Waypoint& waypoint = lane.waypoints[i];
+    waypoint.pose.pose.position.x = x_[i];
+    waypoint.pose.pose.position.y = y_[i];
+    waypoint.pose.pose.orientation.x = 0.0;
+    waypoint.pose.pose.orientation.y = 0.0;
+    waypoint.pose.pose.orientation.z = std::sin(0.5 * heading_[i]);
+    waypoint.pose.pose.orientation.w = std::cos(0.5 * heading_[i]);
+    waypoint.twist.twist.linear.x = speed_[i];
+  }
+}
+
+const std::vector<double>& TrajectoryToWaypoints::speeds() const
+{
+  return speed_;
+}
+
+const std::vector<double>& TrajectoryToWaypoints::headings() const
+{
+  return heading_;
+}
+
+const std::vector<double>& TrajectoryToWaypoints::curvatures() const
+{
+  return curvature_;
+}
+
+}  // namespace trajectory_utils
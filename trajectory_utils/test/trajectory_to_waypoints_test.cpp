@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2020 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <trajectory_utils/trajectory_to_waypoints.h>
+#include <gtest/gtest.h>
+#include <cmath>
+
+namespace
+{
+cav_msgs::TrajectoryPlanPoint makePoint(double x, double y, uint64_t target_time)
+{
+  cav_msgs::TrajectoryPlanPoint point;
+  point.x = x;
+  point.y = y;
+  point.target_time = target_time;
+  return point;
+}
+}  // namespace
+
+TEST(TrajectoryToWaypointsTest, convert)
+{
+  cav_msgs::TrajectoryPlan trajectory;
+  trajectory.header.frame_id = "map";
+  trajectory.trajectory_points.push_back(makePoint(10, 10, 1e8));
+  trajectory.trajectory_points.push_back(makePoint(12, 12, 2e8));
+  trajectory.trajectory_points.push_back(makePoint(12, 12, 2e8));
+  // Target time going backwards must not wrap around
+  trajectory.trajectory_points.push_back(makePoint(13, 11, 1e8));
+
+  trajectory_utils::TrajectoryToWaypoints converter;
+  autoware_msgs::Lane lane;
+  converter.convert(trajectory, lane);
+
+  ASSERT_EQ(3, lane.waypoints.size());
+  EXPECT_EQ("map", lane.header.frame_id);
+  EXPECT_NEAR(10.0, lane.waypoints[0].pose.pose.position.x, 0.0001);
+  EXPECT_NEAR(12.0, lane.waypoints[1].pose.pose.position.y, 0.0001);
+  EXPECT_NEAR(28.28, lane.waypoints[0].twist.twist.linear.x, 0.01);
+  EXPECT_NEAR(0.0, lane.waypoints[1].twist.twist.linear.x, 0.0001);
+  EXPECT_NEAR(14.14, lane.waypoints[2].twist.twist.linear.x, 0.01);
+
+  EXPECT_NEAR(M_PI / 4.0, converter.headings()[0], 0.0001);
+  EXPECT_NEAR(-M_PI / 4.0, converter.headings()[2], 0.0001);
+  // Orientation matches heading
+  EXPECT_NEAR(std::sin(M_PI / 8.0), lane.waypoints[0].pose.pose.orientation.z, 0.0001);
+  EXPECT_NEAR(std::cos(M_PI / 8.0), lane.waypoints[0].pose.pose.orientation.w, 0.0001);
+  EXPECT_TRUE(converter.curvatures().empty());
+
+  // Shorter trajectories reuse the lane
+  trajectory.trajectory_points.resize(2);
+  converter.convert(trajectory, lane);
+  ASSERT_EQ(1, lane.waypoints.size());
+
+  trajectory.trajectory_points.resize(1);
+  converter.convert(trajectory, lane);
+  ASSERT_TRUE(lane.waypoints.empty());
+}
+
+TEST(TrajectoryToWaypointsTest, curvature)
+{
+  // Points on a circle of radius 10
+  cav_msgs::TrajectoryPlan trajectory;
+  const double radius = 10.0;
+  for (int i = 0; i < 20; i++)
+  {
+    double angle = i * 0.05;
+    trajectory.trajectory_points.push_back(
+        makePoint(radius * std::cos(angle), radius * std::sin(angle), static_cast<uint64_t>(i * 1e8)));
+  }
+
+  trajectory_utils::TrajectoryToWaypoints converter(true);
+  autoware_msgs::Lane lane;
+  converter.convert(trajectory, lane);
+
+  ASSERT_EQ(19, converter.curvatures().size());
+  for (double curvature : converter.curvatures())
+  {
+    EXPECT_NEAR(1.0 / radius, curvature, 0.001);
+  }
+  // Arc length of 0.5 m per 0.1 s
+  EXPECT_NEAR(5.0, converter.speeds()[5], 0.01);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -23,7 +23,7 @@
 #include <cav_msgs/MobilityRequest.h>
 #include <cav_msgs/BSM.h>
 #include <std_msgs/String.h>
-#include "boost/format.hpp"
+#include <strategy_params_codec/message_schemas.h>
 
 namespace truck_inspection_client
 {
@@ -79,6 +79,12 @@ namespace truck_inspection_client
         bool permit_required_;
         bool ads_engaged_;  
         std::string ads_system_alert_type_;  
+
+        // vehicle identification broadcast on every spin, encoded once on initialization
+        cav_msgs::MobilityOperation vin_msg_;
+
+        // inspection response with the static truck info filled on initialization
+        strategy_params_codec::TruckInspectionResponseParams response_params_;
     };
 
 }
\ No newline at end of file
@@ -44,12 +44,26 @@ namespace truck_inspection_client
         this->ads_engaged_ = false;
         this->ads_system_alert_type_ = std::to_string(cav_msgs::SystemAlert::NOT_READY);
         this->ads_software_version_ = "System Version Unknown";
+        // the truck info does not change so the vin message and the static part of the response are encoded once
+        strategy_params_codec::TruckInspectionVinParams vin_params;
+        vin_params.vin_number = vin_number_;
+        vin_params.license_plate = license_plate_;
+        vin_params.state_short_name = state_short_name_;
+        vin_msg_.strategy = this->INSPECTION_STRATEGY;
+        strategy_params_codec::encode(vin_params, vin_msg_.strategy_params);
+        response_params_.vin_number = vin_number_;
+        response_params_.license_plate = license_plate_;
+        response_params_.carrier_name = carrier_name_;
+        response_params_.carrier_id = carrier_id_;
+        response_params_.weight = weight_;
+        response_params_.date_of_last_state_inspection = date_of_last_state_inspection_;
+        response_params_.date_of_last_ads_calibration = date_of_last_ads_calibration_;
+        response_params_.pre_trip_ads_health_check = pre_trip_ads_health_check_;
+        response_params_.iss_score = iss_score_;
+        response_params_.permit_required = permit_required_;
         // set vin publisher
         ros::CARMANodeHandle::setSpinCallback([this]() -> bool {
-            cav_msgs::MobilityOperation msg_out;
-            msg_out.strategy = this->INSPECTION_STRATEGY;
-            msg_out.strategy_params = "vin_number:" + vin_number_ + ",license_plate:" + license_plate_ +",state_short_name:"+ state_short_name_;
-            mo_pub_.publish(msg_out);
+            mo_pub_.publish(vin_msg_);
             return true;
         });
         ROS_INFO_STREAM("Truck inspection plugin is initialized...");
@@ -82,13 +96,12 @@ namespace truck_inspection_client
             cav_msgs::MobilityOperation mo_msg;
             mo_msg.header.sender_bsm_id = bsm_id_;
             mo_msg.strategy = this->INSPECTION_STRATEGY;
-            std::string ads_auto_status = this->ads_engaged_ ? "Engaged" : "Not Engaged";
-            std::string ads_health_status = ads_system_alert_type_ ;
-            std::string params = boost::str(boost::format("vin_number:%s,license_plate:%s,carrier_name:%s,carrier_id:%s,weight:%d,ads_software_version:%s,date_of_last_state_inspection:%s,date_of_last_ads_calibration:%s,pre_trip_ads_health_check:%s,ads_health_status:%s,ads_auto_status:%s,iss_score:%d,permit_required:%s")
-                                                         % vin_number_ % license_plate_ % carrier_name_ % carrier_id_ % weight_ % ads_software_version_ % date_of_last_state_inspection_ % date_of_last_ads_calibration_ % pre_trip_ads_health_check_ % ads_health_status % ads_auto_status % iss_score_ % permit_required_);
+            response_params_.ads_software_version = ads_software_version_;
+            response_params_.ads_health_status = ads_system_alert_type_;
+            response_params_.ads_auto_status = this->ads_engaged_ ? "Engaged" : "Not Engaged";
             long time = (long)(ros::Time::now().toNSec() / pow(10, 6));
             mo_msg.header.timestamp = time;
-            mo_msg.strategy_params = params;
+            strategy_params_codec::encode(response_params_, mo_msg.strategy_params);
             mo_pub_.publish(mo_msg);
         }
     }